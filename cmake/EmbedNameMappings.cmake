@@ -0,0 +1,116 @@
+# SPDX-License-Identifier: MIT
+#
+# Compiles the default name mappings into a C++ source file of sorted lookup tables.
+#
+# Usage: cmake -DNAME_MAPPINGS=<name-mappings.json> -DVENDORS=<vendors.json> -DOUTPUT=<file.cpp>
+#        -P EmbedNameMappings.cmake
+#
+# Keys are normalised the way NameMappings::loadFromFile() normalises them, so lookups can use a
+# binary search on the same normalised key.
+
+cmake_minimum_required(VERSION 3.19)
+
+# Encodes text as the contents of a C++ string literal. Bytes outside ASCII become hex escapes so
+# the generated file does not depend on the compiler's source character set.
+function(to_cxx_literal out text)
+  string(HEX "${text}" hex)
+  string(LENGTH "${hex}" length)
+  set(literal "")
+  set(after_escape FALSE)
+  set(i 0)
+  while(i LESS length)
+    string(SUBSTRING "${hex}" ${i} 2 byte)
+    math(EXPR code "0x${byte}")
+    if(code GREATER_EQUAL 128)
+      string(APPEND literal "\\x${byte}")
+      set(after_escape TRUE)
+    else()
+      string(ASCII ${code} char)
+      if(after_escape AND char MATCHES "[0-9A-Fa-f]")
+        # End the literal so the next character is not read as part of the escape
+        string(APPEND literal "\"\"")
+      endif()
+      if(char STREQUAL "\\" OR char STREQUAL "\"")
+        string(APPEND literal "\\")
+      endif()
+      string(APPEND literal "${char}")
+      set(after_escape FALSE)
+    endif()
+    math(EXPR i "${i} + 2")
+  endwhile()
+  set(${out} "\"${literal}\"" PARENT_SCOPE)
+endfunction()
+
+# Appends the table definition for one JSON object to the variable named by out.
+# mode: LOWER, UPPER, INTEGER or NONE.
+function(emit_table out json_var name mode)
+  set(json "${${json_var}}")
+  set(path ${ARGN})
+  string(JSON count ERROR_VARIABLE error LENGTH "${json}" ${path})
+  if(error)
+    set(count 0)
+  endif()
+
+  set(keys "")
+  if(count GREATER 0)
+    math(EXPR last "${count} - 1")
+    foreach(i RANGE ${last})
+      string(JSON key MEMBER "${json}" ${path} ${i})
+      string(JSON type TYPE "${json}" ${path} "${key}")
+      if(NOT type STREQUAL "STRING")
+        continue()
+      endif()
+      string(JSON value GET "${json}" ${path} "${key}")
+      if(mode STREQUAL "LOWER")
+        string(TOLOWER "${key}" key)
+      elseif(mode STREQUAL "UPPER")
+        string(TOUPPER "${key}" key)
+      elseif(mode STREQUAL "INTEGER")
+        if(NOT key MATCHES "^[+-]?[0-9]+$")
+          continue()
+        endif()
+        math(EXPR key "${key}")
+      endif()
+      # Later keys win, as with QHash::insert()
+      set("entry_${key}" "${value}")
+      list(APPEND keys "${key}")
+    endforeach()
+  endif()
+  list(REMOVE_DUPLICATES keys)
+  list(SORT keys COMPARE STRING CASE SENSITIVE)
+
+  set(code "")
+  list(LENGTH keys size)
+  if(size EQUAL 0)
+    string(APPEND code "const Table ${name}{nullptr, 0};\n")
+  else()
+    string(APPEND code "constexpr Entry ${name}Entries[] = {\n")
+    foreach(key IN LISTS keys)
+      to_cxx_literal(key_literal "${key}")
+      to_cxx_literal(value_literal "${entry_${key}}")
+      string(APPEND code "    {${key_literal}, ${value_literal}},\n")
+    endforeach()
+    string(APPEND code "};\nconst Table ${name}{${name}Entries, std::size(${name}Entries)};\n")
+  endif()
+  set(${out} "${${out}}\n${code}" PARENT_SCOPE)
+endfunction()
+
+file(READ "${NAME_MAPPINGS}" mappings)
+file(READ "${VENDORS}" vendors)
+
+set(body "")
+emit_table(body mappings guidToCategory LOWER guid-to-category)
+emit_table(body mappings hidVendor LOWER hid-vendor)
+emit_table(body mappings hidBusType INTEGER hid-bus-type)
+emit_table(body mappings softwareDevice NONE software-device)
+emit_table(body mappings acpiDevice UPPER acpi-device)
+emit_table(body vendors vendorUrls NONE)
+
+file(
+  WRITE "${OUTPUT}.tmp"
+  "// Generated from name-mappings.json and vendors.json by EmbedNameMappings.cmake. Do not edit.\n"
+  "#include <iterator>\n\n#include \"namemappingsbuiltin.h\"\n\n"
+  "namespace namemappingsbuiltin {\n${body}\n} // namespace namemappingsbuiltin\n")
+# Only touch the output when it changes to avoid needless rebuilds
+file(COPY_FILE "${OUTPUT}.tmp" "${OUTPUT}" ONLY_IF_DIFFERENT)
+file(REMOVE "${OUTPUT}.tmp")
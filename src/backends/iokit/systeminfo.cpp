@@ -3,6 +3,8 @@
 #include <sys/utsname.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include <QtCore/QDate>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
@@ -11,15 +13,18 @@
 #include <QtCore/QLocale>
 #include <QtCore/QProcess>
 #include <QtCore/QRegularExpression>
-#include <QtCore/QTextStream>
 #include <QtCore/QUrl>
 #include <QtGui/QDesktopServices>
 
+#include "deviceenumerationfilter.h"
 #include "driverinfo.h"
+#include "hardwareiddatabase.h"
 #include "iokitdeviceinfo_p.h"
 #include "iokitmanager.h"
 #include "iokitmonitor.h"
 #include "systeminfo.h"
+#include "systemresources.h"
+#include "termmatcher.h"
 
 bool isComputerEntry(const QString &syspath) {
     return syspath == QStringLiteral("IOService:/");
@@ -308,47 +313,21 @@ QString getMountPoint(const QString &devnode) {
 }
 
 QString lookupUsbVendor(const QString &vendorId) {
-    static QHash<QString, QString> vendorCache;
-    static auto initialized = false;
-
-    if (!initialized) {
-        initialized = true;
-
-        static const QStringList usbIdsLocations = {
-            // Homebrew locations (Apple Silicon and Intel)
-            QStringLiteral("/opt/homebrew/share/hwdata/usb.ids"),
-            QStringLiteral("/usr/local/share/hwdata/usb.ids"),
-            // MacPorts
-            QStringLiteral("/opt/local/share/hwdata/usb.ids"),
-        };
-
-        for (const auto &path : usbIdsLocations) {
-            QFile file(path);
-            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                continue;
-            }
-
-            QTextStream in(&file);
-            while (!in.atEnd()) {
-                auto line = in.readLine();
-                if (line.length() >= 6 && !line.startsWith(QLatin1Char('\t')) &&
-                    !line.startsWith(QLatin1Char('#'))) {
-                    auto lineVendorId = line.left(4).toLower();
-                    auto name = line.mid(6).trimmed();
-                    if (!name.isEmpty()) {
-                        vendorCache.insert(lineVendorId, name);
-                    }
-                }
-            }
-            file.close();
+    static const QStringList usbIdsLocations = {
+        // Homebrew locations (Apple Silicon and Intel)
+        QStringLiteral("/opt/homebrew/share/hwdata/usb.ids"),
+        QStringLiteral("/usr/local/share/hwdata/usb.ids"),
+        // MacPorts
+        QStringLiteral("/opt/local/share/hwdata/usb.ids"),
+    };
+    static HardwareIdDatabase database;
+    static const auto opened = database.openFirst(usbIdsLocations);
 
-            if (!vendorCache.isEmpty()) {
-                break;
-            }
-        }
+    quint16 id = 0;
+    if (!opened || !HardwareIdDatabase::parseId(vendorId, id)) {
+        return {};
     }
-
-    return vendorCache.value(vendorId.toLower());
+    return database.vendor(id);
 }
 
 DeviceEventQuery buildEventQuery(const DeviceInfo &info) {
@@ -362,8 +341,8 @@ DeviceEventQuery buildEventQuery(const DeviceInfo &info) {
     return query;
 }
 
-QStringList queryDeviceEvents(const DeviceEventQuery &query) {
-    QStringList events;
+QList<DeviceEvent> queryDeviceEvents(const DeviceEventQuery &query) {
+    QList<DeviceEvent> events;
     QStringList searchTerms;
 
     if (!query.vendorId.isEmpty() && !query.modelId.isEmpty()) {
@@ -407,16 +386,10 @@ QStringList queryDeviceEvents(const DeviceEventQuery &query) {
         auto output = QString::fromUtf8(logShow.readAllStandardOutput());
         auto lines = output.split(QStringLiteral("\n"), Qt::SkipEmptyParts);
 
+        const TermMatcher matcher(searchTerms);
         for (const auto &line : lines) {
-            auto matches = false;
-            for (const auto &term : searchTerms) {
-                if (line.contains(term, Qt::CaseInsensitive)) {
-                    matches = true;
-                    break;
-                }
-            }
-            if (matches) {
-                events << line;
+            if (matcher.matches(line)) {
+                events.append({line, {}});
             }
             if (events.size() >= 50) {
                 break;
@@ -432,7 +405,7 @@ ParsedEvent parseEventLine(const QString &line) {
 
     // macOS 'log show --style compact' format:
     // "YYYY-MM-DD HH:MM:SS.mmm Df subsystem[pid]: message"
-    QRegularExpression macLogRe(
+    static const QRegularExpression macLogRe(
         QStringLiteral(R"(^(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}\.\d+)\s+\w+\s+)"));
     auto match = macLogRe.match(line);
 
@@ -461,8 +434,11 @@ ParsedEvent parseEventLine(const QString &line) {
     return result;
 }
 
-QList<ResourceInfo> getDeviceResources(const QString &syspath, const QString &driver) {
+QList<ResourceInfo> getDeviceResources(const QString &syspath,
+                                      const QString &driver,
+                                      const SystemResources &snapshot) {
     Q_UNUSED(driver)
+    Q_UNUSED(snapshot)
     QList<ResourceInfo> resources;
 
     if (syspath.isEmpty()) {
@@ -848,6 +824,22 @@ QHash<QString, QString> getSystemResourcesRaw() {
     return {};
 }
 
+SystemResources getSystemResources(const QList<DeviceInfo> &devices) {
+    SystemResources resources;
+    resources.raw = getSystemResourcesRaw();
+    resources.dmaChannels = getSystemDmaChannels();
+    resources.ioPorts = getSystemIoPorts();
+    resources.irqs = getSystemIrqs();
+    resources.memoryRanges = getSystemMemoryRanges();
+    for (const auto &device : devices) {
+        auto deviceResources = getExportDeviceResources(device.syspath());
+        if (!deviceResources.isEmpty()) {
+            resources.deviceResources.insert(device.syspath(), deviceResources);
+        }
+    }
+    return resources;
+}
+
 // Global IOKit manager for enumeration
 static IOKitManager &getGlobalManager() {
     static IOKitManager manager;
@@ -868,6 +860,26 @@ QList<DeviceInfo> enumerateAllDevices() {
     return devices;
 }
 
+QList<DeviceInfo> enumerateDevices(const DeviceEnumerationFilter &filter) {
+    return filterDevices(enumerateAllDevices(), filter);
+}
+
+bool deviceExists(const QString &syspath) {
+    return std::ranges::any_of(enumerateAllDevices(), [&syspath](const DeviceInfo &info) {
+        return info.syspath() == syspath;
+    });
+}
+
+bool supportsPropertyFilter() {
+    return false;
+}
+
 QObject *createDeviceMonitor(QObject *parent) {
     return new IOKitMonitor(parent);
 }
+
+QObject *createDeviceEventStream(const DeviceEventQuery &query, QObject *parent) {
+    Q_UNUSED(query)
+    Q_UNUSED(parent)
+    return nullptr;
+}
@@ -8,15 +8,20 @@
 #include <QtCore/QRegularExpression>
 #include <QtCore/QTextStream>
 
+#include <algorithm>
+
 #include <windows.h>
 
 #include <cfgmgr32.h>
 
+#include "deviceenumerationfilter.h"
 #include "driverinfo.h"
 #include "setupapideviceinfo_p.h"
 #include "setupapimanager.h"
 #include "setupapimonitor.h"
 #include "systeminfo.h"
+#include "systemresources.h"
+#include "termmatcher.h"
 
 bool isComputerEntry(const QString &syspath) {
     // Windows: The computer entry can be empty, the root tree, or the ACPI HAL
@@ -313,8 +318,8 @@ DeviceEventQuery buildEventQuery(const DeviceInfo &info) {
     return query;
 }
 
-QStringList queryDeviceEvents(const DeviceEventQuery &query) {
-    QStringList events;
+QList<DeviceEvent> queryDeviceEvents(const DeviceEventQuery &query) {
+    QList<DeviceEvent> events;
     QStringList searchTerms;
 
     if (!query.vendorId.isEmpty() && !query.modelId.isEmpty()) {
@@ -345,16 +350,10 @@ QStringList queryDeviceEvents(const DeviceEventQuery &query) {
         auto output = QString::fromUtf8(wevtutil.readAllStandardOutput());
         auto lines = output.split(QStringLiteral("\n"), Qt::SkipEmptyParts);
 
+        const TermMatcher matcher(searchTerms);
         for (const auto &line : lines) {
-            auto matches = false;
-            for (const auto &term : searchTerms) {
-                if (line.contains(term, Qt::CaseInsensitive)) {
-                    matches = true;
-                    break;
-                }
-            }
-            if (matches) {
-                events << line;
+            if (matcher.matches(line)) {
+                events.append({line, {}});
             }
             if (events.size() >= 50) {
                 break;
@@ -369,7 +368,7 @@ ParsedEvent parseEventLine(const QString &line) {
     ParsedEvent result;
 
     // Windows wevtutil text output format
-    QRegularExpression winDateRe(
+    static const QRegularExpression winDateRe(
         QStringLiteral(R"(Date:\s*(\d{4}-\d{2}-\d{2}\s+\d{2}:\d{2}:\d{2}))"));
     auto match = winDateRe.match(line);
 
@@ -383,7 +382,8 @@ ParsedEvent parseEventLine(const QString &line) {
         }
         result.message = line;
     } else {
-        QRegularExpression winMsgRe(QStringLiteral(R"((?:Message|Description):\s*(.+))"));
+        static const QRegularExpression winMsgRe(
+            QStringLiteral(R"((?:Message|Description):\s*(.+))"));
         auto msgMatch = winMsgRe.match(line);
         if (msgMatch.hasMatch()) {
             result.message = msgMatch.captured(1).trimmed();
@@ -395,8 +395,11 @@ ParsedEvent parseEventLine(const QString &line) {
     return result;
 }
 
-QList<ResourceInfo> getDeviceResources(const QString &syspath, const QString &driver) {
+QList<ResourceInfo> getDeviceResources(const QString &syspath,
+                                      const QString &driver,
+                                      const SystemResources &snapshot) {
     Q_UNUSED(driver)
+    Q_UNUSED(snapshot)
     QList<ResourceInfo> resources;
 
     if (syspath.isEmpty()) {
@@ -780,6 +783,22 @@ QHash<QString, QString> getSystemResourcesRaw() {
     return {};
 }
 
+SystemResources getSystemResources(const QList<DeviceInfo> &devices) {
+    SystemResources resources;
+    resources.raw = getSystemResourcesRaw();
+    resources.dmaChannels = getSystemDmaChannels();
+    resources.ioPorts = getSystemIoPorts();
+    resources.irqs = getSystemIrqs();
+    resources.memoryRanges = getSystemMemoryRanges();
+    for (const auto &device : devices) {
+        auto deviceResources = getExportDeviceResources(device.syspath());
+        if (!deviceResources.isEmpty()) {
+            resources.deviceResources.insert(device.syspath(), deviceResources);
+        }
+    }
+    return resources;
+}
+
 // Global SetupAPI manager for enumeration
 static SetupApiManager &getGlobalManager() {
     static SetupApiManager manager;
@@ -800,6 +819,26 @@ QList<DeviceInfo> enumerateAllDevices() {
     return devices;
 }
 
+QList<DeviceInfo> enumerateDevices(const DeviceEnumerationFilter &filter) {
+    return filterDevices(enumerateAllDevices(), filter);
+}
+
+bool deviceExists(const QString &syspath) {
+    return std::ranges::any_of(enumerateAllDevices(), [&syspath](const DeviceInfo &info) {
+        return info.syspath() == syspath;
+    });
+}
+
+bool supportsPropertyFilter() {
+    return false;
+}
+
 QObject *createDeviceMonitor(QObject *parent) {
     return new SetupApiMonitor(parent);
 }
+
+QObject *createDeviceEventStream(const DeviceEventQuery &query, QObject *parent) {
+    Q_UNUSED(query)
+    Q_UNUSED(parent)
+    return nullptr;
+}
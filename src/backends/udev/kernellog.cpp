@@ -0,0 +1,287 @@
+// SPDX-License-Identifier: MIT
+#include <errno.h>
+#include <fcntl.h>
+#include <net/if.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QSysInfo>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+#include "kernellog.h"
+#include "procparsers.h"
+
+namespace {
+
+// Enough for the kernel messages of a typical boot and the hotplug events since
+constexpr qsizetype kMaxEvents = 4096;
+// Larger than the longest record the kernel writes, including its continuation lines
+constexpr std::size_t kReadBufferSize = 8192;
+// Length of a PCI address in domain:bus:slot.function form, e.g. 0000:03:00.0
+constexpr std::size_t kPciAddressLength = 12;
+
+// Formats a time as ISO 8601 with a numeric UTC offset, as journalctl -o short-iso does
+QString formatTimestamp(qint64 msecs) {
+    const auto time = QDateTime::fromMSecsSinceEpoch(msecs);
+    const auto offset = time.offsetFromUtc() / 60;
+    return time.toString(QStringLiteral("yyyy-MM-dd'T'HH:mm:ss")) +
+           (offset < 0 ? QLatin1Char('-') : QLatin1Char('+')) +
+           QStringLiteral("%1:%2")
+               .arg(std::abs(offset) / 60, 2, 10, QLatin1Char('0'))
+               .arg(std::abs(offset) % 60, 2, 10, QLatin1Char('0'));
+}
+
+QString fromLatin1(std::string_view text) {
+    return QString::fromLatin1(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+bool isHexDigit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool isPciAddressAt(std::string_view text, std::size_t pos) {
+    if (text.size() - pos < kPciAddressLength) {
+        return false;
+    }
+    for (std::size_t i = 0; i < kPciAddressLength; ++i) {
+        const auto c = text[pos + i];
+        switch (i) {
+        case 4:
+        case 7:
+            if (c != ':') {
+                return false;
+            }
+            break;
+        case 10:
+            if (c != '.') {
+                return false;
+            }
+            break;
+        default:
+            if (!isHexDigit(c)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool isDeviceNameChar(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           c == '_' || c == '-' || c == '.';
+}
+
+bool isDeviceName(std::string_view name) {
+    return !name.empty() && std::all_of(name.cbegin(), name.cend(), isDeviceNameChar);
+}
+
+// Adds the device behind a sysfs link, as udev names it, if the link exists
+void addSyspath(QStringList &syspaths, const QString &sysfsPath) {
+    auto syspath = QFileInfo(sysfsPath).canonicalFilePath();
+    if (!syspath.isEmpty() && !syspaths.contains(syspath)) {
+        syspaths.append(std::move(syspath));
+    }
+}
+
+// Resolves a DEVICE= value: b<major>:<minor>, c<major>:<minor>, n<ifindex> or
+// +<subsystem>:<sysname>
+void addDeviceId(QStringList &syspaths, std::string_view id) {
+    if (id.size() < 2) {
+        return;
+    }
+    const auto rest = id.substr(1);
+    switch (id.front()) {
+    case 'b':
+        addSyspath(syspaths, QStringLiteral("/sys/dev/block/") + fromLatin1(rest));
+        break;
+    case 'c':
+        addSyspath(syspaths, QStringLiteral("/sys/dev/char/") + fromLatin1(rest));
+        break;
+    case 'n': {
+        unsigned int index = 0;
+        char name[IF_NAMESIZE];
+        const auto [ptr, ec] = std::from_chars(rest.data(), rest.data() + rest.size(), index);
+        if (ec == std::errc() && if_indextoname(index, name)) {
+            addSyspath(syspaths, QStringLiteral("/sys/class/net/") + QString::fromLocal8Bit(name));
+        }
+        break;
+    }
+    case '+': {
+        const auto colon = rest.find(':');
+        if (colon == std::string_view::npos) {
+            break;
+        }
+        const auto subsystem = fromLatin1(rest.substr(0, colon));
+        // sysfs spells slashes in device names as '!'
+        const auto sysname = fromLatin1(rest.substr(colon + 1)).replace(QLatin1Char('/'),
+                                                                       QLatin1Char('!'));
+        const auto busPath = QStringLiteral("/sys/bus/%1/devices/%2").arg(subsystem, sysname);
+        if (QFileInfo::exists(busPath)) {
+            addSyspath(syspaths, busPath);
+        } else {
+            addSyspath(syspaths, QStringLiteral("/sys/class/%1/%2").arg(subsystem, sysname));
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void addNamedDevice(QStringList &syspaths, std::string_view name) {
+    if (!isDeviceName(name)) {
+        return;
+    }
+    const auto text = fromLatin1(name);
+    addSyspath(syspaths, QStringLiteral("/sys/class/block/") + text);
+    addSyspath(syspaths, QStringLiteral("/sys/class/net/") + text);
+}
+
+} // namespace
+
+QStringList KernelLog::attribute(const procparsers::KmsgRecord &record, std::string_view message) {
+    QStringList syspaths;
+    if (!record.device.empty()) {
+        addDeviceId(syspaths, record.device);
+    }
+
+    for (std::size_t pos = 0; pos + kPciAddressLength <= message.size(); ++pos) {
+        if (isPciAddressAt(message, pos)) {
+            auto address = fromLatin1(message.substr(pos, kPciAddressLength)).toLower();
+            addSyspath(syspaths, QStringLiteral("/sys/bus/pci/devices/") + address);
+            pos += kPciAddressLength - 1;
+        }
+    }
+
+    // "sda: sda1 sda2", "eth0: renamed from ..."
+    if (const auto colon = message.find(": "); colon != std::string_view::npos) {
+        addNamedDevice(syspaths, message.substr(0, colon));
+    }
+    // "sd 0:0:0:0: [sda] Attached SCSI disk"
+    if (const auto open = message.find('['); open != std::string_view::npos) {
+        const auto close = message.find(']', open);
+        if (close != std::string_view::npos) {
+            addNamedDevice(syspaths, message.substr(open + 1, close - open - 1));
+        }
+    }
+    return syspaths;
+}
+
+qint64 KernelLog::bootTime() {
+    // Record timestamps count from boot, including time spent suspended
+    timespec sinceBoot{};
+    clock_gettime(CLOCK_BOOTTIME, &sinceBoot);
+    return QDateTime::currentMSecsSinceEpoch() - sinceBoot.tv_sec * 1000 -
+           sinceBoot.tv_nsec / 1000000;
+}
+
+QString KernelLog::formatLine(qint64 timestamp, const QString &hostName, const QString &message) {
+    return formatTimestamp(timestamp) + QLatin1Char(' ') + hostName + QStringLiteral(" kernel: ") +
+           message;
+}
+
+KernelLog::KernelLog() : store_(kMaxEvents) {
+}
+
+KernelLog::~KernelLog() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+KernelLog &KernelLog::instance() {
+    static KernelLog log;
+    return log;
+}
+
+bool KernelLog::isAvailable() {
+    QMutexLocker locker(&mutex_);
+    return open();
+}
+
+QString KernelLog::cursor(quint64 sequence) {
+    return QString::number(sequence);
+}
+
+QList<DeviceEvent> KernelLog::eventsForDevice(const QString &syspath, qsizetype limit) {
+    QMutexLocker locker(&mutex_);
+    if (!open()) {
+        return {};
+    }
+    readNew();
+    return formatEvents(store_.eventsForDevice(syspath, limit));
+}
+
+QList<DeviceEvent> KernelLog::search(const QStringList &terms, qsizetype limit) {
+    QMutexLocker locker(&mutex_);
+    if (!open()) {
+        return {};
+    }
+    readNew();
+    return formatEvents(store_.search(terms, limit));
+}
+
+bool KernelLog::open() {
+    if (fd_ >= 0) {
+        return true;
+    }
+    if (openFailed_) {
+        return false;
+    }
+    fd_ = ::open("/dev/kmsg", O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        openFailed_ = true;
+        return false;
+    }
+    bootTime_ = bootTime();
+    hostName_ = QSysInfo::machineHostName();
+    return true;
+}
+
+void KernelLog::readNew() {
+    char buffer[kReadBufferSize];
+    procparsers::KmsgRecord record;
+    while (true) {
+        const auto size = read(fd_, buffer, sizeof(buffer));
+        if (size < 0) {
+            // EPIPE: records were overwritten before they were read, and the next read continues
+            // from the oldest one left
+            if (errno == EPIPE || errno == EINTR) {
+                continue;
+            }
+            // EAGAIN: everything logged so far has been read
+            break;
+        }
+        if (size == 0) {
+            break;
+        }
+        // Only messages from the kernel itself; programs can also write to /dev/kmsg
+        if (!procparsers::parseKmsgRecord({buffer, static_cast<std::size_t>(size)}, record) ||
+            record.facility != 0) {
+            continue;
+        }
+        const auto message = procparsers::unescapeKmsgText(record.message);
+        store_.append(bootTime_ + static_cast<qint64>(record.timestamp / 1000),
+                      QString::fromUtf8(message.data(), static_cast<qsizetype>(message.size())),
+                      attribute(record, message),
+                      record.sequence);
+    }
+}
+
+QList<DeviceEvent> KernelLog::formatEvents(const QList<KernelEventStore::Event> &events) const {
+    QList<DeviceEvent> result;
+    result.reserve(events.size());
+    for (const auto &event : events) {
+        result.append(
+            {formatLine(event.timestamp, hostName_, event.message), cursor(event.sequence)});
+    }
+    return result;
+}
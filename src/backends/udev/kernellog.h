@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <string_view>
+
+#include "deviceevent.h"
+#include "kerneleventstore.h"
+#include "procparsers.h"
+
+/**
+ * @brief In-process copy of the recent kernel log, read from @c /dev/kmsg.
+ *
+ * The device is opened once and kept open without blocking; each query first reads only the
+ * records logged since the previous one, so opening the properties of many devices in a row costs
+ * one read of the ring buffer rather than one @c journalctl process each.
+ *
+ * Each message is attributed to devices once, as it is read, and stored in a
+ * @c KernelEventStore. A message belongs to:
+ * - the device in its @c DEVICE= field, which the kernel adds to messages logged with
+ *   @c dev_printk() and friends;
+ * - any PCI device whose address it mentions;
+ * - the block or network device it starts with (<tt>sda: sda1 sda2</tt>) or names in brackets
+ *   (<tt>[sda] Attached SCSI disk</tt>).
+ *
+ * Lines are formatted like <tt>journalctl -o short-iso</tt> output so @c parseEventLine() handles
+ * both sources.
+ */
+class KernelLog {
+public:
+    KernelLog();
+    ~KernelLog();
+    KernelLog(const KernelLog &) = delete;
+    KernelLog &operator=(const KernelLog &) = delete;
+
+    /**
+     * @brief Returns the shared instance used by @c queryDeviceEvents().
+     * @returns The instance.
+     */
+    static KernelLog &instance();
+
+    /**
+     * @brief Checks whether @c /dev/kmsg can be read.
+     *
+     * Reading it needs @c CAP_SYSLOG when the @c kernel.dmesg_restrict sysctl is set.
+     *
+     * @returns @c true if the device is open.
+     */
+    bool isAvailable();
+
+    /**
+     * @brief Returns the most recent kernel messages attributed to a device.
+     * @param syspath The device's system path.
+     * @param limit Maximum number of lines to return.
+     * @returns Entries, oldest first.
+     */
+    QList<DeviceEvent> eventsForDevice(const QString &syspath, qsizetype limit);
+
+    /**
+     * @brief Finds the most recent kernel messages containing any of the given terms, ignoring
+     *        case.
+     * @param terms The terms to look for.
+     * @param limit Maximum number of lines to return.
+     * @returns Matching entries, oldest first.
+     */
+    QList<DeviceEvent> search(const QStringList &terms, qsizetype limit);
+
+    /**
+     * @brief Finds the devices a kernel message is about.
+     * @param record The record the message was read from.
+     * @param message The unescaped message.
+     * @returns System paths of the devices, as udev names them.
+     */
+    static QStringList attribute(const procparsers::KmsgRecord &record, std::string_view message);
+
+    /**
+     * @brief Returns when the system booted, the origin of record timestamps.
+     * @returns Milliseconds since the epoch.
+     */
+    static qint64 bootTime();
+
+    /**
+     * @brief Formats a kernel message as a log line.
+     * @param timestamp When the message was logged, in milliseconds since the epoch.
+     * @param hostName Host name to show.
+     * @param message The message.
+     * @returns The line.
+     */
+    static QString formatLine(qint64 timestamp, const QString &hostName, const QString &message);
+
+    /**
+     * @brief Returns the cursor identifying a record in @c DeviceEvent::cursor.
+     * @param sequence The record's sequence number.
+     * @returns The cursor.
+     */
+    static QString cursor(quint64 sequence);
+
+private:
+    bool open();
+    void readNew();
+    QList<DeviceEvent> formatEvents(const QList<KernelEventStore::Event> &events) const;
+
+    int fd_ = -1;
+    bool openFailed_ = false;
+    qint64 bootTime_ = 0;
+    QString hostName_;
+    KernelEventStore store_;
+    QMutex mutex_;
+};
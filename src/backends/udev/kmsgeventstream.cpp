@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: MIT
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <QtCore/QSocketNotifier>
+#include <QtCore/QSysInfo>
+
+#include <utility>
+
+#include "kernellog.h"
+#include "kmsgeventstream.h"
+#include "procparsers.h"
+
+namespace {
+
+// Larger than the longest record the kernel writes, including its continuation lines
+constexpr std::size_t kReadBufferSize = 8192;
+// A partial record larger than this is garbage rather than a record still being written
+constexpr qsizetype kMaxPendingBytes = 64 * 1024;
+// Short enough to look live, long enough to merge a burst of messages into one model insert
+constexpr int kDefaultBatchInterval = 200;
+
+} // namespace
+
+KmsgEventStream::KmsgEventStream(const QString &syspath,
+                                 const QStringList &searchTerms,
+                                 const QString &path,
+                                 QObject *parent)
+    : DeviceEventStream(parent), path_(path), syspath_(syspath), matcher_(searchTerms) {
+    batchTimer_.setSingleShot(true);
+    batchTimer_.setInterval(kDefaultBatchInterval);
+    connect(&batchTimer_, &QTimer::timeout, this, &KmsgEventStream::flush);
+}
+
+KmsgEventStream::~KmsgEventStream() {
+    stop();
+}
+
+bool KmsgEventStream::start() {
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    fd_ = ::open(path_.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        return false;
+    }
+    // Skip the records logged so far; queryDeviceEvents() has already returned them. This fails
+    // harmlessly on a FIFO.
+    lseek(fd_, 0, SEEK_END);
+
+    bootTime_ = KernelLog::bootTime();
+    hostName_ = QSysInfo::machineHostName();
+    notifier_ = new QSocketNotifier(fd_, QSocketNotifier::Read, this);
+    connect(notifier_, &QSocketNotifier::activated, this, &KmsgEventStream::onReadable);
+    return true;
+}
+
+void KmsgEventStream::stop() {
+    if (notifier_) {
+        notifier_->setEnabled(false);
+        delete notifier_;
+        notifier_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    batchTimer_.stop();
+    pending_.clear();
+    events_.clear();
+}
+
+bool KmsgEventStream::isRunning() const {
+    return fd_ >= 0;
+}
+
+void KmsgEventStream::setBatchInterval(int msecs) {
+    batchTimer_.setInterval(msecs);
+}
+
+void KmsgEventStream::onReadable() {
+    char buffer[kReadBufferSize];
+    while (true) {
+        const auto size = read(fd_, buffer, sizeof(buffer));
+        if (size < 0) {
+            // EPIPE: records were overwritten before they were read, and the next read continues
+            // from the oldest one left
+            if (errno == EPIPE || errno == EINTR) {
+                continue;
+            }
+            // EAGAIN: everything logged so far has been read
+            break;
+        }
+        if (size == 0) {
+            // Only a FIFO ends; without a writer it would report being readable forever
+            notifier_->setEnabled(false);
+            break;
+        }
+        pending_.append(buffer, size);
+        processRecords();
+    }
+
+    if (events_.isEmpty() || batchTimer_.isActive()) {
+        return;
+    }
+    if (batchTimer_.interval() == 0) {
+        flush();
+    } else {
+        batchTimer_.start();
+    }
+}
+
+void KmsgEventStream::flush() {
+    if (events_.isEmpty()) {
+        return;
+    }
+    const auto events = std::exchange(events_, {});
+    Q_EMIT eventsReceived(events);
+}
+
+void KmsgEventStream::processRecords() {
+    // /dev/kmsg returns one record per read(), but a FIFO returns whatever has been written, so
+    // records are split at each newline that does not start a continuation line
+    qsizetype start = 0;
+    for (qsizetype i = 0; i < pending_.size(); ++i) {
+        if (pending_[i] != '\n' || (i + 1 < pending_.size() && pending_[i + 1] == ' ')) {
+            continue;
+        }
+        processRecord({pending_.constData() + start, static_cast<std::size_t>(i + 1 - start)});
+        start = i + 1;
+    }
+    pending_.remove(0, start);
+    if (pending_.size() > kMaxPendingBytes) {
+        pending_.clear();
+    }
+}
+
+void KmsgEventStream::processRecord(std::string_view text) {
+    procparsers::KmsgRecord record;
+    // Only messages from the kernel itself; programs can also write to /dev/kmsg
+    if (!procparsers::parseKmsgRecord(text, record) || record.facility != 0) {
+        return;
+    }
+    const auto message = procparsers::unescapeKmsgText(record.message);
+    const auto syspaths = KernelLog::attribute(record, message);
+    const auto relevant = syspaths.isEmpty() ? matcher_.matches(QByteArrayView(message))
+                                             : syspaths.contains(syspath_);
+    if (!relevant) {
+        return;
+    }
+    const auto line = KernelLog::formatLine(
+        bootTime_ + static_cast<qint64>(record.timestamp / 1000),
+        hostName_,
+        QString::fromUtf8(message.data(), static_cast<qsizetype>(message.size())));
+    events_.append({line, KernelLog::cursor(record.sequence)});
+}
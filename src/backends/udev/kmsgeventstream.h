@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+
+#include <string_view>
+
+#include "deviceeventstream.h"
+#include "termmatcher.h"
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+QT_END_NAMESPACE
+
+/**
+ * @brief Follows @c /dev/kmsg and reports the kernel messages logged for one device.
+ *
+ * The device is opened without blocking and positioned after the newest record, and a
+ * @c QSocketNotifier reads records as the kernel logs them. Messages are attributed with
+ * @c KernelLog::attribute(); a message belongs to the device if it is attributed to it, or if it is
+ * attributed to no device and contains one of the search terms.
+ *
+ * Lines are collected for a short interval and emitted together, so a burst of messages from a
+ * flapping link or a USB reset loop reaches the view as a few batches.
+ *
+ * A FIFO can stand in for @c /dev/kmsg: records written to it whole, one per @c write(), are read
+ * as they arrive. Reading stops when its last writer closes it.
+ */
+class KmsgEventStream : public DeviceEventStream {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a @c KmsgEventStream.
+     * @param syspath System path of the device.
+     * @param searchTerms Terms identifying the device in messages not attributed to any device.
+     * @param path Path of the log, normally @c /dev/kmsg.
+     * @param parent Optional parent @c QObject for memory management.
+     */
+    KmsgEventStream(const QString &syspath,
+                    const QStringList &searchTerms,
+                    const QString &path,
+                    QObject *parent = nullptr);
+    ~KmsgEventStream() override;
+
+    /**
+     * @brief Opens the log and starts watching it.
+     * @returns @c false if the log cannot be opened, e.g. when @c kernel.dmesg_restrict is set.
+     */
+    bool start() override;
+
+    /**
+     * @brief Closes the log. Entries not emitted yet are dropped.
+     */
+    void stop() override;
+
+    /**
+     * @brief Checks if the log is open.
+     * @returns @c true if the log is open, @c false otherwise.
+     */
+    bool isRunning() const override;
+
+    /**
+     * @brief Sets how long lines are collected before they are emitted.
+     * @param msecs The interval in milliseconds; 0 emits the lines of each read right away.
+     */
+    void setBatchInterval(int msecs);
+
+private Q_SLOTS:
+    void onReadable();
+    void flush();
+
+private:
+    void processRecords();
+    void processRecord(std::string_view text);
+
+    QString path_;
+    QString syspath_;
+    TermMatcher matcher_;
+    QString hostName_;
+    qint64 bootTime_ = 0;
+    int fd_ = -1;
+    QSocketNotifier *notifier_ = nullptr;
+    QByteArray pending_;        // Bytes of records not read completely yet
+    QList<DeviceEvent> events_; // Entries waiting for the batch timer
+    QTimer batchTimer_;
+};
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+
+#include <algorithm>
+#include <string>
+
+#include "mounttable.h"
+#include "procparsers.h"
+
+namespace {
+
+quint64 deviceKey(unsigned int major, unsigned int minor) {
+    return (static_cast<quint64>(major) << 32) | minor;
+}
+
+QString fromStd(const std::string &text) {
+    return QString::fromUtf8(text.data(), static_cast<qsizetype>(text.size()));
+}
+
+} // namespace
+
+MountTable::~MountTable() {
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+MountTable &MountTable::instance() {
+    static MountTable table;
+    return table;
+}
+
+QString MountTable::mountPoint(const QString &devnode) {
+    if (devnode.isEmpty()) {
+        return {};
+    }
+
+    QMutexLocker locker(&mutex_);
+    refreshIfChanged();
+
+    struct stat info;
+    if (stat(QFile::encodeName(devnode).constData(), &info) == 0 && S_ISBLK(info.st_mode)) {
+        auto it = byDevice_.constFind(deviceKey(major(info.st_rdev), minor(info.st_rdev)));
+        if (it != byDevice_.cend()) {
+            return it.value();
+        }
+    }
+
+    auto it = bySource_.constFind(devnode);
+    if (it != bySource_.cend()) {
+        return it.value();
+    }
+    const auto canonical = QFileInfo(devnode).canonicalFilePath();
+    return canonical.isEmpty() ? QString() : bySource_.value(canonical);
+}
+
+void MountTable::refreshIfChanged() {
+    if (fd_ < 0) {
+        fd_ = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            return;
+        }
+        reload();
+        return;
+    }
+
+    // The kernel flags the open file with POLLPRI | POLLERR whenever the namespace's mount table
+    // has changed since the last poll
+    pollfd pfd{fd_, POLLPRI, 0};
+    if (poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLPRI | POLLERR)) != 0) {
+        reload();
+    }
+}
+
+void MountTable::reload() {
+    byDevice_.clear();
+    bySource_.clear();
+
+    std::string content;
+    constexpr size_t chunkSize = 16384;
+    off_t offset = 0;
+    while (true) {
+        const auto size = content.size();
+        content.resize(size + chunkSize);
+        auto bytesRead = pread(fd_, content.data() + size, chunkSize, offset);
+        if (bytesRead < 0 && errno == EINTR) {
+            content.resize(size);
+            continue;
+        }
+        content.resize(size + static_cast<size_t>(std::max<ssize_t>(bytesRead, 0)));
+        if (bytesRead <= 0) {
+            break;
+        }
+        offset += bytesRead;
+    }
+
+    procparsers::MountInfoParser parser(content);
+    procparsers::MountInfoEntry entry;
+    while (parser.next(entry)) {
+        const auto mountPoint = fromStd(procparsers::unescapeMountField(entry.mountPoint));
+        // Keep the first mount of a device, as a linear scan of the table would
+        const auto key = deviceKey(entry.major, entry.minor);
+        if (!byDevice_.contains(key)) {
+            byDevice_.insert(key, mountPoint);
+        }
+        if (entry.source.starts_with('/')) {
+            const auto source = fromStd(procparsers::unescapeMountField(entry.source));
+            if (!bySource_.contains(source)) {
+                bySource_.insert(source, mountPoint);
+            }
+        }
+    }
+}
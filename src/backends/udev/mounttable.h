@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+/**
+ * @brief Index of the mount table by device number.
+ *
+ * The table is parsed from @c /proc/self/mountinfo once and kept until the kernel reports a
+ * change: the file is held open and polled for @c POLLPRI before each lookup, which costs one
+ * syscall instead of a re-read. A lookup then needs a single @c stat() of the device node, so its
+ * cost does not grow with the number of mounts (container hosts can have thousands).
+ *
+ * Filesystems whose device number is not the node's (e.g. btrfs subvolumes) are found through
+ * their mount source instead.
+ */
+class MountTable {
+public:
+    MountTable() = default;
+    ~MountTable();
+    MountTable(const MountTable &) = delete;
+    MountTable &operator=(const MountTable &) = delete;
+
+    /**
+     * @brief Returns the shared instance used by @c getMountPoint().
+     * @returns The instance.
+     */
+    static MountTable &instance();
+
+    /**
+     * @brief Finds where a device node is mounted.
+     * @param devnode The device node path (e.g. @c /dev/sda1).
+     * @returns The first mount point of the device, or an empty string if it is not mounted.
+     */
+    QString mountPoint(const QString &devnode);
+
+private:
+    void refreshIfChanged();
+    void reload();
+
+    int fd_ = -1;
+    QHash<quint64, QString> byDevice_;
+    QHash<QString, QString> bySource_;
+    QMutex mutex_;
+};
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <QtCore/QFile>
+
+#include "sysfsreader.h"
+
+SysfsReader::SysfsReader(const QString &directory) {
+    open(directory);
+}
+
+SysfsReader::~SysfsReader() {
+    close();
+}
+
+bool SysfsReader::open(const QString &directory) {
+    close();
+    dirFd_ = ::open(QFile::encodeName(directory).constData(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    return dirFd_ >= 0;
+}
+
+void SysfsReader::close() {
+    if (dirFd_ >= 0) {
+        ::close(dirFd_);
+        dirFd_ = -1;
+    }
+}
+
+bool SysfsReader::isOpen() const {
+    return dirFd_ >= 0;
+}
+
+QString SysfsReader::read(const char *attribute) {
+    if (dirFd_ < 0) {
+        return {};
+    }
+    auto fd = openat(dirFd_, attribute, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return {};
+    }
+
+    ssize_t bytesRead;
+    do {
+        bytesRead = ::read(fd, buffer_.data(), buffer_.size());
+    } while (bytesRead < 0 && errno == EINTR);
+    ::close(fd);
+
+    if (bytesRead <= 0) {
+        return {};
+    }
+    return QString::fromUtf8(buffer_.data(), bytesRead).trimmed();
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QString>
+
+#include <array>
+
+/**
+ * @brief Reads attributes of one sysfs (or procfs) directory at a time.
+ *
+ * The directory is opened once and each attribute is opened relative to it with @c openat(), so
+ * the kernel does not walk the full path again for every attribute and no path string is built
+ * per read. All reads share one page-sized buffer, which is as large as a sysfs attribute can be.
+ *
+ * One reader can be moved through many directories with @c open(), e.g. once per device while
+ * exporting, without reallocating anything.
+ *
+ * @code
+ * SysfsReader reader(syspath);
+ * auto irq = reader.read("irq");
+ * auto vendor = reader.read("device/vendor");
+ * @endcode
+ */
+class SysfsReader {
+public:
+    /**
+     * @brief Constructs a reader without a directory.
+     */
+    SysfsReader() = default;
+
+    /**
+     * @brief Constructs a reader and opens a directory.
+     * @param directory The directory, e.g. a device syspath.
+     */
+    explicit SysfsReader(const QString &directory);
+    ~SysfsReader();
+    SysfsReader(const SysfsReader &) = delete;
+    SysfsReader &operator=(const SysfsReader &) = delete;
+
+    /**
+     * @brief Switches to another directory, closing the current one.
+     * @param directory The directory to open.
+     * @returns @c true if the directory could be opened.
+     */
+    bool open(const QString &directory);
+
+    /**
+     * @brief Closes the current directory.
+     */
+    void close();
+
+    /**
+     * @brief Returns whether a directory is open.
+     * @returns @c true if attributes can be read.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Reads an attribute of the open directory.
+     * @param attribute Path relative to the directory; may descend into subdirectories and
+     *        symlinks such as @c device/vendor.
+     * @returns The attribute's contents without surrounding whitespace, or an empty string if it
+     *          cannot be read.
+     */
+    QString read(const char *attribute);
+
+private:
+    int dirFd_ = -1;
+    std::array<char, 4096> buffer_;
+};
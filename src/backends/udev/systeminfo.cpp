@@ -1,22 +1,40 @@
 // SPDX-License-Identifier: MIT
+#include <errno.h>
 #include <fcntl.h>
 #include <sys/utsname.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+
 #include <QtCore/QDate>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QLocale>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QProcess>
 #include <QtCore/QRegularExpression>
-#include <QtCore/QTextStream>
 #include <QtCore/QUrl>
 
+#include "deviceenumerationfilter.h"
+#include "diskmanufacturers.h"
 #include "driverinfo.h"
+#include "hardwareiddatabase.h"
+#include "journalline.h"
+#include "kernellog.h"
+#include "kmsgeventstream.h"
+#include "mounttable.h"
+#include "staticmatch.h"
+#include "sysfsreader.h"
 #include "systeminfo.h"
+#include "systemresources.h"
+#include "termmatcher.h"
 #include "udevdeviceinfo_p.h"
+#include "udevenumerate.h"
 #include "udevmanager.h"
 #include "udevmonitor.h"
 
@@ -26,6 +44,39 @@ namespace {
 constexpr auto BUS_USB = 0x03;
 constexpr auto BUS_I2C = 0x18;
 
+// Friendly names of misc and input software devices, translated at lookup
+constexpr auto kSoftwareDeviceNames = staticmatch::makePerfectHashMap<const char *>({
+    {"autofs", QT_TRANSLATE_NOOP("QObject", "Automount filesystem")},
+    {"cpu_dma_latency", QT_TRANSLATE_NOOP("QObject", "CPU DMA latency")},
+    {"fuse", QT_TRANSLATE_NOOP("QObject", "FUSE interface")},
+    {"hpet", QT_TRANSLATE_NOOP("QObject", "High Precision Event Timer")},
+    {"hwrng", QT_TRANSLATE_NOOP("QObject", "Hardware random number generator")},
+    {"kvm", QT_TRANSLATE_NOOP("QObject", "Kernel-based Virtual Machine")},
+    {"loop-control", QT_TRANSLATE_NOOP("QObject", "Loop device control")},
+    {"mcelog", QT_TRANSLATE_NOOP("QObject", "Machine check error log")},
+    {"net/tun", QT_TRANSLATE_NOOP("QObject", "TUN/TAP network device")},
+    {"ntsync", QT_TRANSLATE_NOOP("QObject", "NT synchronization")},
+    {"rfkill", QT_TRANSLATE_NOOP("QObject", "RF kill switch")},
+    {"uhid", QT_TRANSLATE_NOOP("QObject", "User-space HID driver")},
+    {"uinput", QT_TRANSLATE_NOOP("QObject", "User-space input device")},
+    {"vga_arbiter", QT_TRANSLATE_NOOP("QObject", "VGA arbiter")},
+    {"vhost-net", QT_TRANSLATE_NOOP("QObject", "VirtIO host network")},
+    {"mapper/control", QT_TRANSLATE_NOOP("QObject", "Device mapper control")},
+});
+
+// Software devices provided by the kernel, by device name (as shown) and by device node
+constexpr std::string_view kLinuxFoundationNameKeys[] = {
+    "autofs", "cpu dma latency", "cpu_dma_latency", "fuse", "hpet", "hwrng", "kvm", "loop-control",
+    "loop control", "mcelog", "net/tun", "ntsync", "rfkill", "uhid", "uinput", "vga arbiter",
+    "vhost-net", "mapper/control",
+};
+constexpr auto kLinuxFoundationNames = staticmatch::makePerfectHashSet(kLinuxFoundationNameKeys);
+constexpr std::string_view kLinuxFoundationNodeKeys[] = {
+    "autofs", "cpu_dma_latency", "fuse", "hpet", "hwrng", "kvm", "loop-control", "mcelog",
+    "net/tun", "ntsync", "rfkill", "uhid", "uinput", "vga_arbiter", "vhost-net", "mapper/control",
+};
+constexpr auto kLinuxFoundationNodes = staticmatch::makePerfectHashSet(kLinuxFoundationNodeKeys);
+
 struct HidDeviceId {
     int busType = 0;
     QString vendorId;
@@ -224,28 +275,8 @@ QString getDeviceDisplayName(const DeviceInfo &info) {
 
     // Software/misc device friendly names
     if (subsystem == QStringLiteral("misc") || subsystem == QStringLiteral("input")) {
-        static const QHash<QString, QString> softwareDeviceNames = {
-            {QStringLiteral("autofs"), QObject::tr("Automount filesystem")},
-            {QStringLiteral("cpu_dma_latency"), QObject::tr("CPU DMA latency")},
-            {QStringLiteral("fuse"), QObject::tr("FUSE interface")},
-            {QStringLiteral("hpet"), QObject::tr("High Precision Event Timer")},
-            {QStringLiteral("hwrng"), QObject::tr("Hardware random number generator")},
-            {QStringLiteral("kvm"), QObject::tr("Kernel-based Virtual Machine")},
-            {QStringLiteral("loop-control"), QObject::tr("Loop device control")},
-            {QStringLiteral("mcelog"), QObject::tr("Machine check error log")},
-            {QStringLiteral("net/tun"), QObject::tr("TUN/TAP network device")},
-            {QStringLiteral("ntsync"), QObject::tr("NT synchronization")},
-            {QStringLiteral("rfkill"), QObject::tr("RF kill switch")},
-            {QStringLiteral("uhid"), QObject::tr("User-space HID driver")},
-            {QStringLiteral("uinput"), QObject::tr("User-space input device")},
-            {QStringLiteral("vga_arbiter"), QObject::tr("VGA arbiter")},
-            {QStringLiteral("vhost-net"), QObject::tr("VirtIO host network")},
-            {QStringLiteral("mapper/control"), QObject::tr("Device mapper control")},
-        };
-
-        auto it = softwareDeviceNames.find(shortName);
-        if (it != softwareDeviceNames.end()) {
-            return it.value();
+        if (const auto *name = kSoftwareDeviceNames.find(shortName)) {
+            return QObject::tr(*name);
         }
     }
 
@@ -310,24 +341,92 @@ bool hasDriverInfo(const DeviceInfo &info) {
     return false;
 }
 
-static QString safeReadSysfsFile(const QString &path) {
-    auto pathBytes = path.toLocal8Bit();
-    auto fd = open(pathBytes.constData(), O_RDONLY | O_NONBLOCK);
+namespace {
+
+// Reads a whole /proc file. These report a size of 0 and can exceed any fixed buffer (e.g.
+// /proc/interrupts on many-core machines), so read until EOF.
+std::string readProcFile(const char *path) {
+    std::string content;
+    auto fd = open(path, O_RDONLY | O_CLOEXEC);
     if (fd < 0) {
-        return {};
+        return content;
     }
 
-    char buffer[4096];
-    ssize_t bytesRead = read(fd, buffer, sizeof(buffer) - 1);
+    constexpr size_t chunkSize = 16384;
+    while (true) {
+        const auto size = content.size();
+        content.resize(size + chunkSize);
+        auto bytesRead = read(fd, content.data() + size, chunkSize);
+        if (bytesRead < 0 && errno == EINTR) {
+            content.resize(size);
+            continue;
+        }
+        content.resize(size + static_cast<size_t>(std::max<ssize_t>(bytesRead, 0)));
+        if (bytesRead <= 0) {
+            break;
+        }
+    }
     close(fd);
+    return content;
+}
 
-    if (bytesRead <= 0) {
-        return {};
+bool hasAffinity(const IrqInfo &irq) {
+    return !irq.irqNumber.isEmpty() && irq.irqNumber.front().isDigit();
+}
+
+// Affinity is not part of /proc/interrupts; numeric IRQs have it under /proc/irq. Reading it
+// costs a file per IRQ, too much for every interrupt rate sample, so it is kept until the
+// resources are rebuilt or the set of IRQs changes.
+class IrqAffinityCache {
+public:
+    static IrqAffinityCache &instance() {
+        static IrqAffinityCache cache;
+        return cache;
     }
 
-    buffer[bytesRead] = '\0';
-    return QString::fromUtf8(buffer).trimmed();
-}
+    void fill(QList<IrqInfo> &irqs, bool reload) {
+        QMutexLocker locker(&mutex_);
+        if (reload || !coversExactly(irqs)) {
+            read(irqs);
+        }
+        for (auto &irq : irqs) {
+            if (hasAffinity(irq)) {
+                irq.affinity = affinity_.value(irq.irqNumber);
+            }
+        }
+    }
+
+private:
+    bool coversExactly(const QList<IrqInfo> &irqs) const {
+        qsizetype count = 0;
+        for (const auto &irq : irqs) {
+            if (hasAffinity(irq)) {
+                if (!affinity_.contains(irq.irqNumber)) {
+                    return false;
+                }
+                ++count;
+            }
+        }
+        return count == affinity_.size();
+    }
+
+    void read(const QList<IrqInfo> &irqs) {
+        affinity_.clear();
+        SysfsReader reader(QStringLiteral("/proc/irq"));
+        for (const auto &irq : irqs) {
+            if (hasAffinity(irq)) {
+                const auto attribute = irq.irqNumber.toLatin1() + "/smp_affinity_list";
+                affinity_.insert(irq.irqNumber,
+                                 reader.isOpen() ? reader.read(attribute.constData()) : QString());
+            }
+        }
+    }
+
+    QHash<QString, QString> affinity_;
+    QMutex mutex_;
+};
+
+} // namespace
 
 QString getKernelVersion() {
     struct utsname buffer;
@@ -531,94 +630,24 @@ QString translateDevicePath(const QString &devpath) {
 }
 
 QString getMountPoint(const QString &devnode) {
-    if (devnode.isEmpty()) {
-        return {};
-    }
-
-    QFileInfo devnodeInfo(devnode);
-    auto canonicalDevnode = devnodeInfo.canonicalFilePath();
-    if (canonicalDevnode.isEmpty()) {
-        canonicalDevnode = devnode;
-    }
-
-    QFile mountsFile(QStringLiteral("/proc/mounts"));
-    if (!mountsFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return {};
-    }
-
-    auto allData = mountsFile.readAll();
-    mountsFile.close();
-
-    auto mountLines = QString::fromUtf8(allData).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-
-    for (const auto &line : mountLines) {
-        auto parts = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
-        if (parts.size() >= 2) {
-            auto device = parts.at(0);
-            auto mountPoint = parts.at(1);
-
-            QFileInfo mountDevInfo(device);
-            auto canonicalMountDev = mountDevInfo.canonicalFilePath();
-            if (canonicalMountDev.isEmpty()) {
-                canonicalMountDev = device;
-            }
-
-            if (device == devnode || device == canonicalDevnode || canonicalMountDev == devnode ||
-                canonicalMountDev == canonicalDevnode) {
-                // Decode escaped characters
-                mountPoint.replace(QStringLiteral(R"(\040)"), QStringLiteral(" "));
-                mountPoint.replace(QStringLiteral(R"(\011)"), QStringLiteral("\t"));
-                mountPoint.replace(QStringLiteral(R"(\012)"), QStringLiteral("\n"));
-                mountPoint.replace(QStringLiteral(R"(\134)"), QStringLiteral(R"(\)"));
-                return mountPoint;
-            }
-        }
-    }
-
-    return {};
+    return MountTable::instance().mountPoint(devnode);
 }
 
 QString lookupUsbVendor(const QString &vendorId) {
-    static QHash<QString, QString> vendorCache;
-    static bool initialized = false;
-
-    if (!initialized) {
-        initialized = true;
-
-        static const QStringList usbIdsLocations = {
-            QStringLiteral("/usr/share/hwdata/usb.ids"),
-            QStringLiteral("/usr/share/misc/usb.ids"),
-            QStringLiteral("/usr/share/usb.ids"),
-            QStringLiteral("/var/lib/usbutils/usb.ids"),
-        };
-
-        for (const auto &path : usbIdsLocations) {
-            QFile file(path);
-            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                continue;
-            }
-
-            QTextStream in(&file);
-            while (!in.atEnd()) {
-                auto line = in.readLine();
-                if (line.length() >= 6 && !line.startsWith(QLatin1Char('\t')) &&
-                    !line.startsWith(QLatin1Char('#'))) {
-                    auto lineVendorId = line.left(4).toLower();
-                    auto name = line.mid(6).trimmed();
-                    if (!name.isEmpty()) {
-                        vendorCache.insert(lineVendorId, name);
-                    }
-                }
-            }
-            file.close();
+    static const QStringList usbIdsLocations = {
+        QStringLiteral("/usr/share/hwdata/usb.ids"),
+        QStringLiteral("/usr/share/misc/usb.ids"),
+        QStringLiteral("/usr/share/usb.ids"),
+        QStringLiteral("/var/lib/usbutils/usb.ids"),
+    };
+    static HardwareIdDatabase database;
+    static const auto opened = database.openFirst(usbIdsLocations);
 
-            if (!vendorCache.isEmpty()) {
-                break;
-            }
-        }
+    quint16 id = 0;
+    if (!opened || !HardwareIdDatabase::parseId(vendorId, id)) {
+        return {};
     }
-
-    return vendorCache.value(vendorId.toLower());
+    return database.vendor(id);
 }
 
 DeviceEventQuery buildEventQuery(const DeviceInfo &info) {
@@ -631,8 +660,8 @@ DeviceEventQuery buildEventQuery(const DeviceInfo &info) {
     return query;
 }
 
-QStringList queryDeviceEvents(const DeviceEventQuery &query) {
-    QStringList events;
+// Terms that name a device in messages the kernel did not attribute to it
+static QStringList deviceEventSearchTerms(const DeviceEventQuery &query) {
     QStringList searchTerms;
 
     if (!query.vendorId.isEmpty() && !query.modelId.isEmpty()) {
@@ -658,16 +687,38 @@ QStringList queryDeviceEvents(const DeviceEventQuery &query) {
         }
     }
 
-    QRegularExpression pciRe(QStringLiteral(R"(([0-9a-f]{4}:[0-9a-f]{2}:[0-9a-f]{2}\.[0-9a-f]))"));
+    static const QRegularExpression pciRe(
+        QStringLiteral(R"(([0-9a-f]{4}:[0-9a-f]{2}:[0-9a-f]{2}\.[0-9a-f]))"));
     auto pciMatch = pciRe.match(query.syspath);
     if (pciMatch.hasMatch()) {
         searchTerms << pciMatch.captured(1);
     }
 
+    return searchTerms;
+}
+
+QList<DeviceEvent> queryDeviceEvents(const DeviceEventQuery &query) {
+    constexpr qsizetype kMaxDeviceEvents = 50;
+    QList<DeviceEvent> events;
+    const auto searchTerms = deviceEventSearchTerms(query);
+
+    auto &kernelLog = KernelLog::instance();
+    if (kernelLog.isAvailable()) {
+        // Messages attributed to the device when they were read; the search terms only find
+        // messages that name the device in free text
+        events = kernelLog.eventsForDevice(query.syspath, kMaxDeviceEvents);
+        if (events.isEmpty()) {
+            events = kernelLog.search(searchTerms, kMaxDeviceEvents);
+        }
+        return events;
+    }
+
     if (searchTerms.isEmpty()) {
         return events;
     }
 
+    // The journal may still be readable through group membership when /dev/kmsg is not. Its lines
+    // carry no cursor, but without /dev/kmsg there is no live stream to tell them apart from
     QProcess journalctl;
     QStringList args;
     args << QStringLiteral("-k") << QStringLiteral("-n") << QStringLiteral("500")
@@ -675,23 +726,19 @@ QStringList queryDeviceEvents(const DeviceEventQuery &query) {
 
     journalctl.start(QStringLiteral("journalctl"), args);
     if (journalctl.waitForFinished(5000)) {
-        auto output = QString::fromUtf8(journalctl.readAllStandardOutput());
-        auto lines = output.split(QStringLiteral("\n"), Qt::SkipEmptyParts);
-
-        for (const QString &line : lines) {
-            auto matches = false;
-            for (const QString &term : searchTerms) {
-                if (line.contains(term, Qt::CaseInsensitive)) {
-                    matches = true;
-                    break;
-                }
+        // Match the UTF-8 output directly and only decode the lines that are kept
+        const auto output = journalctl.readAllStandardOutput();
+        const TermMatcher matcher(searchTerms);
+        for (qsizetype start = 0; start < output.size() && events.size() < kMaxDeviceEvents;) {
+            auto end = output.indexOf('\n', start);
+            if (end == -1) {
+                end = output.size();
             }
-            if (matches) {
-                events << line;
-            }
-            if (events.size() >= 50) {
-                break;
+            const auto line = QByteArrayView(output).sliced(start, end - start);
+            if (!line.isEmpty() && matcher.matches(line)) {
+                events.append({QString::fromUtf8(line), {}});
             }
+            start = end + 1;
         }
     }
 
@@ -701,38 +748,20 @@ QStringList queryDeviceEvents(const DeviceEventQuery &query) {
 ParsedEvent parseEventLine(const QString &line) {
     ParsedEvent result;
 
-    // Parse journalctl output with -o short-iso format
-    // Format: "YYYY-MM-DDTHH:MM:SS+ZZZZ hostname kernel: message"
-    QRegularExpression isoTimestampRe(
-        QStringLiteral(R"(^(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[+-]\d{2}:?\d{2})\s+)"));
-    auto match = isoTimestampRe.match(line);
-
-    if (match.hasMatch()) {
-        auto isoTimestamp = match.captured(1);
-        auto remainder = line.mid(match.capturedEnd());
-
-        auto dateTime = QDateTime::fromString(isoTimestamp, Qt::ISODate);
-        if (dateTime.isValid()) {
-            result.timestamp = QLocale::system().toString(dateTime, QLocale::ShortFormat);
-        } else {
-            result.timestamp = isoTimestamp;
-        }
-
-        auto kernelIdx = remainder.indexOf(QStringLiteral("kernel:"));
-        if (kernelIdx != -1) {
-            result.message = remainder.mid(kernelIdx + 7).trimmed();
-        } else {
-            auto colonIdx = remainder.indexOf(QStringLiteral(": "));
-            if (colonIdx != -1) {
-                result.message = remainder.mid(colonIdx + 2).trimmed();
-            } else {
-                result.message = remainder.trimmed();
-            }
-        }
-    } else {
+    // KernelLog lines and journalctl -o short-iso output:
+    // "YYYY-MM-DDTHH:MM:SS+ZZ:ZZ hostname kernel: message"
+    QStringView timestamp;
+    QStringView message;
+    if (!splitJournalLine(line, timestamp, message)) {
         result.message = line;
+        return result;
     }
 
+    static const auto locale = QLocale::system();
+    const auto dateTime = QDateTime::fromString(timestamp, Qt::ISODate);
+    result.timestamp = dateTime.isValid() ? locale.toString(dateTime, QLocale::ShortFormat)
+                                          : timestamp.toString();
+    result.message = message.toString();
     return result;
 }
 
@@ -745,56 +774,12 @@ static QString getBlockDeviceManufacturer(const QString &syspath,
             return {};
         }
 
-        static const QList<QPair<QString, QString>> manufacturerMappings = {
-            {QStringLiteral("Samsung"), QStringLiteral("Samsung")},
-            {QStringLiteral("WDC"), QStringLiteral("Western Digital")},
-            {QStringLiteral("Western Digital"), QStringLiteral("Western Digital")},
-            {QStringLiteral("Seagate"), QStringLiteral("Seagate")},
-            {QStringLiteral("Toshiba"), QStringLiteral("Toshiba")},
-            {QStringLiteral("HGST"), QStringLiteral("HGST")},
-            {QStringLiteral("Hitachi"), QStringLiteral("Hitachi")},
-            {QStringLiteral("Kingston"), QStringLiteral("Kingston")},
-            {QStringLiteral("SanDisk"), QStringLiteral("SanDisk")},
-            {QStringLiteral("Crucial"), QStringLiteral("Crucial")},
-            {QStringLiteral("CT"), QStringLiteral("Crucial")},
-            {QStringLiteral("Intel"), QStringLiteral("Intel")},
-            {QStringLiteral("Micron"), QStringLiteral("Micron")},
-            {QStringLiteral("SK hynix"), QStringLiteral("SK hynix")},
-            {QStringLiteral("KIOXIA"), QStringLiteral("KIOXIA")},
-            {QStringLiteral("Phison"), QStringLiteral("Phison")},
-            {QStringLiteral("Realtek"), QStringLiteral("Realtek")},
-            {QStringLiteral("Sabrent"), QStringLiteral("Sabrent")},
-            {QStringLiteral("ADATA"), QStringLiteral("ADATA")},
-            {QStringLiteral("PNY"), QStringLiteral("PNY")},
-            {QStringLiteral("Corsair"), QStringLiteral("Corsair")},
-            {QStringLiteral("Transcend"), QStringLiteral("Transcend")},
-            {QStringLiteral("LiteOn"), QStringLiteral("Lite-On")},
-            {QStringLiteral("LITE-ON"), QStringLiteral("Lite-On")},
-            {QStringLiteral("Plextor"), QStringLiteral("Plextor")},
-            {QStringLiteral("OCZ"), QStringLiteral("OCZ")},
-            {QStringLiteral("Patriot"), QStringLiteral("Patriot")},
-            {QStringLiteral("SPCC"), QStringLiteral("Silicon Power")},
-            {QStringLiteral("Silicon Power"), QStringLiteral("Silicon Power")},
-            {QStringLiteral("Team"), QStringLiteral("Team Group")},
-            {QStringLiteral("Lexar"), QStringLiteral("Lexar")},
-            {QStringLiteral("HP"), QStringLiteral("HP")},
-            {QStringLiteral("Dell"), QStringLiteral("Dell")},
-            {QStringLiteral("Lenovo"), QStringLiteral("Lenovo")},
-            {QStringLiteral("Apple"), QStringLiteral("Apple")},
-            {QStringLiteral("Maxtor"), QStringLiteral("Maxtor")},
-            {QStringLiteral("Fujitsu"), QStringLiteral("Fujitsu")},
-        };
-
-        for (const auto &mapping : manufacturerMappings) {
-            if (text.startsWith(mapping.first, Qt::CaseInsensitive)) {
-                return mapping.second;
-            }
-            if (text.contains(mapping.first, Qt::CaseInsensitive)) {
-                return mapping.second;
-            }
+        // A pattern that occurs at the start also occurs in the text, so one search covers both
+        const auto index = diskmanufacturers::kMatcher.firstMatch(text);
+        if (index < 0) {
+            return {};
         }
-
-        return {};
+        return QString::fromLatin1(diskmanufacturers::kNames[index]);
     };
 
     // Try device name first
@@ -818,8 +803,8 @@ static QString getBlockDeviceManufacturer(const QString &syspath,
     }
 
     // Try to read vendor from sysfs
-    auto vendorPath = syspath + QStringLiteral("/device/vendor");
-    auto vendor = safeReadSysfsFile(vendorPath);
+    SysfsReader reader(syspath);
+    auto vendor = reader.read("device/vendor");
     if (!vendor.isEmpty()) {
         vendor = vendor.trimmed();
 
@@ -866,9 +851,8 @@ static QString getBlockDeviceManufacturer(const QString &syspath,
     }
 
     // Try parent device's vendor
-    if (!parentSyspath.isEmpty()) {
-        auto parentVendorPath = parentSyspath + QStringLiteral("/vendor");
-        vendor = safeReadSysfsFile(parentVendorPath);
+    if (!parentSyspath.isEmpty() && reader.open(parentSyspath)) {
+        vendor = reader.read("vendor");
         if (!vendor.isEmpty()) {
             return vendor.trimmed();
         }
@@ -885,248 +869,75 @@ bool isPciDevice(const QString &syspath) {
 }
 } // namespace
 
-QList<ResourceInfo> getDeviceResources(const QString &syspath, const QString &driver) {
-    QList<ResourceInfo> resources;
+QList<ResourceInfo> getDeviceResources(const QString &syspath,
+                                      const QString &driver,
+                                      const SystemResources &resources) {
+    QList<ResourceInfo> result;
 
     if (!isPciDevice(syspath)) {
-        return resources;
-    }
-
-    // Get IRQ
-    auto irqPath = syspath + QStringLiteral("/irq");
-    auto irq = safeReadSysfsFile(irqPath);
-    if (!irq.isEmpty() && irq != QStringLiteral("0")) {
-        auto irqNum = irq.toInt();
-        auto setting =
-            QStringLiteral("0x%1 (%2)").arg(irqNum, 8, 16, QLatin1Char('0')).arg(irqNum).toUpper();
-        resources.append({QObject::tr("IRQ"), setting, QStringLiteral("preferences-other")});
+        return result;
     }
 
-    // Get PCI resources
-    auto resourcePath = syspath + QStringLiteral("/resource");
-    auto resourceContent = safeReadSysfsFile(resourcePath);
-    if (!resourceContent.isEmpty()) {
-        static const QRegularExpression whitespaceRe(QStringLiteral(R"(\s+)"));
-        const auto lines = resourceContent.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-        for (const QString &line : lines) {
-            auto trimmedLine = line.trimmed();
-            if (trimmedLine.isEmpty()) {
-                continue;
-            }
-
-            auto parts = trimmedLine.split(whitespaceRe, Qt::SkipEmptyParts);
-            if (parts.size() >= 3) {
-                auto ok1 = false;
-                auto ok2 = false;
-                auto ok3 = false;
-                auto start = parts[0].toULongLong(&ok1, 16);
-                auto end = parts[1].toULongLong(&ok2, 16);
-                auto flags = parts[2].toULongLong(&ok3, 16);
-
-                if (ok1 && ok2 && ok3 && start != 0 && end != 0) {
-                    QString type;
-                    if (flags & 0x00000100) {
-                        type = QObject::tr("I/O Range");
-                    } else if (flags & 0x00000200) {
-                        type = QObject::tr("Memory Range");
-                    } else {
-                        continue;
-                    }
-
-                    auto setting = QStringLiteral("%1 - %2")
-                                       .arg(start, 16, 16, QLatin1Char('0'))
-                                       .arg(end, 16, 16, QLatin1Char('0'))
-                                       .toUpper();
-                    resources.append({type, setting, QStringLiteral("drive-harddisk")});
-                }
-            }
+    // IRQ and BARs were read from sysfs when the snapshot was taken
+    for (const auto &resource : resources.deviceResources.value(syspath)) {
+        if (resource.type == QStringLiteral("IRQ")) {
+            result.append(
+                {QObject::tr("IRQ"), resource.displayValue, QStringLiteral("preferences-other")});
+        } else if (resource.type == QStringLiteral("I/O Range")) {
+            result.append({QObject::tr("I/O Range"),
+                           resource.displayValue,
+                           QStringLiteral("drive-harddisk")});
+        } else if (resource.type == QStringLiteral("Memory Range")) {
+            result.append({QObject::tr("Memory Range"),
+                           resource.displayValue,
+                           QStringLiteral("drive-harddisk")});
         }
     }
 
-    // Get DMA
     if (!driver.isEmpty()) {
-        auto dmaContent = safeReadSysfsFile(QStringLiteral("/proc/dma"));
-        if (!dmaContent.isEmpty()) {
-            static const QRegularExpression dmaRe(QStringLiteral(R"(^(\d+):\s*(.*)$)"));
-            const auto lines = dmaContent.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-            for (const QString &line : lines) {
-                if (line.contains(driver, Qt::CaseInsensitive)) {
-                    auto match = dmaRe.match(line);
-                    if (match.hasMatch()) {
-                        auto channel = match.captured(1);
-                        resources.append(
-                            {QObject::tr("DMA"), channel, QStringLiteral("preferences-other")});
-                    }
-                }
+        for (const auto &channel : resources.dmaChannels) {
+            if (channel.name.contains(driver, Qt::CaseInsensitive)) {
+                result.append(
+                    {QObject::tr("DMA"), channel.channel, QStringLiteral("preferences-other")});
             }
         }
     }
 
-    return resources;
+    return result;
 }
 
 QList<DmaChannelInfo> getSystemDmaChannels() {
-    QList<DmaChannelInfo> channels;
-
-    auto content = safeReadSysfsFile(QStringLiteral("/proc/dma"));
-    if (content.isEmpty()) {
-        return channels;
-    }
-
-    static const QRegularExpression dmaRe(QStringLiteral(R"(^(\d+):\s*(.*)$)"));
-    const auto lines = content.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-    for (const QString &line : lines) {
-        auto trimmed = line.trimmed();
-        if (trimmed.isEmpty()) {
-            continue;
-        }
-        auto match = dmaRe.match(trimmed);
-        if (match.hasMatch()) {
-            channels.append({match.captured(1), match.captured(2)});
-        }
-    }
-
-    return channels;
+    return parseSystemDmaChannels(readProcFile("/proc/dma"));
 }
 
 QList<IoPortInfo> getSystemIoPorts() {
-    QList<IoPortInfo> ports;
-
-    auto content = safeReadSysfsFile(QStringLiteral("/proc/ioports"));
-    if (content.isEmpty()) {
-        return ports;
-    }
-
-    static const QRegularExpression resourceRe(
-        QStringLiteral("^(\\s*)([0-9a-fA-F]+)-([0-9a-fA-F]+)\\s*:\\s*(.*)$"));
-
-    const auto lines = content.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-    for (const QString &line : lines) {
-        if (line.trimmed().isEmpty()) {
-            continue;
-        }
-
-        auto match = resourceRe.match(line);
-        if (!match.hasMatch()) {
-            continue;
-        }
-
-        auto name = match.captured(4);
-        if (name.isEmpty()) {
-            continue;
-        }
-
-        IoPortInfo info;
-        info.indentLevel = static_cast<int>(match.captured(1).length());
-        info.rangeStart = match.captured(2).toUpper();
-        info.rangeEnd = match.captured(3).toUpper();
-        info.name = name;
-        ports.append(info);
-    }
-
-    return ports;
+    return parseSystemIoPorts(readProcFile("/proc/ioports"));
 }
 
 QList<IrqInfo> getSystemIrqs() {
-    QList<IrqInfo> irqs;
-
-    auto content = safeReadSysfsFile(QStringLiteral("/proc/interrupts"));
-    if (content.isEmpty()) {
-        return irqs;
-    }
-
-    auto lines = content.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-    if (!lines.isEmpty()) {
-        lines.removeFirst(); // Skip header
-    }
-
-    static const QRegularExpression whitespaceRe(QStringLiteral(R"(\s+)"));
-    for (const QString &line : lines) {
-        if (line.trimmed().isEmpty()) {
-            continue;
-        }
-
-        auto parts = line.split(whitespaceRe, Qt::SkipEmptyParts);
-        if (parts.size() < 2) {
-            continue;
-        }
-
-        auto irqNum = parts[0];
-        if (irqNum.endsWith(QLatin1Char(':'))) {
-            irqNum.chop(1);
-        }
-
-        QString deviceName;
-        QString irqType;
-
-        for (auto i = 1; i < parts.size(); ++i) {
-            if (parts[i].contains(QStringLiteral("APIC")) ||
-                parts[i].contains(QStringLiteral("PCI")) ||
-                parts[i].contains(QStringLiteral("MSI")) ||
-                parts[i].contains(QStringLiteral("DMAR")) ||
-                parts[i].contains(QStringLiteral("edge")) ||
-                parts[i].contains(QStringLiteral("level")) ||
-                parts[i].contains(QStringLiteral("fasteoi"))) {
-                if (irqType.isEmpty()) {
-                    irqType = parts[i];
-                } else {
-                    irqType += QLatin1Char(' ') + parts[i];
-                }
-            } else if (i > 1 && !parts[i].isEmpty() && !parts[i].at(0).isDigit()) {
-                if (deviceName.isEmpty()) {
-                    deviceName = parts[i];
-                } else {
-                    deviceName += QLatin1Char(' ') + parts[i];
-                }
-            }
-        }
-
-        if (deviceName.isEmpty()) {
-            continue;
-        }
-
-        irqs.append({irqNum, irqType, deviceName});
-    }
-
+    auto irqs = parseSystemIrqs(readProcFile("/proc/interrupts"));
+    IrqAffinityCache::instance().fill(irqs, false);
     return irqs;
 }
 
 QList<MemoryRangeInfo> getSystemMemoryRanges() {
-    QList<MemoryRangeInfo> ranges;
-
-    auto content = safeReadSysfsFile(QStringLiteral("/proc/iomem"));
-    if (content.isEmpty()) {
-        return ranges;
-    }
-
-    static const QRegularExpression resourceRe(
-        QStringLiteral(R"(^(\s*)([0-9a-fA-F]+)-([0-9a-fA-F]+)\s*:\s*(.*)$)"));
-
-    const auto lines = content.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
-    for (const QString &line : lines) {
-        if (line.trimmed().isEmpty()) {
-            continue;
-        }
-
-        auto match = resourceRe.match(line);
-        if (!match.hasMatch()) {
-            continue;
-        }
+    return parseSystemMemoryRanges(readProcFile("/proc/iomem"));
+}
 
-        auto name = match.captured(4);
-        if (name.isEmpty()) {
-            continue;
+static QList<ExportResourceInfo> readExportDeviceResources(SysfsReader &reader,
+                                                           const QString &syspath);
+
+SystemResources getSystemResources(const QList<DeviceInfo> &devices) {
+    auto resources = SystemResources::fromRaw(getSystemResourcesRaw());
+    IrqAffinityCache::instance().fill(resources.irqs, true);
+    SysfsReader reader;
+    for (const auto &device : devices) {
+        auto deviceResources = readExportDeviceResources(reader, device.syspath());
+        if (!deviceResources.isEmpty()) {
+            resources.deviceResources.insert(device.syspath(), deviceResources);
         }
-
-        MemoryRangeInfo info;
-        info.indentLevel = static_cast<int>(match.captured(1).length());
-        info.rangeStart = match.captured(2).toUpper();
-        info.rangeEnd = match.captured(3).toUpper();
-        info.name = name;
-        ranges.append(info);
     }
-
-    return ranges;
+    return resources;
 }
 
 QList<PropertyMapping> getDevicePropertyMappings() {
@@ -1415,29 +1226,11 @@ QString getDeviceManufacturer(const DeviceInfo &info) {
         return QStringLiteral("Intel Corporation");
     }
     // Linux Foundation devices (misc/software devices and input devices)
-    if (shortName == QStringLiteral("autofs") || shortName == QStringLiteral("cpu dma latency") ||
-        shortName == QStringLiteral("cpu_dma_latency") || shortName == QStringLiteral("fuse") ||
-        shortName == QStringLiteral("hpet") || shortName == QStringLiteral("hwrng") ||
-        shortName == QStringLiteral("kvm") || shortName == QStringLiteral("loop-control") ||
-        shortName == QStringLiteral("loop control") || shortName == QStringLiteral("mcelog") ||
-        shortName == QStringLiteral("net/tun") || shortName == QStringLiteral("ntsync") ||
-        shortName == QStringLiteral("rfkill") || shortName == QStringLiteral("uhid") ||
-        shortName == QStringLiteral("uinput") || shortName == QStringLiteral("vga arbiter") ||
-        shortName == QStringLiteral("vhost-net") ||
+    if (kLinuxFoundationNames.contains(shortName) || kLinuxFoundationNodes.contains(shortNode) ||
         shortName.startsWith(QStringLiteral("input/event")) ||
         shortName.startsWith(QStringLiteral("input/mouse")) ||
-        shortNode == QStringLiteral("autofs") || shortNode == QStringLiteral("cpu_dma_latency") ||
-        shortNode == QStringLiteral("fuse") || shortNode == QStringLiteral("hpet") ||
-        shortNode == QStringLiteral("hwrng") || shortNode == QStringLiteral("kvm") ||
-        shortNode == QStringLiteral("loop-control") || shortNode == QStringLiteral("mcelog") ||
-        shortNode == QStringLiteral("net/tun") || shortNode == QStringLiteral("ntsync") ||
-        shortNode == QStringLiteral("rfkill") || shortNode == QStringLiteral("uhid") ||
-        shortNode == QStringLiteral("uinput") ||
         shortNode.startsWith(QStringLiteral("input/event")) ||
-        shortNode.startsWith(QStringLiteral("input/mouse")) ||
-        shortNode == QStringLiteral("vga_arbiter") || shortNode == QStringLiteral("vhost-net") ||
-        shortName == QStringLiteral("mapper/control") ||
-        shortNode == QStringLiteral("mapper/control")) {
+        shortNode.startsWith(QStringLiteral("input/mouse"))) {
         return QStringLiteral("Linux Foundation");
     }
 
@@ -1519,15 +1312,17 @@ static bool isPciDeviceForExport(const QString &syspath) {
     return pciPathRe.match(syspath).hasMatch();
 }
 
-QList<ExportResourceInfo> getExportDeviceResources(const QString &syspath) {
+// Reads through the caller's reader so that a pass over every device reuses one buffer
+static QList<ExportResourceInfo> readExportDeviceResources(SysfsReader &reader,
+                                                           const QString &syspath) {
     QList<ExportResourceInfo> resources;
 
-    if (syspath.isEmpty() || !isPciDeviceForExport(syspath)) {
+    if (syspath.isEmpty() || !isPciDeviceForExport(syspath) || !reader.open(syspath)) {
         return resources;
     }
 
     // Get IRQ
-    auto irq = safeReadSysfsFile(syspath + QStringLiteral("/irq"));
+    auto irq = reader.read("irq");
     if (!irq.isEmpty() && irq != QStringLiteral("0")) {
         ExportResourceInfo res;
         res.type = QStringLiteral("IRQ");
@@ -1538,7 +1333,7 @@ QList<ExportResourceInfo> getExportDeviceResources(const QString &syspath) {
     }
 
     // Get PCI resources (memory ranges and I/O ports)
-    auto resourceContent = safeReadSysfsFile(syspath + QStringLiteral("/resource"));
+    auto resourceContent = reader.read("resource");
     if (!resourceContent.isEmpty()) {
         static const QRegularExpression whitespaceRe(QStringLiteral(R"(\s+)"));
         const auto lines = resourceContent.split(QLatin1Char('\n'), Qt::SkipEmptyParts);
@@ -1580,6 +1375,11 @@ QList<ExportResourceInfo> getExportDeviceResources(const QString &syspath) {
     return resources;
 }
 
+QList<ExportResourceInfo> getExportDeviceResources(const QString &syspath) {
+    SysfsReader reader;
+    return readExportDeviceResources(reader, syspath);
+}
+
 ExportDriverInfo getExportDriverInfo(const DeviceInfo &info) {
     ExportDriverInfo driverInfo;
 
@@ -1674,24 +1474,58 @@ static UdevManager &getGlobalManager() {
 }
 
 QList<DeviceInfo> enumerateAllDevices() {
+    return enumerateDevices({});
+}
+
+QList<DeviceInfo> enumerateDevices(const DeviceEnumerationFilter &filter) {
     QList<DeviceInfo> devices;
     auto &manager = getGlobalManager();
 
-    auto *enumerator = udev_enumerate_new(manager.context());
-    udev_enumerate_scan_devices(enumerator);
+    UdevEnumerate enumerator(manager);
+    for (const auto &subsystem : filter.subsystems) {
+        enumerator.addMatchSubsystem(subsystem);
+    }
+    for (const auto &[name, value] : filter.properties) {
+        enumerator.addMatchProperty(name.toLatin1().constData(), value);
+    }
+    if (!filter.parentSyspath.isEmpty() && !enumerator.addMatchParent(filter.parentSyspath)) {
+        return devices;
+    }
+    if (filter.withDriver) {
+        enumerator.addMatchDriverBound();
+    }
+    udev_enumerate_scan_devices(enumerator.enumerator());
     struct udev_list_entry *listEntry;
-    udev_list_entry_foreach(listEntry, udev_enumerate_get_list_entry(enumerator)) {
+    udev_list_entry_foreach(listEntry, udev_enumerate_get_list_entry(enumerator.enumerator())) {
         const char *syspath = udev_list_entry_get_name(listEntry);
         auto *d = createDeviceInfo(manager.context(), syspath);
         if (d) {
             devices.emplaceBack(d);
         }
     }
-    udev_enumerate_unref(enumerator);
 
     return devices;
 }
 
+bool deviceExists(const QString &syspath) {
+    auto *device = udev_device_new_from_syspath(getGlobalManager().context(),
+                                                syspath.toLocal8Bit().constData());
+    if (!device) {
+        return false;
+    }
+    udev_device_unref(device);
+    return true;
+}
+
+bool supportsPropertyFilter() {
+    return true;
+}
+
 QObject *createDeviceMonitor(QObject *parent) {
     return new UdevMonitor(getGlobalManager().context(), parent);
 }
+
+QObject *createDeviceEventStream(const DeviceEventQuery &query, QObject *parent) {
+    return new KmsgEventStream(
+        query.syspath, deviceEventSearchTerms(query), QStringLiteral("/dev/kmsg"), parent);
+}
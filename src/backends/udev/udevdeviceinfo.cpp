@@ -16,8 +16,16 @@ static const auto singleSpace = QStringLiteral(" ");
 static const auto empty = QStringLiteral("");
 
 UdevDeviceInfoPrivate::UdevDeviceInfoPrivate(udev *ctx, const char *syspath)
-    : DeviceInfoPrivate(), ctx_(ctx), dev_(nullptr) {
-    dev_ = udev_device_new_from_syspath(ctx, syspath);
+    : DeviceInfoPrivate(), ctx_(ctx), dev_(udev_device_new_from_syspath(ctx, syspath)) {
+    readDevice();
+}
+
+UdevDeviceInfoPrivate::UdevDeviceInfoPrivate(udev *ctx, udev_device *dev)
+    : DeviceInfoPrivate(), ctx_(ctx), dev_(dev ? udev_device_ref(dev) : nullptr) {
+    readDevice();
+}
+
+void UdevDeviceInfoPrivate::readDevice() {
     if (!dev_) {
         isHidden_ = true;
         return;
@@ -207,6 +215,19 @@ QString UdevDeviceInfoPrivate::propertyValue(const char *key) const {
     return QString::fromLocal8Bit(udev_device_get_property_value(dev_, key));
 }
 
+QJsonObject UdevDeviceInfoPrivate::propertyValues() const {
+    QJsonObject values;
+    if (!dev_) {
+        return values;
+    }
+    udev_list_entry *entry;
+    udev_list_entry_foreach(entry, udev_device_get_properties_list_entry(dev_)) {
+        values[QString::fromLatin1(udev_list_entry_get_name(entry))] =
+            QString::fromLocal8Bit(udev_list_entry_get_value(entry));
+    }
+    return values;
+}
+
 DeviceInfoPrivate *UdevDeviceInfoPrivate::clone(DeviceInfo *q) const {
     return new UdevDeviceInfoPrivate(*this, q);
 }
@@ -227,3 +248,7 @@ void UdevDeviceInfoPrivate::dump() const {
 DeviceInfoPrivate *createDeviceInfo(udev *ctx, const char *syspath) {
     return new UdevDeviceInfoPrivate(ctx, syspath);
 }
+
+DeviceInfoPrivate *createDeviceInfo(udev *ctx, udev_device *dev) {
+    return new UdevDeviceInfoPrivate(ctx, dev);
+}
@@ -17,9 +17,20 @@ public:
      */
     UdevDeviceInfoPrivate(udev *ctx, const char *syspath);
 
+    /**
+     * @brief Construct from a udev device, e.g. one received from a monitor.
+     *
+     * Works for devices that have been removed, whose properties are only held by the event.
+     *
+     * @param ctx The udev context.
+     * @param dev The device; a reference is taken.
+     */
+    UdevDeviceInfoPrivate(udev *ctx, udev_device *dev);
+
     ~UdevDeviceInfoPrivate() override;
 
     QString propertyValue(const char *key) const override;
+    QJsonObject propertyValues() const override;
     DeviceInfoPrivate *clone(DeviceInfo *q) const override;
     void dump() const override;
 
@@ -27,6 +38,7 @@ private:
     // Copy constructor for clone()
     UdevDeviceInfoPrivate(const UdevDeviceInfoPrivate &other, DeviceInfo *q);
 
+    void readDevice();
     void setName();
     void calculateIsHidden();
     void calculateCategory();
@@ -42,3 +54,11 @@ private:
  * @returns A new UdevDeviceInfoPrivate instance (q_ptr will be set by DeviceInfo).
  */
 DeviceInfoPrivate *createDeviceInfo(udev *ctx, const char *syspath);
+
+/**
+ * @brief Factory function to create a DeviceInfoPrivate from a udev device.
+ * @param ctx The udev context.
+ * @param dev The device; a reference is taken.
+ * @returns A new UdevDeviceInfoPrivate instance (q_ptr will be set by DeviceInfo).
+ */
+DeviceInfoPrivate *createDeviceInfo(udev *ctx, udev_device *dev);
@@ -14,6 +14,27 @@ void UdevEnumerate::addMatchProperty(const char *property, const QString &value)
     udev_enumerate_add_match_property(enumerator_, property, value.toLocal8Bit().constData());
 }
 
+void UdevEnumerate::addMatchSubsystem(const QString &subsystem) {
+    udev_enumerate_add_match_subsystem(enumerator_, subsystem.toLocal8Bit().constData());
+}
+
+bool UdevEnumerate::addMatchParent(const QString &syspath) {
+    auto *parent = udev_device_new_from_syspath(udev_enumerate_get_udev(enumerator_),
+                                                syspath.toLocal8Bit().constData());
+    if (!parent) {
+        return false;
+    }
+    // The enumerator keeps its own reference
+    udev_enumerate_add_match_parent(enumerator_, parent);
+    udev_device_unref(parent);
+    return true;
+}
+
+void UdevEnumerate::addMatchDriverBound() {
+    // libudev reads the driver symbolic link as a sysfs attribute; a null value matches any
+    udev_enumerate_add_match_sysattr(enumerator_, "driver", nullptr);
+}
+
 UdevEnumerate::~UdevEnumerate() {
     udev_enumerate_unref(enumerator_);
 }
@@ -33,6 +33,24 @@ public:
      */
     void addMatchProperty(const char *property, const QString &value);
 
+    /**
+     * @brief Adds a subsystem match filter. Devices in any of the matched subsystems are kept.
+     * @param subsystem The subsystem name or a wildcard.
+     */
+    void addMatchSubsystem(const QString &subsystem);
+
+    /**
+     * @brief Restricts the scan to a device and its descendants.
+     * @param syspath The system path of the device.
+     * @returns @c false if there is no device at @p syspath; the filter is then unchanged.
+     */
+    bool addMatchParent(const QString &syspath);
+
+    /**
+     * @brief Restricts the scan to devices bound to a driver.
+     */
+    void addMatchDriverBound();
+
     /**
      * @brief Returns the underlying udev_enumerate object.
      * @returns Pointer to the udev_enumerate structure.
@@ -26,7 +26,6 @@ QList<DeviceInfo> UdevManager::convertToDeviceInfo(struct udev_enumerate *enumer
             ret.emplaceBack(d);
         }
     }
-    std::sort(ret.begin(), ret.end(), [](auto &a, auto &b) { return a.name() < b.name(); });
     return ret;
 }
 
@@ -53,8 +53,12 @@ public:
 
     /**
      * @brief Converts udev enumeration results to @c DeviceInfo objects.
+     *
+     * The devices are in enumeration order. Callers that show them by name sort them with
+     * @c sortByCollation().
+     *
      * @param enumerator The udev enumerator with scan results.
-     * @returns List of @c DeviceInfo objects, sorted by name.
+     * @returns List of @c DeviceInfo objects.
      */
     QList<DeviceInfo> convertToDeviceInfo(struct udev_enumerate *enumerator) const;
 
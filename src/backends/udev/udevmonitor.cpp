@@ -1,8 +1,21 @@
 // SPDX-License-Identifier: MIT
+#include <cerrno>
+
+#include <QtCore/QMetaMethod>
 #include <QtCore/QSocketNotifier>
 
+#include "deviceinfo.h"
+#include "udevdeviceinfo_p.h"
 #include "udevmonitor.h"
 
+namespace {
+
+// Room for a burst of events, e.g. a dock with a hub of devices being connected, while the event
+// loop is busy. Raising the socket's limit needs CAP_NET_ADMIN and otherwise fails harmlessly.
+constexpr int kReceiveBufferSize = 16 * 1024 * 1024;
+
+} // namespace
+
 UdevMonitor::UdevMonitor(struct udev *ctx, QObject *parent) : DeviceMonitor(parent), ctx_(ctx) {
 }
 
@@ -21,6 +34,8 @@ std::expected<void, DeviceMonitorError> UdevMonitor::start() {
         return std::unexpected(DeviceMonitorError::MonitorCreationFailed);
     }
 
+    udev_monitor_set_receive_buffer_size(monitor_, kReceiveBufferSize);
+
     // Enable receiving of events
     if (udev_monitor_enable_receiving(monitor_) < 0) {
         udev_monitor_unref(monitor_);
@@ -72,20 +87,37 @@ void UdevMonitor::onUdevEvent() {
         return;
     }
 
-    // Receive the device event
-    struct udev_device *dev = udev_monitor_receive_device(monitor_);
-    if (!dev) {
-        return;
-    }
-
-    // Check if this is an add or remove action
-    const char *action = udev_device_get_action(dev);
-    if (action) {
-        auto actionStr = QString::fromLatin1(action);
-        if (actionStr == QLatin1String("add") || actionStr == QLatin1String("remove")) {
-            Q_EMIT deviceChanged();
+    // The socket does not block, so everything queued is read now rather than one event per
+    // notification, and the kernel does not drop events while the rest wait. A receiver may stop
+    // the monitor in between.
+    const auto reportEvents =
+        isSignalConnected(QMetaMethod::fromSignal(&DeviceMonitor::deviceEvent));
+    auto changed = false;
+    auto lost = false;
+    while (monitor_) {
+        errno = 0;
+        auto *dev = udev_monitor_receive_device(monitor_);
+        if (!dev) {
+            // The kernel drops events when the socket's buffer is full and reports it once
+            lost = errno == ENOBUFS;
+            break;
+        }
+        if (const char *action = udev_device_get_action(dev)) {
+            const auto actionStr = QString::fromLatin1(action);
+            if (actionStr == QLatin1String("add") || actionStr == QLatin1String("remove")) {
+                changed = true;
+            }
+            if (reportEvents) {
+                Q_EMIT deviceEvent(actionStr, DeviceInfo(createDeviceInfo(ctx_, dev)));
+            }
         }
+        udev_device_unref(dev);
     }
 
-    udev_device_unref(dev);
+    if (lost) {
+        Q_EMIT eventsLost();
+    }
+    if (changed || lost) {
+        Q_EMIT deviceChanged();
+    }
 }
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Construction of Aho-Corasick automata, shared by the compile-time
+ *        @c staticmatch::CaseInsensitiveMatcher and the run-time @c TermMatcher.
+ *
+ * An automaton is a flat transition table with a fixed number of character classes per state
+ * (@c next[state * classCount + cls]) and, per state, the lowest index of a pattern that ends in
+ * it or in one of its suffixes (@c best, -1 for none). State 0 is the root. The functions work on
+ * any random-access containers, so the same code fills @c std::array at compile time and
+ * @c std::vector at run time; containers must already be sized for every state.
+ */
+namespace ahocorasick {
+
+/**
+ * @brief Adds a pattern to the trie.
+ *
+ * Call for each pattern in order of priority before @c complete(). Until then 0 marks a missing
+ * edge, which is unambiguous because the root is never a child.
+ *
+ * @param next Transition table; @p classCount entries per state, zero-initialised.
+ * @param best Pattern index per state; -1-initialised.
+ * @param states Number of states in use, starting at 1 for the root; grows by the states added.
+ * @param classCount Character classes per state.
+ * @param pattern The pattern's characters.
+ * @param classOf Maps a character of @p pattern to its class.
+ * @param index The pattern's index.
+ */
+template <typename Table, typename Best, typename Pattern, typename ClassOf>
+constexpr void insert(Table &next,
+                      Best &best,
+                      std::size_t &states,
+                      std::size_t classCount,
+                      const Pattern &pattern,
+                      const ClassOf &classOf,
+                      std::size_t index) {
+    using State = std::remove_cvref_t<decltype(next[0])>;
+    using Index = std::remove_cvref_t<decltype(best[0])>;
+    std::size_t state = 0;
+    for (const auto c : pattern) {
+        auto &edge = next[state * classCount + static_cast<std::size_t>(classOf(c))];
+        if (edge == 0) {
+            edge = static_cast<State>(states++);
+        }
+        state = static_cast<std::size_t>(edge);
+    }
+    // Patterns are added in order of priority, so an earlier duplicate keeps its state
+    if (best[state] < 0) {
+        best[state] = static_cast<Index>(index);
+    }
+}
+
+/**
+ * @brief Turns the trie into the automaton's full transition table.
+ *
+ * Goes breadth-first over the trie, turning missing edges into the transitions of the longest
+ * proper suffix that is also a trie node, and letting each state report the patterns that end in
+ * its suffixes.
+ *
+ * @param next Transition table filled by @c insert(); completed in place.
+ * @param best Pattern index per state; updated in place.
+ * @param classCount Character classes per state.
+ * @param fail Scratch space for a suffix link per state; zero-initialised.
+ * @param queue Scratch space for a queue of every state but the root.
+ */
+template <typename Table, typename Best, typename Scratch>
+constexpr void complete(Table &next,
+                        Best &best,
+                        std::size_t classCount,
+                        Scratch &fail,
+                        Scratch &queue) {
+    using State = std::remove_cvref_t<decltype(fail[0])>;
+    std::size_t head = 0;
+    std::size_t tail = 0;
+    // Missing edges of the root already lead back to it
+    for (std::size_t cls = 0; cls < classCount; ++cls) {
+        if (next[cls] != 0) {
+            queue[tail++] = static_cast<State>(next[cls]);
+        }
+    }
+    while (head < tail) {
+        const auto state = static_cast<std::size_t>(queue[head++]);
+        const auto failRow = static_cast<std::size_t>(fail[state]) * classCount;
+        for (std::size_t cls = 0; cls < classCount; ++cls) {
+            auto &edge = next[state * classCount + cls];
+            // The suffix is shallower, so its row is already complete
+            const auto fallback = next[failRow + cls];
+            if (edge == 0) {
+                edge = fallback;
+                continue;
+            }
+            const auto child = static_cast<std::size_t>(edge);
+            fail[child] = static_cast<State>(fallback);
+            const auto inherited = best[static_cast<std::size_t>(fallback)];
+            if (inherited >= 0 && (best[child] < 0 || inherited < best[child])) {
+                best[child] = inherited;
+            }
+            queue[tail++] = static_cast<State>(child);
+        }
+    }
+}
+
+} // namespace ahocorasick
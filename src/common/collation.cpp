@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: MIT
+#include <algorithm>
+#include <numeric>
+
+#include "collation.h"
+
+namespace {
+
+QCollator makeCollator() {
+    QCollator collator;
+    // Names differing only in case are equal, and "sda2" comes before "sda10"
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.setNumericMode(true);
+    return collator;
+}
+
+} // namespace
+
+QList<QCollatorSortKey> collationKeys(const QStringList &texts) {
+    // A collator initialises itself on first use, so each thread needs its own
+    thread_local const QCollator collator = makeCollator();
+    QList<QCollatorSortKey> keys;
+    keys.reserve(texts.size());
+    for (const auto &text : texts) {
+        keys.append(collator.sortKey(text));
+    }
+    return keys;
+}
+
+void sortByCollationKeys(QList<int> &indexes, const QList<QCollatorSortKey> &keys) {
+    std::ranges::stable_sort(
+        indexes, [&keys](int a, int b) { return keys.at(a).compare(keys.at(b)) < 0; });
+}
+
+QList<qsizetype> collationOrder(const QStringList &texts) {
+    QList<qsizetype> order(texts.size());
+    std::iota(order.begin(), order.end(), qsizetype{0});
+    if (texts.size() < 2) {
+        return order;
+    }
+
+    const auto keys = collationKeys(texts);
+    std::ranges::stable_sort(
+        order, [&keys](qsizetype a, qsizetype b) { return keys.at(a).compare(keys.at(b)) < 0; });
+    return order;
+}
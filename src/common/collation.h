@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QCollator>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <utility>
+
+/**
+ * @brief Computes the keys texts are sorted by for display.
+ *
+ * Keys are meant to be kept with data that is sorted repeatedly, so sorting only compares them.
+ *
+ * @param texts The texts.
+ * @returns One key per text.
+ */
+QList<QCollatorSortKey> collationKeys(const QStringList &texts);
+
+/**
+ * @brief Sorts indexes by keys from @c collationKeys(). Equal keys keep their order.
+ * @param indexes Indexes into @p keys.
+ * @param keys The keys.
+ */
+void sortByCollationKeys(QList<int> &indexes, const QList<QCollatorSortKey> &keys);
+
+/**
+ * @brief Returns the order in which texts are shown to the user.
+ *
+ * Texts are compared as the user's locale sorts them (see @c QCollator), ignoring case and with
+ * numbers compared by value. A sort key is computed once per text and only indexes are sorted.
+ * Equal texts keep their relative order.
+ *
+ * @param texts The texts.
+ * @returns Indexes into @p texts in display order.
+ */
+QList<qsizetype> collationOrder(const QStringList &texts);
+
+/**
+ * @brief Sorts items by a text for display.
+ *
+ * Uses @c collationOrder(), then moves each item once to its place, so items that are expensive
+ * to copy or swap, such as @c DeviceInfo, are never copied.
+ *
+ * @param items The items to sort.
+ * @param textOf Returns the text an item is sorted by.
+ */
+template <typename T, typename TextOf>
+void sortByCollation(QList<T> &items, TextOf textOf) {
+    QStringList texts;
+    texts.reserve(items.size());
+    for (const auto &item : std::as_const(items)) {
+        texts << textOf(item);
+    }
+    QList<T> sorted;
+    sorted.reserve(items.size());
+    for (const auto index : collationOrder(texts)) {
+        sorted.append(std::move(items[index]));
+    }
+    items = std::move(sorted);
+}
@@ -267,6 +267,15 @@ inline const QIcon &irq() {
     return icon;
 }
 
+/**
+ * @brief Returns the icon for resources that conflict with another assignment.
+ * @returns Reference to the cached icon.
+ */
+inline const QIcon &resourceConflict() {
+    static const auto icon = QIcon::fromTheme(QStringLiteral("dialog-error"));
+    return icon;
+}
+
 /**
  * @brief Returns the icon for memory resources.
  * @returns Reference to the cached icon.
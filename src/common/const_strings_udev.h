@@ -32,6 +32,7 @@ constexpr char ID_INPUT_KEYBOARD[] = "ID_INPUT_KEYBOARD";           ///< Keyboar
 constexpr char ID_INPUT_MOUSE[] = "ID_INPUT_MOUSE";                 ///< Mouse indicator.
 constexpr char ID_MODEL[] = "ID_MODEL";                             ///< Device model.
 constexpr char ID_MODEL_FROM_DATABASE[] = "ID_MODEL_FROM_DATABASE"; ///< Model from hwdb.
+constexpr char ID_MODEL_ID[] = "ID_MODEL_ID";                       ///< Model ID (hex).
 constexpr char ID_PCI_CLASS_FROM_DATABASE[] =
     "ID_PCI_CLASS_FROM_DATABASE"; ///< PCI class from hwdb.
 constexpr char ID_PCI_INTERFACE_FROM_DATABASE[] =
@@ -42,8 +43,11 @@ constexpr char ID_USB_VENDOR[] = "ID_USB_VENDOR";                     ///< USB v
 constexpr char ID_VENDOR[] = "ID_VENDOR";                             ///< Vendor name.
 constexpr char ID_VENDOR_ENC[] = "ID_VENDOR_ENC";                     ///< Encoded vendor name.
 constexpr char ID_VENDOR_FROM_DATABASE[] = "ID_VENDOR_FROM_DATABASE"; ///< Vendor from hwdb.
+constexpr char ID_VENDOR_ID[] = "ID_VENDOR_ID";                       ///< Vendor ID (hex).
 constexpr char MODALIAS[] = "MODALIAS";                               ///< Module alias.
 constexpr char NAME[] = "NAME";                                       ///< Device name.
+constexpr char PCI_ID[] = "PCI_ID";                                   ///< PCI vendor:device ID.
+constexpr char PCI_SUBSYS_ID[] = "PCI_SUBSYS_ID";                     ///< PCI subsystem ID.
 constexpr char SUBSYSTEM[] = "SUBSYSTEM";                             ///< Subsystem name.
 } // namespace propertyNames
 
@@ -0,0 +1,56 @@
+// SPDX-License-Identifier: MIT
+#include <algorithm>
+#include <utility>
+
+#include "devicechangequeue.h"
+
+DeviceChangeQueue::DeviceChangeQueue(qsizetype capacity)
+    : capacity_(std::max<qsizetype>(capacity, 1)) {
+}
+
+qsizetype DeviceChangeQueue::capacity() const {
+    return capacity_;
+}
+
+bool DeviceChangeQueue::push(DeviceChange change) {
+    {
+        QMutexLocker locker(&mutex_);
+        if (closed_ || static_cast<qsizetype>(changes_.size()) >= capacity_) {
+            ++pendingDrops_;
+            ++droppedCount_;
+            return false;
+        }
+        changes_.push_back(std::move(change));
+    }
+    ready_.wakeOne();
+    return true;
+}
+
+bool DeviceChangeQueue::take(QList<DeviceChange> &changes, quint64 &dropped) {
+    QMutexLocker locker(&mutex_);
+    while (changes_.empty() && pendingDrops_ == 0 && !closed_) {
+        ready_.wait(&mutex_);
+    }
+
+    changes.clear();
+    changes.reserve(static_cast<qsizetype>(changes_.size()));
+    for (auto &change : changes_) {
+        changes.append(std::move(change));
+    }
+    changes_.clear();
+    dropped = std::exchange(pendingDrops_, 0);
+    return !changes.isEmpty() || dropped > 0 || !closed_;
+}
+
+void DeviceChangeQueue::close() {
+    {
+        QMutexLocker locker(&mutex_);
+        closed_ = true;
+    }
+    ready_.wakeAll();
+}
+
+quint64 DeviceChangeQueue::droppedCount() const {
+    QMutexLocker locker(&mutex_);
+    return droppedCount_;
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QDateTime>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QWaitCondition>
+
+#include <deque>
+
+#include "deviceinfo.h"
+
+/**
+ * @brief A device event waiting to be written out.
+ */
+struct DeviceChange {
+    QString action;    ///< The event's action, e.g. @c add or @c unbind.
+    QDateTime time;    ///< When the event was received.
+    DeviceInfo device; ///< The device as the event describes it.
+};
+
+/**
+ * @brief Bounded queue handing device events from the thread receiving them to a writer thread.
+ *
+ * Pushing never blocks, so the receiving thread keeps draining the event source however slow the
+ * writer is. When the queue is full, new events are dropped and counted instead; the writer learns
+ * how many were lost after the events that preceded them, and can tell its reader to resynchronise.
+ */
+class DeviceChangeQueue {
+public:
+    /**
+     * @brief Creates an empty queue.
+     * @param capacity Maximum number of events waiting; at least 1.
+     */
+    explicit DeviceChangeQueue(qsizetype capacity);
+
+    /**
+     * @brief Returns the maximum number of events waiting.
+     * @returns The capacity.
+     */
+    qsizetype capacity() const;
+
+    /**
+     * @brief Adds an event without blocking.
+     * @param change The event.
+     * @returns @c false if the event was dropped because the queue is full or closed.
+     */
+    bool push(DeviceChange change);
+
+    /**
+     * @brief Waits for events and removes all of them.
+     * @param changes Receives the events, oldest first.
+     * @param dropped Receives the number of events dropped after them since the previous call.
+     * @returns @c false once the queue is closed and has nothing left to return.
+     */
+    bool take(QList<DeviceChange> &changes, quint64 &dropped);
+
+    /**
+     * @brief Closes the queue, waking a waiting @c take(). Events already queued are still
+     * returned.
+     */
+    void close();
+
+    /**
+     * @brief Returns the number of events dropped since the queue was created.
+     * @returns The count.
+     */
+    quint64 droppedCount() const;
+
+private:
+    mutable QMutex mutex_;
+    QWaitCondition ready_;
+    std::deque<DeviceChange> changes_;
+    qsizetype capacity_;
+    quint64 pendingDrops_ = 0; // Dropped since the last take()
+    quint64 droppedCount_ = 0;
+    bool closed_ = false;
+};
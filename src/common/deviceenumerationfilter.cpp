@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QHash>
+#include <QtCore/QRegularExpression>
+
+#include <algorithm>
+
+#include "deviceenumerationfilter.h"
+#include "deviceinfo.h"
+
+namespace {
+
+// Like fnmatch() without flags, which libudev matches subsystems and property values with
+QRegularExpression wildcard(const QString &pattern) {
+    return QRegularExpression::fromWildcard(
+        pattern, Qt::CaseSensitive, QRegularExpression::NonPathWildcardConversion);
+}
+
+bool anyMatches(const QList<QRegularExpression> &patterns, const QString &value) {
+    return std::ranges::any_of(
+        patterns, [&value](const auto &pattern) { return pattern.match(value).hasMatch(); });
+}
+
+} // namespace
+
+std::expected<DeviceEnumerationFilter, QString>
+DeviceEnumerationFilter::parse(const QStringList &subsystems,
+                               const QStringList &properties,
+                               const QString &parentSyspath,
+                               bool withDriver) {
+    DeviceEnumerationFilter filter;
+    filter.subsystems = subsystems;
+    filter.parentSyspath = parentSyspath;
+    filter.withDriver = withDriver;
+    for (const auto &property : properties) {
+        const auto separator = property.indexOf(QLatin1Char('='));
+        if (separator <= 0) {
+            return std::unexpected(
+                QStringLiteral("Invalid property match '%1'. Expected NAME=value.").arg(property));
+        }
+        filter.properties.emplaceBack(property.left(separator), property.mid(separator + 1));
+    }
+    return filter;
+}
+
+bool DeviceEnumerationFilter::isEmpty() const {
+    return subsystems.isEmpty() && properties.isEmpty() && parentSyspath.isEmpty() && !withDriver;
+}
+
+QList<DeviceInfo> filterDevices(QList<DeviceInfo> devices, const DeviceEnumerationFilter &filter) {
+    if (filter.isEmpty()) {
+        return devices;
+    }
+
+    QList<QRegularExpression> subsystems;
+    for (const auto &subsystem : filter.subsystems) {
+        subsystems << wildcard(subsystem);
+    }
+    QList<std::pair<QByteArray, QRegularExpression>> properties;
+    for (const auto &[name, value] : filter.properties) {
+        properties.emplaceBack(name.toLatin1(), wildcard(value));
+    }
+    QHash<QString, QString> parents;
+    if (!filter.parentSyspath.isEmpty()) {
+        parents.reserve(devices.size());
+        for (const auto &info : std::as_const(devices)) {
+            parents.insert(info.syspath(), info.parentSyspath());
+        }
+    }
+
+    const auto inSubtree = [&](QString syspath) {
+        // Bounded by the number of devices, so a cycle in broken data cannot hang the walk
+        for (qsizetype depth = 0; depth <= parents.size() && !syspath.isEmpty(); ++depth) {
+            if (syspath == filter.parentSyspath) {
+                return true;
+            }
+            syspath = parents.value(syspath);
+        }
+        return false;
+    };
+    const auto matches = [&](const DeviceInfo &info) {
+        if (!subsystems.isEmpty() && !anyMatches(subsystems, info.subsystem())) {
+            return false;
+        }
+        if (!properties.isEmpty() &&
+            std::ranges::none_of(properties, [&info](const auto &property) {
+                const auto value = info.propertyValue(property.first.constData());
+                return !value.isEmpty() && property.second.match(value).hasMatch();
+            })) {
+            return false;
+        }
+        if (filter.withDriver && info.driver().isEmpty()) {
+            return false;
+        }
+        return filter.parentSyspath.isEmpty() || inSubtree(info.syspath());
+    };
+    devices.removeIf([&](const DeviceInfo &info) { return !matches(info); });
+    return devices;
+}
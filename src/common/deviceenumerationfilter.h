@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <expected>
+#include <utility>
+
+class DeviceInfo;
+
+/**
+ * @brief Limits an enumeration to part of the device tree.
+ *
+ * The criteria are those libudev can apply while scanning, so the udev backend passes them down
+ * and never creates devices that do not match; other backends enumerate everything and apply
+ * @c filterDevices(). Subsystems and property values may be shell-style wildcards. A device must
+ * satisfy every kind of criterion given, but only one of the subsystems and one of the property
+ * matches, as libudev combines them.
+ */
+struct DeviceEnumerationFilter {
+    QStringList subsystems; ///< Subsystems a device may be in; empty for any.
+    /// Property names with the values a device may have; empty for any.
+    QList<std::pair<QString, QString>> properties;
+    QString parentSyspath;   ///< Only this device and its descendants, if set.
+    bool withDriver = false; ///< Only devices bound to a driver.
+
+    /**
+     * @brief Builds a filter from command line values.
+     * @param subsystems Subsystem names or wildcards.
+     * @param properties Property matches, each written as @c NAME=value.
+     * @param parentSyspath System path of the subtree to enumerate, or empty.
+     * @param withDriver Whether to only enumerate devices bound to a driver.
+     * @returns The filter, or a message naming the first invalid property match.
+     */
+    static std::expected<DeviceEnumerationFilter, QString> parse(const QStringList &subsystems,
+                                                                 const QStringList &properties,
+                                                                 const QString &parentSyspath,
+                                                                 bool withDriver);
+
+    /**
+     * @brief Checks whether the filter lets every device through.
+     * @returns @c true if no criterion is set.
+     */
+    bool isEmpty() const;
+};
+
+/**
+ * @brief Applies a filter to devices that were enumerated without it.
+ *
+ * The parent subtree is followed through @c DeviceInfo::parentSyspath(), so a device whose
+ * ancestors are missing from @p devices is outside every subtree but its own.
+ *
+ * @param devices All devices.
+ * @param filter The filter.
+ * @returns The matching devices in their original order.
+ */
+QList<DeviceInfo> filterDevices(QList<DeviceInfo> devices, const DeviceEnumerationFilter &filter);
@@ -0,0 +1,17 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QString>
+
+/**
+ * @brief A system log entry about a device.
+ *
+ * The cursor tells entries apart where their text does not: the kernel repeats messages such as
+ * link resets verbatim, sometimes within the same second.
+ */
+struct DeviceEvent {
+    QString line;   ///< Raw log line, as @c parseEventLine() takes it.
+    QString cursor; ///< Identifies the entry in its log (for kernel messages, the record's
+                    ///< sequence number); empty if the log has no such identifier.
+};
@@ -30,6 +30,10 @@ DeviceInfoPrivate::DeviceInfoPrivate(const DeviceInfoPrivate &other, DeviceInfo
 
 DeviceInfoPrivate::~DeviceInfoPrivate() = default; // LCOV_EXCL_LINE
 
+QJsonObject DeviceInfoPrivate::propertyValues() const {
+    return {};
+}
+
 // DeviceInfo implementation
 DeviceInfo::DeviceInfo(DeviceInfoPrivate *d) : d_ptr(d), isImported_(false) {
     if (d_ptr) {
@@ -203,6 +207,15 @@ const QJsonArray &DeviceInfo::resources() const {
     return emptyArray;
 }
 
+DeviceInfo DeviceInfo::detached() const {
+    Q_D(const DeviceInfo);
+    if (!d || isImported_) {
+        return *this;
+    }
+    // Still a live device; only where its data is held changes
+    return DeviceInfo(new ImportedDeviceInfoPrivate(*d, d->propertyValues()));
+}
+
 bool DeviceInfo::isImported() const {
     return isImported_;
 }
@@ -221,3 +234,43 @@ DeviceCategory DeviceInfo::category() const {
     Q_D(const DeviceInfo);
     return d ? d->category_ : DeviceCategory::Unknown;
 }
+
+QString deviceCategoryName(DeviceCategory category) {
+    switch (category) {
+    case DeviceCategory::AudioInputsAndOutputs:
+        return QStringLiteral("Audio inputs and outputs");
+    case DeviceCategory::Batteries:
+        return QStringLiteral("Batteries");
+    case DeviceCategory::Computer:
+        return QStringLiteral("Computer");
+    case DeviceCategory::DiskDrives:
+        return QStringLiteral("Disk drives");
+    case DeviceCategory::DisplayAdapters:
+        return QStringLiteral("Display adapters");
+    case DeviceCategory::DvdCdromDrives:
+        return QStringLiteral("DVD/CD-ROM drives");
+    case DeviceCategory::HumanInterfaceDevices:
+        return QStringLiteral("Human Interface Devices");
+    case DeviceCategory::Keyboards:
+        return QStringLiteral("Keyboards");
+    case DeviceCategory::MiceAndOtherPointingDevices:
+        return QStringLiteral("Mice and other pointing devices");
+    case DeviceCategory::NetworkAdapters:
+        return QStringLiteral("Network adapters");
+    case DeviceCategory::SoftwareDevices:
+        return QStringLiteral("Software devices");
+    case DeviceCategory::SoundVideoAndGameControllers:
+        return QStringLiteral("Sound, video and game controllers");
+    case DeviceCategory::StorageControllers:
+        return QStringLiteral("Storage controllers");
+    case DeviceCategory::StorageVolumes:
+        return QStringLiteral("Storage volumes");
+    case DeviceCategory::SystemDevices:
+        return QStringLiteral("System devices");
+    case DeviceCategory::UniversalSerialBusControllers:
+        return QStringLiteral("Universal Serial Bus controllers");
+    case DeviceCategory::Unknown:
+    default:
+        return QStringLiteral("Unknown");
+    }
+}
@@ -36,6 +36,13 @@ enum class DeviceCategory {
     UniversalSerialBusControllers, ///< USB host controllers.
 };
 
+/**
+ * @brief Returns the untranslated name of a device category, as written to export files.
+ * @param category The category.
+ * @returns The name, e.g. "Display adapters".
+ */
+QString deviceCategoryName(DeviceCategory category);
+
 /**
  * @brief Encapsulates information about a hardware device.
  *
@@ -90,6 +97,18 @@ public:
      */
     DeviceInfo &operator=(DeviceInfo &&other) noexcept;
 
+    /**
+     * @brief Returns a copy that holds all of the device's data itself.
+     *
+     * Live devices may read their properties through the platform's device handle, which must
+     * not be used from several threads (on Linux, @c libudev objects are not thread-safe). Call
+     * this on the thread the device came from before handing the device to another thread. The
+     * copy is still a live device: @c isImported() is unchanged.
+     *
+     * @returns The copy.
+     */
+    DeviceInfo detached() const;
+
     /**
      * @brief Returns the driver name for this device.
      * @returns The driver name, or empty string if no driver.
@@ -33,6 +33,16 @@ public:
      */
     virtual QString propertyValue(const char *key) const = 0;
 
+    /**
+     * @brief Get all property values.
+     *
+     * Backends that cache everything at construction return an empty object, as their
+     * @c propertyValue() has nothing to look up.
+     *
+     * @returns Property names mapped to their values.
+     */
+    virtual QJsonObject propertyValues() const;
+
     /**
      * @brief Clone this private implementation for a new public instance.
      * @param q The new public instance that will own the clone.
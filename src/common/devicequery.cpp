@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "devicequery.h"
+#include "deviceinfo.h"
+
+namespace {
+
+using FieldGetter = QJsonValue (*)(const DeviceInfo &info);
+
+struct FieldDefinition {
+    QLatin1StringView name;
+    FieldGetter value;
+};
+
+QJsonValue pciValue(const DeviceInfo &info) {
+    if (info.pciClass().isEmpty()) {
+        return {};
+    }
+    return QJsonObject{{QStringLiteral("class"), info.pciClass()},
+                       {QStringLiteral("subclass"), info.pciSubclass()},
+                       {QStringLiteral("interface"), info.pciInterface()}};
+}
+
+QJsonValue idsValue(const DeviceInfo &info) {
+    return QJsonObject{{QStringLiteral("cdrom"), info.idCdrom()},
+                       {QStringLiteral("devType"), info.devType()},
+                       {QStringLiteral("inputKeyboard"), info.idInputKeyboard()},
+                       {QStringLiteral("inputMouse"), info.idInputMouse()},
+                       {QStringLiteral("type"), info.idType()},
+                       {QStringLiteral("modelFromDatabase"), info.idModelFromDatabase()}};
+}
+
+// Same names and shapes as DeviceExport::serializeDevice(). The last three are only stored on
+// imported devices; live ones need a provider.
+const std::array kFields{
+    FieldDefinition{QLatin1StringView("syspath"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.syspath()); }},
+    FieldDefinition{QLatin1StringView("name"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.name()); }},
+    FieldDefinition{QLatin1StringView("driver"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.driver()); }},
+    FieldDefinition{QLatin1StringView("subsystem"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.subsystem()); }},
+    FieldDefinition{QLatin1StringView("devnode"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.devnode()); }},
+    FieldDefinition{QLatin1StringView("parentSyspath"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.parentSyspath()); }},
+    FieldDefinition{QLatin1StringView("devPath"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.devPath()); }},
+    FieldDefinition{QLatin1StringView("isHidden"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.isHidden()); }},
+    FieldDefinition{QLatin1StringView("isValidForDisplay"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.isValidForDisplay()); }},
+    FieldDefinition{QLatin1StringView("category"),
+                    [](const DeviceInfo &info) {
+                        return QJsonValue(static_cast<int>(info.category()));
+                    }},
+    FieldDefinition{QLatin1StringView("categoryName"),
+                    [](const DeviceInfo &info) {
+                        return QJsonValue(deviceCategoryName(info.category()));
+                    }},
+    FieldDefinition{QLatin1StringView("pci"), pciValue},
+    FieldDefinition{QLatin1StringView("ids"), idsValue},
+    FieldDefinition{QLatin1StringView("properties"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.properties()); }},
+    FieldDefinition{QLatin1StringView("driverInfo"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.driverInfo()); }},
+    FieldDefinition{QLatin1StringView("resources"),
+                    [](const DeviceInfo &info) { return QJsonValue(info.resources()); }},
+};
+
+qsizetype findField(QStringView name) {
+    for (std::size_t i = 0; i < kFields.size(); ++i) {
+        if (kFields[i].name == name) {
+            return static_cast<qsizetype>(i);
+        }
+    }
+    return -1;
+}
+
+// Position of the '=' or '~' ending the field name of a filter, or -1
+qsizetype operatorIndex(QStringView expression) {
+    for (qsizetype i = 0; i < expression.size(); ++i) {
+        if (expression[i] == u'=' || expression[i] == u'~') {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// The text filters compare against
+QString filterText(const QJsonValue &value) {
+    switch (value.type()) {
+    case QJsonValue::String:
+        return value.toString();
+    case QJsonValue::Bool:
+        return value.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    case QJsonValue::Double:
+        return QString::number(value.toDouble());
+    case QJsonValue::Array:
+        return QString::fromUtf8(QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact));
+    case QJsonValue::Object:
+        return QString::fromUtf8(QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact));
+    default:
+        return {};
+    }
+}
+
+} // namespace
+
+DeviceQuery::DeviceQuery() : providers_(kFields.size()) {
+}
+
+std::expected<DeviceQuery, QString> DeviceQuery::parse(const QStringList &filters,
+                                                       const QStringList &fields) {
+    const auto invalidFilter = [](const QString &expression) {
+        return QStringLiteral("Invalid filter '%1'. Expected field=value, field!=value or "
+                              "field~text.")
+            .arg(expression);
+    };
+    const auto unknownField = [](const QString &name) {
+        return QStringLiteral("Unknown field '%1'. Fields are: %2.")
+            .arg(name, fieldNames().join(QStringLiteral(", ")));
+    };
+
+    DeviceQuery query;
+    for (const auto &expression : filters) {
+        const auto opIndex = operatorIndex(expression);
+        if (opIndex < 0) {
+            return std::unexpected(invalidFilter(expression));
+        }
+        Filter filter;
+        auto nameLength = opIndex;
+        if (expression.at(opIndex) == QLatin1Char('~')) {
+            filter.op = Operator::Contains;
+        } else if (opIndex > 0 && expression.at(opIndex - 1) == QLatin1Char('!')) {
+            filter.op = Operator::NotEqual;
+            --nameLength;
+        }
+        const auto name = expression.left(nameLength);
+        auto path = resolve(name);
+        if (!path) {
+            return std::unexpected(name.isEmpty() ? invalidFilter(expression) : unknownField(name));
+        }
+        filter.path = std::move(*path);
+        filter.value = expression.mid(opIndex + 1);
+        query.filters_.append(std::move(filter));
+    }
+
+    for (const auto &name : fields.isEmpty() ? defaultFields() : fields) {
+        auto path = resolve(name);
+        if (!path) {
+            return std::unexpected(unknownField(name));
+        }
+        query.projection_.append(std::move(*path));
+    }
+    return query;
+}
+
+QStringList DeviceQuery::fieldNames() {
+    QStringList names;
+    names.reserve(static_cast<qsizetype>(kFields.size()));
+    for (const auto &field : kFields) {
+        names << field.name;
+    }
+    return names;
+}
+
+QStringList DeviceQuery::defaultFields() {
+    return {QStringLiteral("syspath"),
+            QStringLiteral("name"),
+            QStringLiteral("driver"),
+            QStringLiteral("subsystem"),
+            QStringLiteral("categoryName")};
+}
+
+bool DeviceQuery::setFieldProvider(const QString &name, FieldProvider provider) {
+    const auto field = findField(name);
+    if (field < 0) {
+        return false;
+    }
+    providers_[static_cast<std::size_t>(field)] = std::move(provider);
+    return true;
+}
+
+bool DeviceQuery::usesField(const QString &name) const {
+    const auto field = findField(name);
+    const auto names = [field](const FieldPath &path) { return path.field == field; };
+    return field >= 0 && (std::ranges::any_of(filters_, names, &Filter::path) ||
+                          std::ranges::any_of(projection_, names));
+}
+
+std::optional<QJsonObject> DeviceQuery::evaluate(const DeviceInfo &info) const {
+    std::array<std::optional<QJsonValue>, kFields.size()> computed;
+    const auto valueOf = [&](const FieldPath &path) {
+        const auto field = static_cast<std::size_t>(path.field);
+        auto &value = computed[field];
+        if (!value) {
+            value = providers_[field] ? providers_[field](info) : kFields[field].value(info);
+        }
+        auto result = *value;
+        for (const auto &key : path.keys) {
+            result = result.toObject().value(key);
+        }
+        return result;
+    };
+
+    for (const auto &filter : filters_) {
+        const auto text = filterText(valueOf(filter.path));
+        auto matched = false;
+        switch (filter.op) {
+        case Operator::Equal:
+            matched = text == filter.value;
+            break;
+        case Operator::NotEqual:
+            matched = text != filter.value;
+            break;
+        case Operator::Contains:
+            matched = text.contains(filter.value, Qt::CaseInsensitive);
+            break;
+        }
+        if (!matched) {
+            return std::nullopt;
+        }
+    }
+
+    QJsonObject result;
+    for (const auto &path : projection_) {
+        // A missing key is output as null; inserting an undefined value would drop the field
+        const auto value = valueOf(path);
+        result.insert(path.name, value.isUndefined() ? QJsonValue() : value);
+    }
+    return result;
+}
+
+std::optional<DeviceQuery::FieldPath> DeviceQuery::resolve(const QString &name) {
+    auto keys = name.split(QLatin1Char('.'));
+    const auto field = findField(keys.first());
+    if (field < 0 || keys.contains(QString())) {
+        return std::nullopt;
+    }
+    keys.removeFirst();
+    return FieldPath{name, field, std::move(keys)};
+}
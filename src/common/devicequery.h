@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QJsonValue>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <expected>
+#include <functional>
+#include <optional>
+#include <vector>
+
+class DeviceInfo;
+
+/**
+ * @brief Filters devices and projects them to JSON objects for scripted queries.
+ *
+ * Fields are named as in export files: @c syspath, @c name, @c driver, @c subsystem, @c devnode,
+ * @c parentSyspath, @c devPath, @c isHidden, @c isValidForDisplay, @c category, @c categoryName,
+ * @c pci, @c ids, @c properties, @c driverInfo and @c resources. A dotted name such as
+ * @c pci.class or @c properties.ID_VENDOR_ID reaches into an object field.
+ *
+ * A filter is written as @c field=value (equal), @c field!=value (not equal) or @c field~text
+ * (contains, ignoring case). Values are compared as text: a missing value is empty, so
+ * @c driver= selects devices without a driver, and Booleans are @c true or @c false.
+ *
+ * Each field is computed at most once per device and only if a filter or the projection names
+ * it. The filters run first and stop at the first one that fails, so fields only projected are
+ * never computed for devices that are filtered out. @c properties, @c driverInfo and
+ * @c resources are expensive for live devices and come from providers set with
+ * @c setFieldProvider(); without one they are read from the device, which only has them when it
+ * was imported.
+ */
+class DeviceQuery {
+public:
+    /**
+     * @brief Computes the value of a field for a device.
+     */
+    using FieldProvider = std::function<QJsonValue(const DeviceInfo &info)>;
+
+    /**
+     * @brief Parses filters and a projection.
+     * @param filters Filter expressions, all of which a device must satisfy.
+     * @param fields Names of the fields to output; empty for @c defaultFields().
+     * @returns The query, or a message naming the first invalid filter or field.
+     */
+    static std::expected<DeviceQuery, QString> parse(const QStringList &filters,
+                                                     const QStringList &fields);
+
+    /**
+     * @brief Returns the names of all top-level fields.
+     * @returns The names.
+     */
+    static QStringList fieldNames();
+
+    /**
+     * @brief Returns the fields output when none are requested.
+     * @returns The names.
+     */
+    static QStringList defaultFields();
+
+    /**
+     * @brief Sets how a field is computed.
+     * @param name A top-level field name.
+     * @param provider The function computing it.
+     * @returns @c false if there is no such field.
+     */
+    bool setFieldProvider(const QString &name, FieldProvider provider);
+
+    /**
+     * @brief Checks whether a top-level field is named by a filter or the projection.
+     * @param name The field name.
+     * @returns @c true if the field is computed for at least some devices.
+     */
+    bool usesField(const QString &name) const;
+
+    /**
+     * @brief Applies the filters to a device and projects it.
+     * @param info The device.
+     * @returns The requested fields keyed by their names as given, or @c std::nullopt if a filter
+     * rejects the device.
+     */
+    std::optional<QJsonObject> evaluate(const DeviceInfo &info) const;
+
+private:
+    enum class Operator { Equal, NotEqual, Contains };
+
+    // A field name resolved to its top-level field and the keys leading into it
+    struct FieldPath {
+        QString name;
+        qsizetype field = 0;
+        QStringList keys;
+    };
+
+    struct Filter {
+        FieldPath path;
+        Operator op = Operator::Equal;
+        QString value;
+    };
+
+    DeviceQuery();
+
+    static std::optional<FieldPath> resolve(const QString &name);
+
+    QList<Filter> filters_;
+    QList<FieldPath> projection_;
+    std::vector<FieldProvider> providers_; // One per top-level field, empty for the default
+};
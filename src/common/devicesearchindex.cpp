@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QStringList>
+
+#include <algorithm>
+#include <iterator>
+
+#include "const_strings_udev.h"
+#include "deviceinfo.h"
+#include "devicesearchindex.h"
+
+namespace {
+
+constexpr auto trigramLength = 3;
+
+quint64 trigramKey(const QChar *c) {
+    return (static_cast<quint64>(c[0].unicode()) << 32) |
+           (static_cast<quint64>(c[1].unicode()) << 16) | static_cast<quint64>(c[2].unicode());
+}
+
+QString searchText(const DeviceInfo &info, const QStringList &displayNames) {
+    namespace p = strings::udev::propertyNames;
+    QStringList fields{info.name(), info.driver(), info.syspath(), info.idModelFromDatabase()};
+    for (const auto *key : {p::MODALIAS,
+                            p::ID_VENDOR_FROM_DATABASE,
+                            p::ID_MODEL_FROM_DATABASE,
+                            p::ID_VENDOR_ID,
+                            p::ID_MODEL_ID,
+                            p::PCI_ID,
+                            p::PCI_SUBSYS_ID}) {
+        if (auto value = info.propertyValue(key); !value.isEmpty()) {
+            fields.append(value);
+        }
+    }
+    for (const auto &name : displayNames) {
+        if (!name.isEmpty() && !fields.contains(name)) {
+            fields.append(name);
+        }
+    }
+    // Newlines separate fields so that no trigram spans two of them
+    return fields.join(QLatin1Char('\n')).toLower();
+}
+
+QList<int> intersectSorted(const QList<int> &a, const QList<int> &b) {
+    QList<int> result;
+    std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
+
+} // namespace
+
+void DeviceSearchIndex::build(const QList<DeviceInfo> &devices,
+                              const QList<QStringList> &displayNames) {
+    clear();
+    texts_.reserve(devices.size());
+
+    for (auto i = 0; i < devices.size(); ++i) {
+        const auto &text = texts_.emplaceBack(searchText(devices.at(i), displayNames.value(i)));
+        const auto *data = text.constData();
+        for (qsizetype j = 0; j + trigramLength <= text.size(); ++j) {
+            const auto *c = data + j;
+            if (c[0] == QLatin1Char('\n') || c[1] == QLatin1Char('\n') ||
+                c[2] == QLatin1Char('\n')) {
+                continue;
+            }
+            // Devices are visited in order, so checking the tail keeps each list sorted and unique
+            auto &list = postings_[trigramKey(c)];
+            if (list.isEmpty() || list.last() != i) {
+                list.append(i);
+            }
+        }
+    }
+}
+
+void DeviceSearchIndex::clear() {
+    texts_.clear();
+    postings_.clear();
+}
+
+qsizetype DeviceSearchIndex::size() const {
+    return texts_.size();
+}
+
+QList<int> DeviceSearchIndex::match(const QString &query) const {
+    const auto terms = query.toLower().simplified().split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    QList<int> result;
+    for (auto i = 0; i < terms.size(); ++i) {
+        auto termMatches = matchTerm(terms.at(i));
+        result = i == 0 ? std::move(termMatches) : intersectSorted(result, termMatches);
+        if (result.isEmpty()) {
+            break;
+        }
+    }
+    return result;
+}
+
+QList<int> DeviceSearchIndex::matchTerm(const QString &term) const {
+    QList<int> result;
+    if (term.size() < trigramLength) {
+        // Too short for the index; the pre-lowered texts make a scan cheap
+        for (auto i = 0; i < texts_.size(); ++i) {
+            if (texts_.at(i).contains(term)) {
+                result.append(i);
+            }
+        }
+        return result;
+    }
+
+    QList<const QList<int> *> lists;
+    for (qsizetype j = 0; j + trigramLength <= term.size(); ++j) {
+        const auto it = postings_.constFind(trigramKey(term.constData() + j));
+        if (it == postings_.cend()) {
+            return result;
+        }
+        lists.append(&it.value());
+    }
+
+    // Start from the rarest trigram so the candidate set shrinks as fast as possible
+    std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b) {
+        return a->size() < b->size();
+    });
+    auto candidates = *lists.constFirst();
+    for (auto k = 1; k < lists.size() && !candidates.isEmpty(); ++k) {
+        candidates = intersectSorted(candidates, *lists.at(k));
+    }
+
+    // Trigrams only prove the pieces are present; confirm they are contiguous
+    for (auto idx : std::as_const(candidates)) {
+        if (texts_.at(idx).contains(term)) {
+            result.append(idx);
+        }
+    }
+    return result;
+}
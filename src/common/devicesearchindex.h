@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+class DeviceInfo;
+
+/**
+ * @brief Trigram index for free-text device search.
+ *
+ * The index is built once per device snapshot over each device's name, driver, syspath, modalias,
+ * vendor/model names and IDs, PCI IDs, and the names the views show for it. Queries are
+ * case-insensitive substring searches; every whitespace-separated term of a query must match one
+ * of the indexed fields.
+ *
+ * Terms of three or more characters are answered by intersecting the posting lists of their
+ * trigrams and then verifying the remaining candidates, so a query only touches the devices that
+ * can possibly match. Shorter terms fall back to scanning the pre-lowered search text.
+ */
+class DeviceSearchIndex {
+public:
+    /**
+     * @brief Rebuilds the index for a device list.
+     * @param devices The device snapshot. Indices returned by @c match() refer to this list.
+     * @param displayNames Names shown for each device, in the order of @p devices; may be empty.
+     */
+    void build(const QList<DeviceInfo> &devices, const QList<QStringList> &displayNames = {});
+
+    /**
+     * @brief Removes all entries from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of indexed devices.
+     * @returns The device count.
+     */
+    qsizetype size() const;
+
+    /**
+     * @brief Finds the devices matching a query.
+     * @param query Whitespace-separated search terms.
+     * @returns Indices of matching devices in ascending order. An empty or blank query matches
+     *          nothing.
+     */
+    QList<int> match(const QString &query) const;
+
+private:
+    QList<int> matchTerm(const QString &term) const;
+
+    QList<QString> texts_; // Lower-cased, newline-separated searchable fields per device
+    QHash<quint64, QList<int>> postings_;
+};
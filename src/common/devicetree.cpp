@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+#include "devicetree.h"
+#include "deviceinfo.h"
+
+void DeviceTree::build(const QList<DeviceInfo> &devices) {
+    clear();
+
+    const auto count = static_cast<int>(devices.size());
+    syspathIndex_.reserve(count);
+    parents_.fill(-1, count);
+    children_.resize(count);
+
+    for (auto i = 0; i < count; ++i) {
+        const auto &syspath = devices.at(i).syspath();
+        if (!syspath.isEmpty() && !syspathIndex_.contains(syspath)) {
+            syspathIndex_.insert(syspath, i);
+        }
+    }
+
+    // Resolve parents once the whole snapshot is indexed, so that a device listed before its
+    // parent is attached too and the children lists stay in snapshot order
+    for (auto i = 0; i < count; ++i) {
+        const auto &parentSyspath = devices.at(i).parentSyspath();
+        const auto parent = parentSyspath.isEmpty() ? -1 : indexOf(parentSyspath);
+        if (parent < 0 || parent == i) {
+            roots_.append(i);
+            continue;
+        }
+        parents_[i] = parent;
+        children_[parent].append(i);
+    }
+}
+
+void DeviceTree::clear() {
+    syspathIndex_.clear();
+    parents_.clear();
+    children_.clear();
+    roots_.clear();
+}
+
+qsizetype DeviceTree::size() const {
+    return parents_.size();
+}
+
+int DeviceTree::indexOf(const QString &syspath) const {
+    return syspathIndex_.value(syspath, -1);
+}
+
+int DeviceTree::parentOf(int index) const {
+    if (index < 0 || index >= parents_.size()) {
+        return -1;
+    }
+    return parents_.at(index);
+}
+
+const QList<int> &DeviceTree::childrenOf(int index) const {
+    static const QList<int> none;
+    if (index < 0 || index >= children_.size()) {
+        return none;
+    }
+    return children_.at(index);
+}
+
+const QList<int> &DeviceTree::roots() const {
+    return roots_;
+}
+
+QList<int> DeviceTree::ancestorsOf(int index) const {
+    QList<int> ancestors;
+    // Bounded by the tree size so malformed (cyclic) imported data cannot loop forever
+    for (auto parent = parentOf(index); parent >= 0 && ancestors.size() < parents_.size();
+         parent = parentOf(parent)) {
+        ancestors.append(parent);
+    }
+    return ancestors;
+}
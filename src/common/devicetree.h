@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+class DeviceInfo;
+
+/**
+ * @brief Index of the parent/child topology of a device list.
+ *
+ * The tree is built once per device snapshot from each device's @c parentSyspath() and refers to
+ * devices by their position in that snapshot; it is rebuilt with every new snapshot rather than
+ * updated in place. Once built, parent, ancestor and child lookups are plain integer lookups and
+ * do not require any syspath string manipulation.
+ *
+ * Devices whose parent is not part of the snapshot (or that have no parent) are roots.
+ */
+class DeviceTree {
+public:
+    /**
+     * @brief Rebuilds the index for a device list.
+     * @param devices The device snapshot. Indices used by this class refer to this list.
+     */
+    void build(const QList<DeviceInfo> &devices);
+
+    /**
+     * @brief Removes all entries from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of devices in the index.
+     * @returns The device count.
+     */
+    qsizetype size() const;
+
+    /**
+     * @brief Returns the index of the device with the given syspath.
+     * @param syspath The system path to look up.
+     * @returns The device index, or @c -1 if not found.
+     */
+    int indexOf(const QString &syspath) const;
+
+    /**
+     * @brief Returns the index of a device's parent.
+     * @param index The device index.
+     * @returns The parent index, or @c -1 if the device is a root or @p index is out of range.
+     */
+    int parentOf(int index) const;
+
+    /**
+     * @brief Returns the indices of a device's direct children.
+     * @param index The device index.
+     * @returns The child indices in snapshot order (empty if @p index is out of range).
+     */
+    const QList<int> &childrenOf(int index) const;
+
+    /**
+     * @brief Returns the indices of all devices without a parent in the snapshot.
+     * @returns The root indices in snapshot order.
+     */
+    const QList<int> &roots() const;
+
+    /**
+     * @brief Returns the ancestor chain of a device.
+     * @param index The device index.
+     * @returns Ancestor indices, nearest parent first.
+     */
+    QList<int> ancestorsOf(int index) const;
+
+private:
+    QHash<QString, int> syspathIndex_;
+    QList<int> parents_;
+    QList<QList<int>> children_;
+    QList<int> roots_;
+};
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <iterator>
+#include <string_view>
+
+#include "staticmatch.h"
+
+/**
+ * @brief Manufacturer names found in disk model strings.
+ *
+ * Order matters: the first pattern that occurs anywhere in the text wins, so a pattern that is
+ * part of a longer one (e.g. @c CT of @c Crucial_CT500) comes after it.
+ */
+namespace diskmanufacturers {
+
+/// Patterns searched for in model strings, case-insensitively.
+inline constexpr std::string_view kPatterns[] = {
+    "Samsung", "WDC", "Western Digital", "Seagate", "Toshiba", "HGST", "Hitachi", "Kingston",
+    "SanDisk", "Crucial", "CT", "Intel", "Micron", "SK hynix", "KIOXIA", "Phison", "Realtek",
+    "Sabrent", "ADATA", "PNY", "Corsair", "Transcend", "LiteOn", "LITE-ON", "Plextor", "OCZ",
+    "Patriot", "SPCC", "Silicon Power", "Team", "Lexar", "HP", "Dell", "Lenovo", "Apple", "Maxtor",
+    "Fujitsu",
+};
+
+/// Manufacturer shown for the pattern at the same index.
+inline constexpr const char *kNames[] = {
+    "Samsung", "Western Digital", "Western Digital", "Seagate", "Toshiba", "HGST", "Hitachi",
+    "Kingston", "SanDisk", "Crucial", "Crucial", "Intel", "Micron", "SK hynix", "KIOXIA", "Phison",
+    "Realtek", "Sabrent", "ADATA", "PNY", "Corsair", "Transcend", "Lite-On", "Lite-On", "Plextor",
+    "OCZ", "Patriot", "Silicon Power", "Silicon Power", "Team Group", "Lexar", "HP", "Dell",
+    "Lenovo", "Apple", "Maxtor", "Fujitsu",
+};
+static_assert(std::size(kNames) == std::size(kPatterns));
+
+/// Finds the index of the first of @c kPatterns that occurs in a model string.
+inline constexpr staticmatch::CaseInsensitiveMatcher<std::size(kPatterns),
+                                                     staticmatch::stateCount(kPatterns)>
+    kMatcher(kPatterns);
+
+} // namespace diskmanufacturers
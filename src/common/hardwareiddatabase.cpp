@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QStandardPaths>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "hardwareiddatabase.h"
+
+namespace {
+
+using Entry = HardwareIdDatabase::Entry;
+
+// Bump when the layout of CacheHeader or Entry changes
+constexpr quint32 kCacheVersion = 2;
+constexpr char kCacheMagic[4] = {'H', 'W', 'I', 'D'};
+
+struct CacheHeader {
+    char magic[4];
+    quint32 version;
+    qint64 sourceMtime;
+    qint64 sourceSize;
+    quint32 vendorCount;
+    quint32 reserved;
+};
+
+static_assert(sizeof(CacheHeader) % alignof(Entry) == 0);
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// Parses exactly four hex digits at the start of [begin, end)
+bool parseHex4(const char *begin, const char *end, quint16 &id) {
+    if (end - begin < 4) {
+        return false;
+    }
+    id = 0;
+    for (auto i = 0; i < 4; ++i) {
+        const auto value = hexValue(begin[i]);
+        if (value < 0) {
+            return false;
+        }
+        id = static_cast<quint16>((id << 4) | value);
+    }
+    return true;
+}
+
+bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Records the name found in [begin, end) after the ID, which must be followed by whitespace
+bool appendEntry(std::vector<Entry> &entries,
+                 quint16 id,
+                 const char *data,
+                 const char *begin,
+                 const char *end) {
+    if (begin >= end || !isBlank(*begin)) {
+        return false;
+    }
+    while (begin < end && isBlank(*begin)) {
+        ++begin;
+    }
+    while (end > begin && isBlank(end[-1])) {
+        --end;
+    }
+    if (begin == end) {
+        return false;
+    }
+    entries.push_back({id, static_cast<quint32>(begin - data), static_cast<quint32>(end - begin)});
+    return true;
+}
+
+bool idLess(const Entry &a, const Entry &b) {
+    return a.id < b.id;
+}
+
+} // namespace
+
+HardwareIdDatabase::~HardwareIdDatabase() {
+    close();
+}
+
+bool HardwareIdDatabase::open(const QString &path, const QString &cachePath) {
+    close();
+
+    source_.setFileName(path);
+    if (!source_.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    size_ = source_.size();
+    // Offsets are stored as 32 bits; the real databases are a few megabytes
+    if (size_ <= 0 || size_ > std::numeric_limits<quint32>::max()) {
+        close();
+        return false;
+    }
+    data_ = reinterpret_cast<const char *>(source_.map(0, size_));
+    if (!data_) {
+        close();
+        return false;
+    }
+    mtime_ = QFileInfo(source_).lastModified().toMSecsSinceEpoch();
+
+    if (cachePath.isEmpty() || !loadCache(cachePath)) {
+        buildIndex();
+        if (!cachePath.isEmpty() && !vendors_.empty()) {
+            saveCache(cachePath);
+        }
+    }
+
+    if (vendors_.empty()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool HardwareIdDatabase::openFirst(const QStringList &paths) {
+    const auto cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    for (const auto &path : paths) {
+        // Without a writable cache location (e.g. no home directory) the index stays in memory.
+        // The hash of the full path keeps same-named databases from replacing each other's cache.
+        const QFileInfo info(path);
+        const auto pathHash =
+            QCryptographicHash::hash(info.absoluteFilePath().toUtf8(), QCryptographicHash::Sha1)
+                .toHex()
+                .left(16);
+        const auto cachePath = cacheDir.isEmpty()
+                                   ? QString()
+                                   : cacheDir + QStringLiteral("/hwview/") + info.fileName() +
+                                         QLatin1Char('-') + QString::fromLatin1(pathHash) +
+                                         QStringLiteral(".idx");
+        if (open(path, cachePath)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void HardwareIdDatabase::close() {
+    vendors_ = {};
+    built_ = {};
+    fromCache_ = false;
+    data_ = nullptr;
+    size_ = 0;
+    mtime_ = 0;
+    // Closing a QFile also unmaps it
+    cache_.close();
+    source_.close();
+}
+
+bool HardwareIdDatabase::isOpen() const {
+    return data_ != nullptr;
+}
+
+bool HardwareIdDatabase::isFromCache() const {
+    return fromCache_;
+}
+
+qsizetype HardwareIdDatabase::vendorCount() const {
+    return static_cast<qsizetype>(vendors_.size());
+}
+
+QString HardwareIdDatabase::vendor(quint16 vendorId) const {
+    const auto it =
+        std::lower_bound(vendors_.begin(), vendors_.end(), Entry{vendorId, 0, 0}, idLess);
+    if (it == vendors_.end() || it->id != vendorId ||
+        static_cast<qint64>(it->offset) + it->length > size_) {
+        return {};
+    }
+    return QString::fromUtf8(data_ + it->offset, it->length);
+}
+
+bool HardwareIdDatabase::parseId(const QString &text, quint16 &id) {
+    auto view = QStringView(text).trimmed();
+    if (view.startsWith(QStringLiteral("0x"), Qt::CaseInsensitive)) {
+        view = view.mid(2);
+    }
+    if (view.isEmpty() || view.size() > 4) {
+        return false;
+    }
+    auto ok = false;
+    const auto value = view.toUShort(&ok, 16);
+    if (ok) {
+        id = value;
+    }
+    return ok;
+}
+
+bool HardwareIdDatabase::loadCache(const QString &cachePath) {
+    cache_.setFileName(cachePath);
+    if (!cache_.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const auto cacheSize = cache_.size();
+    if (cacheSize < static_cast<qint64>(sizeof(CacheHeader))) {
+        cache_.close();
+        return false;
+    }
+    const auto *mapped = cache_.map(0, cacheSize);
+    if (!mapped) {
+        cache_.close();
+        return false;
+    }
+
+    CacheHeader header;
+    std::memcpy(&header, mapped, sizeof(header));
+    const auto entryCount = static_cast<qint64>(header.vendorCount);
+    if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 ||
+        header.version != kCacheVersion || header.sourceMtime != mtime_ ||
+        header.sourceSize != size_ ||
+        cacheSize != static_cast<qint64>(sizeof(CacheHeader) + entryCount * sizeof(Entry))) {
+        cache_.close();
+        return false;
+    }
+
+    const auto *entries = reinterpret_cast<const Entry *>(mapped + sizeof(CacheHeader));
+    vendors_ = {entries, header.vendorCount};
+    fromCache_ = true;
+    return true;
+}
+
+void HardwareIdDatabase::buildIndex() {
+    const auto *end = data_ + size_;
+    for (const auto *line = data_; line < end;) {
+        const auto *lineEnd = static_cast<const char *>(std::memchr(line, '\n', end - line));
+        if (!lineEnd) {
+            lineEnd = end;
+        }
+        const auto *cursor = line;
+        line = lineEnd + 1;
+
+        // Comments, product lines and sections that are not about vendors are skipped
+        quint16 vendor = 0;
+        if (parseHex4(cursor, lineEnd, vendor)) {
+            appendEntry(built_, vendor, data_, cursor + 4, lineEnd);
+        }
+    }
+
+    // The file is kept sorted, but do not rely on it; a stable sort keeps the first of any
+    // duplicate IDs where the lookup will find it
+    std::stable_sort(built_.begin(), built_.end(), idLess);
+    vendors_ = built_;
+}
+
+void HardwareIdDatabase::saveCache(const QString &cachePath) const {
+    QDir().mkpath(QFileInfo(cachePath).absolutePath());
+    QSaveFile file(cachePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+
+    CacheHeader header{};
+    std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+    header.version = kCacheVersion;
+    header.sourceMtime = mtime_;
+    header.sourceSize = size_;
+    header.vendorCount = static_cast<quint32>(vendors_.size());
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(built_.data()),
+               static_cast<qint64>(built_.size() * sizeof(Entry)));
+    file.commit();
+}
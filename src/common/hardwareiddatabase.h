@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <span>
+#include <vector>
+
+/**
+ * @brief Read-only view of the vendors in a @c usb.ids database.
+ *
+ * The database file is memory-mapped and never copied: a sorted index of fixed-size entries points
+ * at the names inside the mapping, and a lookup is a binary search followed by decoding one line.
+ *
+ * Building the index means one pass over the file. To skip even that, the index can be saved to a
+ * cache file stamped with the database's modification time and size; as long as both still
+ * match, later opens map the cache as well and do no parsing at all.
+ *
+ * Only the top-level vendor lines are indexed:
+ * @code
+ * vvvv  Vendor name
+ * <TAB>pppp  Product name
+ * @endcode
+ * Product lines and sections that do not start with a hexadecimal vendor ID (device classes, HID
+ * usages, etc.) are skipped.
+ */
+class HardwareIdDatabase {
+public:
+    HardwareIdDatabase() = default;
+    ~HardwareIdDatabase();
+    HardwareIdDatabase(const HardwareIdDatabase &) = delete;
+    HardwareIdDatabase &operator=(const HardwareIdDatabase &) = delete;
+
+    /**
+     * @brief Opens a database file, replacing any open one.
+     * @param path Path to @c usb.ids.
+     * @param cachePath Where to load the index from or save it to. Empty to always build it in
+     *        memory.
+     * @returns @c true if the file could be mapped and contains at least one vendor.
+     */
+    bool open(const QString &path, const QString &cachePath = {});
+
+    /**
+     * @brief Opens the first database file of @p paths that can be opened.
+     *
+     * Each file's index is cached under the generic cache location, named after the file and a
+     * hash of its full path.
+     *
+     * @param paths Candidate paths in order of preference.
+     * @returns @c true if a database was opened.
+     */
+    bool openFirst(const QStringList &paths);
+
+    /**
+     * @brief Closes the database and unmaps all files.
+     */
+    void close();
+
+    /**
+     * @brief Returns whether a database is open.
+     * @returns @c true if lookups can succeed.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Returns whether the index of the open database was loaded from its cache file.
+     * @returns @c true if no parsing was needed.
+     */
+    bool isFromCache() const;
+
+    /**
+     * @brief Returns the number of vendors in the open database.
+     * @returns The vendor count.
+     */
+    qsizetype vendorCount() const;
+
+    /**
+     * @brief Looks up a vendor name.
+     * @param vendorId The vendor ID.
+     * @returns The name, or an empty string if unknown.
+     */
+    QString vendor(quint16 vendorId) const;
+
+    /**
+     * @brief Parses a 4-digit hexadecimal ID as found in udev properties and sysfs.
+     * @param text The ID, with or without a @c 0x prefix (e.g. @c 046d, @c 0x8086).
+     * @param id Receives the ID.
+     * @returns @c false if @p text is not a 16-bit hexadecimal number.
+     */
+    static bool parseId(const QString &text, quint16 &id);
+
+    /// One index entry: a vendor ID and where its name is in the database file.
+    struct Entry {
+        quint32 id;     ///< Vendor ID.
+        quint32 offset; ///< Byte offset of the name.
+        quint32 length; ///< Byte length of the name.
+    };
+
+private:
+    bool loadCache(const QString &cachePath);
+    void buildIndex();
+    void saveCache(const QString &cachePath) const;
+
+    QFile source_;
+    QFile cache_;
+    const char *data_ = nullptr;
+    qint64 size_ = 0;
+    qint64 mtime_ = 0;
+    bool fromCache_ = false;
+    std::vector<Entry> built_;
+    std::span<const Entry> vendors_;
+};
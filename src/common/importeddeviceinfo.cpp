@@ -37,6 +37,11 @@ ImportedDeviceInfoPrivate::ImportedDeviceInfoPrivate(const QJsonObject &json)
     resources_ = json[QStringLiteral("resources")].toArray();
 }
 
+ImportedDeviceInfoPrivate::ImportedDeviceInfoPrivate(const DeviceInfoPrivate &other,
+                                                     const QJsonObject &properties)
+    : DeviceInfoPrivate(other, nullptr), properties_(properties) {
+}
+
 ImportedDeviceInfoPrivate::ImportedDeviceInfoPrivate(const ImportedDeviceInfoPrivate &other,
                                                      DeviceInfo *q)
     : DeviceInfoPrivate(other, q), properties_(other.properties_), driverInfo_(other.driverInfo_),
@@ -47,6 +52,10 @@ QString ImportedDeviceInfoPrivate::propertyValue(const char *key) const {
     return properties_[QString::fromLatin1(key)].toString();
 }
 
+QJsonObject ImportedDeviceInfoPrivate::propertyValues() const {
+    return properties_;
+}
+
 DeviceInfoPrivate *ImportedDeviceInfoPrivate::clone(DeviceInfo *q) const {
     return new ImportedDeviceInfoPrivate(*this, q);
 }
@@ -16,9 +16,17 @@ public:
      */
     explicit ImportedDeviceInfoPrivate(const QJsonObject &json);
 
+    /**
+     * @brief Construct from another device's data.
+     * @param other The device whose fields are copied.
+     * @param properties The device's property values.
+     */
+    ImportedDeviceInfoPrivate(const DeviceInfoPrivate &other, const QJsonObject &properties);
+
     ~ImportedDeviceInfoPrivate() override = default;
 
     QString propertyValue(const char *key) const override;
+    QJsonObject propertyValues() const override;
     DeviceInfoPrivate *clone(DeviceInfo *q) const override;
     void dump() const override;
 
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: MIT
+#include "irqratesampler.h"
+
+void IrqRateSampler::addSample(const QList<IrqInfo> &irqs, qint64 timestampMs) {
+    if (timestampMs <= timestampMs_) {
+        return;
+    }
+
+    if (timestampMs_ >= 0) {
+        QHash<QString, const IrqInfo *> previous;
+        previous.reserve(latest_.size());
+        for (const auto &irq : std::as_const(latest_)) {
+            previous.insert(irq.irqNumber, &irq);
+        }
+
+        const auto seconds = static_cast<double>(timestampMs - timestampMs_) / 1000.0;
+        QHash<QString, IrqRate> rates;
+        rates.reserve(irqs.size());
+        for (const auto &irq : irqs) {
+            const auto *before = previous.value(irq.irqNumber, nullptr);
+            if (!before || before->cpuCounts.size() != irq.cpuCounts.size()) {
+                continue;
+            }
+            IrqRate rate;
+            rate.perCpu.reserve(irq.cpuCounts.size());
+            auto busiest = 0.0;
+            for (auto cpu = 0; cpu < irq.cpuCounts.size(); ++cpu) {
+                const auto now = irq.cpuCounts.at(cpu);
+                const auto then = before->cpuCounts.at(cpu);
+                const auto perSecond = now >= then ? static_cast<double>(now - then) / seconds : 0;
+                rate.perCpu.append(perSecond);
+                rate.total += perSecond;
+                if (perSecond > busiest) {
+                    busiest = perSecond;
+                    rate.busiestCpu = cpu;
+                }
+            }
+            rates.insert(irq.irqNumber, rate);
+        }
+        rates_ = std::move(rates);
+    }
+
+    latest_ = irqs;
+    timestampMs_ = timestampMs;
+}
+
+const QList<IrqInfo> &IrqRateSampler::latest() const {
+    return latest_;
+}
+
+bool IrqRateSampler::hasRates() const {
+    return !rates_.isEmpty();
+}
+
+IrqRate IrqRateSampler::rate(const QString &irqNumber) const {
+    return rates_.value(irqNumber);
+}
+
+void IrqRateSampler::clear() {
+    latest_.clear();
+    rates_.clear();
+    timestampMs_ = -1;
+}
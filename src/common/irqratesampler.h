@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "systeminfo.h"
+
+/**
+ * @brief Interrupt rate of one IRQ between two samples.
+ */
+struct IrqRate {
+    QList<double> perCpu; ///< Interrupts per second on each CPU, in CPU order.
+    double total = 0;     ///< Interrupts per second across all CPUs.
+    int busiestCpu = -1;  ///< CPU with the highest rate, or -1 if the IRQ did not fire.
+};
+
+/**
+ * @brief Derives per-CPU interrupt rates from successive IRQ snapshots.
+ *
+ * Each sample replaces the previous one; rates are the count differences between the two divided
+ * by the elapsed time. A counter that went backwards counts as zero for that interval; IRQs that
+ * are new or changed their CPU count since the previous sample report no rate until the next one.
+ */
+class IrqRateSampler {
+public:
+    /**
+     * @brief Records a snapshot and updates the rates.
+     * @param irqs The result of @c getSystemIrqs().
+     * @param timestampMs Monotonic time of the snapshot in milliseconds. Samples that are not
+     *                    newer than the previous one are ignored.
+     */
+    void addSample(const QList<IrqInfo> &irqs, qint64 timestampMs);
+
+    /**
+     * @brief Returns the most recent snapshot.
+     * @returns The IRQs passed to the last accepted @c addSample() call.
+     */
+    const QList<IrqInfo> &latest() const;
+
+    /**
+     * @brief Returns whether rates are available, i.e. at least two samples were taken.
+     * @returns @c true once rates can be reported.
+     */
+    bool hasRates() const;
+
+    /**
+     * @brief Returns the rate of an IRQ over the last sampling interval.
+     * @param irqNumber The IRQ number as reported in @c IrqInfo::irqNumber.
+     * @returns The rate, or an empty rate if it is unknown.
+     */
+    IrqRate rate(const QString &irqNumber) const;
+
+    /**
+     * @brief Discards all samples and rates.
+     */
+    void clear();
+
+private:
+    QList<IrqInfo> latest_;
+    QHash<QString, IrqRate> rates_;
+    qint64 timestampMs_ = -1;
+};
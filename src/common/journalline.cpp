@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+#include <iterator>
+
+#include "journalline.h"
+
+namespace {
+
+bool isDigitAt(QStringView text, qsizetype pos) {
+    return pos < text.size() && text[pos] >= u'0' && text[pos] <= u'9';
+}
+
+bool isCharAt(QStringView text, qsizetype pos, char16_t c) {
+    return pos < text.size() && text[pos] == c;
+}
+
+// Returns the length of the timestamp at the start of the line, or 0 if there is none
+qsizetype timestampLength(QStringView line) {
+    // YYYY-MM-DDTHH:MM:SS
+    static constexpr char16_t kPattern[] = u"0000-00-00T00:00:00";
+    constexpr qsizetype kPatternLength = std::size(kPattern) - 1;
+    for (qsizetype i = 0; i < kPatternLength; ++i) {
+        if (kPattern[i] == u'0' ? !isDigitAt(line, i) : !isCharAt(line, i, kPattern[i])) {
+            return 0;
+        }
+    }
+    // Offset: +HH:MM or +HHMM
+    auto pos = kPatternLength;
+    if (!isCharAt(line, pos, u'+') && !isCharAt(line, pos, u'-')) {
+        return 0;
+    }
+    if (!isDigitAt(line, pos + 1) || !isDigitAt(line, pos + 2)) {
+        return 0;
+    }
+    pos += 3;
+    if (isCharAt(line, pos, u':')) {
+        ++pos;
+    }
+    if (!isDigitAt(line, pos) || !isDigitAt(line, pos + 1)) {
+        return 0;
+    }
+    return pos + 2;
+}
+
+} // namespace
+
+bool splitJournalLine(QStringView line, QStringView &timestamp, QStringView &message) {
+    const auto length = timestampLength(line);
+    if (length == 0 || length >= line.size() || !line[length].isSpace()) {
+        return false;
+    }
+    timestamp = line.first(length);
+
+    auto remainder = line.sliced(length).trimmed();
+    if (const auto kernel = remainder.indexOf(u"kernel:"); kernel != -1) {
+        message = remainder.sliced(kernel + 7).trimmed();
+    } else if (const auto colon = remainder.indexOf(u": "); colon != -1) {
+        message = remainder.sliced(colon + 2).trimmed();
+    } else {
+        message = remainder;
+    }
+    return true;
+}
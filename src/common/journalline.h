@@ -0,0 +1,21 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QStringView>
+
+/**
+ * @brief Splits a line of <tt>journalctl -o short-iso</tt> output into timestamp and message.
+ *
+ * The line has the form <tt>YYYY-MM-DDTHH:MM:SS+ZZ:ZZ hostname identifier: message</tt>. The
+ * message is everything after the first @c kernel:, or else after the first <tt>": "</tt>, with
+ * surrounding whitespace removed. The line is checked by hand rather than with a regular
+ * expression, so splitting costs one pass over the timestamp and one search for the identifier.
+ *
+ * @param line The line.
+ * @param timestamp Receives the timestamp, including its UTC offset.
+ * @param message Receives the message.
+ * @returns @c false if the line does not start with a timestamp followed by whitespace; the
+ *          outputs are then unchanged.
+ */
+bool splitJournalLine(QStringView line, QStringView &timestamp, QStringView &message);
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+#include <algorithm>
+
+#include "kerneleventstore.h"
+#include "termmatcher.h"
+
+KernelEventStore::KernelEventStore(qsizetype capacity)
+    : capacity_(std::max<qsizetype>(capacity, 1)) {
+}
+
+void KernelEventStore::append(qint64 timestamp,
+                              const QString &message,
+                              const QStringList &syspaths,
+                              quint64 sequence) {
+    const auto id = nextId_++;
+    if (ring_.size() < static_cast<std::size_t>(capacity_)) {
+        ring_.push_back({id, timestamp, message, syspaths, sequence});
+    } else {
+        auto &slot = ring_[id % static_cast<quint64>(capacity_)];
+        // Ids in each index list ascend, so the evicted message is at the front of its lists
+        for (const auto &syspath : slot.syspaths) {
+            auto it = bySyspath_.find(syspath);
+            if (it == bySyspath_.end()) {
+                continue;
+            }
+            if (!it->empty() && it->front() == slot.id) {
+                it->pop_front();
+            }
+            if (it->empty()) {
+                bySyspath_.erase(it);
+            }
+        }
+        slot = {id, timestamp, message, syspaths, sequence};
+    }
+
+    for (const auto &syspath : syspaths) {
+        auto &ids = bySyspath_[syspath];
+        // A message naming the same device twice is listed once
+        if (ids.empty() || ids.back() != id) {
+            ids.push_back(id);
+        }
+    }
+}
+
+void KernelEventStore::clear() {
+    ring_.clear();
+    bySyspath_.clear();
+    nextId_ = 0;
+}
+
+qsizetype KernelEventStore::size() const {
+    return static_cast<qsizetype>(ring_.size());
+}
+
+qsizetype KernelEventStore::capacity() const {
+    return capacity_;
+}
+
+QList<KernelEventStore::Event> KernelEventStore::eventsForDevice(const QString &syspath,
+                                                                 qsizetype limit) const {
+    QList<Event> events;
+    const auto it = bySyspath_.constFind(syspath);
+    if (it == bySyspath_.cend() || limit <= 0) {
+        return events;
+    }
+    const auto &ids = it.value();
+    const auto count = std::min(static_cast<std::size_t>(limit), ids.size());
+    events.reserve(static_cast<qsizetype>(count));
+    for (auto id = ids.cend() - static_cast<std::ptrdiff_t>(count); id != ids.cend(); ++id) {
+        events.append(at(*id));
+    }
+    return events;
+}
+
+QList<KernelEventStore::Event> KernelEventStore::search(const QStringList &terms,
+                                                        qsizetype limit) const {
+    QList<Event> events;
+    if (terms.isEmpty() || limit <= 0) {
+        return events;
+    }
+    const TermMatcher matcher(terms);
+    // Newest first, so the scan can stop at the limit
+    for (auto id = nextId_; id > firstId() && events.size() < limit; --id) {
+        const auto &event = at(id - 1);
+        if (matcher.matches(event.message)) {
+            events.append(event);
+        }
+    }
+    std::reverse(events.begin(), events.end());
+    return events;
+}
+
+const KernelEventStore::Event &KernelEventStore::at(quint64 id) const {
+    return ring_[id % static_cast<quint64>(capacity_)];
+}
+
+quint64 KernelEventStore::firstId() const {
+    return nextId_ - ring_.size();
+}
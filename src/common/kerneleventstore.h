@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <deque>
+#include <vector>
+
+/**
+ * @brief Bounded store of kernel log messages indexed by the devices they concern.
+ *
+ * Messages are kept in a ring buffer; once it is full each new message replaces the oldest. An
+ * inverted index maps every device system path to the messages attributed to it, oldest first,
+ * so the events of one device are found without scanning the log. Attribution is done once, by
+ * whoever appends the message.
+ */
+class KernelEventStore {
+public:
+    /**
+     * @brief A stored message.
+     */
+    struct Event {
+        quint64 id = 0;       ///< Position in the order of appending, starting at 0.
+        qint64 timestamp = 0; ///< Milliseconds since the epoch.
+        QString message;      ///< Message text.
+        QStringList syspaths; ///< Devices the message is attributed to.
+        quint64 sequence = 0; ///< Sequence number of the kernel log record.
+    };
+
+    /**
+     * @brief Creates an empty store.
+     * @param capacity Maximum number of messages kept.
+     */
+    explicit KernelEventStore(qsizetype capacity = 4096);
+
+    /**
+     * @brief Adds a message, evicting the oldest one if the store is full.
+     * @param timestamp Milliseconds since the epoch.
+     * @param message Message text.
+     * @param syspaths Devices the message is attributed to; may be empty.
+     * @param sequence Sequence number of the kernel log record.
+     */
+    void append(qint64 timestamp,
+                const QString &message,
+                const QStringList &syspaths = {},
+                quint64 sequence = 0);
+
+    /**
+     * @brief Removes all messages.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of messages kept.
+     * @returns The size.
+     */
+    qsizetype size() const;
+
+    /**
+     * @brief Returns the maximum number of messages kept.
+     * @returns The capacity.
+     */
+    qsizetype capacity() const;
+
+    /**
+     * @brief Returns the most recent messages attributed to a device.
+     *
+     * The cost depends only on the number of messages returned.
+     *
+     * @param syspath The device's system path.
+     * @param limit Maximum number of messages.
+     * @returns Up to @p limit messages, oldest first.
+     */
+    QList<Event> eventsForDevice(const QString &syspath, qsizetype limit) const;
+
+    /**
+     * @brief Returns the most recent messages containing any of the given terms, ignoring case.
+     *
+     * For devices the kernel names only in free text. This scans the whole store.
+     *
+     * @param terms The terms to look for.
+     * @param limit Maximum number of messages.
+     * @returns Up to @p limit messages, oldest first.
+     */
+    QList<Event> search(const QStringList &terms, qsizetype limit) const;
+
+private:
+    const Event &at(quint64 id) const;
+    quint64 firstId() const;
+
+    std::vector<Event> ring_;
+    qsizetype capacity_;
+    quint64 nextId_ = 0;
+    QHash<QString, std::deque<quint64>> bySyspath_;
+};
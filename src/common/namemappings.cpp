@@ -7,7 +7,70 @@
 #include <QtCore/QLocale>
 #include <QtCore/QStandardPaths>
 
+#include <algorithm>
+#include <string_view>
+
 #include "namemappings.h"
+#ifdef HWVIEW_EMBEDDED_NAME_MAPPINGS
+#include "namemappingsbuiltin.h"
+#endif
+
+namespace {
+
+// Order matches the tables array in findBuiltin()
+enum class BuiltinTable {
+    GuidToCategory,
+    HidVendor,
+    HidBusType,
+    SoftwareDevice,
+    AcpiDevice,
+    VendorUrls,
+};
+
+QString findBuiltin(BuiltinTable table, const QString &key) {
+#ifdef HWVIEW_EMBEDDED_NAME_MAPPINGS
+    static const namemappingsbuiltin::Table *const tables[] = {
+        &namemappingsbuiltin::guidToCategory,
+        &namemappingsbuiltin::hidVendor,
+        &namemappingsbuiltin::hidBusType,
+        &namemappingsbuiltin::softwareDevice,
+        &namemappingsbuiltin::acpiDevice,
+        &namemappingsbuiltin::vendorUrls,
+    };
+    const auto &entries = *tables[static_cast<int>(table)];
+    const auto utf8 = key.toUtf8();
+    const std::string_view needle(utf8.constData(), static_cast<size_t>(utf8.size()));
+    const auto *end = entries.entries + entries.size;
+    const auto *it = std::lower_bound(
+        entries.entries, end, needle, [](const auto &entry, std::string_view value) {
+            return std::string_view(entry.key) < value;
+        });
+    if (it == end || std::string_view(it->key) != needle) {
+        return {};
+    }
+    return QString::fromUtf8(it->value);
+#else
+    Q_UNUSED(table)
+    Q_UNUSED(key)
+    return {};
+#endif
+}
+
+// JSON mappings override the compiled-in ones key by key
+template <typename Key>
+QString findMapping(const QHash<Key, QString> &loaded,
+                    const Key &key,
+                    bool builtin,
+                    BuiltinTable table,
+                    const QString &builtinKey) {
+    auto it = loaded.constFind(key);
+    if (it != loaded.cend()) {
+        return it.value();
+    }
+    return builtin ? findBuiltin(table, builtinKey) : QString();
+}
+
+} // namespace
 
 NameMappings &NameMappings::instance() {
     static NameMappings mappings;
@@ -18,7 +81,15 @@ NameMappings::NameMappings() {
     reload();
 }
 
+bool NameMappings::loadBuiltin() {
+#ifdef HWVIEW_EMBEDDED_NAME_MAPPINGS
+    builtin_ = true;
+#endif
+    return builtin_;
+}
+
 void NameMappings::clear() {
+    builtin_ = false;
     guidToCategory_.clear();
     hidVendor_.clear();
     hidBusType_.clear();
@@ -38,6 +109,7 @@ QString NameMappings::systemLocale() const {
 
 void NameMappings::reload() {
     clear();
+    loadBuiltin();
 
     // LCOV_EXCL_START - Platform-specific path resolution
     auto locale = systemLocale();
@@ -226,29 +298,33 @@ void NameMappings::loadFromFile(const QString &filePath) {
 QString NameMappings::categoryNameFromGuid(const QString &guidString) const {
     // Normalise to lowercase for lookup
     auto normalizedGuid = guidString.toLower();
-    return guidToCategory_.value(normalizedGuid, QStringLiteral("Other devices"));
+    auto category = findMapping(
+        guidToCategory_, normalizedGuid, builtin_, BuiltinTable::GuidToCategory, normalizedGuid);
+    return category.isEmpty() ? QStringLiteral("Other devices") : category;
 }
 
 QString NameMappings::hidVendorName(const QString &vendorId) const {
     // Normalise to lowercase for lookup
     auto normalizedId = vendorId.toLower();
-    return hidVendor_.value(normalizedId);
+    return findMapping(hidVendor_, normalizedId, builtin_, BuiltinTable::HidVendor, normalizedId);
 }
 
 QString NameMappings::hidBusTypeName(int busType) const {
-    return hidBusType_.value(busType);
+    return findMapping(
+        hidBusType_, busType, builtin_, BuiltinTable::HidBusType, QString::number(busType));
 }
 
 QString NameMappings::softwareDeviceDisplayName(const QString &deviceName) const {
-    return softwareDevice_.value(deviceName);
+    return findMapping(
+        softwareDevice_, deviceName, builtin_, BuiltinTable::SoftwareDevice, deviceName);
 }
 
 QString NameMappings::acpiDeviceDisplayName(const QString &pnpId) const {
     // Normalise to uppercase for lookup
     auto normalizedId = pnpId.toUpper();
-    return acpiDevice_.value(normalizedId);
+    return findMapping(acpiDevice_, normalizedId, builtin_, BuiltinTable::AcpiDevice, normalizedId);
 }
 
 QString NameMappings::vendorSupportUrl(const QString &vendorName) const {
-    return vendorUrls_.value(vendorName);
+    return findMapping(vendorUrls_, vendorName, builtin_, BuiltinTable::VendorUrls, vendorName);
 }
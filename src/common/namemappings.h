@@ -22,6 +22,11 @@
  * Locale-specific files only need to define the keys they want to override. Keys not present in
  * locale-specific files retain their values from the default file.
  *
+ * When built with @c HWVIEW_EMBED_NAME_MAPPINGS, the default files from the source tree are
+ * compiled into the binary as sorted tables and are not installed. They then sit below all of
+ * the locations above, which only need to hold overrides, and starting up parses no JSON unless
+ * such overrides exist.
+ *
  * System locations:
  * - Linux: @c /usr/share/hwview, @c /usr/local/share/hwview
  * - Windows: @c C:/ProgramData/hwview
@@ -97,12 +102,19 @@ public:
     /**
      * @brief Reloads all mappings from JSON files.
      *
-     * Clears existing mappings and reloads from system and user locations, respecting locale.
+     * Clears existing mappings, enables the compiled-in mappings if available and reloads from
+     * system and user locations, respecting locale.
      */
     void reload();
 
     /**
-     * @brief Clears all mappings.
+     * @brief Enables the mappings compiled into the binary as the lowest-priority layer.
+     * @returns @c true if the binary was built with @c HWVIEW_EMBED_NAME_MAPPINGS.
+     */
+    bool loadBuiltin();
+
+    /**
+     * @brief Clears all mappings, including the compiled-in ones until @c loadBuiltin().
      *
      * This is primarily useful for testing to reset state before loading test data.
      */
@@ -141,6 +153,7 @@ private:
     QHash<QString, QString> softwareDevice_;
     QHash<QString, QString> acpiDevice_;
     QHash<QString, QString> vendorUrls_;
+    bool builtin_ = false;
 
     static constexpr const char *kDefaultLocale = "en-US";
 };
@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <cstddef>
+
+/**
+ * @brief Default name mappings compiled into the binary.
+ *
+ * The definitions are generated at build time from @c data/name-mappings.json and
+ * @c data/vendors.json by @c cmake/EmbedNameMappings.cmake when @c HWVIEW_EMBED_NAME_MAPPINGS is
+ * enabled. Each table is sorted by key, with keys normalised as @c NameMappings normalises them.
+ * Strings are UTF-8.
+ */
+namespace namemappingsbuiltin {
+
+/**
+ * @brief One mapping.
+ */
+struct Entry {
+    const char *key;   ///< Normalised key.
+    const char *value; ///< Mapped name or URL.
+};
+
+/**
+ * @brief A sorted table of mappings.
+ */
+struct Table {
+    const Entry *entries; ///< Entries in ascending key order.
+    std::size_t size;     ///< Number of entries.
+};
+
+extern const Table guidToCategory; ///< @c guid-to-category, keys in lowercase.
+extern const Table hidVendor;      ///< @c hid-vendor, keys in lowercase.
+extern const Table hidBusType;     ///< @c hid-bus-type, keys as decimal integers.
+extern const Table softwareDevice; ///< @c software-device.
+extern const Table acpiDevice;     ///< @c acpi-device, keys in uppercase.
+extern const Table vendorUrls;     ///< @c vendors.json.
+
+} // namespace namemappingsbuiltin
@@ -0,0 +1,299 @@
+// SPDX-License-Identifier: MIT
+#include <algorithm>
+#include <charconv>
+
+#include "procparsers.h"
+
+namespace {
+
+constexpr bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+}
+
+constexpr bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool isHexDigit(char c) {
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+std::string_view trimmed(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+std::string_view nextLine(std::string_view &rest) {
+    const auto pos = rest.find('\n');
+    const auto line = rest.substr(0, pos);
+    rest = pos == std::string_view::npos ? std::string_view() : rest.substr(pos + 1);
+    return line;
+}
+
+/** Returns the run of characters matching @p pred starting at @p pos and advances past it. */
+template <typename Pred> std::string_view takeWhile(std::string_view line, size_t &pos, Pred pred) {
+    const auto begin = pos;
+    while (pos < line.size() && pred(line[pos])) {
+        ++pos;
+    }
+    return line.substr(begin, pos - begin);
+}
+
+bool isNumber(std::string_view token) {
+    return !token.empty() && std::all_of(token.cbegin(), token.cend(), isDigit);
+}
+
+constexpr bool isOctalDigit(char c) {
+    return c >= '0' && c <= '7';
+}
+
+template <typename T> bool parseUnsigned(std::string_view token, T &value) {
+    const auto end = token.data() + token.size();
+    const auto [ptr, ec] = std::from_chars(token.data(), end, value);
+    return ec == std::errc() && ptr == end;
+}
+
+} // namespace
+
+namespace procparsers {
+
+bool nextToken(std::string_view &text, std::string_view &token) {
+    size_t pos = 0;
+    takeWhile(text, pos, isSpace);
+    token = takeWhile(text, pos, [](char c) { return !isSpace(c); });
+    text.remove_prefix(pos);
+    return !token.empty();
+}
+
+bool isInterruptTypeToken(std::string_view token) {
+    for (auto marker : {"APIC", "PCI", "MSI", "DMAR", "edge", "level", "fasteoi"}) {
+        if (token.contains(marker)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string unescapeMountField(std::string_view field) {
+    std::string result;
+    result.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        if (field[i] == '\\' && i + 3 < field.size() && isOctalDigit(field[i + 1]) &&
+            isOctalDigit(field[i + 2]) && isOctalDigit(field[i + 3])) {
+            result += static_cast<char>(((field[i + 1] - '0') << 6) | ((field[i + 2] - '0') << 3) |
+                                        (field[i + 3] - '0'));
+            i += 3;
+        } else {
+            result += field[i];
+        }
+    }
+    return result;
+}
+
+bool parseKmsgRecord(std::string_view text, KmsgRecord &record) {
+    auto header = nextLine(text);
+    const auto semicolon = header.find(';');
+    if (semicolon == std::string_view::npos) {
+        return false;
+    }
+    record.message = header.substr(semicolon + 1);
+    header = header.substr(0, semicolon);
+
+    // Fields after the flags may be added by future kernels and are ignored
+    std::string_view fields[3];
+    for (auto &field : fields) {
+        const auto comma = header.find(',');
+        if (comma == std::string_view::npos) {
+            return false;
+        }
+        field = header.substr(0, comma);
+        header.remove_prefix(comma + 1);
+    }
+    unsigned int prefix = 0;
+    if (!parseUnsigned(fields[0], prefix) || !parseUnsigned(fields[1], record.sequence) ||
+        !parseUnsigned(fields[2], record.timestamp)) {
+        return false;
+    }
+    record.priority = prefix & 7;
+    record.facility = prefix >> 3;
+
+    record.subsystem = {};
+    record.device = {};
+    while (!text.empty()) {
+        const auto line = nextLine(text);
+        if (line.starts_with(" SUBSYSTEM=")) {
+            record.subsystem = line.substr(11);
+        } else if (line.starts_with(" DEVICE=")) {
+            record.device = line.substr(8);
+        }
+    }
+    return true;
+}
+
+std::string unescapeKmsgText(std::string_view text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\\' && i + 3 < text.size() && text[i + 1] == 'x' &&
+            isHexDigit(text[i + 2]) && isHexDigit(text[i + 3])) {
+            unsigned int value = 0;
+            std::from_chars(text.data() + i + 2, text.data() + i + 4, value, 16);
+            result += static_cast<char>(value);
+            i += 3;
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+ResourceRangeParser::ResourceRangeParser(std::string_view text) : rest_(text) {
+}
+
+bool ResourceRangeParser::next(ResourceRange &range) {
+    // Line format: <indent><start>-<end> : <name>
+    while (!rest_.empty()) {
+        const auto line = nextLine(rest_);
+        size_t pos = 0;
+        const auto indent = takeWhile(line, pos, isSpace);
+        const auto start = takeWhile(line, pos, isHexDigit);
+        if (start.empty() || pos >= line.size() || line[pos] != '-') {
+            continue;
+        }
+        ++pos;
+        const auto end = takeWhile(line, pos, isHexDigit);
+        takeWhile(line, pos, isSpace);
+        if (end.empty() || pos >= line.size() || line[pos] != ':') {
+            continue;
+        }
+        const auto name = trimmed(line.substr(pos + 1));
+        if (name.empty()) {
+            continue;
+        }
+        range = {start, end, name, static_cast<int>(indent.size())};
+        return true;
+    }
+    return false;
+}
+
+DmaParser::DmaParser(std::string_view text) : rest_(text) {
+}
+
+bool DmaParser::next(DmaChannel &channel) {
+    // Line format: <channel>: <name>
+    while (!rest_.empty()) {
+        const auto line = trimmed(nextLine(rest_));
+        size_t pos = 0;
+        const auto number = takeWhile(line, pos, isDigit);
+        if (number.empty() || pos >= line.size() || line[pos] != ':') {
+            continue;
+        }
+        channel = {number, trimmed(line.substr(pos + 1))};
+        return true;
+    }
+    return false;
+}
+
+InterruptsParser::InterruptsParser(std::string_view text) : rest_(text) {
+    std::string_view header;
+    while (!rest_.empty() && header.empty()) {
+        header = trimmed(nextLine(rest_));
+    }
+    std::string_view token;
+    while (nextToken(header, token)) {
+        ++cpuCount_;
+    }
+}
+
+int InterruptsParser::cpuCount() const {
+    return cpuCount_;
+}
+
+bool InterruptsParser::next(InterruptLine &line) {
+    // Line format: <irq>: <count per CPU>... <chip> <hwirq> <trigger> <actions>
+    while (!rest_.empty()) {
+        auto cursor = nextLine(rest_);
+        std::string_view irq;
+        if (!nextToken(cursor, irq)) {
+            continue;
+        }
+        if (irq.ends_with(':')) {
+            irq.remove_suffix(1);
+        }
+
+        // Summary lines such as ERR and MIS carry a single count, so stop at the first non-number
+        auto columns = 0;
+        const char *countsBegin = nullptr;
+        const char *countsEnd = nullptr;
+        while (cpuCount_ == 0 || columns < cpuCount_) {
+            auto peek = cursor;
+            std::string_view token;
+            if (!nextToken(peek, token) || !isNumber(token)) {
+                break;
+            }
+            if (columns++ == 0) {
+                countsBegin = token.data();
+            }
+            countsEnd = token.data() + token.size();
+            cursor = peek;
+        }
+
+        line.irq = irq;
+        line.counts = columns > 0 ? std::string_view(countsBegin, countsEnd - countsBegin)
+                                  : std::string_view();
+        line.description = trimmed(cursor);
+        line.countColumns = columns;
+        return true;
+    }
+    return false;
+}
+
+MountInfoParser::MountInfoParser(std::string_view text) : rest_(text) {
+}
+
+bool MountInfoParser::next(MountInfoEntry &entry) {
+    // Line format: <id> <parent> <major>:<minor> <root> <mount point> <options>
+    //              [<optional field>...] - <type> <source> <super options>
+    while (!rest_.empty()) {
+        auto cursor = nextLine(rest_);
+        std::string_view id;
+        std::string_view parent;
+        std::string_view device;
+        std::string_view root;
+        std::string_view mountPoint;
+        std::string_view options;
+        if (!nextToken(cursor, id) || !nextToken(cursor, parent) || !nextToken(cursor, device) ||
+            !nextToken(cursor, root) || !nextToken(cursor, mountPoint) ||
+            !nextToken(cursor, options)) {
+            continue;
+        }
+
+        const auto colon = device.find(':');
+        if (colon == std::string_view::npos ||
+            !parseUnsigned(device.substr(0, colon), entry.major) ||
+            !parseUnsigned(device.substr(colon + 1), entry.minor)) {
+            continue;
+        }
+
+        std::string_view token;
+        while (nextToken(cursor, token) && token != "-") {
+        }
+        std::string_view type;
+        std::string_view source;
+        if (token != "-" || !nextToken(cursor, type) || !nextToken(cursor, source)) {
+            continue;
+        }
+
+        entry.mountPoint = mountPoint;
+        entry.source = source;
+        return true;
+    }
+    return false;
+}
+
+} // namespace procparsers
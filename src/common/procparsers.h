@@ -0,0 +1,215 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Allocation-free parsers for the /proc resource and mount tables and the kernel log.
+ *
+ * Each parser walks a buffer holding the complete contents of one file and yields one record per
+ * line. Record fields are views into that buffer, so the buffer must outlive them. No memory is
+ * allocated while parsing; callers only pay for the strings they choose to keep.
+ */
+namespace procparsers {
+
+/**
+ * @brief One line of @c /proc/ioports or @c /proc/iomem.
+ */
+struct ResourceRange {
+    std::string_view start; ///< Starting address (hex digits, as written by the kernel).
+    std::string_view end;   ///< Ending address (hex digits, as written by the kernel).
+    std::string_view name;  ///< Region name, never empty.
+    int indentLevel = 0;    ///< Leading whitespace width; nested regions are indented.
+};
+
+/**
+ * @brief One line of @c /proc/dma.
+ */
+struct DmaChannel {
+    std::string_view channel; ///< Channel number (decimal digits).
+    std::string_view name;    ///< Owner name, possibly empty.
+};
+
+/**
+ * @brief One line of @c /proc/interrupts.
+ */
+struct InterruptLine {
+    std::string_view irq;         ///< IRQ number or name (e.g. @c 24, @c NMI) without the colon.
+    std::string_view counts;      ///< The per-CPU count columns, as one span.
+    std::string_view description; ///< Everything after the counts: chip, hwirq, trigger, actions.
+    int countColumns = 0;         ///< Number of count columns present on this line.
+};
+
+/**
+ * @brief One line of @c /proc/self/mountinfo.
+ */
+struct MountInfoEntry {
+    unsigned int major = 0;      ///< Major number of the device backing the filesystem.
+    unsigned int minor = 0;      ///< Minor number of the device backing the filesystem.
+    std::string_view mountPoint; ///< Mount point, still octal-escaped as written by the kernel.
+    std::string_view source;     ///< Mount source such as @c /dev/sda1, escaped likewise.
+};
+
+/**
+ * @brief One record read from @c /dev/kmsg.
+ */
+struct KmsgRecord {
+    unsigned int priority = 0;        ///< Syslog level, from 0 (emergency) to 7 (debug).
+    unsigned int facility = 0;        ///< Syslog facility; 0 for messages from the kernel itself.
+    unsigned long long sequence = 0;  ///< Sequence number; a gap means records were overwritten.
+    unsigned long long timestamp = 0; ///< Microseconds since boot.
+    std::string_view message;         ///< Message text, still escaped as written by the kernel.
+    std::string_view subsystem;       ///< Value of the @c SUBSYSTEM= continuation line, if any.
+    std::string_view device;          ///< Value of the @c DEVICE= continuation line, if any.
+};
+
+/**
+ * @brief Splits the next whitespace-separated token off the front of @p text.
+ * @param text Remaining text; advanced past the token.
+ * @param token Receives the token.
+ * @returns @c false when no token is left.
+ */
+bool nextToken(std::string_view &text, std::string_view &token);
+
+/**
+ * @brief Checks whether a @c /proc/interrupts description token names the IRQ type.
+ *
+ * Type tokens are the interrupt chip and trigger, e.g. @c IR-PCI-MSI, @c IO-APIC or
+ * @c 327680-edge.
+ *
+ * @param token A token from @c InterruptLine::description.
+ * @returns @c true for type tokens.
+ */
+bool isInterruptTypeToken(std::string_view token);
+
+/**
+ * @brief Decodes the octal escapes (e.g. @c \\040 for a space) of a mount table field.
+ * @param field A field of @c MountInfoEntry.
+ * @returns The field as it appears on the file system.
+ */
+std::string unescapeMountField(std::string_view field);
+
+/**
+ * @brief Parses one record returned by a @c read() of @c /dev/kmsg.
+ *
+ * A record is a header line, <tt>priority,sequence,timestamp,flags;message</tt>, followed by
+ * optional continuation lines of the form <tt> KEY=value</tt> naming the device that logged it.
+ *
+ * @param text The bytes returned by one @c read().
+ * @param record Receives the record.
+ * @returns @c false if the header is malformed.
+ */
+bool parseKmsgRecord(std::string_view text, KmsgRecord &record);
+
+/**
+ * @brief Decodes the @c \xHH escapes the kernel writes for non-printable bytes in a message.
+ * @param text @c KmsgRecord::message.
+ * @returns The message as it was logged.
+ */
+std::string unescapeKmsgText(std::string_view text);
+
+/**
+ * @brief Pull parser for @c /proc/ioports and @c /proc/iomem.
+ */
+class ResourceRangeParser {
+public:
+    /**
+     * @brief Creates a parser over the file contents.
+     * @param text The whole file.
+     */
+    explicit ResourceRangeParser(std::string_view text);
+
+    /**
+     * @brief Parses the next well-formed line, skipping malformed and unnamed ones.
+     * @param range Receives the record.
+     * @returns @c false at the end of the input.
+     */
+    bool next(ResourceRange &range);
+
+private:
+    std::string_view rest_;
+};
+
+/**
+ * @brief Pull parser for @c /proc/dma.
+ */
+class DmaParser {
+public:
+    /**
+     * @brief Creates a parser over the file contents.
+     * @param text The whole file.
+     */
+    explicit DmaParser(std::string_view text);
+
+    /**
+     * @brief Parses the next well-formed line, skipping malformed ones.
+     * @param channel Receives the record.
+     * @returns @c false at the end of the input.
+     */
+    bool next(DmaChannel &channel);
+
+private:
+    std::string_view rest_;
+};
+
+/**
+ * @brief Pull parser for @c /proc/interrupts.
+ *
+ * The header line names one column per online CPU. That column count bounds how many leading
+ * numbers of each line are treated as counts, so a numeric hwirq following the counts is never
+ * mistaken for one.
+ */
+class InterruptsParser {
+public:
+    /**
+     * @brief Creates a parser over the file contents and consumes the header line.
+     * @param text The whole file.
+     */
+    explicit InterruptsParser(std::string_view text);
+
+    /**
+     * @brief Returns the number of CPU columns named by the header.
+     * @returns The CPU count.
+     */
+    int cpuCount() const;
+
+    /**
+     * @brief Parses the next non-blank line.
+     * @param line Receives the record.
+     * @returns @c false at the end of the input.
+     */
+    bool next(InterruptLine &line);
+
+private:
+    std::string_view rest_;
+    int cpuCount_ = 0;
+};
+
+/**
+ * @brief Pull parser for @c /proc/self/mountinfo.
+ *
+ * Unlike @c /proc/mounts, each line carries the device number of the mounted filesystem, so a
+ * device node can be matched with a single @c stat() instead of resolving every mount source.
+ */
+class MountInfoParser {
+public:
+    /**
+     * @brief Creates a parser over the file contents.
+     * @param text The whole file.
+     */
+    explicit MountInfoParser(std::string_view text);
+
+    /**
+     * @brief Parses the next well-formed line, skipping malformed ones.
+     * @param entry Receives the record.
+     * @returns @c false at the end of the input.
+     */
+    bool next(MountInfoEntry &entry);
+
+private:
+    std::string_view rest_;
+};
+
+} // namespace procparsers
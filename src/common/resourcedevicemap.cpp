@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+#include "resourcedevicemap.h"
+#include "deviceinfo.h"
+
+namespace {
+
+// Length of a PCI address in domain:bus:slot.function form, e.g. 0000:03:00.0
+constexpr auto pciAddressLength = 12;
+
+bool isHexDigit(QChar c) {
+    return (c >= QLatin1Char('0') && c <= QLatin1Char('9')) ||
+           (c >= QLatin1Char('a') && c <= QLatin1Char('f')) ||
+           (c >= QLatin1Char('A') && c <= QLatin1Char('F'));
+}
+
+bool isPciAddressAt(const QString &text, qsizetype pos) {
+    if (text.size() - pos < pciAddressLength) {
+        return false;
+    }
+    for (auto i = 0; i < pciAddressLength; ++i) {
+        const auto c = text.at(pos + i);
+        switch (i) {
+        case 4:
+        case 7:
+            if (c != QLatin1Char(':')) {
+                return false;
+            }
+            break;
+        case 10:
+            if (c != QLatin1Char('.')) {
+                return false;
+            }
+            break;
+        default:
+            if (!isHexDigit(c)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void insertUnique(QHash<QString, int> &hash, const QString &key, int index) {
+    if (key.isEmpty()) {
+        return;
+    }
+    if (auto it = hash.find(key); it != hash.end()) {
+        it.value() = -1;
+    } else {
+        hash.insert(key, index);
+    }
+}
+
+// Strips a trailing queue suffix such as the "q3" of "nvme0q3"
+QString withoutQueueSuffix(const QString &token) {
+    auto end = token.size();
+    while (end > 0 && token.at(end - 1).isDigit()) {
+        --end;
+    }
+    if (end < token.size() && end > 1 && token.at(end - 1) == QLatin1Char('q')) {
+        return token.left(end - 1);
+    }
+    return QString();
+}
+
+} // namespace
+
+void ResourceDeviceMap::build(const QList<DeviceInfo> &devices) {
+    clear();
+    syspaths_.reserve(devices.size());
+    drivers_.reserve(devices.size());
+    bySyspath_.reserve(devices.size());
+
+    for (auto i = 0; i < devices.size(); ++i) {
+        const auto &device = devices.at(i);
+        const auto &syspath = device.syspath();
+        syspaths_.append(syspath);
+        drivers_.append(device.driver());
+        bySyspath_.insert(syspath, i);
+
+        const auto sysname = syspath.mid(syspath.lastIndexOf(QLatin1Char('/')) + 1);
+        if (device.subsystem() == QStringLiteral("pci") && isPciAddressAt(sysname, 0)) {
+            byPciAddress_.insert(sysname.toLower(), i);
+        }
+        insertUnique(bySysname_, sysname, i);
+        insertUnique(byDriver_, device.driver(), i);
+    }
+}
+
+void ResourceDeviceMap::clear() {
+    syspaths_.clear();
+    drivers_.clear();
+    bySyspath_.clear();
+    byPciAddress_.clear();
+    byDriver_.clear();
+    bySysname_.clear();
+}
+
+QString ResourceDeviceMap::deviceForRange(const QString &name,
+                                          const QString &parentSyspath) const {
+    if (!parentSyspath.isEmpty()) {
+        // e.g. an "nvme" BAR nested under the "0000:03:00.0" range of the NVMe controller
+        if (const auto parent = bySyspath_.value(parentSyspath, -1);
+            parent >= 0 && !name.isEmpty() && drivers_.at(parent) == name) {
+            return parentSyspath;
+        }
+    }
+    const auto index = resolve(name);
+    return index >= 0 ? syspaths_.at(index) : QString();
+}
+
+QString ResourceDeviceMap::deviceForIrq(const IrqInfo &irq) const {
+    auto index = resolvePciAddress(irq.irqType);
+    if (index < 0) {
+        index = resolve(irq.deviceName);
+    }
+    return index >= 0 ? syspaths_.at(index) : QString();
+}
+
+int ResourceDeviceMap::resolve(const QString &text) const {
+    if (const auto index = resolvePciAddress(text); index >= 0) {
+        return index;
+    }
+    // Shared IRQs list their devices separated by commas
+    qsizetype start = 0;
+    for (qsizetype pos = 0; pos <= text.size(); ++pos) {
+        if (pos < text.size() && text.at(pos) != QLatin1Char(',') && !text.at(pos).isSpace()) {
+            continue;
+        }
+        if (pos > start) {
+            if (const auto index = resolveToken(text.mid(start, pos - start)); index >= 0) {
+                return index;
+            }
+        }
+        start = pos + 1;
+    }
+    return -1;
+}
+
+int ResourceDeviceMap::resolveToken(const QString &token) const {
+    const QString candidates[] = {
+        token,
+        token.section(QLatin1Char('['), 0, 0),
+        token.section(QLatin1Char(':'), 0, 0),
+        token.section(QLatin1Char('-'), 0, 0),
+        withoutQueueSuffix(token),
+    };
+    for (const auto &candidate : candidates) {
+        if (candidate.isEmpty()) {
+            continue;
+        }
+        if (const auto index = bySysname_.value(candidate, -1); index >= 0) {
+            return index;
+        }
+        if (const auto index = byDriver_.value(candidate, -1); index >= 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+int ResourceDeviceMap::resolvePciAddress(const QString &text) const {
+    for (qsizetype pos = 0; pos + pciAddressLength <= text.size(); ++pos) {
+        if (isPciAddressAt(text, pos)) {
+            const auto address = text.mid(pos, pciAddressLength).toLower();
+            if (const auto index = byPciAddress_.value(address, -1); index >= 0) {
+                return index;
+            }
+            pos += pciAddressLength - 1;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "systeminfo.h"
+
+class DeviceInfo;
+
+/**
+ * @brief Joins the names in @c /proc resource tables to devices.
+ *
+ * Resource ranges and IRQs are labelled by the kernel with a PCI address (@c 0000:03:00.0), a
+ * driver (@c nvme, @c xhci_hcd) or a kernel device name (@c i8042, @c nvme0q1). The map is built
+ * once per device snapshot with hash indexes over PCI addresses, drivers and kernel names, so
+ * resolving a resource is a handful of hash lookups and joining a whole table stays linear in
+ * resources plus devices.
+ *
+ * Drivers and kernel names shared by several devices are ambiguous and never resolve; a range
+ * nested under a device's range may still resolve to that device through its driver.
+ */
+class ResourceDeviceMap {
+public:
+    /**
+     * @brief Rebuilds the map for a device list.
+     * @param devices The device snapshot.
+     */
+    void build(const QList<DeviceInfo> &devices);
+
+    /**
+     * @brief Removes all devices from the map.
+     */
+    void clear();
+
+    /**
+     * @brief Finds the device owning an I/O port or memory range.
+     * @param name The range name from @c /proc/ioports or @c /proc/iomem.
+     * @param parentSyspath System path of the device owning the enclosing range, if any. A range
+     *        named after that device's driver belongs to it.
+     * @returns The device's system path, or an empty string if no single device matches.
+     */
+    QString deviceForRange(const QString &name, const QString &parentSyspath = QString()) const;
+
+    /**
+     * @brief Finds the device raising an IRQ.
+     *
+     * A PCI address in the IRQ type (as in @c PCI-MSIX-0000:03:00.0) wins; otherwise each device
+     * name listed for the IRQ is tried in order, with queue and port suffixes such as @c q3,
+     * @c :usb1 or @c -rx-0 removed.
+     *
+     * @param irq The IRQ.
+     * @returns The device's system path, or an empty string if no single device matches.
+     */
+    QString deviceForIrq(const IrqInfo &irq) const;
+
+private:
+    int resolve(const QString &text) const;
+    int resolveToken(const QString &token) const;
+    int resolvePciAddress(const QString &text) const;
+
+    QList<QString> syspaths_;
+    QList<QString> drivers_;
+    QHash<QString, int> bySyspath_;
+    QHash<QString, int> byPciAddress_;
+    QHash<QString, int> byDriver_;  // -1 when several devices share the driver
+    QHash<QString, int> bySysname_; // -1 when several devices share the name
+};
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: MIT
+#include <algorithm>
+
+#include "resourceindex.h"
+
+namespace {
+
+template <typename T> QList<ResourceIndex::Range> toRanges(const QList<T> &entries) {
+    QList<ResourceIndex::Range> ranges;
+    ranges.reserve(entries.size());
+    for (const auto &entry : entries) {
+        auto startOk = false;
+        auto endOk = false;
+        ResourceIndex::Range range;
+        range.start = entry.rangeStart.toULongLong(&startOk, 16);
+        range.end = entry.rangeEnd.toULongLong(&endOk, 16);
+        range.name = entry.name;
+        range.depth = entry.indentLevel;
+        range.valid = startOk && endOk && range.start <= range.end;
+        ranges.append(range);
+    }
+    return ranges;
+}
+
+bool contains(const ResourceIndex::Range &outer, const ResourceIndex::Range &inner) {
+    return outer.start <= inner.start && inner.end <= outer.end;
+}
+
+} // namespace
+
+void ResourceIndex::build(const QList<Range> &ranges) {
+    clear();
+    ranges_ = ranges;
+
+    order_.reserve(ranges_.size());
+    for (auto i = 0; i < ranges_.size(); ++i) {
+        if (ranges_.at(i).valid) {
+            order_.append(i);
+            byName_[ranges_.at(i).name].append(i);
+        }
+    }
+    std::stable_sort(order_.begin(), order_.end(), [this](int a, int b) {
+        return ranges_.at(a).start < ranges_.at(b).start;
+    });
+    maxEnd_.resize(order_.size());
+    buildMaxEnd(0, order_.size());
+
+    // Without CAP_SYS_ADMIN the kernel reports every range as 0-0; they would all overlap
+    addressesHidden_ = !order_.isEmpty() && std::ranges::all_of(order_, [this](int i) {
+        return ranges_.at(i).start == 0 && ranges_.at(i).end == 0;
+    });
+    if (addressesHidden_) {
+        return;
+    }
+
+    for (auto i : std::as_const(order_)) {
+        const auto &range = ranges_.at(i);
+        for (auto j : overlapping(range.start, range.end)) {
+            const auto &other = ranges_.at(j);
+            // Nesting explains the overlap only if the inner range is also indented deeper
+            const auto nested = (contains(range, other) && range.depth < other.depth) ||
+                                (contains(other, range) && other.depth < range.depth);
+            if (j != i && !nested) {
+                conflicts_[i].append(j);
+            }
+        }
+    }
+}
+
+void ResourceIndex::build(const QList<IoPortInfo> &ports) {
+    build(toRanges(ports));
+}
+
+void ResourceIndex::build(const QList<MemoryRangeInfo> &ranges) {
+    build(toRanges(ranges));
+}
+
+void ResourceIndex::clear() {
+    ranges_.clear();
+    order_.clear();
+    maxEnd_.clear();
+    byName_.clear();
+    conflicts_.clear();
+    addressesHidden_ = false;
+}
+
+qsizetype ResourceIndex::size() const {
+    return ranges_.size();
+}
+
+const ResourceIndex::Range &ResourceIndex::at(int position) const {
+    return ranges_.at(position);
+}
+
+QList<int> ResourceIndex::overlapping(quint64 start, quint64 end) const {
+    QList<int> result;
+    if (start <= end) {
+        collectOverlapping(0, order_.size(), start, end, result);
+        std::sort(result.begin(), result.end());
+    }
+    return result;
+}
+
+QList<int> ResourceIndex::containing(quint64 start, quint64 end) const {
+    auto result = overlapping(start, end);
+    result.removeIf([this, start, end](int i) {
+        return ranges_.at(i).start > start || ranges_.at(i).end < end;
+    });
+    return result;
+}
+
+QList<int> ResourceIndex::rangesOf(const QString &name) const {
+    return byName_.value(name);
+}
+
+bool ResourceIndex::addressesHidden() const {
+    return addressesHidden_;
+}
+
+QList<int> ResourceIndex::conflictsWith(int position) const {
+    return conflicts_.value(position);
+}
+
+void ResourceIndex::collectOverlapping(qsizetype lo,
+                                       qsizetype hi,
+                                       quint64 start,
+                                       quint64 end,
+                                       QList<int> &result) const {
+    if (lo >= hi) {
+        return;
+    }
+    const auto mid = lo + (hi - lo) / 2;
+    // Nothing in this subtree reaches the query
+    if (maxEnd_.at(mid) < start) {
+        return;
+    }
+    collectOverlapping(lo, mid, start, end, result);
+    const auto &range = ranges_.at(order_.at(mid));
+    // Everything right of mid starts at or after it; once past the query, so is the right subtree
+    if (range.start > end) {
+        return;
+    }
+    if (range.end >= start) {
+        result.append(order_.at(mid));
+    }
+    collectOverlapping(mid + 1, hi, start, end, result);
+}
+
+quint64 ResourceIndex::buildMaxEnd(qsizetype lo, qsizetype hi) {
+    if (lo >= hi) {
+        return 0;
+    }
+    const auto mid = lo + (hi - lo) / 2;
+    maxEnd_[mid] = std::max({ranges_.at(order_.at(mid)).end,
+                             buildMaxEnd(lo, mid),
+                             buildMaxEnd(mid + 1, hi)});
+    return maxEnd_.at(mid);
+}
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include "systeminfo.h"
+
+/**
+ * @brief Interval index over the ranges of @c /proc/ioports or @c /proc/iomem.
+ *
+ * Ranges are parsed into 64-bit integers and kept in an interval tree: an array sorted by start
+ * address, viewed as an implicit balanced binary tree whose nodes also store the largest end
+ * address below them. Overlap and containment queries take O(log n + k) for k results; lookups
+ * by name are hash lookups.
+ *
+ * Ranges are identified by their position in the list passed to @c build(), so callers can map
+ * results back to the entries they display.
+ *
+ * A conflict is an overlap that the kernel's resource hierarchy does not explain: two ranges
+ * overlap, yet neither is nested inside the other at a deeper indentation level. Conflicts are not
+ * computed when the addresses are hidden (see @c addressesHidden()).
+ */
+class ResourceIndex {
+public:
+    /**
+     * @brief One indexed address range.
+     */
+    struct Range {
+        quint64 start = 0; ///< First address.
+        quint64 end = 0;   ///< Last address (inclusive).
+        QString name;      ///< Region or device name.
+        int depth = 0;     ///< Nesting level; nested ranges have a higher depth than their parent.
+        bool valid = true; ///< Whether the addresses could be parsed. Invalid ranges never match.
+    };
+
+    /**
+     * @brief Rebuilds the index for a list of ranges.
+     * @param ranges The ranges. Query results refer to positions in this list.
+     */
+    void build(const QList<Range> &ranges);
+
+    /**
+     * @brief Rebuilds the index for the result of @c getSystemIoPorts().
+     * @param ports The I/O port ranges.
+     */
+    void build(const QList<IoPortInfo> &ports);
+
+    /**
+     * @brief Rebuilds the index for the result of @c getSystemMemoryRanges().
+     * @param ranges The memory ranges.
+     */
+    void build(const QList<MemoryRangeInfo> &ranges);
+
+    /**
+     * @brief Removes all ranges from the index.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of ranges passed to @c build().
+     * @returns The range count.
+     */
+    qsizetype size() const;
+
+    /**
+     * @brief Returns a range.
+     * @param position Position of the range in the list passed to @c build().
+     * @returns The range.
+     */
+    const Range &at(int position) const;
+
+    /**
+     * @brief Finds the ranges overlapping an address range.
+     * @param start First address of the query.
+     * @param end Last address of the query (inclusive).
+     * @returns Positions of the overlapping ranges in ascending order.
+     */
+    QList<int> overlapping(quint64 start, quint64 end) const;
+
+    /**
+     * @brief Finds the ranges that fully contain an address range.
+     * @param start First address of the query.
+     * @param end Last address of the query (inclusive).
+     * @returns Positions of the containing ranges in ascending order.
+     */
+    QList<int> containing(quint64 start, quint64 end) const;
+
+    /**
+     * @brief Finds the ranges assigned to a device or region name.
+     * @param name The name as it appears in the file, e.g. @c 0000:03:00.0 or @c nvme.
+     * @returns Positions of the ranges in ascending order.
+     */
+    QList<int> rangesOf(const QString &name) const;
+
+    /**
+     * @brief Returns whether the file was read without the privilege to see addresses.
+     *
+     * Unprivileged readers get every range as @c 00000000-00000000. The names and nesting are
+     * still accurate, but address queries and conflicts are meaningless.
+     *
+     * @returns @c true if all valid ranges are zero, @c false otherwise or if there are none.
+     */
+    bool addressesHidden() const;
+
+    /**
+     * @brief Returns the ranges conflicting with a range.
+     * @param position Position of the range in the list passed to @c build().
+     * @returns Positions of the conflicting ranges in ascending order, empty if there are none.
+     */
+    QList<int> conflictsWith(int position) const;
+
+private:
+    void collectOverlapping(qsizetype lo,
+                            qsizetype hi,
+                            quint64 start,
+                            quint64 end,
+                            QList<int> &result) const;
+    quint64 buildMaxEnd(qsizetype lo, qsizetype hi);
+
+    QList<Range> ranges_;
+    QList<int> order_;      // Positions of valid ranges sorted by start address
+    QList<quint64> maxEnd_; // Largest end address in the subtree rooted at each slot
+    QHash<QString, QList<int>> byName_;
+    QHash<int, QList<int>> conflicts_;
+    bool addressesHidden_ = false;
+};
@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QStringView>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "ahocorasick.h"
+
+/**
+ * @brief String lookup structures built entirely at compile time.
+ *
+ * Hard-coded name tables are declared @c constexpr with these types, so they cost nothing at
+ * startup (no function-static @c QHash to populate on first use) and live in read-only data.
+ * Keys and patterns are ASCII; text to look up may be any UTF-16 string.
+ */
+namespace staticmatch {
+
+/**
+ * @brief One key and its value.
+ */
+template <typename T> struct Entry {
+    std::string_view key; ///< ASCII key.
+    T value;              ///< Value returned for the key.
+};
+
+namespace detail {
+
+constexpr char16_t foldCase(char16_t c) {
+    return c >= u'A' && c <= u'Z' ? static_cast<char16_t>(c - u'A' + u'a') : c;
+}
+
+template <typename Chars> constexpr std::uint32_t hash(std::uint32_t seed, const Chars &chars) {
+    // FNV-1a with the seed folded into the offset basis, and a final mix so the low bits used to
+    // pick a slot depend on every character
+    auto h = 2166136261u ^ (seed * 0x9e3779b9u);
+    for (const auto c : chars) {
+        h ^= static_cast<std::uint16_t>(c);
+        h *= 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+struct Utf16Range {
+    QStringView text;
+    constexpr const char16_t *begin() const {
+        return text.utf16();
+    }
+    constexpr const char16_t *end() const {
+        return text.utf16() + text.size();
+    }
+};
+
+constexpr bool equals(std::string_view key, QStringView text) {
+    if (key.size() != static_cast<std::size_t>(text.size())) {
+        return false;
+    }
+    const auto *units = text.utf16();
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        if (static_cast<char16_t>(key[i]) != units[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Immutable map with a perfect hash over its keys.
+ *
+ * The constructor, which only runs at compile time, searches for a hash seed under which every
+ * key lands in its own slot of a table four times the key count. A lookup then hashes the text
+ * once and compares it with at most one key. Matching is case-sensitive.
+ *
+ * Create instances with @c makePerfectHashMap() or @c makePerfectHashSet().
+ */
+template <typename T, std::size_t N> class PerfectHashMap {
+    static_assert(N > 0 && N < 0xffff, "Unsupported number of keys");
+
+public:
+    /// Number of hash slots.
+    static constexpr std::size_t kSlots = std::bit_ceil(N * 4);
+
+    /**
+     * @brief Builds the map. Fails to compile on duplicate keys.
+     * @param entries The keys and values.
+     */
+    consteval explicit PerfectHashMap(const Entry<T> (&entries)[N]) {
+        for (std::size_t i = 0; i < N; ++i) {
+            entries_[i] = entries[i];
+            for (std::size_t j = 0; j < i; ++j) {
+                if (entries[j].key == entries[i].key) {
+                    throw "Duplicate key";
+                }
+            }
+        }
+        for (seed_ = 1; seed_ < 100000; ++seed_) {
+            if (tryPlace()) {
+                return;
+            }
+        }
+        throw "No perfect hash seed found";
+    }
+
+    /**
+     * @brief Looks up a key.
+     * @param text The text to look up.
+     * @returns Pointer to the value, or @c nullptr if @p text is not a key.
+     */
+    constexpr const T *find(QStringView text) const {
+        const auto slot = slots_[detail::hash(seed_, detail::Utf16Range{text}) & (kSlots - 1)];
+        if (slot == 0 || !detail::equals(entries_[slot - 1].key, text)) {
+            return nullptr;
+        }
+        return &entries_[slot - 1].value;
+    }
+
+    /**
+     * @copydoc find(QStringView) const
+     */
+    constexpr const T *find(std::string_view text) const {
+        const auto slot = slots_[detail::hash(seed_, text) & (kSlots - 1)];
+        if (slot == 0 || entries_[slot - 1].key != text) {
+            return nullptr;
+        }
+        return &entries_[slot - 1].value;
+    }
+
+    /**
+     * @brief Checks whether a text is a key.
+     * @param text The text to look up.
+     * @returns @c true if @p text is a key.
+     */
+    constexpr bool contains(QStringView text) const {
+        return find(text) != nullptr;
+    }
+
+    /**
+     * @brief Returns the number of keys.
+     * @returns @c N.
+     */
+    static constexpr std::size_t size() {
+        return N;
+    }
+
+private:
+    consteval bool tryPlace() {
+        slots_ = {};
+        for (std::size_t i = 0; i < N; ++i) {
+            auto &slot = slots_[detail::hash(seed_, entries_[i].key) & (kSlots - 1)];
+            if (slot != 0) {
+                return false;
+            }
+            slot = static_cast<std::uint16_t>(i + 1);
+        }
+        return true;
+    }
+
+    std::array<Entry<T>, N> entries_{};
+    std::array<std::uint16_t, kSlots> slots_{}; // Entry index + 1; 0 for an empty slot
+    std::uint32_t seed_ = 0;
+};
+
+/**
+ * @brief Builds a @c PerfectHashMap, deducing its size.
+ * @param entries The keys and values.
+ * @returns The map.
+ */
+template <typename T, std::size_t N>
+consteval PerfectHashMap<T, N> makePerfectHashMap(const Entry<T> (&entries)[N]) {
+    return PerfectHashMap<T, N>(entries);
+}
+
+/**
+ * @brief Builds a @c PerfectHashMap used only for @c contains().
+ * @param keys The keys.
+ * @returns The map, with every value @c true.
+ */
+template <std::size_t N>
+consteval PerfectHashMap<bool, N> makePerfectHashSet(const std::string_view (&keys)[N]) {
+    Entry<bool> entries[N]{};
+    for (std::size_t i = 0; i < N; ++i) {
+        entries[i] = {keys[i], true};
+    }
+    return PerfectHashMap<bool, N>(entries);
+}
+
+/**
+ * @brief Returns the number of automaton states needed for a set of patterns.
+ * @param patterns The patterns.
+ * @returns One state per pattern character plus the root; an upper bound.
+ */
+template <std::size_t N> consteval std::size_t stateCount(const std::string_view (&patterns)[N]) {
+    std::size_t count = 1;
+    for (const auto pattern : patterns) {
+        count += pattern.size();
+    }
+    return count;
+}
+
+/**
+ * @brief Case-insensitive Aho-Corasick automaton finding which of several patterns occur in a
+ *        text.
+ *
+ * The automaton is compiled into a full transition table at compile time, so a search reads
+ * each character of the text once regardless of the number of patterns. Patterns are compared
+ * ignoring ASCII case; non-ASCII characters in the text never match.
+ *
+ * @tparam N Number of patterns.
+ * @tparam States State table size; use @c stateCount().
+ */
+template <std::size_t N, std::size_t States> class CaseInsensitiveMatcher {
+    static_assert(N > 0 && N < 0x7fff && States < 0xffff, "Unsupported pattern set");
+
+public:
+    /// Upper bound of distinct pattern characters, after case folding, plus one for all others.
+    static constexpr std::size_t kMaxClasses = 48;
+
+    /**
+     * @brief Builds the automaton. Fails to compile on empty or non-ASCII patterns.
+     * @param patterns The patterns, in order of priority.
+     */
+    consteval explicit CaseInsensitiveMatcher(const std::string_view (&patterns)[N]) {
+        std::size_t classes = 1;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (patterns[i].empty()) {
+                throw "Empty pattern";
+            }
+            for (const auto c : patterns[i]) {
+                if (static_cast<unsigned char>(c) >= 0x80) {
+                    throw "Non-ASCII pattern";
+                }
+                auto &cls = classOf_[detail::foldCase(static_cast<char16_t>(c))];
+                if (cls == 0) {
+                    if (classes == kMaxClasses) {
+                        throw "Too many distinct pattern characters";
+                    }
+                    cls = static_cast<std::uint8_t>(classes++);
+                }
+            }
+        }
+
+        for (auto &best : best_) {
+            best = -1;
+        }
+        const auto classOf = [this](char c) {
+            return classOf_[detail::foldCase(static_cast<char16_t>(c))];
+        };
+        std::size_t states = 1;
+        for (std::size_t i = 0; i < N; ++i) {
+            ahocorasick::insert(next_, best_, states, kMaxClasses, patterns[i], classOf, i);
+        }
+        std::array<std::uint16_t, States> fail{};
+        std::array<std::uint16_t, States> queue{};
+        ahocorasick::complete(next_, best_, kMaxClasses, fail, queue);
+    }
+
+    /**
+     * @brief Finds the first-listed pattern occurring anywhere in a text.
+     * @param text The text to search.
+     * @returns The pattern's index, or -1 if none occurs.
+     */
+    constexpr int firstMatch(QStringView text) const {
+        return search(detail::Utf16Range{text});
+    }
+
+    /**
+     * @copydoc firstMatch(QStringView) const
+     */
+    constexpr int firstMatch(std::string_view text) const {
+        return search(text);
+    }
+
+private:
+    template <typename Chars> constexpr int search(const Chars &chars) const {
+        std::size_t state = 0;
+        int result = -1;
+        for (const auto c : chars) {
+            const auto unit = static_cast<char16_t>(static_cast<std::uint16_t>(c));
+            const auto cls = unit < 0x80 ? classOf_[detail::foldCase(unit)] : 0;
+            state = next_[state * kMaxClasses + cls];
+            const auto best = best_[state];
+            if (best >= 0 && (result < 0 || best < result)) {
+                result = best;
+                if (result == 0) {
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    std::array<std::uint8_t, 0x80> classOf_{};
+    std::array<std::uint16_t, States * kMaxClasses> next_{}; // State * kMaxClasses + class
+    std::array<std::int16_t, States> best_{}; // Lowest pattern index ending in the state, or -1
+};
+
+} // namespace staticmatch
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonArray>
+
+#include <charconv>
+
+#include "deviceinfo.h"
+#include "procparsers.h"
+#include "systemresources.h"
+
+namespace {
+
+QString fromView(std::string_view view) {
+    return QString::fromUtf8(view.data(), static_cast<qsizetype>(view.size()));
+}
+
+void appendToken(QString &target, std::string_view token) {
+    if (!target.isEmpty()) {
+        target += QLatin1Char(' ');
+    }
+    target += fromView(token);
+}
+
+template <typename T> QList<T> parseRanges(std::string_view text) {
+    QList<T> ranges;
+    procparsers::ResourceRangeParser parser(text);
+    procparsers::ResourceRange range;
+    while (parser.next(range)) {
+        T info;
+        info.indentLevel = range.indentLevel;
+        info.rangeStart = fromView(range.start).toUpper();
+        info.rangeEnd = fromView(range.end).toUpper();
+        info.name = fromView(range.name);
+        ranges.append(info);
+    }
+    return ranges;
+}
+
+template <typename T>
+QList<T> parseRaw(const QHash<QString, QString> &raw,
+                  const QString &key,
+                  QList<T> (*parse)(std::string_view)) {
+    const auto utf8 = raw.value(key).toUtf8();
+    return parse(std::string_view(utf8.constData(), static_cast<size_t>(utf8.size())));
+}
+
+} // namespace
+
+SystemResources SystemResources::fromRaw(const QHash<QString, QString> &raw) {
+    SystemResources resources;
+    resources.raw = raw;
+    resources.dmaChannels = parseRaw(raw, QStringLiteral("dma"), parseSystemDmaChannels);
+    resources.ioPorts = parseRaw(raw, QStringLiteral("ioports"), parseSystemIoPorts);
+    resources.irqs = parseRaw(raw, QStringLiteral("interrupts"), parseSystemIrqs);
+    resources.memoryRanges = parseRaw(raw, QStringLiteral("iomem"), parseSystemMemoryRanges);
+    return resources;
+}
+
+SystemResources SystemResources::fromExport(const QJsonObject &systemResources,
+                                            const QList<DeviceInfo> &devices) {
+    QHash<QString, QString> raw;
+    for (auto it = systemResources.begin(); it != systemResources.end(); ++it) {
+        raw.insert(it.key(), it.value().toString());
+    }
+    auto resources = fromRaw(raw);
+
+    for (const auto &device : devices) {
+        const auto &array = device.resources();
+        if (array.isEmpty()) {
+            continue;
+        }
+        QList<ExportResourceInfo> list;
+        list.reserve(array.size());
+        for (const auto value : array) {
+            const auto object = value.toObject();
+            ExportResourceInfo info;
+            info.type = object[QStringLiteral("type")].toString();
+            info.displayValue = object[QStringLiteral("displayValue")].toString();
+            info.start = object[QStringLiteral("start")].toString();
+            info.end = object[QStringLiteral("end")].toString();
+            info.flags = object[QStringLiteral("flags")].toString();
+            info.value = object[QStringLiteral("value")].toInt();
+            list.append(info);
+        }
+        resources.deviceResources.insert(device.syspath(), list);
+    }
+    return resources;
+}
+
+QList<DmaChannelInfo> parseSystemDmaChannels(std::string_view text) {
+    QList<DmaChannelInfo> channels;
+    procparsers::DmaParser parser(text);
+    procparsers::DmaChannel channel;
+    while (parser.next(channel)) {
+        channels.append({fromView(channel.channel), fromView(channel.name)});
+    }
+    return channels;
+}
+
+QList<IoPortInfo> parseSystemIoPorts(std::string_view text) {
+    return parseRanges<IoPortInfo>(text);
+}
+
+QList<IrqInfo> parseSystemIrqs(std::string_view text) {
+    QList<IrqInfo> irqs;
+    procparsers::InterruptsParser parser(text);
+    procparsers::InterruptLine line;
+    while (parser.next(line)) {
+        QString deviceName;
+        QString irqType;
+
+        auto rest = line.description;
+        std::string_view token;
+        // Without count columns the description starts at the first column, which never names
+        // the device
+        for (auto first = line.countColumns == 0; procparsers::nextToken(rest, token);
+             first = false) {
+            if (procparsers::isInterruptTypeToken(token)) {
+                appendToken(irqType, token);
+            } else if (!first && (token.front() < '0' || token.front() > '9')) {
+                appendToken(deviceName, token);
+            }
+        }
+
+        if (deviceName.isEmpty()) {
+            continue;
+        }
+
+        IrqInfo info{fromView(line.irq), irqType, deviceName, {}, {}};
+        info.cpuCounts.reserve(line.countColumns);
+        auto counts = line.counts;
+        while (procparsers::nextToken(counts, token)) {
+            quint64 count = 0;
+            std::from_chars(token.data(), token.data() + token.size(), count);
+            info.cpuCounts.append(count);
+        }
+        irqs.append(info);
+    }
+    return irqs;
+}
+
+QList<MemoryRangeInfo> parseSystemMemoryRanges(std::string_view text) {
+    return parseRanges<MemoryRangeInfo>(text);
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+#include <string_view>
+
+#include "systeminfo.h"
+
+class DeviceInfo;
+
+/**
+ * @brief Snapshot of the system-wide and per-device resource tables.
+ *
+ * A snapshot is taken once per device refresh (see @c getSystemResources()) and serves the
+ * resource views, the Properties dialog's Resources tab and the export without reading the
+ * underlying files again. The raw tables are kept alongside the parsed ones because the export
+ * stores them verbatim; a snapshot loaded from an export is rebuilt from them with
+ * @c fromExport().
+ */
+struct SystemResources {
+    /// Raw @c /proc/dma, @c /proc/ioports, @c /proc/interrupts and @c /proc/iomem, keyed
+    /// @c dma, @c ioports, @c interrupts and @c iomem as in the export format.
+    QHash<QString, QString> raw;
+    QList<DmaChannelInfo> dmaChannels;   ///< Parsed @c dma table.
+    QList<IoPortInfo> ioPorts;           ///< Parsed @c ioports table.
+    QList<IrqInfo> irqs;                 ///< Parsed @c interrupts table.
+    QList<MemoryRangeInfo> memoryRanges; ///< Parsed @c iomem table.
+    /// IRQ and address ranges of each device that has any, keyed by syspath.
+    QHash<QString, QList<ExportResourceInfo>> deviceResources;
+
+    /**
+     * @brief Builds a snapshot from raw resource tables.
+     * @param raw Tables keyed as in @c raw. Missing tables leave their parsed list empty.
+     * @returns The snapshot, without per-device resources.
+     */
+    static SystemResources fromRaw(const QHash<QString, QString> &raw);
+
+    /**
+     * @brief Builds a snapshot from the data of an export file.
+     * @param systemResources The export's @c systemResources object.
+     * @param devices The imported devices, whose @c resources() fill @c deviceResources.
+     * @returns The snapshot.
+     */
+    static SystemResources fromExport(const QJsonObject &systemResources,
+                                      const QList<DeviceInfo> &devices);
+};
+
+/**
+ * @brief Parses the contents of @c /proc/dma.
+ * @param text The file contents.
+ * @returns The DMA channels.
+ */
+QList<DmaChannelInfo> parseSystemDmaChannels(std::string_view text);
+
+/**
+ * @brief Parses the contents of @c /proc/ioports.
+ * @param text The file contents.
+ * @returns The I/O port ranges.
+ */
+QList<IoPortInfo> parseSystemIoPorts(std::string_view text);
+
+/**
+ * @brief Parses the contents of @c /proc/interrupts.
+ * @param text The file contents.
+ * @returns The IRQs with their per-CPU counts. Affinity is not part of the file and stays empty.
+ */
+QList<IrqInfo> parseSystemIrqs(std::string_view text);
+
+/**
+ * @brief Parses the contents of @c /proc/iomem.
+ * @param text The file contents.
+ * @returns The memory ranges.
+ */
+QList<MemoryRangeInfo> parseSystemMemoryRanges(std::string_view text);
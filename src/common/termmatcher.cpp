@@ -0,0 +1,152 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QByteArray>
+
+#include <type_traits>
+
+#include "ahocorasick.h"
+#include "termmatcher.h"
+
+namespace {
+
+constexpr unsigned char foldCase(unsigned char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+
+// Encodes one code point as UTF-8 and returns the number of bytes written
+int encodeUtf8(char32_t codePoint, unsigned char (&bytes)[4]) {
+    if (codePoint < 0x800) {
+        bytes[0] = static_cast<unsigned char>(0xc0 | (codePoint >> 6));
+        bytes[1] = static_cast<unsigned char>(0x80 | (codePoint & 0x3f));
+        return 2;
+    }
+    if (codePoint < 0x10000) {
+        bytes[0] = static_cast<unsigned char>(0xe0 | (codePoint >> 12));
+        bytes[1] = static_cast<unsigned char>(0x80 | ((codePoint >> 6) & 0x3f));
+        bytes[2] = static_cast<unsigned char>(0x80 | (codePoint & 0x3f));
+        return 3;
+    }
+    bytes[0] = static_cast<unsigned char>(0xf0 | (codePoint >> 18));
+    bytes[1] = static_cast<unsigned char>(0x80 | ((codePoint >> 12) & 0x3f));
+    bytes[2] = static_cast<unsigned char>(0x80 | ((codePoint >> 6) & 0x3f));
+    bytes[3] = static_cast<unsigned char>(0x80 | (codePoint & 0x3f));
+    return 4;
+}
+
+} // namespace
+
+TermMatcher::TermMatcher() : next_(1, 0), best_(1, -1) {
+}
+
+TermMatcher::TermMatcher(const QStringList &terms) : termCount_(terms.size()) {
+    QList<QByteArray> encoded;
+    encoded.reserve(terms.size());
+    for (const auto &term : terms) {
+        encoded.append(term.toUtf8());
+        for (const auto c : std::as_const(encoded.last())) {
+            auto &cls = classOf_[foldCase(static_cast<unsigned char>(c))];
+            if (cls == 0) {
+                cls = static_cast<unsigned char>(classCount_++);
+            }
+        }
+    }
+    for (unsigned char c = 'A'; c <= 'Z'; ++c) {
+        classOf_[c] = classOf_[foldCase(c)];
+    }
+
+    // One state per term byte plus the root is enough; the unused ones are dropped afterwards
+    std::size_t stateBound = 1;
+    for (const auto &term : std::as_const(encoded)) {
+        stateBound += static_cast<std::size_t>(term.size());
+    }
+    const auto classCount = static_cast<std::size_t>(classCount_);
+    next_.assign(stateBound * classCount, 0);
+    best_.assign(stateBound, -1);
+    const auto classOf = [this](char c) { return classOf_[static_cast<unsigned char>(c)]; };
+    std::size_t states = 1;
+    for (qsizetype i = 0; i < encoded.size(); ++i) {
+        ahocorasick::insert(next_, best_, states, classCount, encoded.at(i), classOf,
+                            static_cast<std::size_t>(i));
+    }
+    next_.resize(states * classCount);
+    best_.resize(states);
+
+    std::vector<int> fail(states, 0);
+    std::vector<int> queue(states);
+    ahocorasick::complete(next_, best_, classCount, fail, queue);
+}
+
+qsizetype TermMatcher::termCount() const {
+    return termCount_;
+}
+
+bool TermMatcher::step(Scan &scan, unsigned char byte, bool stopAtAny) const {
+    scan.state = next_[scan.state * classCount_ + classOf_[byte]];
+    const auto best = best_[scan.state];
+    if (best < 0) {
+        return false;
+    }
+    if (scan.result < 0 || best < scan.result) {
+        scan.result = best;
+    }
+    return stopAtAny || scan.result == 0;
+}
+
+template <typename Text> int TermMatcher::search(const Text &text, bool stopAtAny) const {
+    // The root only reports a term when there is an empty one
+    Scan scan{0, best_[0]};
+    if (scan.result == 0 || (stopAtAny && scan.result > 0)) {
+        return scan.result;
+    }
+
+    if constexpr (std::is_same_v<Text, QByteArrayView>) {
+        for (const auto c : text) {
+            if (step(scan, static_cast<unsigned char>(c), stopAtAny)) {
+                break;
+            }
+        }
+    } else {
+        const auto *units = text.utf16();
+        const auto size = text.size();
+        for (qsizetype i = 0; i < size; ++i) {
+            char32_t codePoint = units[i];
+            if (codePoint < 0x80) {
+                if (step(scan, static_cast<unsigned char>(codePoint), stopAtAny)) {
+                    break;
+                }
+                continue;
+            }
+            if (QChar::isHighSurrogate(codePoint) && i + 1 < size &&
+                QChar::isLowSurrogate(units[i + 1])) {
+                codePoint = QChar::surrogateToUcs4(static_cast<char16_t>(codePoint), units[++i]);
+            } else if (QChar::isSurrogate(codePoint)) {
+                codePoint = QChar::ReplacementCharacter;
+            }
+            unsigned char bytes[4];
+            const auto count = encodeUtf8(codePoint, bytes);
+            auto stop = false;
+            for (auto j = 0; j < count && !stop; ++j) {
+                stop = step(scan, bytes[j], stopAtAny);
+            }
+            if (stop) {
+                break;
+            }
+        }
+    }
+    return scan.result;
+}
+
+int TermMatcher::firstMatch(QByteArrayView text) const {
+    return search(text, false);
+}
+
+int TermMatcher::firstMatch(QStringView text) const {
+    return search(text, false);
+}
+
+bool TermMatcher::matches(QByteArrayView text) const {
+    return search(text, true) >= 0;
+}
+
+bool TermMatcher::matches(QStringView text) const {
+    return search(text, true) >= 0;
+}
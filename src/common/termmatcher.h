@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QByteArrayView>
+#include <QtCore/QStringList>
+#include <QtCore/QStringView>
+
+#include <vector>
+
+/**
+ * @brief Finds which of several search terms occur in a text, ignoring ASCII case.
+ *
+ * The terms are compiled into an Aho-Corasick automaton over UTF-8 bytes, so a text is read once
+ * however many terms there are, instead of once per term as with repeated
+ * @c QString::contains(). UTF-16 text is encoded on the fly while it is scanned, so it can be
+ * matched without converting it first.
+ *
+ * Only ASCII letters are compared without case; other characters must match exactly. An empty
+ * term occurs in every text, as with @c QString::contains().
+ *
+ * For fixed pattern sets known at compile time see @c staticmatch::CaseInsensitiveMatcher; both
+ * are built by the functions in @c ahocorasick.h.
+ */
+class TermMatcher {
+public:
+    /**
+     * @brief Creates a matcher with no terms, which matches nothing.
+     */
+    TermMatcher();
+
+    /**
+     * @brief Compiles a matcher.
+     * @param terms The terms, in order of priority.
+     */
+    explicit TermMatcher(const QStringList &terms);
+
+    /**
+     * @brief Returns the number of terms.
+     * @returns The count.
+     */
+    qsizetype termCount() const;
+
+    /**
+     * @brief Finds the first-listed term occurring anywhere in a UTF-8 text.
+     * @param text The text to search.
+     * @returns The term's index, or -1 if none occurs.
+     */
+    int firstMatch(QByteArrayView text) const;
+
+    /**
+     * @copydoc firstMatch(QByteArrayView) const
+     */
+    int firstMatch(QStringView text) const;
+
+    /**
+     * @brief Checks whether any term occurs in a UTF-8 text.
+     *
+     * Stops at the first occurrence of any term, so it can be faster than @c firstMatch().
+     *
+     * @param text The text to search.
+     * @returns @c true if a term occurs.
+     */
+    bool matches(QByteArrayView text) const;
+
+    /**
+     * @copydoc matches(QByteArrayView) const
+     */
+    bool matches(QStringView text) const;
+
+private:
+    struct Scan {
+        int state = 0;
+        int result = -1;
+    };
+
+    bool step(Scan &scan, unsigned char byte, bool stopAtAny) const;
+    template <typename Text> int search(const Text &text, bool stopAtAny) const;
+
+    qsizetype termCount_ = 0;
+    int classCount_ = 1;
+    unsigned char classOf_[256] = {};
+    std::vector<int> next_; // State * classCount_ + class
+    std::vector<int> best_; // Lowest term index ending in the state, or -1
+};
@@ -12,8 +12,9 @@
 
 bool DeviceExport::exportToFile(const QString &filePath,
                                 const QList<DeviceInfo> &devices,
-                                const QString &hostname) {
-    QJsonObject exportData = createExportData(devices, hostname);
+                                const QString &hostname,
+                                const SystemResources &resources) {
+    QJsonObject exportData = createExportData(devices, hostname, resources);
     QJsonDocument doc(exportData);
 
     QFile file(filePath);
@@ -27,7 +28,8 @@ bool DeviceExport::exportToFile(const QString &filePath,
 }
 
 QJsonObject DeviceExport::createExportData(const QList<DeviceInfo> &devices,
-                                           const QString &hostname) {
+                                           const QString &hostname,
+                                           const SystemResources &resources) {
     QJsonObject root;
 
     // Format metadata
@@ -47,17 +49,19 @@ QJsonObject DeviceExport::createExportData(const QList<DeviceInfo> &devices,
     // The viewer can reconstruct any view from this complete device list
     QJsonArray devicesArray;
     for (const auto &info : devices) {
-        devicesArray.append(serializeDevice(info));
+        const auto deviceResources = resources.deviceResources.value(info.syspath());
+        devicesArray.append(serializeDevice(info, deviceResources));
     }
     root[QStringLiteral("devices")] = devicesArray;
 
     // System resources for Resources views (Linux only)
-    root[QStringLiteral("systemResources")] = collectSystemResources();
+    root[QStringLiteral("systemResources")] = collectSystemResources(resources);
 
     return root;
 }
 
-QJsonObject DeviceExport::serializeDevice(const DeviceInfo &info) {
+QJsonObject DeviceExport::serializeDevice(const DeviceInfo &info,
+                                          const QList<ExportResourceInfo> &resources) {
     QJsonObject device;
 
     // Basic device identification
@@ -75,62 +79,7 @@ QJsonObject DeviceExport::serializeDevice(const DeviceInfo &info) {
     device[QStringLiteral("category")] = static_cast<int>(info.category());
 
     // Category name for human readability
-    QString categoryName;
-    switch (info.category()) {
-    case DeviceCategory::AudioInputsAndOutputs:
-        categoryName = QStringLiteral("Audio inputs and outputs");
-        break;
-    case DeviceCategory::Batteries:
-        categoryName = QStringLiteral("Batteries");
-        break;
-    case DeviceCategory::Computer:
-        categoryName = QStringLiteral("Computer");
-        break;
-    case DeviceCategory::DiskDrives:
-        categoryName = QStringLiteral("Disk drives");
-        break;
-    case DeviceCategory::DisplayAdapters:
-        categoryName = QStringLiteral("Display adapters");
-        break;
-    case DeviceCategory::DvdCdromDrives:
-        categoryName = QStringLiteral("DVD/CD-ROM drives");
-        break;
-    case DeviceCategory::HumanInterfaceDevices:
-        categoryName = QStringLiteral("Human Interface Devices");
-        break;
-    case DeviceCategory::Keyboards:
-        categoryName = QStringLiteral("Keyboards");
-        break;
-    case DeviceCategory::MiceAndOtherPointingDevices:
-        categoryName = QStringLiteral("Mice and other pointing devices");
-        break;
-    case DeviceCategory::NetworkAdapters:
-        categoryName = QStringLiteral("Network adapters");
-        break;
-    case DeviceCategory::SoftwareDevices:
-        categoryName = QStringLiteral("Software devices");
-        break;
-    case DeviceCategory::SoundVideoAndGameControllers:
-        categoryName = QStringLiteral("Sound, video and game controllers");
-        break;
-    case DeviceCategory::StorageControllers:
-        categoryName = QStringLiteral("Storage controllers");
-        break;
-    case DeviceCategory::StorageVolumes:
-        categoryName = QStringLiteral("Storage volumes");
-        break;
-    case DeviceCategory::SystemDevices:
-        categoryName = QStringLiteral("System devices");
-        break;
-    case DeviceCategory::UniversalSerialBusControllers:
-        categoryName = QStringLiteral("Universal Serial Bus controllers");
-        break;
-    case DeviceCategory::Unknown:
-    default:
-        categoryName = QStringLiteral("Unknown");
-        break;
-    }
-    device[QStringLiteral("categoryName")] = categoryName;
+    device[QStringLiteral("categoryName")] = deviceCategoryName(info.category());
 
     // PCI information
     if (!info.pciClass().isEmpty()) {
@@ -152,12 +101,8 @@ QJsonObject DeviceExport::serializeDevice(const DeviceInfo &info) {
     device[QStringLiteral("ids")] = ids;
 
     // Fetch additional platform-specific properties
-    QHash<QString, QString> exportProps = getExportDeviceProperties(info);
-    if (!exportProps.isEmpty()) {
-        QJsonObject properties;
-        for (auto it = exportProps.begin(); it != exportProps.end(); ++it) {
-            properties[it.key()] = it.value();
-        }
+    auto properties = serializeProperties(info);
+    if (!properties.isEmpty()) {
         device[QStringLiteral("properties")] = properties;
     }
 
@@ -165,33 +110,45 @@ QJsonObject DeviceExport::serializeDevice(const DeviceInfo &info) {
     device[QStringLiteral("driverInfo")] = serializeDriverInfo(info);
 
     // Resources (for PCI devices)
-    QList<ExportResourceInfo> resList = getExportDeviceResources(info.syspath());
-    if (!resList.isEmpty()) {
-        QJsonArray resources;
-        for (const auto &res : resList) {
-            QJsonObject resObj;
-            resObj[QStringLiteral("type")] = res.type;
-            resObj[QStringLiteral("displayValue")] = res.displayValue;
-            if (!res.start.isEmpty()) {
-                resObj[QStringLiteral("start")] = res.start;
-            }
-            if (!res.end.isEmpty()) {
-                resObj[QStringLiteral("end")] = res.end;
-            }
-            if (!res.flags.isEmpty()) {
-                resObj[QStringLiteral("flags")] = res.flags;
-            }
-            if (res.value != 0) {
-                resObj[QStringLiteral("value")] = res.value;
-            }
-            resources.append(resObj);
-        }
-        device[QStringLiteral("resources")] = resources;
+    if (!resources.isEmpty()) {
+        device[QStringLiteral("resources")] = serializeResources(resources);
     }
 
     return device;
 }
 
+QJsonObject DeviceExport::serializeProperties(const DeviceInfo &info) {
+    QJsonObject properties;
+    const auto exportProps = getExportDeviceProperties(info);
+    for (auto it = exportProps.begin(); it != exportProps.end(); ++it) {
+        properties[it.key()] = it.value();
+    }
+    return properties;
+}
+
+QJsonArray DeviceExport::serializeResources(const QList<ExportResourceInfo> &resources) {
+    QJsonArray resourcesArray;
+    for (const auto &res : resources) {
+        QJsonObject resObj;
+        resObj[QStringLiteral("type")] = res.type;
+        resObj[QStringLiteral("displayValue")] = res.displayValue;
+        if (!res.start.isEmpty()) {
+            resObj[QStringLiteral("start")] = res.start;
+        }
+        if (!res.end.isEmpty()) {
+            resObj[QStringLiteral("end")] = res.end;
+        }
+        if (!res.flags.isEmpty()) {
+            resObj[QStringLiteral("flags")] = res.flags;
+        }
+        if (res.value != 0) {
+            resObj[QStringLiteral("value")] = res.value;
+        }
+        resourcesArray.append(resObj);
+    }
+    return resourcesArray;
+}
+
 QJsonObject DeviceExport::collectSystemInfo(const QString &hostname) {
     QJsonObject info;
 
@@ -225,18 +182,15 @@ QJsonObject DeviceExport::collectSystemInfo(const QString &hostname) {
     return info;
 }
 
-// LCOV_EXCL_START - Reads from /proc filesystem (platform-specific)
-QJsonObject DeviceExport::collectSystemResources() {
-    QJsonObject resources;
+QJsonObject DeviceExport::collectSystemResources(const SystemResources &resources) {
+    QJsonObject result;
 
-    QHash<QString, QString> rawResources = getSystemResourcesRaw();
-    for (auto it = rawResources.begin(); it != rawResources.end(); ++it) {
-        resources[it.key()] = it.value();
+    for (auto it = resources.raw.begin(); it != resources.raw.end(); ++it) {
+        result[it.key()] = it.value();
     }
 
-    return resources;
+    return result;
 }
-// LCOV_EXCL_STOP
 
 QJsonObject DeviceExport::serializeDriverInfo(const DeviceInfo &info) {
     QJsonObject driverInfoObj;
@@ -7,6 +7,8 @@
 #include <QtCore/QList>
 #include <QtCore/QString>
 
+#include "systemresources.h"
+
 class DeviceInfo;
 
 /**
@@ -30,19 +32,24 @@ public:
      * @param filePath The path to save the export file.
      * @param devices List of devices to export.
      * @param hostname The hostname of the system being exported.
+     * @param resources Resource snapshot of @p devices, e.g. from @c getSystemResources().
      * @returns @c true if export was successful, @c false otherwise.
      */
     static bool exportToFile(const QString &filePath,
                              const QList<DeviceInfo> &devices,
-                             const QString &hostname);
+                             const QString &hostname,
+                             const SystemResources &resources);
 
     /**
      * @brief Creates a JSON object containing all export data.
      * @param devices List of devices to include in the export.
      * @param hostname The hostname of the system being exported.
+     * @param resources Resource snapshot of @p devices.
      * @returns A QJsonObject containing the complete export data for all views.
      */
-    static QJsonObject createExportData(const QList<DeviceInfo> &devices, const QString &hostname);
+    static QJsonObject createExportData(const QList<DeviceInfo> &devices,
+                                        const QString &hostname,
+                                        const SystemResources &resources);
 
     /**
      * @brief File extension for export files.
@@ -62,9 +69,25 @@ public:
     /**
      * @brief Serialises a DeviceInfo object to JSON.
      * @param info The device info to serialise.
+     * @param resources The device's resources from the snapshot.
      * @returns A QJsonObject containing all device properties.
      */
-    static QJsonObject serializeDevice(const DeviceInfo &info);
+    static QJsonObject serializeDevice(const DeviceInfo &info,
+                                       const QList<ExportResourceInfo> &resources);
+
+    /**
+     * @brief Serialises a device's platform-specific properties to JSON.
+     * @param info The device info.
+     * @returns A QJsonObject of property names to values, empty if the device has none.
+     */
+    static QJsonObject serializeProperties(const DeviceInfo &info);
+
+    /**
+     * @brief Serialises a device's resources to JSON.
+     * @param resources The device's resources from the snapshot.
+     * @returns A QJsonArray with one object per resource.
+     */
+    static QJsonArray serializeResources(const QList<ExportResourceInfo> &resources);
 
     /**
      * @brief Collects system information for the export.
@@ -79,9 +102,10 @@ public:
      * On Linux, this includes content from /proc/dma, /proc/ioports,
      * /proc/interrupts, and /proc/iomem.
      *
+     * @param resources The snapshot holding the raw tables.
      * @returns A QJsonObject containing system resource data.
      */
-    static QJsonObject collectSystemResources();
+    static QJsonObject collectSystemResources(const SystemResources &resources);
 
     /**
      * @brief Serialises driver information to JSON.
@@ -9,10 +9,31 @@
 
 // SPDX-License-Identifier: MIT
 #include "devicecache.h"
+#include "deviceenumerationfilter.h"
 #include "devicemonitor.h"
 #include "systeminfo.h"
 #include "viewsettings.h"
 
+namespace {
+
+DeviceEnumerationFilter &enumerationFilter() {
+    static DeviceEnumerationFilter filter;
+    return filter;
+}
+
+// The names the device views show, so a search finds what the user sees
+QList<QStringList> displayNames(const DeviceNames &names) {
+    QList<QStringList> result;
+    result.reserve(names.size());
+    for (qsizetype i = 0; i < names.size(); ++i) {
+        const auto &entry = names.at(i);
+        result.append({entry.name, entry.connectionName, entry.typeName});
+    }
+    return result;
+}
+
+} // namespace
+
 DeviceCache &DeviceCache::instance() {
     static DeviceCache cache;
     return cache;
@@ -27,6 +48,10 @@ const QString &DeviceCache::hostname() {
     return cachedHostname;
 }
 
+void DeviceCache::setEnumerationFilter(const DeviceEnumerationFilter &filter) {
+    enumerationFilter() = filter;
+}
+
 DeviceCache::DeviceCache() : QObject(nullptr) {
     enumerate();
     startMonitoring();
@@ -45,17 +70,20 @@ DeviceCache::~DeviceCache() {
 
 void DeviceCache::enumerate() {
     devices_.clear();
-    syspathIndex_.clear();
-
-    devices_ = enumerateAllDevices();
-
-    // Build the syspath index
-    for (auto i = 0; i < devices_.size(); ++i) {
-        const auto &syspath = devices_.at(i).syspath();
-        if (!syspath.isEmpty()) {
-            syspathIndex_.insert(syspath, i);
-        }
-    }
+    tree_.clear();
+    searchIndex_.clear();
+    resourceMap_.clear();
+    names_.clear();
+
+    devices_ = enumerateDevices(enumerationFilter());
+
+    // Build the syspath and topology indexes, the display names, and the search and resource
+    // indexes
+    tree_.build(devices_);
+    names_.build(devices_);
+    searchIndex_.build(devices_, displayNames(names_));
+    resourceMap_.build(devices_);
+    resources_ = getSystemResources(devices_);
 }
 
 QList<DeviceInfo> DeviceCache::allDevices() const {
@@ -63,15 +91,60 @@ QList<DeviceInfo> DeviceCache::allDevices() const {
     return devices_; // Returns a copy for thread safety
 }
 
+QList<DeviceInfo> DeviceCache::allDevices(DeviceNames &names) const {
+    QMutexLocker locker(&mutex_);
+    names = names_;
+    return devices_;
+}
+
+QList<DeviceInfo> DeviceCache::allDevices(DeviceTree &tree, DeviceNames &names) const {
+    QMutexLocker locker(&mutex_);
+    tree = tree_;
+    names = names_;
+    return devices_;
+}
+
 const DeviceInfo *DeviceCache::deviceBySyspath(const QString &syspath) const {
     QMutexLocker locker(&mutex_);
-    auto it = syspathIndex_.find(syspath);
-    if (it != syspathIndex_.end()) {
-        return &devices_.at(it.value());
+    const auto index = tree_.indexOf(syspath);
+    if (index >= 0) {
+        return &devices_.at(index);
     }
     return nullptr;
 }
 
+QStringList DeviceCache::childSyspaths(const QString &syspath) const {
+    QMutexLocker locker(&mutex_);
+    QStringList result;
+    const auto &children = tree_.childrenOf(tree_.indexOf(syspath));
+    result.reserve(children.size());
+    for (auto child : children) {
+        result.append(devices_.at(child).syspath());
+    }
+    return result;
+}
+
+QSet<QString> DeviceCache::matchingSyspaths(const QString &query) const {
+    QMutexLocker locker(&mutex_);
+    QSet<QString> result;
+    const auto matches = searchIndex_.match(query);
+    result.reserve(matches.size());
+    for (auto index : matches) {
+        result.insert(devices_.at(index).syspath());
+    }
+    return result;
+}
+
+ResourceDeviceMap DeviceCache::resourceDeviceMap() const {
+    QMutexLocker locker(&mutex_);
+    return resourceMap_;
+}
+
+SystemResources DeviceCache::resourceSnapshot() const {
+    QMutexLocker locker(&mutex_);
+    return resources_;
+}
+
 void DeviceCache::refresh() {
     QMutexLocker locker(&mutex_);
     enumerate();
@@ -144,7 +217,10 @@ bool DeviceCache::loadFromFile(const QString &filePath) {
 
     // Clear existing data
     devices_.clear();
-    syspathIndex_.clear();
+    tree_.clear();
+    searchIndex_.clear();
+    resourceMap_.clear();
+    names_.clear();
 
     // Load metadata
     viewerMode_ = true;
@@ -165,11 +241,12 @@ bool DeviceCache::loadFromFile(const QString &filePath) {
             continue;
         }
         devices_.emplaceBack(val.toObject());
-        const QString &syspath = devices_.last().syspath();
-        if (!syspath.isEmpty()) {
-            syspathIndex_.insert(syspath, static_cast<int>(devices_.size() - 1));
-        }
     }
+    tree_.build(devices_);
+    names_.build(devices_);
+    searchIndex_.build(devices_, displayNames(names_));
+    resourceMap_.build(devices_);
+    resources_ = SystemResources::fromExport(systemResources_, devices_);
 
     locker.unlock();
     Q_EMIT devicesChanged();
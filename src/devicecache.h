@@ -2,13 +2,21 @@
 /** @file */
 #pragma once
 
-#include <QtCore/QHash>
 #include <QtCore/QJsonObject>
 #include <QtCore/QList>
 #include <QtCore/QMutex>
 #include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
 
 #include "deviceinfo.h"
+#include "devicenames.h"
+#include "devicesearchindex.h"
+#include "devicetree.h"
+#include "resourcedevicemap.h"
+#include "systemresources.h"
+
+struct DeviceEnumerationFilter;
 
 /**
  * @brief Singleton cache that holds all device information.
@@ -51,6 +59,16 @@ public:
      */
     static const QString &hostname();
 
+    /**
+     * @brief Limits the live devices to those matching a filter.
+     *
+     * The filter applies from the next enumeration on. Set it before the first call to
+     * @c instance() so that the initial enumeration only reads the matching devices.
+     *
+     * @param filter The filter; an empty one enumerates all devices.
+     */
+    static void setEnumerationFilter(const DeviceEnumerationFilter &filter);
+
     /**
      * @brief Returns a copy of all cached devices.
      *
@@ -61,6 +79,28 @@ public:
      */
     QList<DeviceInfo> allDevices() const;
 
+    /**
+     * @brief Returns a copy of all cached devices together with their display names.
+     *
+     * The names are built once per snapshot, so views neither derive nor compare raw names.
+     *
+     * @param names Receives the names of the returned devices, in the same order.
+     * @returns List of all cached @c DeviceInfo objects.
+     */
+    QList<DeviceInfo> allDevices(DeviceNames &names) const;
+
+    /**
+     * @brief Returns a copy of all cached devices together with their topology and display names.
+     *
+     * All three are taken under the same lock, so the indices in @p tree and @p names always refer
+     * to the returned list.
+     *
+     * @param tree Receives the parent/child index of the returned devices.
+     * @param names Receives the names of the returned devices, in the same order.
+     * @returns List of all cached @c DeviceInfo objects.
+     */
+    QList<DeviceInfo> allDevices(DeviceTree &tree, DeviceNames &names) const;
+
     /**
      * @brief Finds a device by its system path.
      * @param syspath The system path (e.g., "/sys/devices/...") to search for.
@@ -71,6 +111,46 @@ public:
      */
     const DeviceInfo *deviceBySyspath(const QString &syspath) const;
 
+    /**
+     * @brief Returns the system paths of a device's direct children.
+     * @param syspath The system path of the parent device.
+     * @returns Child system paths in enumeration order, or an empty list if the device is unknown
+     *          or has no children.
+     */
+    QStringList childSyspaths(const QString &syspath) const;
+
+    /**
+     * @brief Searches the cached devices.
+     *
+     * The search uses a text index built with each snapshot over device names, drivers, syspaths,
+     * modaliases, vendor/model names and IDs, PCI IDs, and the names the device views show. See
+     * @c DeviceSearchIndex.
+     *
+     * @param query Whitespace-separated search terms; all must match (case-insensitive).
+     * @returns System paths of the matching devices.
+     */
+    QSet<QString> matchingSyspaths(const QString &query) const;
+
+    /**
+     * @brief Returns the map from @c /proc resource names to the cached devices.
+     *
+     * The map is built with each snapshot; see @c ResourceDeviceMap.
+     *
+     * @returns A copy of the map. Copies are implicitly shared and cheap.
+     */
+    ResourceDeviceMap resourceDeviceMap() const;
+
+    /**
+     * @brief Returns the resource tables captured with the current snapshot.
+     *
+     * Live snapshots are taken with @c getSystemResources() on every refresh; in viewer mode the
+     * snapshot is rebuilt from the export. Resource views, the Properties dialog and the export
+     * use it instead of reading the tables again.
+     *
+     * @returns A copy of the snapshot.
+     */
+    SystemResources resourceSnapshot() const;
+
     /**
      * @brief Refreshes the device cache by re-enumerating all devices.
      *
@@ -195,7 +275,11 @@ private:
 
     QObject *monitor_ = nullptr;
     QList<DeviceInfo> devices_;
-    QHash<QString, int> syspathIndex_;
+    DeviceTree tree_;
+    DeviceSearchIndex searchIndex_;
+    ResourceDeviceMap resourceMap_;
+    DeviceNames names_;
+    SystemResources resources_;
     mutable QMutex mutex_;
 
     // Viewer mode state
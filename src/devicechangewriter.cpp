@@ -0,0 +1,83 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QFileDevice>
+#include <QtCore/QIODevice>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QThread>
+
+#include <utility>
+
+#include "devicechangewriter.h"
+
+DeviceChangeWriter::DeviceChangeWriter(QIODevice *output,
+                                       Serializer serializer,
+                                       qsizetype capacity,
+                                       QObject *parent)
+    : QObject(parent), output_(output), serializer_(std::move(serializer)), queue_(capacity) {
+}
+
+DeviceChangeWriter::~DeviceChangeWriter() {
+    stop();
+}
+
+void DeviceChangeWriter::start() {
+    if (thread_) {
+        return;
+    }
+    thread_.reset(QThread::create([this] { run(); }));
+    thread_->start();
+}
+
+void DeviceChangeWriter::stop() {
+    queue_.close();
+    if (thread_) {
+        thread_->wait();
+        thread_.reset();
+    }
+}
+
+bool DeviceChangeWriter::isRunning() const {
+    return thread_ != nullptr;
+}
+
+quint64 DeviceChangeWriter::droppedCount() const {
+    return queue_.droppedCount();
+}
+
+void DeviceChangeWriter::addEvent(const QString &action, const DeviceInfo &device) {
+    // The writer thread must not touch the platform's device handle, which the monitor thread
+    // keeps using; copying the properties only costs memory, so the monitor is not held up
+    queue_.push({action, QDateTime::currentDateTimeUtc(), device.detached()});
+}
+
+void DeviceChangeWriter::run() {
+    QList<DeviceChange> changes;
+    quint64 dropped = 0;
+    while (queue_.take(changes, dropped)) {
+        // One write per batch, so a burst costs a few system calls rather than one per event
+        QByteArray lines;
+        for (const auto &change : std::as_const(changes)) {
+            const QJsonObject line{
+                {QStringLiteral("event"), change.action},
+                {QStringLiteral("time"), change.time.toString(Qt::ISODateWithMs)},
+                {QStringLiteral("device"), serializer_(change.device)},
+            };
+            lines += QJsonDocument(line).toJson(QJsonDocument::Compact);
+            lines += '\n';
+        }
+        if (dropped > 0) {
+            const QJsonObject line{
+                {QStringLiteral("event"), QStringLiteral("overflow")},
+                {QStringLiteral("dropped"), static_cast<qint64>(dropped)},
+            };
+            lines += QJsonDocument(line).toJson(QJsonDocument::Compact);
+            lines += '\n';
+        }
+        // The events are released here rather than when the next batch arrives
+        changes.clear();
+
+        output_->write(lines);
+        if (auto *file = qobject_cast<QFileDevice *>(output_)) {
+            file->flush();
+        }
+    }
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+
+#include <functional>
+#include <memory>
+
+#include "devicechangequeue.h"
+
+QT_BEGIN_NAMESPACE
+class QIODevice;
+class QThread;
+QT_END_NAMESPACE
+
+/**
+ * @brief Writes device events as newline-delimited JSON, one object per event.
+ *
+ * Events are usually connected from @c DeviceMonitor::deviceEvent. @c addEvent() only queues the
+ * event, so the thread receiving events never waits for the output; a writer thread serialises the
+ * devices and writes the lines. Each line looks like
+ * @code{.json}
+ * {"event":"add","time":"2026-03-14T08:12:01.250Z","device":{...}}
+ * @endcode
+ * with @c device as produced by the serialiser. If the output falls so far behind that the queue
+ * fills, further events are dropped until the writer catches up, and a line
+ * @code{.json}
+ * {"event":"overflow","dropped":12}
+ * @endcode
+ * follows the events written before the loss.
+ */
+class DeviceChangeWriter : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Serialises a device for output.
+     *
+     * Called on the writer thread with a copy made by @c DeviceInfo::detached(), so it may do
+     * slow lookups such as reading driver details, but no platform device handles are shared.
+     */
+    using Serializer = std::function<QJsonObject(const DeviceInfo &device)>;
+
+    /**
+     * @brief Default number of events that may wait for the writer.
+     */
+    static constexpr qsizetype DEFAULT_CAPACITY = 4096;
+
+    /**
+     * @brief Constructs a @c DeviceChangeWriter.
+     * @param output Device the lines are written to, already open. Only the writer thread uses it
+     *               while the writer runs.
+     * @param serializer Serialises the device of each event.
+     * @param capacity Maximum number of events waiting to be written.
+     * @param parent Optional parent @c QObject for memory management.
+     */
+    DeviceChangeWriter(QIODevice *output,
+                       Serializer serializer,
+                       qsizetype capacity = DEFAULT_CAPACITY,
+                       QObject *parent = nullptr);
+    ~DeviceChangeWriter() override;
+
+    /**
+     * @brief Starts the writer thread.
+     */
+    void start();
+
+    /**
+     * @brief Writes the events still queued and stops the writer thread.
+     *
+     * Events added afterwards are dropped.
+     */
+    void stop();
+
+    /**
+     * @brief Checks if the writer thread is running.
+     * @returns @c true if it is running, @c false otherwise.
+     */
+    bool isRunning() const;
+
+    /**
+     * @brief Returns the number of events dropped because the queue was full.
+     * @returns The count.
+     */
+    quint64 droppedCount() const;
+
+public Q_SLOTS:
+    /**
+     * @brief Queues an event for writing.
+     *
+     * Must be called on the thread @p device belongs to, which @c DeviceMonitor::deviceEvent
+     * connections do.
+     *
+     * @param action The event's action.
+     * @param device The device the event is for.
+     */
+    void addEvent(const QString &action, const DeviceInfo &device);
+
+private:
+    void run();
+
+    QIODevice *output_;
+    Serializer serializer_;
+    DeviceChangeQueue queue_;
+    std::unique_ptr<QThread> thread_;
+};
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QList>
+#include <QtCore/QObject>
+
+#include "deviceevent.h"
+
+/**
+ * @brief Abstract interface for platform-specific sources of live device events.
+ *
+ * A stream follows the system log for one device and reports the entries logged for it after
+ * @c start() was called, so the Properties dialog can append them to the events it has already
+ * loaded with @c queryDeviceEvents().
+ *
+ * On platforms without a followable log, no implementation is provided and
+ * @c createDeviceEventStream() returns @c nullptr.
+ */
+class DeviceEventStream : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a @c DeviceEventStream.
+     * @param parent Optional parent @c QObject for memory management.
+     */
+    explicit DeviceEventStream(QObject *parent = nullptr) : QObject(parent) {
+    }
+
+    ~DeviceEventStream() override = default;
+
+    /**
+     * @brief Starts following the log.
+     * @returns @c false if the log cannot be read.
+     */
+    virtual bool start() = 0;
+
+    /**
+     * @brief Stops following the log.
+     *
+     * Safe to call even if the stream is not running.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @brief Checks if the stream is currently following the log.
+     * @returns @c true if the stream is running, @c false otherwise.
+     */
+    virtual bool isRunning() const = 0;
+
+Q_SIGNALS:
+    /**
+     * @brief Emitted with the entries logged for the device since the previous emission.
+     *
+     * Entries arriving close together are delivered in one batch. They have the format and
+     * cursors of @c queryDeviceEvents() results, so entries returned by both can be told apart.
+     *
+     * @param events The new entries, oldest first.
+     */
+    void eventsReceived(const QList<DeviceEvent> &events);
+};
@@ -6,6 +6,8 @@
 
 #include <QtCore/QObject>
 
+#include "deviceinfo.h"
+
 /**
  * @brief Error codes for device monitor operations.
  */
@@ -68,6 +70,26 @@ public:
 Q_SIGNALS:
     /**
      * @brief Emitted when a device is added or removed.
+     *
+     * Emitted once for a burst of events received together.
      */
     void deviceChanged();
+
+    /**
+     * @brief Emitted for each event reported for a device.
+     *
+     * The device is only built from the event when a receiver is connected.
+     *
+     * @param action The event's action, e.g. @c add, @c remove, @c change, @c bind or @c unbind.
+     * @param device The device as the event describes it; for @c remove, its last known state.
+     */
+    void deviceEvent(const QString &action, const DeviceInfo &device);
+
+    /**
+     * @brief Emitted when events were dropped before they could be received.
+     *
+     * State kept from @c deviceEvent() may be stale afterwards and should be rebuilt from a new
+     * enumeration. @c deviceChanged() follows.
+     */
+    void eventsLost();
 };
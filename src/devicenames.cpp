@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QStringList>
+
+#include <utility>
+
+#include "collation.h"
+#include "const_strings.h"
+#include "deviceinfo.h"
+#include "devicenames.h"
+
+namespace s = strings;
+namespace us = strings::udev;
+
+namespace {
+
+QString syspathBasename(const QString &syspath) {
+    auto lastSlash = syspath.lastIndexOf(QLatin1Char('/'));
+    return lastSlash >= 0 ? syspath.mid(lastSlash + 1) : syspath;
+}
+
+QString displayName(const DeviceInfo &info, const QString &rawName) {
+    if (info.subsystem() == QStringLiteral("acpi")) {
+        return s::acpiDeviceDisplayName(info.devPath(), rawName);
+    }
+    return s::softwareDeviceDisplayName(rawName);
+}
+
+void setTypeNames(const DeviceInfo &info, DeviceNames::Entry &entry) {
+    entry.typeRawName = info.name();
+    entry.typeName = entry.typeRawName;
+
+    switch (info.category()) {
+    case DeviceCategory::Batteries:
+        entry.typeName = s::acpiDeviceDisplayName(info.devPath(), entry.typeRawName);
+        break;
+
+    case DeviceCategory::StorageVolumes: {
+        // Partition label, then filesystem label, then the device name
+        auto volumeName = info.propertyValue(us::propertyNames::ID_PART_ENTRY_NAME);
+        if (volumeName.isEmpty()) {
+            volumeName = info.propertyValue(us::propertyNames::ID_FS_LABEL);
+        }
+        if (!volumeName.isEmpty()) {
+            entry.typeName = volumeName;
+        }
+        break;
+    }
+
+    case DeviceCategory::HumanInterfaceDevices:
+    case DeviceCategory::Keyboards:
+    case DeviceCategory::MiceAndOtherPointingDevices:
+        entry.typeName = s::softwareDeviceDisplayName(entry.typeRawName);
+        break;
+
+    case DeviceCategory::SoftwareDevices:
+        if (entry.typeRawName.startsWith(QStringLiteral("/dev/"))) {
+            entry.typeRawName.remove(0, 5);
+        }
+        entry.typeName = s::softwareDeviceDisplayName(entry.typeRawName);
+        break;
+
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+void DeviceNames::build(const QList<DeviceInfo> &devices) {
+    clear();
+    entries_.reserve(devices.size());
+    QStringList names;
+    QStringList typeNames;
+    names.reserve(devices.size());
+    typeNames.reserve(devices.size());
+
+    for (const auto &info : devices) {
+        Entry entry;
+        entry.rawName = info.name();
+        const auto unnamed = entry.rawName.isEmpty();
+        if (unnamed) {
+            entry.rawName = syspathBasename(info.syspath());
+        }
+        entry.name = displayName(info, entry.rawName);
+
+        // Unnamed devices of subsystems without display names of their own are told apart by
+        // their subsystem in the connection view
+        const auto subsystem = info.subsystem();
+        if (unnamed && !subsystem.isEmpty() && subsystem != QStringLiteral("acpi") &&
+            subsystem != QStringLiteral("scsi_host") && subsystem != QStringLiteral("scsi") &&
+            subsystem != QStringLiteral("i2c")) {
+            entry.connectionRawName = QStringLiteral("[%1] %2").arg(subsystem, entry.rawName);
+            entry.connectionName = QStringLiteral("[%1] %2").arg(subsystem, entry.name);
+        } else {
+            entry.connectionRawName = entry.rawName;
+            entry.connectionName = entry.name;
+        }
+
+        setTypeNames(info, entry);
+
+        names << entry.name;
+        typeNames << entry.typeName;
+        entries_.append(std::move(entry));
+    }
+
+    nameKeys_ = collationKeys(names);
+    typeNameKeys_ = collationKeys(typeNames);
+}
+
+void DeviceNames::clear() {
+    entries_.clear();
+    nameKeys_.clear();
+    typeNameKeys_.clear();
+}
+
+qsizetype DeviceNames::size() const {
+    return entries_.size();
+}
+
+const DeviceNames::Entry &DeviceNames::at(qsizetype index) const {
+    return entries_.at(index);
+}
+
+void DeviceNames::sortByName(QList<int> &indexes) const {
+    sortByCollationKeys(indexes, nameKeys_);
+}
+
+void DeviceNames::sortByTypeName(QList<int> &indexes) const {
+    sortByCollationKeys(indexes, typeNameKeys_);
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QCollator>
+#include <QtCore/QList>
+#include <QtCore/QString>
+
+class DeviceInfo;
+
+/**
+ * @brief Names the device views show for the devices of a cache snapshot.
+ *
+ * Display names come from the name mappings, ACPI IDs and volume labels, which makes them costly
+ * to derive. They are built once with each snapshot, together with their collation keys, so that
+ * building or switching a view only reads and compares them. Entries are in the order of the
+ * snapshot's device list. Copies are implicitly shared and cheap.
+ */
+class DeviceNames {
+public:
+    /**
+     * @brief The names of one device.
+     */
+    struct Entry {
+        /// Shown in the driver views; unnamed devices fall back to their syspath's last component.
+        QString name;
+        QString rawName; ///< @c name before display mapping.
+        /// Shown in Devices by connection: @c name, prefixed with the subsystem for unnamed devices
+        /// whose subsystem has no display names of its own.
+        QString connectionName;
+        QString connectionRawName; ///< @c connectionName before display mapping.
+        QString typeName;          ///< Shown in Devices by type.
+        QString typeRawName;       ///< @c typeName before display mapping.
+    };
+
+    /**
+     * @brief Builds the names of devices.
+     * @param devices The devices.
+     */
+    void build(const QList<DeviceInfo> &devices);
+
+    /**
+     * @brief Removes all names.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of devices names were built for.
+     * @returns The device count.
+     */
+    qsizetype size() const;
+
+    /**
+     * @brief Returns the names of a device.
+     * @param index The device's index in the list the names were built from.
+     * @returns The names.
+     */
+    const Entry &at(qsizetype index) const;
+
+    /**
+     * @brief Sorts device indexes by @c Entry::name for display.
+     * @param indexes Indexes into the list the names were built from.
+     */
+    void sortByName(QList<int> &indexes) const;
+
+    /**
+     * @brief Sorts device indexes by @c Entry::typeName for display.
+     * @param indexes Indexes into the list the names were built from.
+     */
+    void sortByTypeName(QList<int> &indexes) const;
+
+private:
+    QList<Entry> entries_;
+    QList<QCollatorSortKey> nameKeys_;
+    QList<QCollatorSortKey> typeNameKeys_;
+};
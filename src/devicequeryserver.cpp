@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: MIT
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QDir>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStandardPaths>
+#include <QtNetwork/QLocalServer>
+#include <QtNetwork/QLocalSocket>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "devicequery.h"
+#include "devicequeryserver.h"
+
+namespace {
+
+QByteArray errorResponse(const QString &message) {
+    return QJsonDocument(QJsonObject{{QStringLiteral("error"), message}})
+        .toJson(QJsonDocument::Compact);
+}
+
+// Copies that share no state with the backend, so request threads can read them
+QList<DeviceInfo> detachedDevices(const QList<DeviceInfo> &devices) {
+    QList<DeviceInfo> result;
+    result.reserve(devices.size());
+    for (const auto &device : devices) {
+        result.append(device.detached());
+    }
+    return result;
+}
+
+// A missing value is an empty list; anything but an array of strings is invalid
+std::optional<QStringList> stringList(const QJsonValue &value) {
+    QStringList result;
+    if (value.isUndefined()) {
+        return result;
+    }
+    if (!value.isArray()) {
+        return std::nullopt;
+    }
+    for (const auto &item : value.toArray()) {
+        if (!item.isString()) {
+            return std::nullopt;
+        }
+        result << item.toString();
+    }
+    return result;
+}
+
+} // namespace
+
+DeviceQueryServer::DeviceQueryServer(QList<DeviceInfo> devices, QObject *parent)
+    : QObject(parent), server_(new QLocalServer(this)), devices_(detachedDevices(devices)) {
+    snapshot_ = std::make_shared<const DeviceSnapshot>(DeviceSnapshot{0, devices_});
+    rebuildIndex();
+    // Requests mostly wait for files and processes rather than use a processor
+    pool_.setMaxThreadCount(std::max(pool_.maxThreadCount(), MIN_REQUEST_THREADS));
+    server_->setSocketOptions(QLocalServer::UserAccessOption);
+    connect(server_, &QLocalServer::newConnection, this, &DeviceQueryServer::onNewConnection);
+    // Events arriving together are published as one snapshot once control returns to the loop
+    publishTimer_.setSingleShot(true);
+    publishTimer_.setInterval(0);
+    connect(&publishTimer_, &QTimer::timeout, this, &DeviceQueryServer::publish);
+}
+
+DeviceQueryServer::~DeviceQueryServer() {
+    // Running requests may use providers whose state is owned alongside the server
+    waitForRequests();
+}
+
+QString DeviceQueryServer::defaultSocketPath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation))
+        .filePath(QStringLiteral("hwview.sock"));
+}
+
+void DeviceQueryServer::setProviderSetup(ProviderSetup setup) {
+    providerSetup_ = std::move(setup);
+}
+
+bool DeviceQueryServer::listen(const QString &path) {
+    // Listening replaces whatever is at the path, so make sure no other server still answers there
+    QLocalSocket probe;
+    probe.connectToServer(path);
+    if (probe.waitForConnected(1000)) {
+        errorString_ = tr("Another server is listening on this socket.");
+        return false;
+    }
+    QLocalServer::removeServer(path);
+    if (!server_->listen(path)) {
+        errorString_ = server_->errorString();
+        return false;
+    }
+    return true;
+}
+
+QString DeviceQueryServer::errorString() const {
+    return errorString_;
+}
+
+std::shared_ptr<const DeviceSnapshot> DeviceQueryServer::snapshot() const {
+    return snapshot_;
+}
+
+QByteArray DeviceQueryServer::handleRequest(const QByteArray &request) const {
+    return prepareRequest(request)();
+}
+
+void DeviceQueryServer::waitForRequests() {
+    pool_.waitForDone();
+}
+
+std::function<QByteArray()> DeviceQueryServer::prepareRequest(const QByteArray &request) const {
+    const auto error = [](const QString &message) {
+        return [response = errorResponse(message)] { return response; };
+    };
+    QJsonParseError parseError;
+    const auto document = QJsonDocument::fromJson(request, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !document.isObject()) {
+        return error(QStringLiteral("Invalid request. Expected a JSON object."));
+    }
+    const auto object = document.object();
+    const auto filters = stringList(object.value(QStringLiteral("filters")));
+    const auto fields = stringList(object.value(QStringLiteral("fields")));
+    if (!filters || !fields) {
+        return error(
+            QStringLiteral("Invalid request. 'filters' and 'fields' must be arrays of strings."));
+    }
+    auto query = DeviceQuery::parse(*filters, *fields);
+    if (!query) {
+        return error(query.error());
+    }
+
+    // Held for the whole request, so events arriving meanwhile cannot change the answer
+    const auto snapshot = snapshot_;
+    if (providerSetup_) {
+        providerSetup_(*query, snapshot);
+    }
+    return [query = std::move(*query), snapshot] {
+        QJsonArray devices;
+        for (const auto &info : snapshot->devices) {
+            if (const auto device = query.evaluate(info)) {
+                devices.append(*device);
+            }
+        }
+        const QJsonObject response{
+            {QStringLiteral("generation"), static_cast<qint64>(snapshot->generation)},
+            {QStringLiteral("devices"), devices},
+        };
+        return QJsonDocument(response).toJson(QJsonDocument::Compact);
+    };
+}
+
+void DeviceQueryServer::applyEvent(const QString &action, const DeviceInfo &device) {
+    if (action == QStringLiteral("remove")) {
+        removeDevice(device.syspath());
+    } else {
+        if (action == QStringLiteral("move")) {
+            if (const auto oldPath = device.propertyValue("DEVPATH_OLD"); !oldPath.isEmpty()) {
+                removeDevice(QStringLiteral("/sys") + oldPath);
+            }
+        }
+        if (const auto it = index_.constFind(device.syspath()); it != index_.cend()) {
+            devices_[*it] = device.detached();
+        } else {
+            index_.insert(device.syspath(), devices_.size());
+            devices_.append(device.detached());
+        }
+    }
+    publishTimer_.start();
+}
+
+void DeviceQueryServer::replaceDevices(const QList<DeviceInfo> &devices) {
+    devices_ = detachedDevices(devices);
+    rebuildIndex();
+    publishTimer_.start();
+}
+
+void DeviceQueryServer::onNewConnection() {
+    while (auto *socket = server_->nextPendingConnection()) {
+        connect(socket, &QLocalSocket::readyRead, this, &DeviceQueryServer::onReadyRead);
+        connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QObject::destroyed, this, [this, socket] { busy_.remove(socket); });
+    }
+}
+
+void DeviceQueryServer::onReadyRead() {
+    if (auto *socket = qobject_cast<QLocalSocket *>(sender())) {
+        processNextRequest(socket);
+    }
+}
+
+void DeviceQueryServer::processNextRequest(QLocalSocket *socket) {
+    // The next request is read once the current one is answered, so responses stay in order
+    if (busy_.contains(socket)) {
+        return;
+    }
+    if (!socket->canReadLine()) {
+        // A client that never ends its line would otherwise make the buffer grow without bound
+        if (socket->bytesAvailable() > MAX_REQUEST_SIZE) {
+            socket->write(errorResponse(QStringLiteral("Request too long.")) + '\n');
+            socket->disconnectFromServer();
+        }
+        return;
+    }
+    auto line = socket->readLine();
+    line.chop(1);
+
+    // Owned by the socket: if the client leaves, the answer is discarded when it is ready
+    auto *watcher = new QFutureWatcher<QByteArray>(socket);
+    connect(watcher, &QFutureWatcherBase::finished, this, [this, socket, watcher] {
+        socket->write(watcher->result() + '\n');
+        watcher->deleteLater();
+        busy_.remove(socket);
+        processNextRequest(socket);
+    });
+    busy_.insert(socket);
+    watcher->setFuture(QtConcurrent::run(&pool_, prepareRequest(line)));
+}
+
+void DeviceQueryServer::publish() {
+    // Requests still running on the previous snapshot keep it alive until they finish
+    snapshot_ = std::make_shared<const DeviceSnapshot>(
+        DeviceSnapshot{snapshot_->generation + 1, devices_});
+}
+
+void DeviceQueryServer::removeDevice(const QString &syspath) {
+    if (const auto it = index_.constFind(syspath); it != index_.cend()) {
+        devices_.removeAt(*it);
+        rebuildIndex();
+    }
+}
+
+void DeviceQueryServer::rebuildIndex() {
+    index_.clear();
+    index_.reserve(devices_.size());
+    for (qsizetype i = 0; i < devices_.size(); ++i) {
+        index_.insert(devices_.at(i).syspath(), i);
+    }
+}
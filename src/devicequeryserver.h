@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QThreadPool>
+#include <QtCore/QTimer>
+
+#include <functional>
+#include <memory>
+
+#include "deviceinfo.h"
+
+QT_BEGIN_NAMESPACE
+class QLocalServer;
+class QLocalSocket;
+QT_END_NAMESPACE
+
+class DeviceQuery;
+
+/**
+ * @brief An immutable set of devices that queries are answered from.
+ */
+struct DeviceSnapshot {
+    quint64 generation = 0;    ///< Increases with every update, starting at 0.
+    QList<DeviceInfo> devices; ///< The devices in enumeration order, newly added ones last.
+};
+
+/**
+ * @brief Answers device queries from a warm snapshot over a local socket.
+ *
+ * The server starts from enumerated devices and keeps them current from device events (see
+ * @c applyEvent()), so clients never wait for an enumeration. Events received together are
+ * applied to a working copy and published as one new snapshot; a request is answered from the
+ * snapshot current when it arrives, which the server never modifies.
+ *
+ * Requests are evaluated on a thread pool, so a slow query (e.g. one reading driver details) holds
+ * up neither other clients nor the events. Devices are held as @c DeviceInfo::detached() copies for
+ * that reason. Each client has at most one request running; its further requests wait in the
+ * socket.
+ *
+ * The protocol is line-based JSON. Each request is one line, for example
+ * @code{.json}
+ * {"filters":["driver=i915"],"fields":["syspath","name"]}
+ * @endcode
+ * with @c filters and @c fields as for @c DeviceQuery::parse(); both are optional. Each response is
+ * one line,
+ * @code{.json}
+ * {"generation":4,"devices":[{"syspath":"/sys/devices/...","name":"..."}]}
+ * @endcode
+ * or @c {"error":"..."} if the request is invalid. A client may send several requests over one
+ * connection and receives the responses in order.
+ */
+class DeviceQueryServer : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Sets the providers of expensive fields on a query before it runs.
+     *
+     * Called on the server's thread with each parsed query and the snapshot it will run over. The
+     * providers are then called on a pool thread, concurrently with other queries' providers.
+     */
+    using ProviderSetup =
+        std::function<void(DeviceQuery &query, const std::shared_ptr<const DeviceSnapshot> &)>;
+
+    /**
+     * @brief Longest request line accepted; the client is disconnected after a longer one.
+     */
+    static constexpr qsizetype MAX_REQUEST_SIZE = 64 * 1024;
+
+    /**
+     * @brief Fewest requests evaluated at once, however few processors there are.
+     */
+    static constexpr int MIN_REQUEST_THREADS = 4;
+
+    /**
+     * @brief Constructs a @c DeviceQueryServer.
+     * @param devices The devices of the first snapshot.
+     * @param parent Optional parent @c QObject for memory management.
+     */
+    explicit DeviceQueryServer(QList<DeviceInfo> devices, QObject *parent = nullptr);
+    ~DeviceQueryServer() override;
+
+    /**
+     * @brief Returns the default socket path, in the user's runtime directory.
+     * @returns The path.
+     */
+    static QString defaultSocketPath();
+
+    /**
+     * @brief Sets how expensive fields are provided; by default they are read from the devices.
+     * @param setup The function setting the providers.
+     */
+    void setProviderSetup(ProviderSetup setup);
+
+    /**
+     * @brief Starts accepting clients. Only the current user may connect.
+     *
+     * A socket left behind by a server that is no longer running is replaced.
+     *
+     * @param path Path of the socket.
+     * @returns @c false if the socket cannot be created or another server is using it.
+     */
+    bool listen(const QString &path);
+
+    /**
+     * @brief Returns a description of the last error of @c listen().
+     * @returns The description.
+     */
+    QString errorString() const;
+
+    /**
+     * @brief Returns the snapshot requests are currently answered from.
+     * @returns The snapshot.
+     */
+    std::shared_ptr<const DeviceSnapshot> snapshot() const;
+
+    /**
+     * @brief Answers one request line on the calling thread.
+     * @param request The request, without its newline.
+     * @returns The response, without its newline.
+     */
+    QByteArray handleRequest(const QByteArray &request) const;
+
+    /**
+     * @brief Waits until no request is being evaluated.
+     */
+    void waitForRequests();
+
+public Q_SLOTS:
+    /**
+     * @brief Applies a device event to the next snapshot.
+     *
+     * @c remove removes the device, @c move replaces the device at its former path, and any other
+     * action adds the device or replaces the entry with the same system path.
+     *
+     * @param action The event's action.
+     * @param device The device as the event describes it.
+     */
+    void applyEvent(const QString &action, const DeviceInfo &device);
+
+    /**
+     * @brief Replaces all devices of the next snapshot, e.g. after events were lost.
+     * @param devices The newly enumerated devices.
+     */
+    void replaceDevices(const QList<DeviceInfo> &devices);
+
+private Q_SLOTS:
+    void onNewConnection();
+    void onReadyRead();
+    void publish();
+
+private:
+    std::function<QByteArray()> prepareRequest(const QByteArray &request) const;
+    void processNextRequest(QLocalSocket *socket);
+    void removeDevice(const QString &syspath);
+    void rebuildIndex();
+
+    QLocalServer *server_;
+    ProviderSetup providerSetup_;
+    QString errorString_;
+    std::shared_ptr<const DeviceSnapshot> snapshot_;
+    QList<DeviceInfo> devices_;       // Working copy the events are applied to
+    QHash<QString, qsizetype> index_; // Positions in devices_ by system path
+    QTimer publishTimer_;
+    QSet<QLocalSocket *> busy_; // Clients with a request being evaluated
+    QThreadPool pool_;
+};
@@ -1,7 +1,14 @@
 // SPDX-License-Identifier: MIT
 #include <QtCore/QCommandLineParser>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 #include <QtCore/QTextStream>
 #include <QtNetwork/QHostInfo>
+#include <QtNetwork/QLocalSocket>
 
 #ifndef HWVIEW_HEADLESS
 #include <QtCore/QSize>
@@ -13,12 +20,25 @@
 #endif // HWVIEW_USE_KDE
 #endif // HWVIEW_HEADLESS
 
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "devicechangewriter.h"
+#include "deviceenumerationfilter.h"
 #include "deviceexport.h"
 #include "deviceinfo.h"
+#include "devicemonitor.h"
+#include "devicequery.h"
+#include "devicequeryserver.h"
 #ifndef HWVIEW_HEADLESS
+#include "devicecache.h"
 #include "mainwindow.h"
 #endif // HWVIEW_HEADLESS
 #include "systeminfo.h"
+#include "systemresources.h"
 
 namespace {
 
@@ -43,25 +63,124 @@ void setupParser(QCommandLineParser &parser) {
     parser.addOption({{QStringLiteral("e"), QStringLiteral("export")},
                       QCoreApplication::translate("main", "Export device data to <file> and exit."),
                       QStringLiteral("file")});
+    parser.addOption(
+        {{QStringLiteral("q"), QStringLiteral("query")},
+         QCoreApplication::translate("main",
+                                     "Print devices to standard output as JSON, one per line, "
+                                     "and exit.")});
+    parser.addOption(
+        {QStringLiteral("filter"),
+         QCoreApplication::translate("main",
+                                     "With --query, only print devices matching <expression>: "
+                                     "field=value, field!=value or field~text. Can be repeated."),
+         QStringLiteral("expression")});
+    parser.addOption(
+        {{QStringLiteral("w"), QStringLiteral("watch")},
+         QCoreApplication::translate("main",
+                                     "Print device events to standard output as JSON, one per "
+                                     "line, until terminated.")});
+    parser.addOption({QStringLiteral("fields"),
+                      QCoreApplication::translate(
+                          "main", "With --query, the comma-separated fields to print."),
+                      QStringLiteral("fields")});
+    parser.addOption(
+        {QStringLiteral("subsystem"),
+         QCoreApplication::translate("main",
+                                     "Only enumerate devices in subsystem <name>, which may be a "
+                                     "wildcard. Can be repeated to allow several subsystems."),
+         QStringLiteral("name")});
+    parser.addOption(
+        {QStringLiteral("property"),
+         QCoreApplication::translate("main",
+                                     "Only enumerate devices with property NAME set to value, "
+                                     "which may be a wildcard. Can be repeated to allow several."),
+         QStringLiteral("NAME=value")});
+    parser.addOption({QStringLiteral("parent"),
+                      QCoreApplication::translate(
+                          "main", "Only enumerate the device at <syspath> and its descendants."),
+                      QStringLiteral("syspath")});
+    parser.addOption(
+        {QStringLiteral("with-driver"),
+         QCoreApplication::translate("main", "Only enumerate devices bound to a driver.")});
+    parser.addOption(
+        {QStringLiteral("daemon"),
+         QCoreApplication::translate("main",
+                                     "Keep the devices up to date and answer queries on a local "
+                                     "socket until terminated.")});
+    parser.addOption(
+        {QStringLiteral("socket"),
+         QCoreApplication::translate("main",
+                                     "Socket the --daemon listens on, or that --query asks "
+                                     "instead of enumerating devices."),
+         QStringLiteral("path")});
+}
+
+/**
+ * @brief Build the enumeration filter from the @c --subsystem, @c --property, @c --parent and
+ * @c --with-driver options, printing an error if one is invalid.
+ * @param parser Command line parser holding the options.
+ * @returns The filter, or @c std::nullopt if an option is invalid, cannot be applied by this
+ * platform's backend or names a parent that does not exist.
+ */
+std::optional<DeviceEnumerationFilter> enumerationFilter(const QCommandLineParser &parser) {
+    QTextStream err(stderr);
+    auto filter = DeviceEnumerationFilter::parse(parser.values(QStringLiteral("subsystem")),
+                                                 parser.values(QStringLiteral("property")),
+                                                 parser.value(QStringLiteral("parent")),
+                                                 parser.isSet(QStringLiteral("with-driver")));
+    if (!filter) {
+        err << QStringLiteral("Error: %1").arg(filter.error()) << Qt::endl;
+        return std::nullopt;
+    }
+    // Without property lookups every match would fail and enumerate nothing
+    if (!filter->properties.isEmpty() && !supportsPropertyFilter()) {
+        err << QStringLiteral("Error: --property is not supported on this platform.") << Qt::endl;
+        return std::nullopt;
+    }
+    // Enumerating a missing subtree would otherwise look like a subtree without devices
+    if (!filter->parentSyspath.isEmpty() && !deviceExists(filter->parentSyspath)) {
+        err << QStringLiteral("Error: No device at %1.").arg(filter->parentSyspath) << Qt::endl;
+        return std::nullopt;
+    }
+    return *filter;
+}
+
+/**
+ * @brief Print an error if enumeration options were given to a mode that does not enumerate.
+ * @param filter The filter built from the options.
+ * @param mode The mode's options as the user gave them, e.g. @c --watch.
+ * @returns @c true if no enumeration option was given.
+ */
+bool checkFilterUnused(const DeviceEnumerationFilter &filter, const QString &mode) {
+    if (filter.isEmpty()) {
+        return true;
+    }
+    QTextStream err(stderr);
+    err << QStringLiteral("Error: --subsystem, --property, --parent and --with-driver cannot be "
+                          "used with %1.")
+               .arg(mode)
+        << Qt::endl;
+    return false;
 }
 
 /**
  * @brief Perform headless export to file.
  * @param filePath Path to export file.
+ * @param filter Limits the devices exported.
  * @returns 0 on success, 1 on failure.
  */
-int performExport(const QString &filePath) {
+int performExport(const QString &filePath, const DeviceEnumerationFilter &filter) {
     QTextStream out(stdout);
     QTextStream err(stderr);
 
     out << QStringLiteral("Enumerating devices...") << Qt::endl;
-    auto devices = enumerateAllDevices();
+    auto devices = enumerateDevices(filter);
     out << QStringLiteral("Found %1 devices.").arg(devices.size()) << Qt::endl;
 
     auto hostname = QHostInfo::localHostName();
     out << QStringLiteral("Exporting to: %1").arg(filePath) << Qt::endl;
 
-    if (DeviceExport::exportToFile(filePath, devices, hostname)) {
+    if (DeviceExport::exportToFile(filePath, devices, hostname, getSystemResources(devices))) {
         out << QStringLiteral("Export successful.") << Qt::endl;
         return 0;
     }
@@ -69,6 +188,338 @@ int performExport(const QString &filePath) {
     return 1;
 }
 
+/**
+ * @brief Set the providers of the fields that are expensive to compute for live devices.
+ * @param query Query to set the providers on.
+ * @param resources Returns the resource tables, read once when first needed.
+ */
+void setExportFieldProviders(DeviceQuery &query,
+                             std::function<const SystemResources &()> resources) {
+    query.setFieldProvider(QStringLiteral("properties"), [](const DeviceInfo &info) {
+        return QJsonValue(DeviceExport::serializeProperties(info));
+    });
+    query.setFieldProvider(QStringLiteral("driverInfo"), [](const DeviceInfo &info) {
+        return QJsonValue(DeviceExport::serializeDriverInfo(info));
+    });
+    query.setFieldProvider(QStringLiteral("resources"),
+                           [resources = std::move(resources)](const DeviceInfo &info) {
+                               return QJsonValue(DeviceExport::serializeResources(
+                                   resources().deviceResources.value(info.syspath())));
+                           });
+}
+
+/**
+ * @brief Get the fields named by the @c --fields option.
+ * @param parser Command line parser holding the query options.
+ * @returns The field names, empty for the default fields.
+ */
+QStringList queryFields(const QCommandLineParser &parser) {
+    return parser.value(QStringLiteral("fields")).split(QLatin1Char(','), Qt::SkipEmptyParts);
+}
+
+/**
+ * @brief Ask the daemon listening on the @c --socket path and print its answer as NDJSON.
+ * @param parser Command line parser holding the query options.
+ * @returns 0 on success, 1 if the daemon cannot be reached or rejects the query.
+ */
+int performRemoteQuery(const QCommandLineParser &parser) {
+    QTextStream err(stderr);
+
+    const auto path = parser.value(QStringLiteral("socket"));
+    QLocalSocket socket;
+    socket.connectToServer(path);
+    if (!socket.waitForConnected(1000)) {
+        err << QStringLiteral("Error: Failed to connect to %1: %2")
+                   .arg(path, socket.errorString())
+            << Qt::endl;
+        return 1;
+    }
+    const QJsonObject request{
+        {QStringLiteral("filters"),
+         QJsonArray::fromStringList(parser.values(QStringLiteral("filter")))},
+        {QStringLiteral("fields"), QJsonArray::fromStringList(queryFields(parser))},
+    };
+    socket.write(QJsonDocument(request).toJson(QJsonDocument::Compact) + '\n');
+    while (!socket.canReadLine()) {
+        if (!socket.waitForReadyRead(30000)) {
+            err << QStringLiteral("Error: No answer from %1.").arg(path) << Qt::endl;
+            return 1;
+        }
+    }
+    const auto response = QJsonDocument::fromJson(socket.readLine()).object();
+    if (const auto error = response.value(QStringLiteral("error")); error.isString()) {
+        err << QStringLiteral("Error: %1").arg(error.toString()) << Qt::endl;
+        return 1;
+    }
+
+    QFile out;
+    if (!out.open(stdout, QIODevice::WriteOnly)) {
+        err << QStringLiteral("Error: Failed to open standard output.") << Qt::endl;
+        return 1;
+    }
+    for (const auto &device : response.value(QStringLiteral("devices")).toArray()) {
+        out.write(QJsonDocument(device.toObject()).toJson(QJsonDocument::Compact));
+        out.write("\n", 1);
+    }
+    return 0;
+}
+
+/**
+ * @brief Print the devices matching the @c --filter options as NDJSON to standard output.
+ *
+ * Only the fields the filters and @c --fields name are computed, so driver, property and
+ * resource lookups are skipped unless asked for. With @c --socket the daemon is asked instead.
+ *
+ * @param parser Command line parser holding the query options.
+ * @param filter Limits the devices enumerated; must be empty with @c --socket, since the daemon
+ * serves the devices it enumerated.
+ * @returns 0 on success, 1 if the query is invalid.
+ */
+int performQuery(const QCommandLineParser &parser, const DeviceEnumerationFilter &filter) {
+    if (parser.isSet(QStringLiteral("socket"))) {
+        if (!checkFilterUnused(filter, QStringLiteral("--query --socket"))) {
+            return 1;
+        }
+        return performRemoteQuery(parser);
+    }
+    QTextStream err(stderr);
+
+    auto query =
+        DeviceQuery::parse(parser.values(QStringLiteral("filter")), queryFields(parser));
+    if (!query) {
+        err << QStringLiteral("Error: %1").arg(query.error()) << Qt::endl;
+        return 1;
+    }
+
+    const auto devices = enumerateDevices(filter);
+    // The resource tables are read for all devices at once, on first use
+    std::optional<SystemResources> resources;
+    setExportFieldProviders(*query, [&]() -> const SystemResources & {
+        if (!resources) {
+            resources = getSystemResources(devices);
+        }
+        return *resources;
+    });
+
+    QFile out;
+    if (!out.open(stdout, QIODevice::WriteOnly)) {
+        err << QStringLiteral("Error: Failed to open standard output.") << Qt::endl;
+        return 1;
+    }
+    for (const auto &info : devices) {
+        if (const auto device = query->evaluate(info)) {
+            out.write(QJsonDocument(*device).toJson(QJsonDocument::Compact));
+            out.write("\n", 1);
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Print device events as NDJSON to standard output until the process is terminated.
+ * @param filter Must be empty; events are reported for every device.
+ * @returns 1 if device events cannot be monitored; otherwise the event loop's exit code.
+ */
+int performWatch(const DeviceEnumerationFilter &filter) {
+    if (!checkFilterUnused(filter, QStringLiteral("--watch"))) {
+        return 1;
+    }
+    QTextStream err(stderr);
+
+    const std::unique_ptr<QObject> monitorObject(createDeviceMonitor(nullptr));
+    auto *monitor = qobject_cast<DeviceMonitor *>(monitorObject.get());
+    if (!monitor) {
+        err << QStringLiteral("Error: Device events cannot be monitored on this system.")
+            << Qt::endl;
+        return 1;
+    }
+
+    QFile out;
+    if (!out.open(stdout, QIODevice::WriteOnly)) {
+        err << QStringLiteral("Error: Failed to open standard output.") << Qt::endl;
+        return 1;
+    }
+    DeviceChangeWriter writer(&out, [](const DeviceInfo &info) {
+        return DeviceExport::serializeDevice(info, getExportDeviceResources(info.syspath()));
+    });
+    QObject::connect(monitor, &DeviceMonitor::deviceEvent, &writer, &DeviceChangeWriter::addEvent);
+    if (const auto result = monitor->start(); !result) {
+        err << QStringLiteral("Error: Failed to start monitoring devices (error %1).")
+                   .arg(static_cast<int>(result.error()))
+            << Qt::endl;
+        return 1;
+    }
+    writer.start();
+    return QCoreApplication::exec();
+}
+
+/**
+ * @brief The daemon's cache of expensive fields, shared by queries running concurrently.
+ *
+ * Resource tables are read at most once per snapshot. Driver details only depend on the driver
+ * and take a process per lookup, so they are kept per driver until the devices change.
+ */
+class DaemonFieldCache {
+public:
+    /**
+     * @brief Returns the resource tables of a snapshot, reading them when first needed.
+     * @param snapshot The snapshot a query runs over.
+     * @returns The resource tables.
+     */
+    std::shared_ptr<const SystemResources>
+    resources(const std::shared_ptr<const DeviceSnapshot> &snapshot) {
+        {
+            QMutexLocker locker(&mutex_);
+            if (!isStale(snapshot->generation) && resources_) {
+                return resources_;
+            }
+        }
+        // Read without the lock, so queries needing only cached fields are not held up
+        auto resources =
+            std::make_shared<const SystemResources>(getSystemResources(snapshot->devices));
+        QMutexLocker locker(&mutex_);
+        if (!isStale(snapshot->generation)) {
+            resources_ = resources;
+        }
+        return resources;
+    }
+
+    /**
+     * @brief Returns the driver details of a device, looking them up once per driver.
+     * @param generation The generation of the snapshot the query runs over.
+     * @param info The device.
+     * @returns The driver details as exported.
+     */
+    QJsonObject driverInfo(quint64 generation, const DeviceInfo &info) {
+        const auto driver = info.driver();
+        {
+            QMutexLocker locker(&mutex_);
+            if (!isStale(generation)) {
+                if (const auto it = driverInfo_.constFind(driver); it != driverInfo_.cend()) {
+                    return *it;
+                }
+            }
+        }
+        auto result = DeviceExport::serializeDriverInfo(info);
+        QMutexLocker locker(&mutex_);
+        if (!isStale(generation)) {
+            driverInfo_.insert(driver, result);
+        }
+        return result;
+    }
+
+private:
+    // Drops what was cached for older snapshots; true if the generation itself is older
+    bool isStale(quint64 generation) {
+        if (generation > generation_) {
+            generation_ = generation;
+            resources_.reset();
+            driverInfo_.clear();
+        }
+        return generation < generation_;
+    }
+
+    QMutex mutex_;
+    quint64 generation_ = 0;
+    std::shared_ptr<const SystemResources> resources_;
+    QHash<QString, QJsonObject> driverInfo_;
+};
+
+/**
+ * @brief Answer queries on a local socket from devices kept up to date by device events.
+ *
+ * Devices are enumerated once; afterwards only the events change them, so answering costs no
+ * enumeration. They are enumerated again if events were lost. Where device events cannot be
+ * monitored the devices are served as enumerated.
+ *
+ * @param parser Command line parser holding the @c --socket option.
+ * @param filter Must be empty; the devices are kept up to date from events for every device.
+ * @returns 1 if the socket cannot be created; otherwise the event loop's exit code.
+ */
+int performDaemon(const QCommandLineParser &parser, const DeviceEnumerationFilter &filter) {
+    if (!checkFilterUnused(filter, QStringLiteral("--daemon"))) {
+        return 1;
+    }
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+
+    // Started before enumerating, so changes made meanwhile are still applied afterwards
+    const std::unique_ptr<QObject> monitorObject(createDeviceMonitor(nullptr));
+    auto *monitor = qobject_cast<DeviceMonitor *>(monitorObject.get());
+    if (!monitor || !monitor->start()) {
+        err << QStringLiteral("Warning: Device events cannot be monitored; devices will not be "
+                              "updated.")
+            << Qt::endl;
+    }
+
+    DeviceQueryServer server(enumerateAllDevices());
+    if (monitor) {
+        QObject::connect(
+            monitor, &DeviceMonitor::deviceEvent, &server, &DeviceQueryServer::applyEvent);
+        QObject::connect(monitor, &DeviceMonitor::eventsLost, &server, [&server] {
+            server.replaceDevices(enumerateAllDevices());
+        });
+    }
+    // Providers run on the server's pool threads, so they share the cache rather than locals
+    const auto cache = std::make_shared<DaemonFieldCache>();
+    server.setProviderSetup(
+        [cache](DeviceQuery &query, const std::shared_ptr<const DeviceSnapshot> &snapshot) {
+            // Keeps the tables alive while the query refers to them
+            auto held = std::make_shared<std::shared_ptr<const SystemResources>>();
+            setExportFieldProviders(query, [cache, snapshot, held]() -> const SystemResources & {
+                if (!*held) {
+                    *held = cache->resources(snapshot);
+                }
+                return **held;
+            });
+            query.setFieldProvider(QStringLiteral("driverInfo"),
+                                   [cache, generation = snapshot->generation](
+                                       const DeviceInfo &info) {
+                                       return QJsonValue(cache->driverInfo(generation, info));
+                                   });
+        });
+
+    const auto path = parser.isSet(QStringLiteral("socket")) ?
+                          parser.value(QStringLiteral("socket")) :
+                          DeviceQueryServer::defaultSocketPath();
+    if (!server.listen(path)) {
+        err << QStringLiteral("Error: Failed to listen on %1: %2").arg(path, server.errorString())
+            << Qt::endl;
+        return 1;
+    }
+    out << QStringLiteral("Serving %1 devices on %2.")
+               .arg(server.snapshot()->devices.size())
+               .arg(path)
+        << Qt::endl;
+    return QCoreApplication::exec();
+}
+
+#ifndef HWVIEW_HEADLESS
+/**
+ * @brief Check whether the command line selects a mode that shows no window.
+ *
+ * The application object has to be chosen before the parser can run, so this looks for the
+ * options in the raw arguments.
+ *
+ * @param argc Argument count.
+ * @param argv Arguments.
+ * @returns @c true if @c --query, @c --watch or @c --daemon is given.
+ */
+bool isHeadlessInvocation(int argc, char *argv[]) {
+    for (auto i = 1; i < argc; ++i) {
+        const std::string_view arg(argv[i]);
+        if (arg == "--") {
+            break;
+        }
+        if (arg == "-q" || arg == "--query" || arg == "-w" || arg == "--watch" ||
+            arg == "--daemon") {
+            return true;
+        }
+    }
+    return false;
+}
+#endif // HWVIEW_HEADLESS
+
 } // namespace
 
 int main(int argc, char *argv[]) {
@@ -79,6 +530,20 @@ int main(int argc, char *argv[]) {
     setAppMetadata();
     setupParser(parser);
     parser.process(app);
+    const auto filter = enumerationFilter(parser);
+    if (!filter) {
+        return 1;
+    }
+
+    if (parser.isSet(QStringLiteral("query"))) {
+        return performQuery(parser, *filter);
+    }
+    if (parser.isSet(QStringLiteral("watch"))) {
+        return performWatch(*filter);
+    }
+    if (parser.isSet(QStringLiteral("daemon"))) {
+        return performDaemon(parser, *filter);
+    }
 
     auto exportPath = parser.value(QStringLiteral("export"));
     if (exportPath.isEmpty()) {
@@ -92,9 +557,15 @@ int main(int argc, char *argv[]) {
         exportPath += QLatin1String(DeviceExport::FILE_EXTENSION);
     }
 
-    return performExport(exportPath);
+    return performExport(exportPath, *filter);
 #else
-    QApplication app(argc, argv);
+    // The headless modes must also run where there is no display, which QApplication requires
+    std::unique_ptr<QCoreApplication> app;
+    if (isHeadlessInvocation(argc, argv)) {
+        app = std::make_unique<QCoreApplication>(argc, argv);
+    } else {
+        app = std::make_unique<QApplication>(argc, argv);
+    }
     setAppMetadata();
 
 #ifdef HWVIEW_USE_KDE
@@ -119,7 +590,11 @@ int main(int argc, char *argv[]) {
     parser.addPositionalArgument(QStringLiteral("file"),
                                  QCoreApplication::translate("main", "Export file to open."),
                                  QStringLiteral("[file]"));
-    parser.process(app);
+    parser.process(*app);
+    const auto filter = enumerationFilter(parser);
+    if (!filter) {
+        return 1;
+    }
 
     // Handle --export option.
     if (parser.isSet(QStringLiteral("export"))) {
@@ -133,7 +608,30 @@ int main(int argc, char *argv[]) {
                                  Qt::CaseInsensitive)) {
             exportPath += QLatin1String(DeviceExport::FILE_EXTENSION);
         }
-        return performExport(exportPath);
+        return performExport(exportPath, *filter);
+    }
+
+    // Handle --query option.
+    if (parser.isSet(QStringLiteral("query"))) {
+        return performQuery(parser, *filter);
+    }
+
+    // Handle --watch option.
+    if (parser.isSet(QStringLiteral("watch"))) {
+        return performWatch(*filter);
+    }
+
+    // Handle --daemon option.
+    if (parser.isSet(QStringLiteral("daemon"))) {
+        return performDaemon(parser, *filter);
+    }
+
+    if (!qobject_cast<QApplication *>(app.get())) {
+        // A headless option was only the value of another option
+        QTextStream err(stderr);
+        err << QStringLiteral("Error: --query, --watch and --daemon cannot be option values.")
+            << Qt::endl;
+        return 1;
     }
 
     QIcon appIcon;
@@ -145,6 +643,8 @@ int main(int argc, char *argv[]) {
     appIcon.addFile(QStringLiteral(":/icons/icon_512.png"), QSize(512, 512));
     QApplication::setWindowIcon(appIcon);
 
+    // Before the window creates the cache, so that the first enumeration is already filtered
+    DeviceCache::setEnumerationFilter(*filter);
     auto *mainWin = new MainWindow;
     mainWin->setAttribute(Qt::WA_DeleteOnClose);
     mainWin->show();
@@ -155,6 +655,6 @@ int main(int argc, char *argv[]) {
         mainWin->loadExportFile(args.first());
     }
 
-    return app.exec();
+    return QCoreApplication::exec();
 #endif // HWVIEW_HEADLESS
 }
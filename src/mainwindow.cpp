@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
 #include <QtConcurrent/QtConcurrent>
 #include <QtCore/QStandardPaths>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtGui/QAction>
 #include <QtGui/QActionGroup>
@@ -8,6 +9,7 @@
 #include <QtGui/QIcon>
 #include <QtGui/QKeyEvent>
 #include <QtGui/QKeySequence>
+#include <QtGui/QShortcut>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QHeaderView>
 #include <QtWidgets/QMenu>
@@ -16,6 +18,8 @@
 #include <QtWidgets/QProgressDialog>
 #include <QtWidgets/QWhatsThis>
 
+#include <algorithm>
+
 #ifdef HWVIEW_USE_KDE
 #include <KAboutApplicationDialog>
 #include <KAboutData>
@@ -30,6 +34,7 @@
 #include "devicecache.h"
 #include "deviceexport.h"
 #include "mainwindow.h"
+#include "models/basetreemodel.h"
 #include "models/devbyconnmodel.h"
 #include "models/devbydrivermodel.h"
 #include "models/devbytypemodel.h"
@@ -38,6 +43,7 @@
 #include "models/node.h"
 #include "models/resbyconnmodel.h"
 #include "models/resbytypemodel.h"
+#include "models/resourcesmodel.h"
 #include "propertiesdialog.h"
 #include "systeminfo.h"
 #include "viewsettings.h"
@@ -92,6 +98,12 @@ MainWindow::MainWindow() {
         switchToModel(new ResourcesByConnectionModel(this));
     });
 
+    // Interrupt rate sampling for the resource views, once per second while enabled
+    irqSampleTimer_ = new QTimer(this);
+    irqSampleTimer_->setInterval(1000);
+    connect(irqSampleTimer_, &QTimer::timeout, this, &MainWindow::sampleIrqRates);
+    connect(actionSampleInterruptRates, &QAction::toggled, this, &MainWindow::toggleIrqSampling);
+
     // Restore last view on startup
     restoreLastView();
 
@@ -133,6 +145,18 @@ MainWindow::MainWindow() {
     // Install event filter to handle Enter key for expand/collapse on categories
     treeView->installEventFilter(this);
 
+    // Live search over the current view (Ctrl+F focuses the search box), applied once typing
+    // pauses rather than on every keystroke
+    searchTimer_ = new QTimer(this);
+    searchTimer_->setSingleShot(true);
+    searchTimer_->setInterval(150);
+    connect(searchTimer_, &QTimer::timeout, this, &MainWindow::applySearchFilter);
+    connect(lineEditSearch, &QLineEdit::textChanged, this, &MainWindow::onSearchTextChanged);
+    connect(new QShortcut(QKeySequence::Find, this), &QShortcut::activated, this, [this]() {
+        lineEditSearch->setFocus();
+        lineEditSearch->selectAll();
+    });
+
     // Connect to device monitor for automatic refresh on device changes
     connectDeviceMonitor();
 
@@ -151,12 +175,18 @@ void MainWindow::switchToModel(QAbstractItemModel *model, int depth) {
     }
     if (model != nullptr) {
         if (ViewSettings::instance().expandAllOnLoad()) {
+            // expandAll() does not fetch deferred subtrees, so load them up front
+            if (auto *treeModel = qobject_cast<BaseTreeModel *>(model)) {
+                treeModel->fetchAll();
+            }
             treeView->expandAll();
         } else {
             treeView->expandToDepth(depth);
         }
     }
+    applySearchFilter();
     applyViewSettings();
+    updateIrqSampling();
 }
 
 void MainWindow::switchToDevicesByType() {
@@ -167,12 +197,15 @@ void MainWindow::switchToDevicesByType() {
         oldModel->deleteLater();
     }
     if (ViewSettings::instance().expandAllOnLoad()) {
+        model->fetchAll();
         treeView->expandAll();
     } else {
         // Expand only the hostname, keeping all categories collapsed
         treeView->expandToDepth(0);
     }
+    applySearchFilter();
     applyViewSettings();
+    updateIrqSampling();
 }
 
 void MainWindow::restoreLastView() {
@@ -269,9 +302,47 @@ void MainWindow::toggleShowHiddenDevices(bool checked) {
     refreshCurrentView();
 }
 
+void MainWindow::toggleIrqSampling(bool checked) {
+    if (!checked) {
+        // Drop the rates so the labels go back to plain IRQ names
+        irqRates_.clear();
+        if (auto *model = qobject_cast<ResourcesModel *>(treeView->model())) {
+            model->setIrqRates(irqRates_);
+        }
+    }
+    updateIrqSampling();
+}
+
+void MainWindow::updateIrqSampling() {
+    const auto live = !DeviceCache::instance().isViewerMode();
+    actionSampleInterruptRates->setEnabled(live);
+
+    auto *model = qobject_cast<ResourcesModel *>(treeView->model());
+    if (!model || !live || !actionSampleInterruptRates->isChecked()) {
+        irqSampleTimer_->stop();
+        return;
+    }
+    if (irqSampleTimer_->isActive()) {
+        // A rebuilt view picks up the rates sampled so far
+        model->setIrqRates(irqRates_);
+        return;
+    }
+    irqRates_.clear();
+    irqSampleClock_.start();
+    sampleIrqRates();
+    irqSampleTimer_->start();
+}
+
+void MainWindow::sampleIrqRates() {
+    irqRates_.addSample(getSystemIrqs(), irqSampleClock_.elapsed());
+    if (auto *model = qobject_cast<ResourcesModel *>(treeView->model())) {
+        model->setIrqRates(irqRates_);
+    }
+}
+
 void MainWindow::refreshCurrentView() {
     // Save expanded state before rebuilding
-    auto expandedPaths = saveExpandedState();
+    auto expandedKeys = saveExpandedState();
 
     // Trigger the current view action to rebuild the model
     if (currentViewAction == actionDevicesByType) {
@@ -320,8 +391,10 @@ void MainWindow::refreshCurrentView() {
     }
 
     // Restore expanded state
-    restoreExpandedState(expandedPaths);
+    restoreExpandedState(expandedKeys);
+    applySearchFilter();
     applyViewSettings();
+    updateIrqSampling();
 }
 
 void MainWindow::scanForHardwareChanges() {
@@ -463,9 +536,10 @@ void MainWindow::exportDeviceData() {
     // Capture device data before starting the background thread
     auto devices = DeviceCache::instance().allDevices();
     auto hostname = DeviceCache::hostname();
+    auto resources = DeviceCache::instance().resourceSnapshot();
 
-    auto future = QtConcurrent::run([filePath, devices, hostname]() {
-        return DeviceExport::exportToFile(filePath, devices, hostname);
+    auto future = QtConcurrent::run([filePath, devices, hostname, resources]() {
+        return DeviceExport::exportToFile(filePath, devices, hostname, resources);
     });
     watcher->setFuture(future);
 }
@@ -593,75 +667,108 @@ void MainWindow::connectDeviceMonitor() {
             &MainWindow::refreshCurrentView);
 }
 
-QSet<QString> MainWindow::saveExpandedState() const {
-    QSet<QString> expandedPaths;
-    auto *model = treeView->model();
-    if (!model) {
-        return expandedPaths;
+QStringList MainWindow::saveExpandedState() const {
+    QStringList expandedKeys;
+    if (treeView->model()) {
+        collectExpandedKeys(QModelIndex(), expandedKeys);
     }
-    collectExpandedPaths(QModelIndex(), QString(), expandedPaths);
-    return expandedPaths;
+    return expandedKeys;
 }
 
-void MainWindow::collectExpandedPaths(const QModelIndex &parent,
-                                      const QString &parentPath,
-                                      QSet<QString> &expandedPaths) const {
+void MainWindow::collectExpandedKeys(const QModelIndex &parent, QStringList &expandedKeys) const {
     auto *model = treeView->model();
-    if (!model) {
-        return;
-    }
-
     auto rowCount = model->rowCount(parent);
     for (auto row = 0; row < rowCount; ++row) {
         auto index = model->index(row, 0, parent);
-        if (!index.isValid()) {
+        // Only descend into expanded nodes; collapsed subtrees cannot contain visible state
+        if (!index.isValid() || !treeView->isExpanded(index)) {
             continue;
         }
+        // Pre-order, so a restore sees every parent before its children
+        expandedKeys.append(static_cast<Node *>(index.internalPointer())->key());
+        collectExpandedKeys(index, expandedKeys);
+    }
+}
 
-        // Build the path using the display name
-        auto name = model->data(index, Qt::DisplayRole).toString();
-        auto path = parentPath.isEmpty() ? name : parentPath + QStringLiteral("/") + name;
+void MainWindow::restoreExpandedState(const QStringList &expandedKeys) {
+    auto *model = qobject_cast<BaseTreeModel *>(treeView->model());
+    if (!model || expandedKeys.isEmpty()) {
+        return;
+    }
 
-        if (treeView->isExpanded(index)) {
-            expandedPaths.insert(path);
-            // Recursively check children
-            collectExpandedPaths(index, path, expandedPaths);
+    // Expand in one batch: look each key up directly and lay the view out once at the end
+    treeView->setUpdatesEnabled(false);
+    for (const auto &key : expandedKeys) {
+        auto index = model->indexForKey(key);
+        if (!index.isValid()) {
+            continue;
+        }
+        // Populate deferred children now so that expanded descendants can be found
+        if (model->canFetchMore(index)) {
+            model->fetchMore(index);
         }
+        treeView->expand(index);
     }
+    treeView->setUpdatesEnabled(true);
 }
 
-void MainWindow::restoreExpandedState(const QSet<QString> &expandedPaths) {
-    if (expandedPaths.isEmpty()) {
+void MainWindow::onSearchTextChanged(const QString &text) {
+    auto active = !text.trimmed().isEmpty();
+    if (active && !searchActive_) {
+        // Remember how the tree looked so clearing the search can put it back
+        preSearchExpandedState_ = saveExpandedState();
+    }
+    searchActive_ = active;
+
+    if (active) {
+        searchTimer_->start();
         return;
     }
-    expandMatchingPaths(QModelIndex(), QString(), expandedPaths);
+    searchTimer_->stop();
+    if (auto *model = qobject_cast<BaseTreeModel *>(treeView->model());
+        model && model->isFiltered()) {
+        model->clearFilter();
+        if (preSearchExpandedState_.isEmpty()) {
+            treeView->expandToDepth(0);
+        } else {
+            restoreExpandedState(preSearchExpandedState_);
+        }
+    }
+    preSearchExpandedState_.clear();
 }
 
-void MainWindow::expandMatchingPaths(const QModelIndex &parent,
-                                     const QString &parentPath,
-                                     const QSet<QString> &expandedPaths) {
-    auto *model = treeView->model();
-    if (!model) {
+void MainWindow::applySearchFilter() {
+    auto *model = qobject_cast<BaseTreeModel *>(treeView->model());
+    if (!model || !searchActive_) {
         return;
     }
 
-    auto rowCount = model->rowCount(parent);
-    for (auto row = 0; row < rowCount; ++row) {
-        auto index = model->index(row, 0, parent);
-        if (!index.isValid()) {
-            continue;
+    auto query = lineEditSearch->text().simplified();
+    auto terms = query.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+    // Devices are matched through the cache's search index alone, which covers the names the
+    // device views show. Labels (categories and drivers) and resources are matched on their display
+    // text; resources linked to a device match either way
+    auto syspaths = DeviceCache::instance().matchingSyspaths(query);
+    auto resources = qobject_cast<ResourcesModel *>(model) != nullptr;
+    model->setFilter([&syspaths, &terms, resources](const Node *node) {
+        const auto &syspath = node->syspath();
+        if (!syspath.isEmpty() && syspaths.contains(syspath)) {
+            return true;
         }
-
-        // Build the path using the display name
-        auto name = model->data(index, Qt::DisplayRole).toString();
-        auto path = parentPath.isEmpty() ? name : parentPath + QStringLiteral("/") + name;
-
-        if (expandedPaths.contains(path)) {
-            treeView->expand(index);
-            // Recursively expand children
-            expandMatchingPaths(index, path, expandedPaths);
+        if (!syspath.isEmpty() && !resources) {
+            return false;
         }
+        auto text = node->data(0).toString();
+        return std::all_of(terms.cbegin(), terms.cend(), [&text](const QString &term) {
+            return text.contains(term, Qt::CaseInsensitive);
+        });
+    });
+    // Reveal the matches only; what lies below a matched node stays collapsed
+    treeView->setUpdatesEnabled(false);
+    for (const auto &index : model->matchAncestors()) {
+        treeView->expand(index);
     }
+    treeView->setUpdatesEnabled(true);
 }
 
 #ifdef HWVIEW_USE_KDE
@@ -8,15 +8,18 @@
 #include <QtWidgets/QMainWindow>
 #endif // HWVIEW_USE_KDE
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFutureWatcher>
-#include <QtCore/QSet>
+#include <QtCore/QStringList>
 
+#include "irqratesampler.h"
 #include "ui_mainwindow.h"
 
 QT_BEGIN_NAMESPACE
 class QAbstractItemModel;
 class QActionGroup;
 class QProgressDialog;
+class QTimer;
 QT_END_NAMESPACE
 
 /**
@@ -65,6 +68,8 @@ private Q_SLOTS:
     void switchToDevicesByType();
     void switchToModel(QAbstractItemModel *model, int depth = 0);
     void toggleShowHiddenDevices(bool checked);
+    void toggleIrqSampling(bool checked);
+    void sampleIrqRates();
     void refreshCurrentView();
     void scanForHardwareChanges();
     void onScanComplete();
@@ -74,6 +79,7 @@ private Q_SLOTS:
     void exportDeviceData();
     void openExportFile();
     void returnToLiveView();
+    void onSearchTextChanged(const QString &text);
 
 protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -82,14 +88,11 @@ private:
     void setupMenus();
     void restoreLastView();
     void connectDeviceMonitor();
-    QSet<QString> saveExpandedState() const;
-    void restoreExpandedState(const QSet<QString> &expandedPaths);
-    void collectExpandedPaths(const QModelIndex &parent,
-                              const QString &parentPath,
-                              QSet<QString> &expandedPaths) const;
-    void expandMatchingPaths(const QModelIndex &parent,
-                             const QString &parentPath,
-                             const QSet<QString> &expandedPaths);
+    QStringList saveExpandedState() const;
+    void restoreExpandedState(const QStringList &expandedKeys);
+    void applySearchFilter();
+    void updateIrqSampling();
+    void collectExpandedKeys(const QModelIndex &parent, QStringList &expandedKeys) const;
 
 #ifdef HWVIEW_USE_KDE
     void setupActions();
@@ -100,4 +103,10 @@ private:
     QAction *currentViewAction = nullptr;
     QProgressDialog *scanProgressDialog = nullptr;
     QFutureWatcher<void> *scanWatcher_ = nullptr;
+    bool searchActive_ = false;
+    QStringList preSearchExpandedState_;
+    QTimer *searchTimer_ = nullptr;
+    QTimer *irqSampleTimer_ = nullptr;
+    QElapsedTimer irqSampleClock_;
+    IrqRateSampler irqRates_;
 };
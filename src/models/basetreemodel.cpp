@@ -14,6 +14,7 @@ Node *BaseTreeModel::rootItem() const {
 
 void BaseTreeModel::setRootItem(Node *root) {
     rootItem_ = root;
+    allLoaded_ = false;
 }
 
 bool BaseTreeModel::shouldShowIcons() const {
@@ -40,7 +41,7 @@ QModelIndex BaseTreeModel::index(int row, int column, const QModelIndex &parent)
         return {};
     }
     Node *parentItem = parent.isValid() ? static_cast<Node *>(parent.internalPointer()) : rootItem_;
-    if (Node *childItem = parentItem->child(row)) {
+    if (Node *childItem = visibleChild(parentItem, row)) {
         return createIndex(row, column, childItem);
     }
     return {};
@@ -55,7 +56,7 @@ QModelIndex BaseTreeModel::parent(const QModelIndex &index) const {
     if (parentItem == rootItem_) {
         return {};
     }
-    return createIndex(parentItem->row(), 0, parentItem);
+    return createIndex(visibleRow(parentItem), 0, parentItem);
 }
 
 int BaseTreeModel::rowCount(const QModelIndex &parent) const {
@@ -63,7 +64,7 @@ int BaseTreeModel::rowCount(const QModelIndex &parent) const {
         return 0;
     }
     Node *parentItem = parent.isValid() ? static_cast<Node *>(parent.internalPointer()) : rootItem_;
-    return parentItem->childCount();
+    return visibleChildCount(parentItem);
 }
 
 int BaseTreeModel::columnCount(const QModelIndex &parent) const {
@@ -84,22 +85,200 @@ QVariant BaseTreeModel::data(const QModelIndex &index, int role) const {
     case Qt::DisplayRole:
         return item->data(index.column());
     case Qt::ToolTipRole:
-        // Show raw name as tooltip if it differs from display name
-        if (index.column() == 0 && !item->rawName().isEmpty()) {
-            auto displayName = item->data(0).toString();
-            if (item->rawName() != displayName) {
-                return item->rawName();
-            }
-        }
-        return {};
+        return toolTipData(item, index.column());
     default:
         return {};
     }
 }
 
+QVariant BaseTreeModel::toolTipData(Node *item, int column) const {
+    // Show raw name as tooltip if it differs from display name
+    if (column == 0 && !item->rawName().isEmpty()) {
+        auto displayName = item->data(0).toString();
+        if (item->rawName() != displayName) {
+            return item->rawName();
+        }
+    }
+    return {};
+}
+
 Qt::ItemFlags BaseTreeModel::flags(const QModelIndex &index) const {
     if (!index.isValid()) {
         return Qt::NoItemFlags;
     }
     return QAbstractItemModel::flags(index);
 }
+
+bool BaseTreeModel::hasChildren(const QModelIndex &parent) const {
+    if (parent.column() > 0) {
+        return false;
+    }
+    Node *parentItem = parent.isValid() ? static_cast<Node *>(parent.internalPointer()) : rootItem_;
+    return visibleChildCount(parentItem) > 0 ||
+           (!filtered_ && parentItem->pendingChildCount() > 0);
+}
+
+bool BaseTreeModel::canFetchMore(const QModelIndex &parent) const {
+    if (!parent.isValid() || filtered_) {
+        return false;
+    }
+    return static_cast<Node *>(parent.internalPointer())->pendingChildCount() > 0;
+}
+
+void BaseTreeModel::fetchMore(const QModelIndex &parent) {
+    if (!canFetchMore(parent)) {
+        return;
+    }
+    auto *item = static_cast<Node *>(parent.internalPointer());
+    auto first = item->childCount();
+    beginInsertRows(parent, first, first + item->pendingChildCount() - 1);
+    item->loadChildren();
+    if (keyIndexValid_) {
+        for (auto row = first; row < item->childCount(); ++row) {
+            indexKeys(item->child(row));
+        }
+    }
+    endInsertRows();
+}
+
+void BaseTreeModel::fetchAll() {
+    beginResetModel();
+    if (rootItem_) {
+        loadAll(rootItem_);
+        allLoaded_ = true;
+    }
+    keyIndexValid_ = false;
+    endResetModel();
+}
+
+QModelIndex BaseTreeModel::indexForKey(const QString &key) const {
+    if (!keyIndexValid_) {
+        keyIndex_.clear();
+        if (rootItem_) {
+            for (auto row = 0; row < rootItem_->childCount(); ++row) {
+                indexKeys(rootItem_->child(row));
+            }
+        }
+        keyIndexValid_ = true;
+    }
+    auto *item = keyIndex_.value(key, nullptr);
+    return item ? indexForNode(item) : QModelIndex();
+}
+
+QModelIndex BaseTreeModel::indexForNode(Node *item) const {
+    if (item == rootItem_ || (filtered_ && !filteredRows_.contains(item))) {
+        return {};
+    }
+    return createIndex(visibleRow(item), 0, item);
+}
+
+void BaseTreeModel::indexKeys(Node *node) const {
+    keyIndex_.insert(node->key(), node);
+    for (auto row = 0; row < node->childCount(); ++row) {
+        indexKeys(node->child(row));
+    }
+}
+
+void BaseTreeModel::loadAll(Node *node) {
+    node->loadChildren();
+    for (auto row = 0; row < node->childCount(); ++row) {
+        loadAll(node->child(row));
+    }
+}
+
+void BaseTreeModel::setFilter(const std::function<bool(const Node *)> &accepts) {
+    beginResetModel();
+    filteredChildren_.clear();
+    filteredRows_.clear();
+    matchAncestors_.clear();
+    filtered_ = true;
+    if (rootItem_) {
+        // Once everything is loaded, refining the search only walks the tree
+        if (!allLoaded_) {
+            loadAll(rootItem_);
+            allLoaded_ = true;
+        }
+        applyFilter(rootItem_, accepts, false);
+    }
+    keyIndexValid_ = false;
+    endResetModel();
+}
+
+QModelIndexList BaseTreeModel::matchAncestors() const {
+    QModelIndexList result;
+    result.reserve(matchAncestors_.size());
+    for (auto *node : matchAncestors_) {
+        if (const auto index = indexForNode(node); index.isValid()) {
+            result.append(index);
+        }
+    }
+    return result;
+}
+
+void BaseTreeModel::clearFilter() {
+    if (!filtered_) {
+        return;
+    }
+    beginResetModel();
+    filteredChildren_.clear();
+    filteredRows_.clear();
+    matchAncestors_.clear();
+    filtered_ = false;
+    endResetModel();
+}
+
+bool BaseTreeModel::isFiltered() const {
+    return filtered_;
+}
+
+// Returns whether a descendant of node matches; showAll keeps every child (below a match)
+bool BaseTreeModel::applyFilter(Node *node,
+                                const std::function<bool(const Node *)> &accepts,
+                                bool showAll) {
+    QList<Node *> visible;
+    auto matchBelow = false;
+    for (auto row = 0; row < node->childCount(); ++row) {
+        auto *childItem = node->child(row);
+        const auto matches = accepts(childItem);
+        // Ancestors of a match stay visible regardless of whether they match themselves
+        const auto ancestor = applyFilter(childItem, accepts, showAll || matches);
+        matchBelow = matchBelow || matches || ancestor;
+        if (showAll || matches || ancestor) {
+            filteredRows_.insert(childItem, static_cast<int>(visible.size()));
+            visible.append(childItem);
+        }
+    }
+    if (!visible.isEmpty()) {
+        filteredChildren_.insert(node, visible);
+    }
+    if (matchBelow && node != rootItem_) {
+        matchAncestors_.append(node);
+    }
+    return matchBelow;
+}
+
+Node *BaseTreeModel::visibleChild(Node *parentItem, int row) const {
+    if (!filtered_) {
+        return parentItem->child(row);
+    }
+    const auto it = filteredChildren_.constFind(parentItem);
+    if (it == filteredChildren_.cend()) {
+        return nullptr;
+    }
+    return it->value(row, nullptr);
+}
+
+int BaseTreeModel::visibleChildCount(Node *parentItem) const {
+    if (!filtered_) {
+        return parentItem->childCount();
+    }
+    const auto it = filteredChildren_.constFind(parentItem);
+    return it == filteredChildren_.cend() ? 0 : static_cast<int>(it->size());
+}
+
+int BaseTreeModel::visibleRow(Node *item) const {
+    if (!filtered_) {
+        return item->row();
+    }
+    return filteredRows_.value(item, 0);
+}
@@ -3,6 +3,9 @@
 #pragma once
 
 #include <QtCore/QAbstractItemModel>
+#include <QtCore/QHash>
+
+#include <functional>
 
 #include "node.h"
 
@@ -12,6 +15,10 @@
  * This class provides common implementations of @c QAbstractItemModel methods for all device tree
  * models. Subclasses should create their tree structure in their constructor by setting the root
  * item with @c setRootItem().
+ *
+ * Subclasses may defer large subtrees with @c Node::setChildLoader(). Such nodes report children
+ * through @c hasChildren() and are populated through @c fetchMore() when a view expands them, or
+ * all at once with @c fetchAll().
  */
 class BaseTreeModel : public QAbstractItemModel {
     Q_OBJECT
@@ -31,6 +38,58 @@ public:
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    /**
+     * @brief Loads every deferred subtree.
+     *
+     * Use this before expanding the whole tree, since @c QTreeView::expandAll() does not fetch.
+     * Views attached to the model are reset.
+     */
+    void fetchAll();
+
+    /**
+     * @brief Returns the index of the node with the given key.
+     *
+     * Keys are indexed once per model as nodes are loaded, so each lookup is a hash lookup. Nodes
+     * inside deferred subtrees are only found after their parent has been fetched.
+     *
+     * @param key A key returned by @c Node::key().
+     * @returns The index in column 0, or an invalid index if no visible node has this key.
+     */
+    QModelIndex indexForKey(const QString &key) const;
+
+    /**
+     * @brief Narrows the model to matching nodes, their ancestors and their descendants.
+     *
+     * The tree is walked once; afterwards the model exposes only nodes for which @p accepts
+     * returns @c true, every ancestor needed to reach them and everything below them, so a
+     * matched label still shows its devices. Nodes keep their relative order. Deferred subtrees
+     * are loaded the first time so that they can be searched. Views attached to the model are
+     * reset.
+     *
+     * @param accepts Predicate deciding whether a node matches.
+     */
+    void setFilter(const std::function<bool(const Node *)> &accepts);
+
+    /**
+     * @brief Returns the nodes a view should expand to reveal every match of the filter.
+     * @returns Indexes of the visible nodes with a match below them; empty without a filter.
+     */
+    QModelIndexList matchAncestors() const;
+
+    /**
+     * @brief Removes the filter set by @c setFilter(), exposing the full tree again.
+     */
+    void clearFilter();
+
+    /**
+     * @brief Returns whether a filter is active.
+     * @returns @c true if @c setFilter() was called and not cleared.
+     */
+    bool isFiltered() const;
 
 protected:
     /**
@@ -62,6 +121,38 @@ protected:
      */
     virtual QVariant decorationData(Node *item, int column) const;
 
+    /**
+     * @brief Returns the tooltip data for a node.
+     *
+     * The default shows the raw name when it differs from the displayed name.
+     *
+     * @param item The node to get the tooltip for.
+     * @param column The column index.
+     * @returns The tooltip as a @c QVariant, or empty @c QVariant if there is none.
+     */
+    virtual QVariant toolTipData(Node *item, int column) const;
+
+    /**
+     * @brief Returns the index of a node.
+     * @param item A node of this model.
+     * @returns The index in column 0, or an invalid index if the filter hides the node.
+     */
+    QModelIndex indexForNode(Node *item) const;
+
 private:
+    static void loadAll(Node *node);
+    void indexKeys(Node *node) const;
+    bool applyFilter(Node *node, const std::function<bool(const Node *)> &accepts, bool showAll);
+    Node *visibleChild(Node *parentItem, int row) const;
+    int visibleChildCount(Node *parentItem) const;
+    int visibleRow(Node *item) const;
+
     Node *rootItem_ = nullptr;
+    bool filtered_ = false;
+    bool allLoaded_ = false; // No deferred subtree is left under rootItem_
+    QHash<const Node *, QList<Node *>> filteredChildren_; // Only nodes with visible children
+    QHash<const Node *, int> filteredRows_;
+    QList<Node *> matchAncestors_;
+    mutable QHash<QString, Node *> keyIndex_;
+    mutable bool keyIndexValid_ = false;
 };
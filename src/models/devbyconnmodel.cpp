@@ -1,5 +1,5 @@
 // SPDX-License-Identifier: MIT
-#include <QtCore/QHash>
+#include <algorithm>
 
 #include "const_strings.h"
 #include "devicecache.h"
@@ -12,146 +12,81 @@ DevicesByConnectionModel::DevicesByConnectionModel(QObject *parent)
     auto *root = new Node({s::empty()});
     setRootItem(root);
     hostnameItem = new Node({DeviceCache::hostname()}, root);
+    hostnameItem->setKey(NodeKeys::host());
     hostnameItem->setIcon(s::categoryIcons::computer());
     root->appendChild(hostnameItem);
     buildTree();
 }
 
-QString DevicesByConnectionModel::getNodeName(const DeviceInfo &info, QString *rawName) const {
-    auto name = info.name();
-    auto subsystem = info.subsystem();
-    auto addSubsystemPrefix = false;
-
-    if (name.isEmpty()) {
-        // Fall back to syspath basename
-        auto syspath = info.syspath();
-        auto lastSlash = syspath.lastIndexOf(QLatin1Char('/'));
-        if (lastSlash >= 0) {
-            name = syspath.mid(lastSlash + 1);
-        } else {
-            name = syspath;
-        }
-        // Only add prefix for subsystems without dedicated display name handling
-        addSubsystemPrefix = !subsystem.isEmpty() && subsystem != QStringLiteral("acpi") &&
-                             subsystem != QStringLiteral("scsi_host") &&
-                             subsystem != QStringLiteral("scsi") &&
-                             subsystem != QStringLiteral("i2c");
-    }
-
-    // Store raw name before transformation
-    if (rawName) {
-        *rawName = addSubsystemPrefix ? QStringLiteral("[%1] %2").arg(subsystem, name) : name;
-    }
-
-    // Apply display name transformations
-    if (subsystem == QStringLiteral("acpi")) {
-        name = s::acpiDeviceDisplayName(info.devPath(), name);
-    } else {
-        name = s::softwareDeviceDisplayName(name);
-    }
-
-    // Add subsystem prefix if name was empty and subsystem lacks display name handling
-    if (addSubsystemPrefix) {
-        name = QStringLiteral("[%1] %2").arg(subsystem, name);
-    }
-    return name;
-}
-
-void DevicesByConnectionModel::collectAncestorSyspaths(const QSet<QString> &deviceSyspaths,
-                                                       QSet<QString> &allSyspaths) const {
-    // For each device syspath, add all ancestor syspaths to maintain the hierarchy
-    for (auto &syspath : deviceSyspaths) {
-        allSyspaths.insert(syspath);
-
-        // Walk up the syspath to add ancestors
-        auto current = syspath;
-        while (true) {
-            auto lastSlash = current.lastIndexOf(QLatin1Char('/'));
-            if (lastSlash <= 0) {
-                break;
-            }
-            current = current.left(lastSlash);
-            if (current == QStringLiteral("/sys/devices") || current == QStringLiteral("/sys")) {
-                break;
-            }
-            allSyspaths.insert(current);
-        }
-    }
-}
-
 void DevicesByConnectionModel::buildTree() {
-    // Store device list locally to avoid dangling pointers
+    // Keep the device list alive for the deferred subtrees
     // (allDevices() returns a copy, so we need stable references)
-    QList<DeviceInfo> allDevices = DeviceCache::instance().allDevices();
-
-    // Use cached devices - filter in memory
-    QSet<QString> validSyspaths;
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->devices = DeviceCache::instance().allDevices(snapshot->tree, snapshot->names);
+    const auto &allDevices = snapshot->devices;
+    const auto &tree = snapshot->tree;
     auto showHidden = DeviceCache::instance().showHiddenDevices();
 
-    // Build filter set
-    for (const DeviceInfo &info : allDevices) {
+    // Mark displayable devices and all of their ancestors to maintain the hierarchy. The walk
+    // stops at the first ancestor already marked, so every device is visited at most once.
+    snapshot->included.fill(false, allDevices.size());
+    for (auto i = 0; i < allDevices.size(); ++i) {
+        const DeviceInfo &info = allDevices.at(i);
         // Skip hidden devices unless show hidden is enabled
         if (info.isHidden() && !showHidden) {
             continue;
         }
-        if (info.isValidForDisplay()) {
-            validSyspaths.insert(info.syspath());
+        if (!info.isValidForDisplay()) {
+            continue;
         }
-    }
-
-    // Expand valid set to include ancestors
-    QSet<QString> expandedSyspaths;
-    collectAncestorSyspaths(validSyspaths, expandedSyspaths);
-
-    // Collect devices to display (store indices to avoid pointer issues)
-    QVector<int> deviceIndicesToDisplay;
-    for (auto i = 0; i < allDevices.size(); ++i) {
-        if (expandedSyspaths.contains(allDevices.at(i).syspath())) {
-            deviceIndicesToDisplay.append(i);
+        for (auto idx = i; idx >= 0 && !snapshot->included.at(idx); idx = tree.parentOf(idx)) {
+            snapshot->included[idx] = true;
         }
     }
 
-    // Sort by syspath length to ensure parents are processed before children
-    std::sort(
-        deviceIndicesToDisplay.begin(), deviceIndicesToDisplay.end(), [&allDevices](int a, int b) {
-            return allDevices.at(a).syspath().length() < allDevices.at(b).syspath().length();
-        });
-
-    // Hash map to quickly look up nodes by syspath
-    QHash<QString, Node *> nodeMap;
+    // Only the top level is built now; deeper levels are created when their parent is expanded
+    appendDeviceNodes(snapshot, tree.roots(), hostnameItem);
+}
 
-    // Build the tree
-    for (auto idx : deviceIndicesToDisplay) {
-        const DeviceInfo &info = allDevices.at(idx);
-        const QString &syspath = info.syspath();
-        if (syspath.isEmpty()) {
+void DevicesByConnectionModel::appendDeviceNodes(const std::shared_ptr<const Snapshot> &snapshot,
+                                                 const QList<int> &indices,
+                                                 Node *parentNode) const {
+    for (auto idx : indices) {
+        if (!snapshot->isShown(idx)) {
             continue;
         }
-
-        // Find parent node
-        Node *parentNode = hostnameItem;
-        const QString &parentSyspath = info.parentSyspath();
-
-        if (!parentSyspath.isEmpty() && nodeMap.contains(parentSyspath)) {
-            parentNode = nodeMap.value(parentSyspath);
-        }
+        const DeviceInfo &info = snapshot->devices.at(idx);
+        const auto &names = snapshot->names.at(idx);
 
         // Create node for this device
-        QString rawName;
-        auto name = getNodeName(info, &rawName);
-        auto *node = new Node({name, info.driver()}, parentNode, NodeType::Device);
+        auto *node =
+            new Node({names.connectionName, info.driver()}, parentNode, NodeType::Device);
         node->setSyspath(info.syspath());
         node->setIsHidden(info.isHidden());
-        node->setRawName(rawName);
+        node->setRawName(names.connectionRawName);
 
         // Set appropriate icon based on subsystem
         node->setIcon(s::categoryIcons::forSubsystem(info.subsystem()));
 
         parentNode->appendChild(node);
-        nodeMap.insert(syspath, node);
+
+        const auto &children = snapshot->tree.childrenOf(idx);
+        auto shownChildren = static_cast<int>(std::count_if(
+            children.cbegin(), children.cend(), [&snapshot](int child) {
+                return snapshot->isShown(child);
+            }));
+        if (shownChildren > 0) {
+            node->setChildLoader(shownChildren, [this, snapshot, idx](Node *item) {
+                appendDeviceNodes(snapshot, snapshot->tree.childrenOf(idx), item);
+            });
+        }
     }
 }
 
+bool DevicesByConnectionModel::Snapshot::isShown(int index) const {
+    return included.at(index) && !devices.at(index).syspath().isEmpty();
+}
+
 QVariant
 DevicesByConnectionModel::headerData(int section, Qt::Orientation orientation, int role) const {
     if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
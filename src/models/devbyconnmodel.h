@@ -2,11 +2,14 @@
 /** @file */
 #pragma once
 
-#include <QtCore/QSet>
+#include <QtCore/QList>
 
-#include "basetreemodel.h"
+#include <memory>
 
-class DeviceInfo;
+#include "basetreemodel.h"
+#include "deviceinfo.h"
+#include "devicenames.h"
+#include "devicetree.h"
 
 /**
  * @brief Tree model that organises devices by their physical connection hierarchy.
@@ -28,10 +31,19 @@ public:
     headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
 
 private:
+    struct Snapshot {
+        QList<DeviceInfo> devices;
+        DeviceTree tree;
+        DeviceNames names;
+        QList<bool> included; // Displayable devices and their ancestors
+
+        bool isShown(int index) const;
+    };
+
     void buildTree();
-    void collectAncestorSyspaths(const QSet<QString> &deviceSyspaths,
-                                 QSet<QString> &allSyspaths) const;
-    QString getNodeName(const DeviceInfo &info, QString *rawName = nullptr) const;
+    void appendDeviceNodes(const std::shared_ptr<const Snapshot> &snapshot,
+                           const QList<int> &indices,
+                           Node *parentNode) const;
 
     Node *hostnameItem;
 };
@@ -12,6 +12,7 @@ DevicesByDriverModel::DevicesByDriverModel(QObject *parent)
     auto *root = new Node({s::empty()});
     setRootItem(root);
     hostnameItem = new Node({DeviceCache::hostname()}, root);
+    hostnameItem->setKey(NodeKeys::host());
     hostnameItem->setIcon(s::categoryIcons::computer());
     root->appendChild(hostnameItem);
     buildTree();
@@ -19,7 +20,8 @@ DevicesByDriverModel::DevicesByDriverModel(QObject *parent)
 
 void DevicesByDriverModel::buildTree() {
     // Store device list locally to avoid dangling pointers
-    QList<DeviceInfo> allDevices = DeviceCache::instance().allDevices();
+    DeviceNames names;
+    QList<DeviceInfo> allDevices = DeviceCache::instance().allDevices(names);
 
     // Map from driver name to list of device indices
     QMap<QString, QVector<int>> devicesByDriver;
@@ -51,36 +53,23 @@ void DevicesByDriverModel::buildTree() {
 
         // Create driver category node
         auto *driverNode = new Node({driverName}, hostnameItem);
+        driverNode->setKey(NodeKeys::driver(driverName));
         driverNode->setIcon(s::categoryIcons::forDriver(driverName));
         hostnameItem->appendChild(driverNode);
 
         // Sort device indices by name
         auto sortedIndices = deviceIndices;
-        std::sort(sortedIndices.begin(), sortedIndices.end(), [&allDevices](int a, int b) {
-            return allDevices.at(a).name() < allDevices.at(b).name();
-        });
+        names.sortByName(sortedIndices);
 
         // Add devices under this driver
         for (auto idx : sortedIndices) {
             const DeviceInfo &info = allDevices.at(idx);
-            auto rawName = info.name();
-            if (rawName.isEmpty()) {
-                // Fall back to syspath basename
-                const QString &syspath = info.syspath();
-                auto lastSlash = syspath.lastIndexOf(QLatin1Char('/'));
-                if (lastSlash >= 0) {
-                    rawName = syspath.mid(lastSlash + 1);
-                } else {
-                    rawName = syspath;
-                }
-            }
-            // Convert to display name if available
-            auto name = s::softwareDeviceDisplayName(rawName);
+            const auto &deviceNames = names.at(idx);
 
-            auto *deviceNode = new Node({name}, driverNode, NodeType::Device);
+            auto *deviceNode = new Node({deviceNames.name}, driverNode, NodeType::Device);
             deviceNode->setSyspath(info.syspath());
             deviceNode->setIsHidden(info.isHidden());
-            deviceNode->setRawName(rawName);
+            deviceNode->setRawName(deviceNames.rawName);
             deviceNode->setIcon(s::categoryIcons::forSubsystem(info.subsystem()));
             driverNode->appendChild(deviceNode);
         }
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: MIT
-#include <QtCore/QRegularExpression>
+#include <QtCore/QHash>
+
+#include <memory>
 
 #include "const_strings.h"
 #include "devicecache.h"
@@ -7,7 +9,28 @@
 #include "systeminfo.h"
 
 namespace s = strings;
-namespace us = strings::udev;
+
+namespace {
+
+struct Snapshot {
+    QList<DeviceInfo> devices;
+    DeviceNames names;
+};
+
+QString categoryKey(DeviceCategory category) {
+    return NodeKeys::category(static_cast<int>(category));
+}
+
+Node *createDeviceNode(const DeviceInfo &info, const DeviceNames::Entry &names, Node *parentNode) {
+    auto *node = new Node({names.typeName, info.driver()}, parentNode, NodeType::Device);
+    node->setSyspath(info.syspath());
+    node->setIsHidden(info.isHidden());
+    node->setRawName(names.typeRawName);
+    node->setIcon(parentNode->icon());
+    return node;
+}
+
+} // namespace
 
 DevicesByTypeModel::DevicesByTypeModel(QObject *parent)
     : BaseTreeModel(parent), hostnameItem(nullptr), audioInputsAndOutputsItem(nullptr),
@@ -21,6 +44,7 @@ DevicesByTypeModel::DevicesByTypeModel(QObject *parent)
     auto *root = new Node({s::empty(), s::empty()});
     setRootItem(root);
     hostnameItem = new Node({DeviceCache::hostname(), s::empty()}, root);
+    hostnameItem->setKey(NodeKeys::host());
     hostnameItem->setIcon(s::categoryIcons::computer());
     root->appendChild(hostnameItem);
     buildTree();
@@ -38,8 +62,49 @@ QVariant DevicesByTypeModel::decorationData(Node *item, int column) const {
     return item->icon();
 }
 
+Node *DevicesByTypeModel::categoryItem(DeviceCategory category) const {
+    // Use pre-computed category for O(1) classification
+    switch (category) {
+    case DeviceCategory::AudioInputsAndOutputs:
+        return audioInputsAndOutputsItem;
+    case DeviceCategory::Batteries:
+        return batteriesItem;
+    case DeviceCategory::DisplayAdapters:
+        return displayAdaptersItem;
+    case DeviceCategory::UniversalSerialBusControllers:
+        return universalSerialBusControllersItem;
+    case DeviceCategory::StorageControllers:
+        return storageControllersItem;
+    case DeviceCategory::NetworkAdapters:
+        return networkAdaptersItem;
+    case DeviceCategory::DvdCdromDrives:
+        return dvdCdromDrivesItem;
+    case DeviceCategory::StorageVolumes:
+        return storageVolumesItem;
+    case DeviceCategory::DiskDrives:
+        return diskDrivesItem;
+    case DeviceCategory::HumanInterfaceDevices:
+        return humanInterfaceDevicesItem;
+    case DeviceCategory::Keyboards:
+        return keyboardsItem;
+    case DeviceCategory::MiceAndOtherPointingDevices:
+        return miceAndOtherPointingDevicesItem;
+    case DeviceCategory::SoundVideoAndGameControllers:
+        return soundVideoAndGameControllersItem;
+    case DeviceCategory::SoftwareDevices:
+        return softwareDevicesItem;
+    case DeviceCategory::SystemDevices:
+        return systemDevicesItem;
+    case DeviceCategory::Computer:
+    case DeviceCategory::Unknown:
+    default:
+        // Skip unknown devices
+        return nullptr;
+    }
+}
+
 void DevicesByTypeModel::finalizeCategory(Node *&category) {
-    if (category && category->childCount() > 0) {
+    if (category && (category->childCount() > 0 || category->pendingChildCount() > 0)) {
         category->sortChildren();
         hostnameItem->appendChild(category);
     } else if (category) {
@@ -53,175 +118,118 @@ void DevicesByTypeModel::buildTree() {
     audioInputsAndOutputsItem =
         new Node({tr("Audio inputs and outputs"), s::empty()}, hostnameItem);
     audioInputsAndOutputsItem->setIcon(s::categoryIcons::audioInputs());
+    audioInputsAndOutputsItem->setKey(categoryKey(DeviceCategory::AudioInputsAndOutputs));
 
     batteriesItem = new Node({tr("Batteries"), s::empty()}, hostnameItem);
     batteriesItem->setIcon(s::categoryIcons::batteries());
+    batteriesItem->setKey(categoryKey(DeviceCategory::Batteries));
 
     computerItem = new Node({tr("Computer"), s::empty()}, hostnameItem);
     computerItem->setIcon(s::categoryIcons::computer());
+    computerItem->setKey(categoryKey(DeviceCategory::Computer));
 
     diskDrivesItem = new Node({tr("Disk drives"), s::empty()}, hostnameItem);
     diskDrivesItem->setIcon(s::categoryIcons::diskDrives());
+    diskDrivesItem->setKey(categoryKey(DeviceCategory::DiskDrives));
 
     displayAdaptersItem = new Node({tr("Display adapters"), s::empty()}, hostnameItem);
     displayAdaptersItem->setIcon(s::categoryIcons::displayAdapters());
+    displayAdaptersItem->setKey(categoryKey(DeviceCategory::DisplayAdapters));
 
     dvdCdromDrivesItem = new Node({tr("DVD/CD-ROM drives"), s::empty()}, hostnameItem);
     dvdCdromDrivesItem->setIcon(s::categoryIcons::dvdCdromDrives());
+    dvdCdromDrivesItem->setKey(categoryKey(DeviceCategory::DvdCdromDrives));
 
     humanInterfaceDevicesItem = new Node({tr("Human Interface Devices"), s::empty()}, hostnameItem);
     humanInterfaceDevicesItem->setIcon(s::categoryIcons::hid());
+    humanInterfaceDevicesItem->setKey(categoryKey(DeviceCategory::HumanInterfaceDevices));
 
     keyboardsItem = new Node({tr("Keyboards"), s::empty()}, hostnameItem);
     keyboardsItem->setIcon(s::categoryIcons::keyboards());
+    keyboardsItem->setKey(categoryKey(DeviceCategory::Keyboards));
 
     miceAndOtherPointingDevicesItem =
         new Node({tr("Mice and other pointing devices"), s::empty()}, hostnameItem);
     miceAndOtherPointingDevicesItem->setIcon(s::categoryIcons::mice());
+    miceAndOtherPointingDevicesItem->setKey(
+        categoryKey(DeviceCategory::MiceAndOtherPointingDevices));
 
     networkAdaptersItem = new Node({tr("Network adapters"), s::empty()}, hostnameItem);
     networkAdaptersItem->setIcon(s::categoryIcons::networkAdapters());
+    networkAdaptersItem->setKey(categoryKey(DeviceCategory::NetworkAdapters));
 
     softwareDevicesItem = new Node({tr("Software devices"), s::empty()}, hostnameItem);
     softwareDevicesItem->setIcon(s::categoryIcons::other());
+    softwareDevicesItem->setKey(categoryKey(DeviceCategory::SoftwareDevices));
 
     soundVideoAndGameControllersItem =
         new Node({tr("Sound, video and game controllers"), s::empty()}, hostnameItem);
     soundVideoAndGameControllersItem->setIcon(s::categoryIcons::soundVideoGameControllers());
+    soundVideoAndGameControllersItem->setKey(
+        categoryKey(DeviceCategory::SoundVideoAndGameControllers));
 
     storageControllersItem = new Node({tr("Storage controllers"), s::empty()}, hostnameItem);
     storageControllersItem->setIcon(s::categoryIcons::storageControllers());
+    storageControllersItem->setKey(categoryKey(DeviceCategory::StorageControllers));
 
     storageVolumesItem = new Node({tr("Storage volumes"), s::empty()}, hostnameItem);
     storageVolumesItem->setIcon(s::categoryIcons::storageVolumes());
+    storageVolumesItem->setKey(categoryKey(DeviceCategory::StorageVolumes));
 
     systemDevicesItem = new Node({tr("System devices"), s::empty()}, hostnameItem);
     systemDevicesItem->setIcon(s::categoryIcons::systemDevices());
+    systemDevicesItem->setKey(categoryKey(DeviceCategory::SystemDevices));
 
     universalSerialBusControllersItem =
         new Node({tr("Universal Serial Bus controllers"), s::empty()}, hostnameItem);
     universalSerialBusControllersItem->setIcon(s::categoryIcons::usbControllers());
+    universalSerialBusControllersItem->setKey(
+        categoryKey(DeviceCategory::UniversalSerialBusControllers));
 
     // Add computer info using platform-specific backend
     auto computerName = getComputerDisplayName();
     auto computerSyspath = getComputerSyspath();
 
     auto *acpiNode = new Node({computerName, s::empty()}, computerItem, NodeType::Device);
-    if (!computerSyspath.isEmpty()) {
+    if (computerSyspath.isEmpty()) {
+        acpiNode->setKey(NodeKeys::computer());
+    } else {
         acpiNode->setSyspath(computerSyspath);
     }
     acpiNode->setIcon(computerItem->icon());
     computerItem->appendChild(acpiNode);
 
-    static const QRegularExpression kBeginningWithSlashDevRe(QStringLiteral("^/dev/"));
-
     auto showHidden = DeviceCache::instance().showHiddenDevices();
-
-    // Single pass through all cached devices - use pre-computed category for fast classification
-    for (const DeviceInfo &info : DeviceCache::instance().allDevices()) {
+    // The loaders outlive this call, so they share one copy of the snapshot
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->devices = DeviceCache::instance().allDevices(snapshot->names);
+    const auto &devices = snapshot->devices;
+
+    // Single pass through all cached devices - use pre-computed category for fast classification.
+    // Only the category is decided here; device nodes are created when a category is expanded.
+    QHash<Node *, QList<int>> categoryDevices;
+    for (auto i = 0; i < devices.size(); ++i) {
+        const DeviceInfo &info = devices.at(i);
         // Skip hidden devices unless show hidden is enabled
         if (info.isHidden() && !showHidden) {
             continue;
         }
-
-        Node *parentNode = nullptr;
-        auto rawName = info.name();
-        auto displayName = rawName;
-
-        // Use pre-computed category for O(1) classification
-        switch (info.category()) {
-        case DeviceCategory::AudioInputsAndOutputs:
-            parentNode = audioInputsAndOutputsItem;
-            break;
-
-        case DeviceCategory::Batteries:
-            displayName = s::acpiDeviceDisplayName(info.devPath(), rawName);
-            parentNode = batteriesItem;
-            break;
-
-        case DeviceCategory::DisplayAdapters:
-            parentNode = displayAdaptersItem;
-            break;
-
-        case DeviceCategory::UniversalSerialBusControllers:
-            parentNode = universalSerialBusControllersItem;
-            break;
-
-        case DeviceCategory::StorageControllers:
-            parentNode = storageControllersItem;
-            break;
-
-        case DeviceCategory::NetworkAdapters:
-            parentNode = networkAdaptersItem;
-            break;
-
-        case DeviceCategory::DvdCdromDrives:
-            parentNode = dvdCdromDrivesItem;
-            break;
-
-        case DeviceCategory::StorageVolumes: {
-            // Try to get a display name: partition label, filesystem label, or device name
-            auto volumeName = info.propertyValue(us::propertyNames::ID_PART_ENTRY_NAME);
-            if (volumeName.isEmpty()) {
-                volumeName = info.propertyValue(us::propertyNames::ID_FS_LABEL);
-            }
-            if (!volumeName.isEmpty()) {
-                displayName = volumeName;
-            }
-            parentNode = storageVolumesItem;
-            break;
-        }
-
-        case DeviceCategory::DiskDrives:
-            parentNode = diskDrivesItem;
-            break;
-
-        case DeviceCategory::HumanInterfaceDevices:
-            displayName = s::softwareDeviceDisplayName(rawName);
-            parentNode = humanInterfaceDevicesItem;
-            break;
-
-        case DeviceCategory::Keyboards:
-            displayName = s::softwareDeviceDisplayName(rawName);
-            parentNode = keyboardsItem;
-            break;
-
-        case DeviceCategory::MiceAndOtherPointingDevices:
-            displayName = s::softwareDeviceDisplayName(rawName);
-            parentNode = miceAndOtherPointingDevicesItem;
-            break;
-
-        case DeviceCategory::SoundVideoAndGameControllers:
-            parentNode = soundVideoAndGameControllersItem;
-            break;
-
-        case DeviceCategory::SoftwareDevices: {
-            rawName = info.name();
-            rawName.replace(kBeginningWithSlashDevRe, s::empty());
-            displayName = s::softwareDeviceDisplayName(rawName);
-            parentNode = softwareDevicesItem;
-            break;
-        }
-
-        case DeviceCategory::SystemDevices:
-            parentNode = systemDevicesItem;
-            break;
-
-        case DeviceCategory::Computer:
-        case DeviceCategory::Unknown:
-        default:
-            // Skip unknown devices
-            continue;
+        if (auto *parentNode = categoryItem(info.category())) {
+            categoryDevices[parentNode].append(i);
         }
+    }
 
-        if (parentNode) {
-            auto *node = new Node({displayName, info.driver()}, parentNode, NodeType::Device);
-            node->setSyspath(info.syspath());
-            node->setIsHidden(info.isHidden());
-            node->setRawName(rawName);
-            node->setIcon(parentNode->icon());
-            parentNode->appendChild(node);
-        }
+    for (auto it = categoryDevices.cbegin(); it != categoryDevices.cend(); ++it) {
+        it.key()->setChildLoader(
+            static_cast<int>(it.value().size()),
+            [snapshot, indices = it.value()](Node *category) mutable {
+                // Devices are appended in display order, so the category needs no sorting
+                snapshot->names.sortByTypeName(indices);
+                for (auto idx : indices) {
+                    category->appendChild(createDeviceNode(
+                        snapshot->devices.at(idx), snapshot->names.at(idx), category));
+                }
+            });
     }
 
     // Finalise categories - only add non-empty ones
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "basetreemodel.h"
+#include "deviceinfo.h"
 
 /**
  * @brief Tree model that organises devices by their category/type.
@@ -28,6 +29,7 @@ protected:
 
 private:
     void buildTree();
+    Node *categoryItem(DeviceCategory category) const;
     void finalizeCategory(Node *&category);
 
     Node *hostnameItem;
@@ -1,4 +1,5 @@
 // SPDX-License-Identifier: MIT
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QSet>
 
@@ -14,6 +15,7 @@ DriversByTypeModel::DriversByTypeModel(QObject *parent)
     auto *root = new Node({s::empty()});
     setRootItem(root);
     hostnameItem = new Node({DeviceCache::hostname()}, root);
+    hostnameItem->setKey(NodeKeys::host());
     hostnameItem->setIcon(s::categoryIcons::computer());
     root->appendChild(hostnameItem);
     buildTree();
@@ -31,6 +33,7 @@ void DriversByTypeModel::finalizeCategory(Node *&category) {
 void DriversByTypeModel::buildTree() {
     // Collect unique drivers by category
     QMap<QString, QSet<QString>> driversByCategory;
+    QHash<QString, DeviceCategory> categoryIds; // Stable identity for each category node
     auto showHidden = DeviceCache::instance().showHiddenDevices();
 
     for (const DeviceInfo &info : DeviceCache::instance().allDevices()) {
@@ -45,57 +48,72 @@ void DriversByTypeModel::buildTree() {
         }
 
         QString category;
+        auto categoryId = DeviceCategory::Unknown;
 
         // Use pre-computed category for O(1) classification
         switch (info.category()) {
         case DeviceCategory::AudioInputsAndOutputs:
         case DeviceCategory::SoundVideoAndGameControllers:
             category = tr("Sound, video and game controllers");
+            categoryId = DeviceCategory::SoundVideoAndGameControllers;
             break;
         case DeviceCategory::DisplayAdapters:
             category = tr("Display adapters");
+            categoryId = DeviceCategory::DisplayAdapters;
             break;
         case DeviceCategory::NetworkAdapters:
             category = tr("Network adapters");
+            categoryId = DeviceCategory::NetworkAdapters;
             break;
         case DeviceCategory::StorageControllers:
             category = tr("Storage controllers");
+            categoryId = DeviceCategory::StorageControllers;
             break;
         case DeviceCategory::UniversalSerialBusControllers:
             category = tr("Universal Serial Bus controllers");
+            categoryId = DeviceCategory::UniversalSerialBusControllers;
             break;
         case DeviceCategory::DiskDrives:
         case DeviceCategory::DvdCdromDrives:
         case DeviceCategory::StorageVolumes:
             category = tr("Disk drives");
+            categoryId = DeviceCategory::DiskDrives;
             break;
         case DeviceCategory::HumanInterfaceDevices:
             category = tr("Human Interface Devices");
+            categoryId = DeviceCategory::HumanInterfaceDevices;
             break;
         case DeviceCategory::Keyboards:
             category = tr("Keyboards");
+            categoryId = DeviceCategory::Keyboards;
             break;
         case DeviceCategory::MiceAndOtherPointingDevices:
             category = tr("Mice and other pointing devices");
+            categoryId = DeviceCategory::MiceAndOtherPointingDevices;
             break;
         case DeviceCategory::Batteries:
             category = tr("Batteries");
+            categoryId = DeviceCategory::Batteries;
             break;
         case DeviceCategory::SystemDevices:
             category = tr("System devices");
+            categoryId = DeviceCategory::SystemDevices;
             break;
         case DeviceCategory::SoftwareDevices:
             category = tr("Software devices");
+            categoryId = DeviceCategory::SoftwareDevices;
             break;
         case DeviceCategory::Computer:
         case DeviceCategory::Unknown:
         default:
             category = tr("Other devices");
+            categoryId = DeviceCategory::Unknown;
             break;
         }
 
         if (!category.isEmpty()) {
             driversByCategory[category].insert(driver);
+            categoryIds.insert(category, categoryId);
         }
     }
 
@@ -105,6 +123,7 @@ void DriversByTypeModel::buildTree() {
         const QSet<QString> &drivers = it.value();
 
         auto *categoryNode = new Node({categoryName}, hostnameItem);
+        categoryNode->setKey(NodeKeys::category(static_cast<int>(categoryIds.value(categoryName))));
         categoryNode->setIcon(s::categoryIcons::forCategory(categoryName));
 
         // Sort drivers
@@ -113,6 +132,8 @@ void DriversByTypeModel::buildTree() {
 
         for (const QString &driver : sortedDrivers) {
             auto *driverNode = new Node({driver}, categoryNode, NodeType::Label);
+            // The same driver can appear under several categories
+            driverNode->setKey(categoryNode->key() + QLatin1Char('/') + NodeKeys::driver(driver));
             driverNode->setIcon(s::categoryIcons::forDriver(driver));
             categoryNode->appendChild(driverNode);
         }
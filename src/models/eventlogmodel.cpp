@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+#include <algorithm>
+
+#include "eventlogmodel.h"
+
+EventLogModel::EventLogModel(qsizetype capacity, QObject *parent)
+    : QAbstractTableModel(parent), capacity_(std::max<qsizetype>(capacity, 1)) {
+}
+
+int EventLogModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(events_.size());
+}
+
+int EventLogModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant EventLogModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount() || role != Qt::DisplayRole) {
+        return {};
+    }
+    const auto &event = events_[static_cast<std::size_t>(index.row())];
+    return index.column() == TimestampColumn ? event.timestamp : event.message;
+}
+
+QVariant EventLogModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return {};
+    }
+    switch (section) {
+    case TimestampColumn:
+        return tr("Timestamp");
+    case MessageColumn:
+        return tr("Event");
+    default:
+        return {};
+    }
+}
+
+qsizetype EventLogModel::capacity() const {
+    return capacity_;
+}
+
+const ParsedEvent &EventLogModel::event(int row) const {
+    return events_[static_cast<std::size_t>(row)];
+}
+
+void EventLogModel::setEvents(const QList<ParsedEvent> &events) {
+    beginResetModel();
+    events_.clear();
+    const auto first = std::max<qsizetype>(events.size() - capacity_, 0);
+    events_.insert(events_.end(), events.cbegin() + first, events.cend());
+    endResetModel();
+}
+
+void EventLogModel::appendEvents(const QList<ParsedEvent> &events) {
+    if (events.isEmpty()) {
+        return;
+    }
+    // A batch larger than the capacity replaces everything with its own newest events
+    const auto incoming = std::min(events.size(), capacity_);
+    const auto size = static_cast<qsizetype>(events_.size());
+    if (const auto overflow = size + incoming - capacity_; overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, static_cast<int>(overflow - 1));
+        events_.erase(events_.begin(), events_.begin() + overflow);
+        endRemoveRows();
+    }
+
+    const auto start = static_cast<int>(events_.size());
+    beginInsertRows(QModelIndex(), start, start + static_cast<int>(incoming) - 1);
+    events_.insert(events_.end(), events.cend() - incoming, events.cend());
+    endInsertRows();
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QAbstractTableModel>
+#include <QtCore/QList>
+
+#include <deque>
+
+#include "systeminfo.h"
+
+/**
+ * @brief Table of a device's log events, with a timestamp and a message column.
+ *
+ * The model keeps at most @c capacity() events, dropping the oldest as new ones are appended, so a
+ * dialog left open on a device that keeps logging uses a fixed amount of memory. Each call to
+ * @c appendEvents() is one insertion and at most one removal however many events it carries.
+ */
+class EventLogModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Table columns.
+     */
+    enum Column {
+        TimestampColumn, ///< When the event was logged.
+        MessageColumn,   ///< What was logged.
+        ColumnCount,     ///< Number of columns.
+    };
+
+    /**
+     * @brief Constructs an @c EventLogModel.
+     * @param capacity Maximum number of events kept; at least 1.
+     * @param parent Optional parent @c QObject.
+     */
+    explicit EventLogModel(qsizetype capacity, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant
+    headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Returns the maximum number of events kept.
+     * @returns The capacity.
+     */
+    qsizetype capacity() const;
+
+    /**
+     * @brief Returns an event.
+     * @param row The event's row; must be valid.
+     * @returns The event.
+     */
+    const ParsedEvent &event(int row) const;
+
+    /**
+     * @brief Replaces all events, resetting attached views.
+     * @param events The events, oldest first. Only the newest @c capacity() are kept.
+     */
+    void setEvents(const QList<ParsedEvent> &events);
+
+    /**
+     * @brief Appends events after the existing ones, dropping the oldest beyond the capacity.
+     * @param events The events, oldest first.
+     */
+    void appendEvents(const QList<ParsedEvent> &events);
+
+private:
+    std::deque<ParsedEvent> events_;
+    qsizetype capacity_;
+};
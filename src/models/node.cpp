@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
-#include <algorithm>
+#include <utility>
 
+#include "collation.h"
 #include "models/node.h"
 
 Node::Node(const QList<QVariant> &data, Node *parent, NodeType nodeType)
@@ -36,6 +37,11 @@ QVariant Node::data(int column) const {
     return itemData.at(column);
 }
 
+void Node::setData(int column, const QVariant &value) {
+    Q_ASSERT(column >= 0 && column < itemData.size());
+    itemData[column] = value;
+}
+
 Node *Node::parentItem() {
     return parentItem_;
 }
@@ -68,6 +74,39 @@ void Node::setSyspath(const QString &syspath) {
     syspath_ = syspath;
 }
 
+QString Node::key() const {
+    if (!key_.isEmpty()) {
+        return key_;
+    }
+    if (!syspath_.isEmpty()) {
+        return syspath_;
+    }
+    const auto text = itemData.isEmpty() ? QString() : itemData.constFirst().toString();
+    if (!parentItem_) {
+        return text;
+    }
+    // Labels repeat (e.g. "reserved" ranges, "cascade" DMA channels), so they are told apart by
+    // their parent and, among same-named siblings, by how many come before them
+    auto key = parentItem_->key() + QLatin1Char('/') + text;
+    auto earlier = 0;
+    for (const auto *sibling : std::as_const(parentItem_->childItems)) {
+        if (sibling == this) {
+            break;
+        }
+        if (!sibling->itemData.isEmpty() && sibling->itemData.constFirst().toString() == text) {
+            ++earlier;
+        }
+    }
+    if (earlier > 0) {
+        key += QLatin1Char('#') + QString::number(earlier);
+    }
+    return key;
+}
+
+void Node::setKey(const QString &key) {
+    key_ = key;
+}
+
 bool Node::isHidden() const {
     return isHidden_;
 }
@@ -85,12 +124,8 @@ void Node::setRawName(const QString &name) {
 }
 
 void Node::sortChildren() {
-    std::sort(childItems.begin(), childItems.end(), [](const Node *a, const Node *b) {
-        // Sort alphabetically by the first column (name)
-        auto nameA = a->data(0).toString().toLower();
-        auto nameB = b->data(0).toString().toLower();
-        return nameA < nameB;
-    });
+    // Sort by the first column (name)
+    sortByCollation(childItems, [](const Node *child) { return child->data(0).toString(); });
     // Update row indices after sorting
     for (auto i = 0; i < childItems.size(); ++i) {
         childItems[i]->row_ = i;
@@ -104,3 +139,23 @@ QPixmap Node::disabledPixmap(int size) const {
     }
     return disabledPixmap_;
 }
+
+void Node::setChildLoader(int count, std::function<void(Node *)> loader) {
+    pendingChildCount_ = loader ? count : 0;
+    childLoader_ = std::move(loader);
+}
+
+int Node::pendingChildCount() const {
+    return pendingChildCount_;
+}
+
+void Node::loadChildren() {
+    if (!childLoader_) {
+        return;
+    }
+    // Release the loader before running it so it cannot be re-entered
+    auto loader = std::move(childLoader_);
+    childLoader_ = nullptr;
+    pendingChildCount_ = 0;
+    loader(this);
+}
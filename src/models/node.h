@@ -8,6 +8,8 @@
 #include <QtGui/QIcon>
 #include <QtGui/QPixmap>
 
+#include <functional>
+
 /**
  * @brief Enumeration of node types in the device tree.
  */
@@ -16,6 +18,39 @@ enum NodeType {
     Label,  ///< Represents a category or label node.
 };
 
+/**
+ * @brief Builders for stable node keys.
+ *
+ * Keys identify a node across model rebuilds independently of its (possibly translated or
+ * renamed) display text. Device nodes default to their syspath.
+ */
+namespace NodeKeys {
+inline QString host() {
+    return QStringLiteral("host");
+}
+inline QString computer() {
+    return QStringLiteral("computer");
+}
+inline QString category(int category) {
+    return QStringLiteral("category:%1").arg(category);
+}
+inline QString driver(const QString &driver) {
+    return QStringLiteral("driver:") + driver;
+}
+inline QString resourceType(const QString &type) {
+    return QStringLiteral("resource:") + type;
+}
+inline QString irq(const QString &number) {
+    return QStringLiteral("irq:") + number;
+}
+inline QString dmaChannel(const QString &channel) {
+    return QStringLiteral("dma:") + channel;
+}
+inline QString range(const QString &start, const QString &end, const QString &name) {
+    return QStringLiteral("range:%1-%2 %3").arg(start, end, name);
+}
+} // namespace NodeKeys
+
 /**
  * @brief Represents a node in the device tree model.
  *
@@ -60,7 +95,7 @@ public:
     int childCount() const;
 
     /**
-     * @brief Sorts children alphabetically by their first column data.
+     * @brief Sorts children by their first column data in the user's collation order.
      */
     void sortChildren();
 
@@ -77,6 +112,13 @@ public:
      */
     QVariant data(int column) const;
 
+    /**
+     * @brief Replaces the data for the specified column.
+     * @param column The column index.
+     * @param value The new data.
+     */
+    void setData(int column, const QVariant &value);
+
     /**
      * @brief Returns the icon for this node.
      * @returns The node's icon.
@@ -125,6 +167,24 @@ public:
      */
     void setSyspath(const QString &syspath);
 
+    /**
+     * @brief Returns the stable key identifying this node within its model.
+     *
+     * The fallback for nodes without a key or syspath is derived from display text and recomputed
+     * on every call, walking the ancestors and scanning the siblings; the models key every node
+     * they create so that restoring expanded state never takes it.
+     *
+     * @returns The key set with @c setKey(), else the syspath, else the parent's key and the first
+     * column's text, numbered among same-named siblings.
+     */
+    QString key() const;
+
+    /**
+     * @brief Sets the stable key identifying this node within its model.
+     * @param key The key; see @c NodeKeys for the builders used by the models.
+     */
+    void setKey(const QString &key);
+
     /**
      * @brief Returns whether this node represents a hidden device.
      * @returns @c true if the device is hidden, @c false otherwise.
@@ -156,6 +216,24 @@ public:
      */
     QPixmap disabledPixmap(int size = 16) const;
 
+    /**
+     * @brief Defers creation of this node's children until they are needed.
+     * @param count The number of children @p loader appends.
+     * @param loader Callback that appends the children to this node. It is called at most once.
+     */
+    void setChildLoader(int count, std::function<void(Node *)> loader);
+
+    /**
+     * @brief Returns the number of children that have not been loaded yet.
+     * @returns The count passed to @c setChildLoader(), or 0 if there is no pending loader.
+     */
+    int pendingChildCount() const;
+
+    /**
+     * @brief Runs the pending child loader, if any.
+     */
+    void loadChildren();
+
 private:
     QList<QVariant> itemData;
     Node *parentItem_;
@@ -163,9 +241,12 @@ private:
     QList<Node *> childItems;
     QIcon icon_;
     QString syspath_;
+    QString key_;
     QString rawName_;
     bool isHidden_ = false;
     int row_ = 0;
+    int pendingChildCount_ = 0;
+    std::function<void(Node *)> childLoader_;
     mutable QPixmap disabledPixmap_;
     mutable bool disabledPixmapCached_ = false;
 };
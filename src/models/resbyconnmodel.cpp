@@ -10,11 +10,12 @@
 namespace s = strings;
 
 ResourcesByConnectionModel::ResourcesByConnectionModel(QObject *parent)
-    : BaseTreeModel(parent), hostnameItem(nullptr), dmaItem(nullptr), ioItem(nullptr),
+    : ResourcesModel(parent), hostnameItem(nullptr), dmaItem(nullptr), ioItem(nullptr),
       irqItem(nullptr), memoryItem(nullptr) {
     auto *root = new Node({s::empty(), s::empty()});
     setRootItem(root);
     hostnameItem = new Node({DeviceCache::hostname(), s::empty()}, root);
+    hostnameItem->setKey(NodeKeys::host());
     hostnameItem->setIcon(s::categoryIcons::computer());
     root->appendChild(hostnameItem);
     buildTree();
@@ -32,17 +33,19 @@ void ResourcesByConnectionModel::buildTree() {
 }
 
 void ResourcesByConnectionModel::addDma() {
-    auto channels = getSystemDmaChannels();
+    const auto &channels = resources().dmaChannels;
     if (channels.isEmpty()) {
         return;
     }
 
     dmaItem = new Node({tr("Direct memory access (DMA)"), s::empty()}, hostnameItem);
+    dmaItem->setKey(NodeKeys::resourceType(QStringLiteral("dma")));
     dmaItem->setIcon(s::categoryIcons::dma());
 
     for (const auto &channel : channels) {
         auto displayText = QStringLiteral("[%1] %2").arg(channel.channel, channel.name);
         auto *node = new Node({displayText, s::empty()}, dmaItem);
+        node->setKey(NodeKeys::dmaChannel(channel.channel));
         node->setIcon(s::categoryIcons::dma());
         dmaItem->appendChild(node);
     }
@@ -50,13 +53,13 @@ void ResourcesByConnectionModel::addDma() {
     hostnameItem->appendChild(dmaItem);
 }
 
-void ResourcesByConnectionModel::buildHierarchicalResource([[maybe_unused]] Node *categoryNode,
-                                                           const QIcon &itemIcon,
-                                                           int indentLevel,
-                                                           const QString &rangeStart,
-                                                           const QString &rangeEnd,
-                                                           const QString &name,
-                                                           QStack<QPair<int, Node *>> &nodeStack) {
+Node *ResourcesByConnectionModel::buildHierarchicalResource(Node *categoryNode,
+                                                            const QIcon &itemIcon,
+                                                            int indentLevel,
+                                                            const QString &rangeStart,
+                                                            const QString &rangeEnd,
+                                                            const QString &name,
+                                                            QStack<QPair<int, Node *>> &nodeStack) {
     // Pop stack until we find a parent with smaller indentation
     while (nodeStack.size() > 1 && nodeStack.top().first >= indentLevel) {
         nodeStack.pop();
@@ -66,83 +69,79 @@ void ResourcesByConnectionModel::buildHierarchicalResource([[maybe_unused]] Node
 
     auto displayText = QStringLiteral("[%1 - %2] %3").arg(rangeStart, rangeEnd, name);
     auto *node = new Node({displayText, s::empty()}, parentNode);
+    node->setKey(uniqueKey(categoryNode->key() + QLatin1Char('/') +
+                           NodeKeys::range(rangeStart, rangeEnd, name)));
     node->setIcon(itemIcon);
+    linkDevice(node, deviceMap().deviceForRange(name, parentNode->syspath()));
     parentNode->appendChild(node);
 
     // Push this node as potential parent for more indented entries
     nodeStack.push({indentLevel, node});
+    return node;
 }
 
 void ResourcesByConnectionModel::addIoPorts() {
-    auto ports = getSystemIoPorts();
+    const auto &ports = resources().ioPorts;
     if (ports.isEmpty()) {
         return;
     }
 
     ioItem = new Node({tr("Input/output (IO)"), s::empty()}, hostnameItem);
+    ioItem->setKey(NodeKeys::resourceType(QStringLiteral("io")));
     ioItem->setIcon(s::categoryIcons::ioPorts());
 
     QStack<QPair<int, Node *>> nodeStack;
     nodeStack.push({-1, ioItem});
 
-    for (const auto &port : ports) {
-        buildHierarchicalResource(ioItem,
-                                  s::categoryIcons::ioPorts(),
-                                  port.indentLevel,
-                                  port.rangeStart,
-                                  port.rangeEnd,
-                                  port.name,
-                                  nodeStack);
+    ResourceIndex index;
+    index.build(ports);
+    for (auto i = 0; i < ports.size(); ++i) {
+        const auto &port = ports.at(i);
+        auto *node = buildHierarchicalResource(ioItem,
+                                               s::categoryIcons::ioPorts(),
+                                               port.indentLevel,
+                                               port.rangeStart,
+                                               port.rangeEnd,
+                                               port.name,
+                                               nodeStack);
+        flagConflict(node, index, i);
     }
 
     hostnameItem->appendChild(ioItem);
 }
 
 void ResourcesByConnectionModel::addIrq() {
-    auto irqs = getSystemIrqs();
-    if (irqs.isEmpty()) {
-        return;
-    }
-
-    irqItem = new Node({tr("Interrupt request (IRQ)"), s::empty()}, hostnameItem);
-    irqItem->setIcon(s::categoryIcons::irq());
-
-    for (const auto &irq : irqs) {
-        QString displayText;
-        if (!irq.irqType.isEmpty()) {
-            displayText =
-                QStringLiteral("(%1) %2 %3").arg(irq.irqType, irq.irqNumber, irq.deviceName);
-        } else {
-            displayText = QStringLiteral("%1 %2").arg(irq.irqNumber, irq.deviceName);
-        }
-        auto *node = new Node({displayText, s::empty()}, irqItem);
-        node->setIcon(s::categoryIcons::irq());
-        irqItem->appendChild(node);
+    irqItem = createIrqCategory(hostnameItem);
+    if (irqItem) {
+        hostnameItem->appendChild(irqItem);
     }
-
-    hostnameItem->appendChild(irqItem);
 }
 
 void ResourcesByConnectionModel::addMemory() {
-    auto ranges = getSystemMemoryRanges();
+    const auto &ranges = resources().memoryRanges;
     if (ranges.isEmpty()) {
         return;
     }
 
     memoryItem = new Node({tr("Memory"), s::empty()}, hostnameItem);
+    memoryItem->setKey(NodeKeys::resourceType(QStringLiteral("memory")));
     memoryItem->setIcon(s::categoryIcons::memory());
 
     QStack<QPair<int, Node *>> nodeStack;
     nodeStack.push({-1, memoryItem});
 
-    for (const auto &range : ranges) {
-        buildHierarchicalResource(memoryItem,
-                                  s::categoryIcons::memory(),
-                                  range.indentLevel,
-                                  range.rangeStart,
-                                  range.rangeEnd,
-                                  range.name,
-                                  nodeStack);
+    ResourceIndex index;
+    index.build(ranges);
+    for (auto i = 0; i < ranges.size(); ++i) {
+        const auto &range = ranges.at(i);
+        auto *node = buildHierarchicalResource(memoryItem,
+                                               s::categoryIcons::memory(),
+                                               range.indentLevel,
+                                               range.rangeStart,
+                                               range.rangeEnd,
+                                               range.name,
+                                               nodeStack);
+        flagConflict(node, index, i);
     }
 
     hostnameItem->appendChild(memoryItem);
@@ -4,7 +4,7 @@
 
 #include <QtCore/QStack>
 
-#include "basetreemodel.h"
+#include "resourcesmodel.h"
 
 /**
  * @brief Tree model that organises system resources by connection hierarchy.
@@ -13,7 +13,7 @@
  * memory ranges) in a hierarchical structure that reflects how they are
  * allocated to devices in the system.
  */
-class ResourcesByConnectionModel : public BaseTreeModel {
+class ResourcesByConnectionModel : public ResourcesModel {
     Q_OBJECT
 
 public:
@@ -35,13 +35,13 @@ private:
     void addIoPorts();
     void addIrq();
     void addMemory();
-    void buildHierarchicalResource(Node *categoryNode,
-                                   const QIcon &itemIcon,
-                                   int indentLevel,
-                                   const QString &rangeStart,
-                                   const QString &rangeEnd,
-                                   const QString &name,
-                                   QStack<QPair<int, Node *>> &nodeStack);
+    Node *buildHierarchicalResource(Node *categoryNode,
+                                    const QIcon &itemIcon,
+                                    int indentLevel,
+                                    const QString &rangeStart,
+                                    const QString &rangeEnd,
+                                    const QString &name,
+                                    QStack<QPair<int, Node *>> &nodeStack);
 
     Node *hostnameItem;
     Node *dmaItem;
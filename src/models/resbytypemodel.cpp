@@ -8,11 +8,12 @@
 namespace s = strings;
 
 ResourcesByTypeModel::ResourcesByTypeModel(QObject *parent)
-    : BaseTreeModel(parent), hostnameItem(nullptr), dmaItem(nullptr), ioItem(nullptr),
+    : ResourcesModel(parent), hostnameItem(nullptr), dmaItem(nullptr), ioItem(nullptr),
       irqItem(nullptr), memoryItem(nullptr) {
     auto *root = new Node({s::empty(), s::empty()});
     setRootItem(root);
     hostnameItem = new Node({DeviceCache::hostname(), s::empty()}, root);
+    hostnameItem->setKey(NodeKeys::host());
     hostnameItem->setIcon(s::categoryIcons::computer());
     root->appendChild(hostnameItem);
     buildTree();
@@ -30,17 +31,19 @@ void ResourcesByTypeModel::buildTree() {
 }
 
 void ResourcesByTypeModel::addDma() {
-    auto channels = getSystemDmaChannels();
+    const auto &channels = resources().dmaChannels;
     if (channels.isEmpty()) {
         return;
     }
 
     dmaItem = new Node({tr("Direct memory access (DMA)"), s::empty()}, hostnameItem);
+    dmaItem->setKey(NodeKeys::resourceType(QStringLiteral("dma")));
     dmaItem->setIcon(s::categoryIcons::dma());
 
     for (const auto &channel : channels) {
         auto displayText = QStringLiteral("[%1] %2").arg(channel.channel, channel.name);
         auto *node = new Node({displayText, s::empty()}, dmaItem);
+        node->setKey(NodeKeys::dmaChannel(channel.channel));
         node->setIcon(s::categoryIcons::dma());
         dmaItem->appendChild(node);
     }
@@ -49,15 +52,19 @@ void ResourcesByTypeModel::addDma() {
 }
 
 void ResourcesByTypeModel::addIoPorts() {
-    auto ports = getSystemIoPorts();
+    const auto &ports = resources().ioPorts;
     if (ports.isEmpty()) {
         return;
     }
 
     ioItem = new Node({tr("Input/output (IO)"), s::empty()}, hostnameItem);
+    ioItem->setKey(NodeKeys::resourceType(QStringLiteral("io")));
     ioItem->setIcon(s::categoryIcons::ioPorts());
 
-    for (const auto &port : ports) {
+    ResourceIndex index;
+    index.build(ports);
+    for (auto i = 0; i < ports.size(); ++i) {
+        const auto &port = ports.at(i);
         // Skip generic entries for the flat view
         if (port.name.startsWith(QStringLiteral("PCI Bus"))) {
             continue;
@@ -65,7 +72,10 @@ void ResourcesByTypeModel::addIoPorts() {
         auto displayText =
             QStringLiteral("[%1 - %2] %3").arg(port.rangeStart, port.rangeEnd, port.name);
         auto *node = new Node({displayText, s::empty()}, ioItem);
+        node->setKey(uniqueKey(ioItem->key() + QLatin1Char('/') +
+                               NodeKeys::range(port.rangeStart, port.rangeEnd, port.name)));
         node->setIcon(s::categoryIcons::ioPorts());
+        flagConflict(node, index, i);
         ioItem->appendChild(node);
     }
 
@@ -78,40 +88,26 @@ void ResourcesByTypeModel::addIoPorts() {
 }
 
 void ResourcesByTypeModel::addIrq() {
-    auto irqs = getSystemIrqs();
-    if (irqs.isEmpty()) {
-        return;
-    }
-
-    irqItem = new Node({tr("Interrupt request (IRQ)"), s::empty()}, hostnameItem);
-    irqItem->setIcon(s::categoryIcons::irq());
-
-    for (const auto &irq : irqs) {
-        QString displayText;
-        if (!irq.irqType.isEmpty()) {
-            displayText =
-                QStringLiteral("(%1) %2 %3").arg(irq.irqType, irq.irqNumber, irq.deviceName);
-        } else {
-            displayText = QStringLiteral("%1 %2").arg(irq.irqNumber, irq.deviceName);
-        }
-        auto *node = new Node({displayText, s::empty()}, irqItem);
-        node->setIcon(s::categoryIcons::irq());
-        irqItem->appendChild(node);
+    irqItem = createIrqCategory(hostnameItem);
+    if (irqItem) {
+        hostnameItem->appendChild(irqItem);
     }
-
-    hostnameItem->appendChild(irqItem);
 }
 
 void ResourcesByTypeModel::addMemory() {
-    auto ranges = getSystemMemoryRanges();
+    const auto &ranges = resources().memoryRanges;
     if (ranges.isEmpty()) {
         return;
     }
 
     memoryItem = new Node({tr("Memory"), s::empty()}, hostnameItem);
+    memoryItem->setKey(NodeKeys::resourceType(QStringLiteral("memory")));
     memoryItem->setIcon(s::categoryIcons::memory());
 
-    for (const auto &range : ranges) {
+    ResourceIndex index;
+    index.build(ranges);
+    for (auto i = 0; i < ranges.size(); ++i) {
+        const auto &range = ranges.at(i);
         // Skip generic/system entries for the flat view
         if (range.name.isEmpty() || range.name == QStringLiteral("Reserved") ||
             range.name == QStringLiteral("System RAM") ||
@@ -125,7 +121,10 @@ void ResourcesByTypeModel::addMemory() {
         auto displayText =
             QStringLiteral("[%1 - %2] %3").arg(range.rangeStart, range.rangeEnd, range.name);
         auto *node = new Node({displayText, s::empty()}, memoryItem);
+        node->setKey(uniqueKey(memoryItem->key() + QLatin1Char('/') +
+                               NodeKeys::range(range.rangeStart, range.rangeEnd, range.name)));
         node->setIcon(s::categoryIcons::memory());
+        flagConflict(node, index, i);
         memoryItem->appendChild(node);
     }
 
@@ -2,7 +2,7 @@
 /** @file */
 #pragma once
 
-#include "basetreemodel.h"
+#include "resourcesmodel.h"
 
 /**
  * @brief Tree model that organises system resources by type.
@@ -11,7 +11,7 @@
  * memory ranges) grouped by their type. Each resource type is a category
  * node containing the individual resource allocations.
  */
-class ResourcesByTypeModel : public BaseTreeModel {
+class ResourcesByTypeModel : public ResourcesModel {
     Q_OBJECT
 
 public:
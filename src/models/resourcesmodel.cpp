@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QLocale>
+
+#include <algorithm>
+
+#include "const_strings.h"
+#include "devicecache.h"
+#include "models/resourcesmodel.h"
+
+namespace s = strings;
+
+ResourcesModel::ResourcesModel(QObject *parent)
+    : BaseTreeModel(parent), resources_(DeviceCache::instance().resourceSnapshot()),
+      deviceMap_(DeviceCache::instance().resourceDeviceMap()) {
+}
+
+const SystemResources &ResourcesModel::resources() const {
+    return resources_;
+}
+
+Node *ResourcesModel::createIrqCategory(Node *parent) {
+    irqs_ = resources_.irqs;
+    if (irqs_.isEmpty()) {
+        return nullptr;
+    }
+
+    auto *irqItem = new Node({tr("Interrupt request (IRQ)"), s::empty()}, parent);
+    irqItem->setKey(NodeKeys::resourceType(QStringLiteral("irq")));
+    irqItem->setIcon(s::categoryIcons::irq());
+
+    irqRates_.resize(irqs_.size());
+    irqNodes_.reserve(irqs_.size());
+    for (auto i = 0; i < irqs_.size(); ++i) {
+        const auto &irq = irqs_.at(i);
+        auto *node = new Node({irqDisplayText(irq, {}), s::empty()}, irqItem);
+        node->setKey(NodeKeys::irq(irq.irqNumber));
+        node->setIcon(s::categoryIcons::irq());
+        linkDevice(node, deviceMap_.deviceForIrq(irq));
+        irqItem->appendChild(node);
+        irqNodes_.append(node);
+        irqIndex_.insert(node, i);
+    }
+
+    return irqItem;
+}
+
+void ResourcesModel::setIrqRates(const IrqRateSampler &sampler) {
+    QHash<QString, const IrqInfo *> latest;
+    latest.reserve(sampler.latest().size());
+    for (const auto &irq : sampler.latest()) {
+        latest.insert(irq.irqNumber, &irq);
+    }
+
+    // All IRQ nodes share one parent, so a single signal covers the visible ones
+    QModelIndex parent;
+    auto first = -1;
+    auto last = -1;
+    for (auto i = 0; i < irqNodes_.size(); ++i) {
+        auto &irq = irqs_[i];
+        if (const auto *current = latest.value(irq.irqNumber, nullptr)) {
+            irq.cpuCounts = current->cpuCounts;
+            irq.affinity = current->affinity;
+        }
+        irqRates_[i] = sampler.rate(irq.irqNumber);
+
+        auto *node = irqNodes_.at(i);
+        node->setData(0, irqDisplayText(irq, irqRates_.at(i)));
+        if (const auto nodeIndex = indexForNode(node); nodeIndex.isValid()) {
+            parent = nodeIndex.parent();
+            first = first < 0 ? nodeIndex.row() : std::min(first, nodeIndex.row());
+            last = std::max(last, nodeIndex.row());
+        }
+    }
+    if (first >= 0) {
+        Q_EMIT dataChanged(index(first, 0, parent),
+                           index(last, 0, parent),
+                           {Qt::DisplayRole, Qt::ToolTipRole});
+    }
+}
+
+void ResourcesModel::flagConflict(Node *node, const ResourceIndex &index, int position) {
+    const auto conflicts = index.conflictsWith(position);
+    if (conflicts.isEmpty()) {
+        return;
+    }
+
+    QStringList lines{tr("Conflicts with:")};
+    for (auto other : conflicts) {
+        const auto &range = index.at(other);
+        lines.append(QStringLiteral("[%1 - %2] %3")
+                         .arg(QString::number(range.start, 16).toUpper(),
+                              QString::number(range.end, 16).toUpper(),
+                              range.name));
+    }
+    node->setIcon(s::categoryIcons::resourceConflict());
+    conflictToolTips_.insert(node, lines.join(QLatin1Char('\n')));
+}
+
+const ResourceDeviceMap &ResourcesModel::deviceMap() const {
+    return deviceMap_;
+}
+
+void ResourcesModel::linkDevice(Node *node, const QString &syspath) {
+    if (syspath.isEmpty()) {
+        return;
+    }
+    // Pin the current key before the syspath would take its place
+    node->setKey(node->key());
+    node->setSyspath(syspath);
+    node->setType(NodeType::Device);
+}
+
+QString ResourcesModel::uniqueKey(const QString &key) {
+    const auto count = keyCounts_[key]++;
+    return count == 0 ? key : key + QLatin1Char('#') + QString::number(count);
+}
+
+QVariant ResourcesModel::toolTipData(Node *item, int column) const {
+    if (column == 0) {
+        if (const auto i = irqIndex_.value(item, -1); i >= 0) {
+            return irqToolTip(irqs_.at(i), irqRates_.at(i));
+        }
+        if (const auto it = conflictToolTips_.constFind(item); it != conflictToolTips_.cend()) {
+            return it.value();
+        }
+    }
+    return BaseTreeModel::toolTipData(item, column);
+}
+
+QString ResourcesModel::irqDisplayText(const IrqInfo &irq, const IrqRate &rate) {
+    auto text = irq.irqType.isEmpty()
+                    ? QStringLiteral("%1 %2").arg(irq.irqNumber, irq.deviceName)
+                    : QStringLiteral("(%1) %2 %3").arg(irq.irqType, irq.irqNumber, irq.deviceName);
+    if (rate.perCpu.isEmpty()) {
+        return text;
+    }
+
+    const QLocale locale;
+    const auto perSecond = locale.toString(qRound64(rate.total));
+    if (rate.perCpu.size() > 1 && rate.busiestCpu >= 0) {
+        text += QStringLiteral(" [%1]").arg(
+            tr("%1/s, %2% on CPU %3")
+                .arg(perSecond)
+                .arg(qRound(100 * rate.perCpu.at(rate.busiestCpu) / rate.total))
+                .arg(rate.busiestCpu));
+    } else {
+        text += QStringLiteral(" [%1]").arg(tr("%1/s").arg(perSecond));
+    }
+    return text;
+}
+
+QString ResourcesModel::irqToolTip(const IrqInfo &irq, const IrqRate &rate) const {
+    const QLocale locale;
+    QStringList lines;
+    if (!irq.affinity.isEmpty()) {
+        lines.append(tr("Affinity: CPU %1").arg(irq.affinity));
+    }
+    // Only CPUs that handled the IRQ; listing every idle CPU is noise on many-core machines
+    for (auto cpu = 0; cpu < irq.cpuCounts.size(); ++cpu) {
+        const auto count = irq.cpuCounts.at(cpu);
+        if (count == 0) {
+            continue;
+        }
+        if (cpu < rate.perCpu.size()) {
+            lines.append(tr("CPU %1: %2/s (%3 total)")
+                             .arg(cpu)
+                             .arg(locale.toString(qRound64(rate.perCpu.at(cpu))))
+                             .arg(locale.toString(count)));
+        } else {
+            lines.append(tr("CPU %1: %2").arg(cpu).arg(locale.toString(count)));
+        }
+    }
+    return lines.join(QLatin1Char('\n'));
+}
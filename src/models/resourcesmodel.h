@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: MIT
+/** @file */
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+
+#include "basetreemodel.h"
+#include "irqratesampler.h"
+#include "resourcedevicemap.h"
+#include "resourceindex.h"
+#include "systeminfo.h"
+#include "systemresources.h"
+
+/**
+ * @brief Base class for the resource views.
+ *
+ * Provides the IRQ category shared by the resource views. IRQ nodes carry the per-CPU counts and
+ * affinity in their tooltip, and once rates are supplied with @c setIrqRates() their label shows
+ * the interrupt rate and the share handled by the busiest CPU, so an unbalanced IRQ stands out.
+ *
+ * I/O port and memory nodes whose range conflicts with another assignment are flagged with
+ * @c flagConflict().
+ *
+ * Resources whose owner can be resolved through the device cache's @c ResourceDeviceMap become
+ * device nodes carrying the owner's syspath, so activating them opens its properties.
+ */
+class ResourcesModel : public BaseTreeModel {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Constructs a ResourcesModel.
+     * @param parent Optional parent QObject.
+     */
+    explicit ResourcesModel(QObject *parent = nullptr);
+
+    /**
+     * @brief Updates the IRQ nodes from a sampler.
+     *
+     * Counts and affinity are taken from the sampler's latest snapshot and labels show the rates
+     * it reports. Passing a sampler without rates restores the plain labels.
+     *
+     * @param sampler The sampler fed by the caller's sampling timer.
+     */
+    void setIrqRates(const IrqRateSampler &sampler);
+
+protected:
+    /**
+     * @brief Returns the resource tables, taken from the device cache when the model was created.
+     * @returns The snapshot.
+     */
+    const SystemResources &resources() const;
+
+    /**
+     * @brief Creates the IRQ category node with one child per system IRQ.
+     * @param parent The node the category will be appended to. The caller appends it.
+     * @returns The category node, or @c nullptr if there are no IRQs.
+     */
+    Node *createIrqCategory(Node *parent);
+
+    /**
+     * @brief Marks a node as conflicting if its range overlaps an unrelated assignment.
+     *
+     * Conflicting nodes get an error icon and a tooltip listing the ranges they overlap.
+     *
+     * @param node The node showing the range.
+     * @param index Index over all ranges of the node's resource type.
+     * @param position Position of the node's range in @p index.
+     */
+    void flagConflict(Node *node, const ResourceIndex &index, int position);
+
+    /**
+     * @brief Returns the map from resource names to devices, taken when the model was created.
+     * @returns The map.
+     */
+    const ResourceDeviceMap &deviceMap() const;
+
+    /**
+     * @brief Links a resource node to the device owning the resource.
+     *
+     * The node keeps its key, so expanded state is unaffected by whether a device was found.
+     *
+     * @param node The resource node.
+     * @param syspath The owning device's system path. Nothing happens if it is empty.
+     */
+    void linkDevice(Node *node, const QString &syspath);
+
+    /**
+     * @brief Makes a node key unique within the model by numbering repeats.
+     *
+     * Ranges may repeat, e.g. several @c Reserved ranges, or every range when an unprivileged
+     * user reads them with their addresses zeroed.
+     *
+     * @param key The key built for the node.
+     * @returns @p key the first time it is given, else @p key followed by @c # and a count.
+     */
+    QString uniqueKey(const QString &key);
+
+    QVariant toolTipData(Node *item, int column) const override;
+
+private:
+    static QString irqDisplayText(const IrqInfo &irq, const IrqRate &rate);
+    QString irqToolTip(const IrqInfo &irq, const IrqRate &rate) const;
+
+    SystemResources resources_;
+    ResourceDeviceMap deviceMap_;
+    QList<IrqInfo> irqs_;
+    QList<IrqRate> irqRates_;
+    QList<Node *> irqNodes_;
+    QHash<const Node *, int> irqIndex_; // IRQ node to its position in irqs_
+    QHash<const Node *, QString> conflictToolTips_;
+    QHash<QString, int> keyCounts_; // Times each key was given to uniqueKey()
+};
@@ -5,6 +5,7 @@
 #include <QtCore/QFileInfo>
 #include <QtCore/QLocale>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtGui/QClipboard>
 #include <QtGui/QDesktopServices>
@@ -20,15 +21,34 @@
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QListWidget>
 #include <QtWidgets/QPushButton>
+#include <QtWidgets/QScrollBar>
 #include <QtWidgets/QTableView>
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QVBoxLayout>
 
 #include "common/namemappings.h"
 #include "devicecache.h"
+#include "deviceeventstream.h"
 #include "driverdetailsdialog.h"
 #include "propertiesdialog.h"
 #include "systeminfo.h"
+#include "systemresources.h"
+
+namespace {
+
+// Events kept per dialog while new ones stream in; the oldest are dropped beyond this
+constexpr qsizetype kMaxEvents = 1000;
+
+QList<ParsedEvent> parseEvents(const QList<DeviceEvent> &events) {
+    QList<ParsedEvent> parsed;
+    parsed.reserve(events.size());
+    for (const auto &event : events) {
+        parsed << parseEventLine(event.line);
+    }
+    return parsed;
+}
+
+} // namespace
 
 PropertiesDialog::PropertiesDialog(QWidget *parent)
     : QDialog(parent), deviceInfo_(nullptr), eventsModel_(nullptr) {
@@ -56,8 +76,7 @@ PropertiesDialog::PropertiesDialog(QWidget *parent)
             &PropertiesDialog::onPropertySelectionChanged);
 
     // Setup events table model
-    eventsModel_ = new QStandardItemModel(this);
-    eventsModel_->setHorizontalHeaderLabels({tr("Timestamp"), tr("Event")});
+    eventsModel_ = new EventLogModel(kMaxEvents, this);
     tableViewEvents->setModel(eventsModel_);
     tableViewEvents->horizontalHeader()->setStretchLastSection(true);
     tableViewEvents->setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -323,8 +342,8 @@ void PropertiesDialog::populateDetailsTab() {
         } else if (mapping.propertyKey == PropertyKeys::parentSyspath()) {
             value = deviceInfo_->parentSyspath();
         } else if (mapping.propertyKey == PropertyKeys::children()) {
-            // Skip children for now - would require additional lookup
-            continue;
+            value = DeviceCache::instance().childSyspaths(deviceInfo_->syspath()).join(
+                QLatin1Char('\n'));
         } else if (mapping.propertyKey == PropertyKeys::compatibleIds()) {
             // Skip for now
             continue;
@@ -362,6 +381,9 @@ void PropertiesDialog::onPropertySelectionChanged(int index) {
         value = deviceInfo_->syspath();
     } else if (propertyKey == PropertyKeys::parentSyspath()) {
         value = deviceInfo_->parentSyspath();
+    } else if (propertyKey == PropertyKeys::children()) {
+        value =
+            DeviceCache::instance().childSyspaths(deviceInfo_->syspath()).join(QLatin1Char('\n'));
     } else if (propertyKey == PropertyKeys::mountPoint()) {
         value = getMountPoint(deviceInfo_->devnode());
     } else {
@@ -396,7 +418,8 @@ void PropertiesDialog::populateEventsTab() {
     if (!deviceInfo_)
         return;
 
-    eventsModel_->removeRows(0, eventsModel_->rowCount());
+    eventsModel_->setEvents({});
+    pendingLiveEvents_.clear();
     textEditEventsInfo->setPlainText(tr("Loading events..."));
     buttonViewAllEvents->setEnabled(false);
 
@@ -409,16 +432,36 @@ void PropertiesDialog::populateEventsTab() {
     }
 
     // Run queryDeviceEvents() asynchronously to avoid blocking the UI
-    eventsWatcher_ = new QFutureWatcher<QStringList>(this);
+    eventsWatcher_ = new QFutureWatcher<QList<DeviceEvent>>(this);
     connect(eventsWatcher_,
-            &QFutureWatcher<QStringList>::finished,
+            &QFutureWatcher<QList<DeviceEvent>>::finished,
             this,
             &PropertiesDialog::onEventsLoaded);
 
     // Build query from device info using platform-appropriate properties
     DeviceEventQuery query = buildEventQuery(*deviceInfo_);
 
-    auto future = QtConcurrent::run([query]() -> QStringList { return queryDeviceEvents(query); });
+    // Follow the log before querying it so that nothing logged while the query runs is missed.
+    // An exported snapshot has no live log.
+    delete eventStream_;
+    eventStream_ = nullptr;
+    if (!DeviceCache::instance().isViewerMode()) {
+        eventStream_ = createDeviceEventStream(query, this);
+        auto *stream = qobject_cast<DeviceEventStream *>(eventStream_);
+        if (stream) {
+            connect(stream,
+                    &DeviceEventStream::eventsReceived,
+                    this,
+                    &PropertiesDialog::onLiveEventsReceived);
+            if (!stream->start()) {
+                delete eventStream_;
+                eventStream_ = nullptr;
+            }
+        }
+    }
+
+    auto future =
+        QtConcurrent::run([query]() -> QList<DeviceEvent> { return queryDeviceEvents(query); });
     eventsWatcher_->setFuture(future);
 }
 
@@ -426,37 +469,61 @@ void PropertiesDialog::onEventsLoaded() {
     if (!eventsWatcher_)
         return;
 
-    allEvents_ = eventsWatcher_->result();
+    auto events = eventsWatcher_->result();
     delete eventsWatcher_;
     eventsWatcher_ = nullptr;
 
-    if (allEvents_.isEmpty()) {
+    // The query may already have read some of the entries the stream delivered meanwhile. They
+    // are matched by cursor, since the kernel repeats the text of messages such as link resets
+    QSet<QString> loaded;
+    loaded.reserve(events.size());
+    for (const auto &event : std::as_const(events)) {
+        if (!event.cursor.isEmpty()) {
+            loaded.insert(event.cursor);
+        }
+    }
+    for (const auto &event : std::as_const(pendingLiveEvents_)) {
+        if (event.cursor.isEmpty() || !loaded.contains(event.cursor)) {
+            events << event;
+        }
+    }
+    pendingLiveEvents_.clear();
+
+    if (events.isEmpty()) {
         textEditEventsInfo->setPlainText(tr("No events found."));
-        buttonViewAllEvents->setEnabled(false);
         return;
     }
+    appendEvents(events);
+}
 
-    // Show only first 5 events in the table
-    auto displayCount = qMin(qsizetype{5}, allEvents_.size());
-    for (decltype(displayCount) i = 0; i < displayCount; ++i) {
-        ParsedEvent event = parseEventLine(allEvents_.at(i));
-
-        QList<QStandardItem *> row;
-        row << new QStandardItem(event.timestamp);
-        row << new QStandardItem(event.message);
-        eventsModel_->appendRow(row);
+void PropertiesDialog::onLiveEventsReceived(const QList<DeviceEvent> &events) {
+    if (eventsWatcher_) {
+        pendingLiveEvents_ << events;
+        return;
     }
+    appendEvents(events);
+}
 
-    // Enable "View All Events" button only if there are more than 5 events
-    buttonViewAllEvents->setEnabled(allEvents_.size() > 5);
+void PropertiesDialog::appendEvents(const QList<DeviceEvent> &events) {
+    // Keep following the newest events unless the user has scrolled away from them
+    const auto *scrollBar = tableViewEvents->verticalScrollBar();
+    const auto followNewest = scrollBar->value() == scrollBar->maximum();
+    const auto wasEmpty = eventsModel_->rowCount() == 0;
 
-    // Resize columns
-    tableViewEvents->resizeColumnsToContents();
+    eventsModel_->appendEvents(parseEvents(events));
+    buttonViewAllEvents->setEnabled(true);
 
-    // Select the first event
-    auto firstIndex = eventsModel_->index(0, 0);
-    tableViewEvents->setCurrentIndex(firstIndex);
-    onEventSelectionChanged(firstIndex, QModelIndex());
+    if (wasEmpty) {
+        tableViewEvents->resizeColumnsToContents();
+
+        // Select the first event
+        auto firstIndex = eventsModel_->index(0, 0);
+        tableViewEvents->setCurrentIndex(firstIndex);
+        onEventSelectionChanged(firstIndex, QModelIndex());
+    }
+    if (followNewest) {
+        tableViewEvents->scrollToBottom();
+    }
 }
 
 void PropertiesDialog::onEventSelectionChanged(const QModelIndex &current,
@@ -469,14 +536,9 @@ void PropertiesDialog::onEventSelectionChanged(const QModelIndex &current,
     }
 
     // Get the full message from the selected row
-    auto row = current.row();
-    QStandardItem *timestampItem = eventsModel_->item(row, 0);
-    QStandardItem *messageItem = eventsModel_->item(row, 1);
-
-    if (timestampItem && messageItem) {
-        auto info = QStringLiteral("%1\n\n%2").arg(timestampItem->text()).arg(messageItem->text());
-        textEditEventsInfo->setPlainText(info);
-    }
+    const auto &event = eventsModel_->event(current.row());
+    auto info = QStringLiteral("%1\n\n%2").arg(event.timestamp).arg(event.message);
+    textEditEventsInfo->setPlainText(info);
 }
 
 void PropertiesDialog::onDriverDetailsClicked() {
@@ -574,7 +636,7 @@ void PropertiesDialog::onUpdateDriverClicked() {
 }
 
 void PropertiesDialog::onViewAllEventsClicked() {
-    if (allEvents_.isEmpty()) {
+    if (eventsModel_->rowCount() == 0) {
         return;
     }
 
@@ -585,21 +647,9 @@ void PropertiesDialog::onViewAllEventsClicked() {
 
     auto *layout = new QVBoxLayout(&dialog);
 
-    // Create table view for all events
+    // Share the tab's model so that events arriving while the dialog is open show up in it too
     auto *tableView = new QTableView(&dialog);
-    auto *model = new QStandardItemModel(&dialog);
-    model->setHorizontalHeaderLabels({tr("Timestamp"), tr("Event")});
-
-    for (const auto &eventLine : allEvents_) {
-        ParsedEvent event = parseEventLine(eventLine);
-
-        QList<QStandardItem *> row;
-        row << new QStandardItem(event.timestamp);
-        row << new QStandardItem(event.message);
-        model->appendRow(row);
-    }
-
-    tableView->setModel(model);
+    tableView->setModel(eventsModel_);
     tableView->horizontalHeader()->setStretchLastSection(true);
     tableView->setSelectionBehavior(QAbstractItemView::SelectRows);
     tableView->setSelectionMode(QAbstractItemView::SingleSelection);
@@ -657,8 +707,10 @@ void PropertiesDialog::createResourcesTab() {
 
     auto syspath = deviceInfo_->syspath();
     auto driverName = deviceInfo_->driver();
-    resourcesWatcher_->setFuture(QtConcurrent::run(
-        [syspath, driverName]() { return getDeviceResources(syspath, driverName); }));
+    auto resources = DeviceCache::instance().resourceSnapshot();
+    resourcesWatcher_->setFuture(QtConcurrent::run([syspath, driverName, resources]() {
+        return getDeviceResources(syspath, driverName, resources);
+    }));
 }
 
 void PropertiesDialog::onResourcesLoaded() {
@@ -4,10 +4,10 @@
 
 #include <QtCore/QFutureWatcher>
 #include <QtGui/QIcon>
-#include <QtGui/QStandardItemModel>
 #include <QtWidgets/QDialog>
 
 #include "deviceinfo.h"
+#include "eventlogmodel.h"
 #include "systeminfo.h"
 #include "ui_propertiesdialog.h"
 
@@ -51,6 +51,7 @@ private Q_SLOTS:
     void onViewAllEventsClicked();
     void onCopyDevicePath();
     void onEventsLoaded();
+    void onLiveEventsReceived(const QList<DeviceEvent> &events);
     void onDriverInfoLoaded();
     void onResourcesLoaded();
 
@@ -59,16 +60,18 @@ private:
     void populateDriverTab();
     void populateDetailsTab();
     void populateEventsTab();
+    void appendEvents(const QList<DeviceEvent> &events);
     void createResourcesTab();
     QString getDeviceCategory();
 
     QString syspath_;
     const DeviceInfo *deviceInfo_;
     QIcon categoryIcon_;
-    QStandardItemModel *eventsModel_;
-    QStringList allEvents_;
+    EventLogModel *eventsModel_;
+    QObject *eventStream_ = nullptr;
+    QList<DeviceEvent> pendingLiveEvents_; // Received before the initial query finished
     QWidget *resourcesTab_ = nullptr;
-    QFutureWatcher<QStringList> *eventsWatcher_ = nullptr;
+    QFutureWatcher<QList<DeviceEvent>> *eventsWatcher_ = nullptr;
     QFutureWatcher<BasicDriverInfo> *driverInfoWatcher_ = nullptr;
     QFutureWatcher<QList<ResourceInfo>> *resourcesWatcher_ = nullptr;
     QList<PropertyMapping> propertyMappings_;
@@ -6,8 +6,12 @@
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 
+#include "deviceevent.h"
 #include "deviceinfo.h"
 
+struct DeviceEnumerationFilter;
+struct SystemResources;
+
 /**
  * @brief Property mapping for Details tab - maps display names to property keys.
  */
@@ -281,9 +285,9 @@ DeviceEventQuery buildEventQuery(const DeviceInfo &info);
 /**
  * @brief Query system logs for events related to a device.
  * @param query Device identifiers to search for.
- * @returns List of raw log lines (up to 50 events).
+ * @returns Up to 50 log entries, oldest first.
  */
-QStringList queryDeviceEvents(const DeviceEventQuery &query);
+QList<DeviceEvent> queryDeviceEvents(const DeviceEventQuery &query);
 
 /**
  * @brief Parsed event with separated timestamp and message.
@@ -311,11 +315,18 @@ struct ResourceInfo {
 
 /**
  * @brief Get hardware resources (IRQ, memory, I/O) for a device.
+ *
+ * On Linux the resources are taken from @p resources without reading any file; other platforms
+ * query the system.
+ *
  * @param syspath Device path (sysfs on Linux, IORegistry on macOS, instance ID on Windows).
  * @param driver Driver name (used on Linux for DMA lookup).
+ * @param resources Snapshot from @c getSystemResources() or @c DeviceCache::resourceSnapshot().
  * @returns List of resources.
  */
-QList<ResourceInfo> getDeviceResources(const QString &syspath, const QString &driver);
+QList<ResourceInfo> getDeviceResources(const QString &syspath,
+                                      const QString &driver,
+                                      const SystemResources &resources);
 
 /**
  * @brief DMA channel information.
@@ -351,13 +362,20 @@ QList<IoPortInfo> getSystemIoPorts();
  * @brief IRQ information.
  */
 struct IrqInfo {
-    QString irqNumber;  ///< IRQ number.
-    QString irqType;    ///< IRQ type (e.g., "IO-APIC", "PCI-MSI").
-    QString deviceName; ///< Device using this IRQ.
+    QString irqNumber;        ///< IRQ number.
+    QString irqType;          ///< IRQ type (e.g., "IO-APIC", "PCI-MSI").
+    QString deviceName;       ///< Device using this IRQ.
+    QList<quint64> cpuCounts; ///< Interrupts handled by each CPU since boot, in CPU order.
+    QString affinity;         ///< CPUs the IRQ may be delivered to (e.g. "0-3,8"), if known.
 };
 
 /**
  * @brief Get all system IRQs.
+ *
+ * Per-CPU counts are a snapshot; successive calls can be fed to @c IrqRateSampler to derive
+ * interrupt rates. Affinity may be cached between calls; it is re-read when the set of IRQs
+ * changes and by @c getSystemResources().
+ *
  * @returns List of IRQ information.
  */
 QList<IrqInfo> getSystemIrqs();
@@ -469,6 +487,17 @@ ExportDriverInfo getExportDriverInfo(const DeviceInfo &info);
  */
 QHash<QString, QString> getSystemResourcesRaw();
 
+/**
+ * @brief Takes a snapshot of the system-wide and per-device resource tables.
+ *
+ * Each table is read once: on Linux the four @c /proc tables (see @c getSystemResourcesRaw()),
+ * the IRQ affinities and the @c irq and @c resource files of each PCI device in @p devices.
+ *
+ * @param devices The devices whose resources to include.
+ * @returns The snapshot.
+ */
+SystemResources getSystemResources(const QList<DeviceInfo> &devices);
+
 /**
  * @brief Enumerate all devices on the system.
  *
@@ -479,6 +508,33 @@ QHash<QString, QString> getSystemResourcesRaw();
  */
 QList<DeviceInfo> enumerateAllDevices();
 
+/**
+ * @brief Enumerate the devices matching a filter.
+ *
+ * On Linux the filter is applied by libudev while scanning, so devices outside it are never read.
+ *
+ * @param filter Criteria the devices must meet; an empty filter enumerates all devices.
+ * @returns List of the matching devices.
+ */
+QList<DeviceInfo> enumerateDevices(const DeviceEnumerationFilter &filter);
+
+/**
+ * @brief Check whether a device exists, e.g. before enumerating its subtree.
+ * @param syspath Device path (sysfs on Linux, IORegistry on macOS, instance ID on Windows).
+ * @returns @c true if the device exists.
+ */
+bool deviceExists(const QString &syspath);
+
+/**
+ * @brief Check whether devices can be enumerated by property value (@c --property).
+ *
+ * Only udev looks up device properties by name; other backends cache the fields they show at
+ * construction, so every property match would fail.
+ *
+ * @returns @c true if @c DeviceInfo::propertyValue() returns the device's properties.
+ */
+bool supportsPropertyFilter();
+
 /**
  * @brief Create a device monitor for tracking device changes.
  *
@@ -489,3 +545,15 @@ QList<DeviceInfo> enumerateAllDevices();
  * @returns A platform-specific device monitor, or nullptr if monitoring is not supported.
  */
 QObject *createDeviceMonitor(QObject *parent);
+
+/**
+ * @brief Create a stream of the events logged for a device from now on.
+ *
+ * The returned QObject is a @c DeviceEventStream that has not been started. The caller is
+ * responsible for deleting it.
+ *
+ * @param query Device identifiers, as passed to queryDeviceEvents().
+ * @param parent Parent QObject for memory management.
+ * @returns A platform-specific stream, or nullptr if the system log cannot be followed.
+ */
+QObject *createDeviceEventStream(const DeviceEventQuery &query, QObject *parent);
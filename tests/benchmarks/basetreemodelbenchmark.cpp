@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QTest>
+
+#include "models/basetreemodel.h"
+
+namespace {
+
+class TestTreeModel : public BaseTreeModel {
+public:
+    explicit TestTreeModel(Node *root) {
+        setRootItem(root);
+    }
+};
+
+Node *addNode(Node *parent, const QString &text) {
+    auto *node = new Node({text}, parent);
+    parent->appendChild(node);
+    return node;
+}
+
+} // namespace
+
+class BaseTreeModelBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void setFilter();
+};
+
+void BaseTreeModelBenchmark::setFilter() {
+    // About the size of a large machine's Devices by connection view
+    auto *root = new Node({QString()});
+    auto *host = addNode(root, QStringLiteral("host"));
+    for (auto i = 0; i < 100; ++i) {
+        auto *bus = addNode(host, QStringLiteral("Bus %1").arg(i));
+        for (auto j = 0; j < 100; ++j) {
+            addNode(bus, QStringLiteral("Device %1:%2").arg(i).arg(j));
+        }
+    }
+    TestTreeModel model(root);
+    const auto term = QStringLiteral("device 42:");
+    const auto accepts = [&term](const Node *node) {
+        return node->data(0).toString().contains(term, Qt::CaseInsensitive);
+    };
+
+    // One search step: the filter, the model reset and what the view expands
+    QBENCHMARK {
+        model.setFilter(accepts);
+        QCOMPARE(model.matchAncestors().size(), 2);
+    }
+}
+
+QTEST_MAIN(BaseTreeModelBenchmark)
+#include "basetreemodelbenchmark.moc"
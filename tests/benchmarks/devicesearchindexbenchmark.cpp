@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "devicesearchindex.h"
+
+namespace {
+
+QList<DeviceInfo> syntheticDevices(int count) {
+    QList<DeviceInfo> devices;
+    devices.reserve(count);
+    for (auto i = 0; i < count; ++i) {
+        auto bus = QStringLiteral("%1").arg(i / 256, 2, 16, QLatin1Char('0'));
+        auto slot = QStringLiteral("%1").arg(i % 256, 2, 16, QLatin1Char('0'));
+        auto vendor = QStringLiteral("%1").arg(0x8000 + i % 512, 4, 16, QLatin1Char('0'));
+        auto device = QStringLiteral("%1").arg(i % 0x10000, 4, 16, QLatin1Char('0'));
+        QJsonObject json;
+        json[QStringLiteral("syspath")] =
+            QStringLiteral("/sys/devices/pci0000:%1/0000:%1:%2.0").arg(bus, slot);
+        json[QStringLiteral("name")] = QStringLiteral("Synthetic Device %1").arg(i);
+        json[QStringLiteral("driver")] = QStringLiteral("driver%1").arg(i % 97);
+        json[QStringLiteral("properties")] = QJsonObject{
+            {QStringLiteral("PCI_ID"), vendor + QLatin1Char(':') + device},
+            {QStringLiteral("MODALIAS"), QStringLiteral("pci:v0000%1d0000%2").arg(vendor, device)},
+        };
+        devices.append(DeviceInfo(json));
+    }
+    return devices;
+}
+
+} // namespace
+
+class DeviceSearchIndexBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void build50k();
+    void match50k();
+};
+
+void DeviceSearchIndexBenchmark::build50k() {
+    auto devices = syntheticDevices(50000);
+    DeviceSearchIndex index;
+    QBENCHMARK {
+        index.build(devices);
+    }
+    QCOMPARE(index.size(), 50000);
+}
+
+void DeviceSearchIndexBenchmark::match50k() {
+    DeviceSearchIndex index;
+    index.build(syntheticDevices(50000));
+    QList<int> result;
+    QBENCHMARK {
+        // Incremental typing of a query, one index lookup per keystroke
+        for (const auto *query : {"d", "dr", "dri", "driv", "drive", "driver", "driver4"}) {
+            result = index.match(QString::fromLatin1(query));
+        }
+    }
+    QVERIFY(!result.isEmpty());
+}
+
+QTEST_MAIN(DeviceSearchIndexBenchmark)
+#include "devicesearchindexbenchmark.moc"
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringTokenizer>
+#include <QtTest/QTest>
+
+#include "journalline.h"
+
+namespace {
+
+// Journal-style kernel log with a few lines of other shapes mixed in
+QString syntheticKernelLog(int lines) {
+    QString log;
+    log.reserve(static_cast<qsizetype>(lines) * 80);
+    for (auto i = 0; i < lines; ++i) {
+        const auto time = QStringLiteral("2026-03-14T09:%1:%2")
+                              .arg(i / 60 % 60, 2, 10, QLatin1Char('0'))
+                              .arg(i % 60, 2, 10, QLatin1Char('0'));
+        switch (i % 8) {
+        case 0:
+            log += time +
+                   QStringLiteral("-0500 workstation systemd[1]: Started session %1.").arg(i);
+            break;
+        case 1:
+            log += QStringLiteral("-- Boot 0f3c9b2a --");
+            break;
+        default:
+            log += time + QStringLiteral("+01:00 workstation kernel: usb 1-2: new device number %1")
+                              .arg(i);
+            break;
+        }
+        log += QLatin1Char('\n');
+    }
+    return log;
+}
+
+} // namespace
+
+class JournalLineBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void regularExpression();
+    void splitJournalLine();
+};
+
+void JournalLineBenchmark::regularExpression() {
+    // What parseEventLine() did before, less the regular expression being compiled per call
+    const auto log = syntheticKernelLog(1000000);
+    static const QRegularExpression re(
+        QStringLiteral(R"(^(\d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}[+-]\d{2}:?\d{2})\s+)"));
+    qsizetype parsed = 0;
+    QBENCHMARK {
+        parsed = 0;
+        for (const auto line : QStringView(log).tokenize(u'\n', Qt::SkipEmptyParts)) {
+            parsed += re.matchView(line).hasMatch() ? 1 : 0;
+        }
+    }
+    QCOMPARE(parsed, qsizetype{875000});
+}
+
+void JournalLineBenchmark::splitJournalLine() {
+    const auto log = syntheticKernelLog(1000000);
+    qsizetype parsed = 0;
+    QBENCHMARK {
+        parsed = 0;
+        for (const auto line : QStringView(log).tokenize(u'\n', Qt::SkipEmptyParts)) {
+            QStringView timestamp;
+            QStringView message;
+            parsed += splitJournalLine(line, timestamp, message) ? 1 : 0;
+        }
+    }
+    QCOMPARE(parsed, qsizetype{875000});
+}
+
+QTEST_MAIN(JournalLineBenchmark)
+#include "journallinebenchmark.moc"
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QTest>
+
+#include "namemappings.h"
+
+class NameMappingsBuiltinBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanupTestCase();
+
+    void coldStartJson();
+    void coldStartBuiltin();
+};
+
+void NameMappingsBuiltinBenchmark::cleanupTestCase() {
+    NameMappings::instance().reload();
+}
+
+void NameMappingsBuiltinBenchmark::coldStartJson() {
+    auto &mappings = NameMappings::instance();
+    QBENCHMARK {
+        mappings.clear();
+        mappings.loadFromDirectory(QStringLiteral(HWVIEW_DATA_DIR), QStringLiteral("en-US"));
+    }
+    QCOMPARE(mappings.hidVendorName(QStringLiteral("046d")), QStringLiteral("Logitech"));
+}
+
+void NameMappingsBuiltinBenchmark::coldStartBuiltin() {
+    auto &mappings = NameMappings::instance();
+    QBENCHMARK {
+        mappings.clear();
+        mappings.loadBuiltin();
+    }
+    QCOMPARE(mappings.hidVendorName(QStringLiteral("046d")), QStringLiteral("Logitech"));
+}
+
+QTEST_MAIN(NameMappingsBuiltinBenchmark)
+#include "namemappingsbuiltinbenchmark.moc"
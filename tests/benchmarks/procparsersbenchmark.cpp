@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtTest/QTest>
+
+#include <string_view>
+
+#include "procparsers.h"
+
+using namespace procparsers;
+
+namespace {
+
+QByteArray readFixture(const QString &name) {
+    QFile file(QStringLiteral(HWVIEW_TEST_DATA_DIR) + QLatin1Char('/') + name);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return file.readAll();
+}
+
+std::string_view view(const QByteArray &bytes) {
+    return {bytes.constData(), static_cast<size_t>(bytes.size())};
+}
+
+// Widens a captured /proc/interrupts to @p factor times as many CPUs by repeating its count
+// columns, and its body @p repeat times, approximating a many-core server with per-queue IRQs.
+QByteArray widenInterrupts(const QByteArray &captured, int factor, int repeat) {
+    InterruptsParser parser(view(captured));
+    QByteArray header(11, ' ');
+    for (auto cpu = 0; cpu < parser.cpuCount() * factor; ++cpu) {
+        header += QByteArrayLiteral("CPU") + QByteArray::number(cpu).leftJustified(8, ' ');
+    }
+
+    QByteArray body;
+    InterruptLine line;
+    while (parser.next(line)) {
+        body += QByteArray(line.irq.data(), static_cast<qsizetype>(line.irq.size())) + ": ";
+        const QByteArray counts(line.counts.data(), static_cast<qsizetype>(line.counts.size()));
+        for (auto i = 0; i < factor; ++i) {
+            body += counts + ' ';
+        }
+        body += QByteArray(line.description.data(),
+                           static_cast<qsizetype>(line.description.size())) +
+                '\n';
+    }
+    return header + '\n' + body.repeated(repeat);
+}
+
+} // namespace
+
+class ProcParsersBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void interrupts256Cpus();
+};
+
+void ProcParsersBenchmark::interrupts256Cpus() {
+    const auto captured = readFixture(QStringLiteral("proc-interrupts-8cpu.txt"));
+    QVERIFY(!captured.isEmpty());
+    const auto wide = widenInterrupts(captured, 32, 20);
+    QCOMPARE(InterruptsParser(view(wide)).cpuCount(), 256);
+
+    qsizetype columns = 0;
+    QBENCHMARK {
+        columns = 0;
+        InterruptsParser parser(view(wide));
+        InterruptLine line;
+        while (parser.next(line)) {
+            columns += line.countColumns;
+        }
+    }
+    // 48 lines with one column per CPU, plus ERR and MIS whose single column was repeated
+    QCOMPARE(columns, 20 * (48 * 256 + 2 * 32));
+}
+
+QTEST_MAIN(ProcParsersBenchmark)
+#include "procparsersbenchmark.moc"
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QSet>
+#include <QtCore/QStringList>
+#include <QtTest/QTest>
+
+#include <iterator>
+
+#include "diskmanufacturers.h"
+#include "staticmatch.h"
+
+namespace {
+
+constexpr std::string_view kNodeKeys[] = {
+    "autofs", "cpu_dma_latency", "fuse", "hpet", "hwrng", "kvm", "loop-control", "mcelog",
+    "net/tun", "ntsync", "rfkill", "uhid", "uinput", "vga_arbiter", "vhost-net", "mapper/control",
+};
+constexpr auto kNodes = staticmatch::makePerfectHashSet(kNodeKeys);
+
+constexpr auto &kVendors = diskmanufacturers::kPatterns;
+constexpr auto &kVendorMatcher = diskmanufacturers::kMatcher;
+
+QString fromKey(std::string_view key) {
+    return QString::fromLatin1(key.data(), static_cast<qsizetype>(key.size()));
+}
+
+// What the matcher replaced: the first pattern that occurs anywhere in the text
+int linearFirstMatch(const QString &text) {
+    for (std::size_t i = 0; i < std::size(kVendors); ++i) {
+        if (text.contains(fromKey(kVendors[i]), Qt::CaseInsensitive)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Mix of software device names and disk model strings, about a third of which match a key
+QStringList syntheticDeviceNames(int count, quint32 seed) {
+    static const QStringList models = {
+        QStringLiteral("Samsung SSD 980 PRO 1TB"), QStringLiteral("WDC WD40EFRX-68N32N0"),
+        QStringLiteral("CT1000MX500SSD1"),         QStringLiteral("KINGSTON SA400S37240G"),
+        QStringLiteral("Generic Flash Disk"),      QStringLiteral("QEMU HARDDISK"),
+        QStringLiteral("VBOX HARDDISK"),           QStringLiteral("Virtual Disk"),
+    };
+    constexpr auto kNodeCount = static_cast<int>(std::size(kNodeKeys));
+    QStringList names;
+    names.reserve(count);
+    QRandomGenerator random(seed);
+    for (auto i = 0; i < count; ++i) {
+        switch (i % 3) {
+        case 0:
+            names.append(fromKey(kNodeKeys[random.bounded(kNodeCount)]));
+            break;
+        case 1:
+            names.append(models.at(random.bounded(static_cast<int>(models.size()))) +
+                         QLatin1Char(' ') + QString::number(i));
+            break;
+        default:
+            names.append(QStringLiteral("device%1").arg(i));
+            break;
+        }
+    }
+    return names;
+}
+
+} // namespace
+
+class StaticMatchBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void setQHash();
+    void setPerfectHash();
+    void matcherLinear();
+    void matcherAhoCorasick();
+};
+
+void StaticMatchBenchmark::setQHash() {
+    const auto names = syntheticDeviceNames(10000, 2);
+    QSet<QString> set;
+    for (const auto key : kNodeKeys) {
+        set.insert(fromKey(key));
+    }
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const auto &name : names) {
+            found += set.contains(name) ? 1 : 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void StaticMatchBenchmark::setPerfectHash() {
+    const auto names = syntheticDeviceNames(10000, 2);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const auto &name : names) {
+            found += kNodes.contains(name) ? 1 : 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void StaticMatchBenchmark::matcherLinear() {
+    const auto names = syntheticDeviceNames(10000, 2);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const auto &name : names) {
+            found += linearFirstMatch(name) >= 0 ? 1 : 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void StaticMatchBenchmark::matcherAhoCorasick() {
+    const auto names = syntheticDeviceNames(10000, 2);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const auto &name : names) {
+            found += kVendorMatcher.firstMatch(name) >= 0 ? 1 : 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_MAIN(StaticMatchBenchmark)
+#include "staticmatchbenchmark.moc"
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QStringList>
+#include <QtCore/QStringTokenizer>
+#include <QtTest/QTest>
+
+#include <iterator>
+
+#include "termmatcher.h"
+
+namespace {
+
+constexpr auto kKernelLogLines = 1000000;
+
+// Terms as queryDeviceEvents() builds them for a USB receiver
+const QStringList &deviceTerms() {
+    static const QStringList terms = {
+        QStringLiteral("idVendor=046d"),
+        QStringLiteral("Logitech USB"),
+        QStringLiteral("hidraw3"),
+    };
+    return terms;
+}
+
+// Journal-style kernel log; about one line in ten mentions the device of deviceTerms()
+QByteArray syntheticKernelLog(int lines, quint32 seed) {
+    static const char *const messages[] = {
+        "usb 1-2: new full-speed USB device number %1 using xhci_hcd",
+        "usb 1-2: New USB device found, idVendor=046D, idProduct=c52b, bcdDevice=12.11",
+        "nvme nvme0: 8/0/0 default/read/poll queues",
+        "EXT4-fs (nvme0n1p2): mounted filesystem with ordered data mode. Quota mode: none.",
+        "r8169 0000:03:00.0 enp3s0: Link is Up - 1Gbps/Full - flow control rx/tx",
+        "audit: type=1400 audit(%1.123:42): apparmor=\"STATUS\" operation=\"profile_load\"",
+        "wlp4s0: associated with Ünïcödé Café Wi-Fi",
+        "input: Logitech USB Receiver as /devices/pci0000:00/0000:00:14.0/usb1/1-2/input/input%1",
+        "ACPI: \\_SB_.PCI0.LPCB.EC0_: EC: interrupt unblocked",
+        "hid-generic 0003:046D:C52B.0004: hidraw3: USB HID v1.11 Device",
+        "snd_hda_intel 0000:00:1f.3: enabling device (0000 -> 0002)",
+        "Bluetooth: hci0: Firmware revision 0.1 build %1 week 46 2023",
+        "perf: interrupt took too long (2500 > 2495), lowering kernel.perf_event_max_sample_rate",
+        "i915 0000:00:02.0: [drm] GuC firmware i915/tgl_guc_70.bin version 70.%1.0",
+        "usb 3-1: USB disconnect, device number %1",
+        "thermal thermal_zone7: failed to read out thermal zone (-61)",
+        "IPv6: ADDRCONF(NETDEV_CHANGE): wlp4s0: link becomes ready",
+        "🙂 kernel test message %1",
+        "CPU%1: Package temperature above threshold, cpu clock throttled",
+        "xhci_hcd 0000:00:14.0: xHCI Host Controller",
+    };
+    constexpr auto kMessageCount = static_cast<int>(std::size(messages));
+    QRandomGenerator random(seed);
+    QByteArray log;
+    log.reserve(static_cast<qsizetype>(lines) * 110);
+    for (auto i = 0; i < lines; ++i) {
+        const auto message = QString::fromUtf8(messages[random.bounded(kMessageCount)]);
+        log += QStringLiteral("2026-03-14T09:%1:%2+01:00 workstation kernel: ")
+                   .arg(i / 60 % 60, 2, 10, QLatin1Char('0'))
+                   .arg(i % 60, 2, 10, QLatin1Char('0'))
+                   .toUtf8();
+        log += (message.contains(QStringLiteral("%1")) ? message.arg(i) : message).toUtf8();
+        log += '\n';
+    }
+    return log;
+}
+
+// Reference behaviour: the first term contained in the text
+int linearFirstMatch(const QStringList &terms, const QString &text) {
+    for (qsizetype i = 0; i < terms.size(); ++i) {
+        if (text.contains(terms.at(i), Qt::CaseInsensitive)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+class TermMatcherBenchmark : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void kernelLogContains();
+    void kernelLogUtf16();
+    void kernelLogUtf8();
+};
+
+void TermMatcherBenchmark::kernelLogContains() {
+    // What queryDeviceEvents() did before: decode, split, then one search per term
+    const auto log = syntheticKernelLog(kKernelLogLines, 1);
+    const auto &terms = deviceTerms();
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        const auto lines = QString::fromUtf8(log).split(QLatin1Char('\n'), Qt::SkipEmptyParts);
+        for (const auto &line : lines) {
+            found += linearFirstMatch(terms, line) >= 0 ? 1 : 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void TermMatcherBenchmark::kernelLogUtf16() {
+    const auto log = QString::fromUtf8(syntheticKernelLog(kKernelLogLines, 1));
+    const TermMatcher matcher(deviceTerms());
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const auto line : QStringView(log).tokenize(u'\n', Qt::SkipEmptyParts)) {
+            found += matcher.matches(line) ? 1 : 0;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void TermMatcherBenchmark::kernelLogUtf8() {
+    const auto log = syntheticKernelLog(kKernelLogLines, 1);
+    const TermMatcher matcher(deviceTerms());
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (qsizetype start = 0; start < log.size();) {
+            auto end = log.indexOf('\n', start);
+            if (end == -1) {
+                end = log.size();
+            }
+            found += matcher.matches(QByteArrayView(log).sliced(start, end - start)) ? 1 : 0;
+            start = end + 1;
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+QTEST_MAIN(TermMatcherBenchmark)
+#include "termmatcherbenchmark.moc"
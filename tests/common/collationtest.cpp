@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtCore/QLocale>
+#include <QtTest/QTest>
+
+#include "collation.h"
+#include "deviceinfo.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &name, int index) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = QStringLiteral("/sys/devices/test/%1").arg(index);
+    json[QStringLiteral("name")] = name;
+    return DeviceInfo(json);
+}
+
+} // namespace
+
+class CollationTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void collationOrder_sorts();
+    void collationOrder_stable();
+    void collationOrder_ignoresCase();
+    void collationOrder_numbers();
+    void collationOrder_small();
+    void sortByCollationKeys_sorts();
+    void sortByCollation_devices();
+    void sortByCollation_indexes();
+};
+
+void CollationTest::initTestCase() {
+    // The collator follows the default locale when a thread first sorts
+    QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedStates));
+}
+
+void CollationTest::collationOrder_sorts() {
+    const QStringList texts{
+        QStringLiteral("mango"), QStringLiteral("apple"), QStringLiteral("zebra")};
+    QCOMPARE(collationOrder(texts), QList<qsizetype>({1, 0, 2}));
+}
+
+void CollationTest::collationOrder_stable() {
+    const QStringList texts{QStringLiteral("usb"),
+                            QStringLiteral("ata"),
+                            QStringLiteral("usb"),
+                            QStringLiteral("ata")};
+    QCOMPARE(collationOrder(texts), QList<qsizetype>({1, 3, 0, 2}));
+}
+
+void CollationTest::collationOrder_ignoresCase() {
+    const QStringList texts{QStringLiteral("banana"),
+                            QStringLiteral("Apple"),
+                            QStringLiteral("cherry"),
+                            QStringLiteral("Banana"),
+                            QStringLiteral("USB"),
+                            QStringLiteral("usb")};
+    // Names differing only in case are equal, so they keep their order
+    QCOMPARE(collationOrder(texts), QList<qsizetype>({1, 0, 3, 2, 4, 5}));
+}
+
+void CollationTest::collationOrder_numbers() {
+    const QStringList texts{
+        QStringLiteral("sda10"), QStringLiteral("sda2"), QStringLiteral("sda1")};
+    QCOMPARE(collationOrder(texts), QList<qsizetype>({2, 1, 0}));
+}
+
+void CollationTest::collationOrder_small() {
+    QVERIFY(collationOrder({}).isEmpty());
+    QCOMPARE(collationOrder({QStringLiteral("only")}), QList<qsizetype>({0}));
+}
+
+void CollationTest::sortByCollationKeys_sorts() {
+    const auto keys = collationKeys({QStringLiteral("usb"),
+                                     QStringLiteral("ata"),
+                                     QStringLiteral("usb"),
+                                     QStringLiteral("nvme")});
+    QCOMPARE(keys.size(), 4);
+    // A subset of the indexes, as when sorting the devices of one driver; ties keep their order
+    QList<int> indexes{2, 0, 1};
+    sortByCollationKeys(indexes, keys);
+    QCOMPARE(indexes, QList<int>({1, 2, 0}));
+}
+
+void CollationTest::sortByCollation_devices() {
+    QList<DeviceInfo> devices{makeDevice(QStringLiteral("sdb"), 0),
+                              makeDevice(QStringLiteral("nvme0"), 1),
+                              makeDevice(QStringLiteral("sda"), 2)};
+    sortByCollation(devices, [](const DeviceInfo &info) { return info.name(); });
+    QCOMPARE(devices.size(), 3);
+    QCOMPARE(devices.at(0).syspath(), QStringLiteral("/sys/devices/test/1"));
+    QCOMPARE(devices.at(1).syspath(), QStringLiteral("/sys/devices/test/2"));
+    QCOMPARE(devices.at(2).syspath(), QStringLiteral("/sys/devices/test/0"));
+}
+
+void CollationTest::sortByCollation_indexes() {
+    const QStringList names{QStringLiteral("xhci_hcd"), QStringLiteral("ahci")};
+    QList<int> indexes{0, 1};
+    sortByCollation(indexes, [&names](int i) { return names.at(i); });
+    QCOMPARE(indexes, QList<int>({1, 0}));
+}
+
+QTEST_MAIN(CollationTest)
+#include "collationtest.moc"
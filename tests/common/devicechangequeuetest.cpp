@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+#include <memory>
+
+#include "devicechangequeue.h"
+
+namespace {
+
+DeviceChange makeChange(const QString &action, int index) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = QStringLiteral("/sys/devices/test/%1").arg(index);
+    return {action, QDateTime::currentDateTimeUtc(), DeviceInfo(json)};
+}
+
+QStringList syspaths(const QList<DeviceChange> &changes) {
+    QStringList result;
+    for (const auto &change : changes) {
+        result << change.device.syspath();
+    }
+    return result;
+}
+
+} // namespace
+
+class DeviceChangeQueueTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void take_inOrder();
+    void push_dropsWhenFull();
+    void take_reportsDropsOnly();
+    void close_drainsThenEnds();
+    void take_wakesForPush();
+};
+
+void DeviceChangeQueueTest::take_inOrder() {
+    DeviceChangeQueue queue(8);
+    QVERIFY(queue.push(makeChange(QStringLiteral("add"), 1)));
+    QVERIFY(queue.push(makeChange(QStringLiteral("bind"), 2)));
+
+    QList<DeviceChange> changes;
+    quint64 dropped = 1;
+    QVERIFY(queue.take(changes, dropped));
+    QCOMPARE(dropped, quint64{0});
+    QCOMPARE(changes.size(), 2);
+    QCOMPARE(changes.at(0).action, QStringLiteral("add"));
+    QCOMPARE(changes.at(1).action, QStringLiteral("bind"));
+    QCOMPARE(changes.at(1).device.syspath(), QStringLiteral("/sys/devices/test/2"));
+}
+
+void DeviceChangeQueueTest::push_dropsWhenFull() {
+    DeviceChangeQueue queue(3);
+    for (auto i = 0; i < 5; ++i) {
+        QCOMPARE(queue.push(makeChange(QStringLiteral("change"), i)), i < 3);
+    }
+    QCOMPARE(queue.droppedCount(), quint64{2});
+
+    // The oldest events are kept; the drops are reported after them
+    QList<DeviceChange> changes;
+    quint64 dropped = 0;
+    QVERIFY(queue.take(changes, dropped));
+    QCOMPARE(syspaths(changes),
+             QStringList({QStringLiteral("/sys/devices/test/0"),
+                          QStringLiteral("/sys/devices/test/1"),
+                          QStringLiteral("/sys/devices/test/2")}));
+    QCOMPARE(dropped, quint64{2});
+
+    // Room again, and the drop count starts over while the total keeps growing
+    QVERIFY(queue.push(makeChange(QStringLiteral("change"), 5)));
+    QVERIFY(queue.take(changes, dropped));
+    QCOMPARE(changes.size(), 1);
+    QCOMPARE(dropped, quint64{0});
+    QCOMPARE(queue.droppedCount(), quint64{2});
+}
+
+void DeviceChangeQueueTest::take_reportsDropsOnly() {
+    DeviceChangeQueue queue(0);
+    QCOMPARE(queue.capacity(), 1);
+    QVERIFY(queue.push(makeChange(QStringLiteral("add"), 0)));
+    QVERIFY(!queue.push(makeChange(QStringLiteral("add"), 1)));
+
+    QList<DeviceChange> changes;
+    quint64 dropped = 0;
+    QVERIFY(queue.take(changes, dropped));
+    QCOMPARE(changes.size(), 1);
+    QCOMPARE(dropped, quint64{1});
+}
+
+void DeviceChangeQueueTest::close_drainsThenEnds() {
+    DeviceChangeQueue queue(4);
+    QVERIFY(queue.push(makeChange(QStringLiteral("remove"), 0)));
+    queue.close();
+    QVERIFY(!queue.push(makeChange(QStringLiteral("add"), 1)));
+
+    QList<DeviceChange> changes;
+    quint64 dropped = 0;
+    QVERIFY(queue.take(changes, dropped));
+    QCOMPARE(changes.size(), 1);
+    QCOMPARE(dropped, quint64{1});
+    QVERIFY(!queue.take(changes, dropped));
+    QVERIFY(changes.isEmpty());
+    QCOMPARE(dropped, quint64{0});
+}
+
+void DeviceChangeQueueTest::take_wakesForPush() {
+    DeviceChangeQueue queue(4);
+    QList<DeviceChange> changes;
+    quint64 dropped = 0;
+    std::unique_ptr<QThread> consumer(QThread::create([&] { queue.take(changes, dropped); }));
+    consumer->start();
+    QTest::qWait(20);
+    QVERIFY(consumer->isRunning());
+
+    QVERIFY(queue.push(makeChange(QStringLiteral("unbind"), 0)));
+    QVERIFY(consumer->wait(5000));
+    QCOMPARE(changes.size(), 1);
+    QCOMPARE(changes.at(0).action, QStringLiteral("unbind"));
+}
+
+QTEST_MAIN(DeviceChangeQueueTest)
+#include "devicechangequeuetest.moc"
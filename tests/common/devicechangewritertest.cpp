@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QBuffer>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtTest/QTest>
+
+#include <atomic>
+#include <utility>
+
+#include "devicechangewriter.h"
+#include "deviceinfo_p.h"
+#include "devicemonitor.h"
+
+namespace {
+
+// Stands in for the platform monitor; the test plays the kernel by calling emitEvent()
+class FakeDeviceMonitor : public DeviceMonitor {
+public:
+    std::expected<void, DeviceMonitorError> start() override {
+        running_ = true;
+        return {};
+    }
+
+    void stop() override {
+        running_ = false;
+    }
+
+    bool isRunning() const override {
+        return running_;
+    }
+
+    void emitEvent(const QString &action, int index) {
+        QJsonObject json;
+        json[QStringLiteral("syspath")] = QStringLiteral("/sys/devices/test/%1").arg(index);
+        Q_EMIT deviceEvent(action, DeviceInfo(json));
+    }
+
+private:
+    bool running_ = false;
+};
+
+// Stands in for a live backend device whose handle may only be used on the thread it came from
+class ThreadBoundDeviceInfoPrivate : public DeviceInfoPrivate {
+public:
+    explicit ThreadBoundDeviceInfoPrivate(std::atomic_int *foreignAccesses)
+        : owner_(QThread::currentThread()), foreignAccesses_(foreignAccesses) {
+        syspath_ = QStringLiteral("/sys/devices/test/live");
+    }
+
+    ~ThreadBoundDeviceInfoPrivate() override {
+        checkThread();
+    }
+
+    QString propertyValue(const char *key) const override {
+        checkThread();
+        return propertyValues().value(QString::fromLatin1(key)).toString();
+    }
+
+    QJsonObject propertyValues() const override {
+        checkThread();
+        return {{QStringLiteral("ID_MODEL"), QStringLiteral("Test model")}};
+    }
+
+    DeviceInfoPrivate *clone(DeviceInfo *q) const override {
+        checkThread();
+        return new ThreadBoundDeviceInfoPrivate(*this, q);
+    }
+
+    void dump() const override {
+    }
+
+private:
+    ThreadBoundDeviceInfoPrivate(const ThreadBoundDeviceInfoPrivate &other, DeviceInfo *q)
+        : DeviceInfoPrivate(other, q), owner_(other.owner_),
+          foreignAccesses_(other.foreignAccesses_) {
+    }
+
+    void checkThread() const {
+        if (QThread::currentThread() != owner_) {
+            ++*foreignAccesses_;
+        }
+    }
+
+    QThread *owner_;
+    std::atomic_int *foreignAccesses_;
+};
+
+QJsonObject serializeSyspath(const DeviceInfo &device) {
+    return {{QStringLiteral("syspath"), device.syspath()}};
+}
+
+QList<QJsonObject> writtenLines(const QBuffer &buffer) {
+    QList<QJsonObject> lines;
+    for (const auto &line : buffer.data().split('\n')) {
+        if (!line.isEmpty()) {
+            lines << QJsonDocument::fromJson(line).object();
+        }
+    }
+    return lines;
+}
+
+} // namespace
+
+class DeviceChangeWriterTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void writesEvents();
+    void reportsOverflow();
+    void stop_dropsLaterEvents();
+    void liveDevice_notUsedByWriterThread();
+};
+
+void DeviceChangeWriterTest::writesEvents() {
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    FakeDeviceMonitor monitor;
+    DeviceChangeWriter writer(&buffer, serializeSyspath);
+    connect(&monitor, &DeviceMonitor::deviceEvent, &writer, &DeviceChangeWriter::addEvent);
+    writer.start();
+    QVERIFY(writer.isRunning());
+
+    monitor.emitEvent(QStringLiteral("add"), 1);
+    monitor.emitEvent(QStringLiteral("bind"), 1);
+    monitor.emitEvent(QStringLiteral("remove"), 2);
+    writer.stop();
+    QVERIFY(!writer.isRunning());
+
+    const auto lines = writtenLines(buffer);
+    QCOMPARE(lines.size(), 3);
+    QCOMPARE(lines.at(0).value(QStringLiteral("event")).toString(), QStringLiteral("add"));
+    QCOMPARE(lines.at(1).value(QStringLiteral("event")).toString(), QStringLiteral("bind"));
+    QCOMPARE(lines.at(2).value(QStringLiteral("event")).toString(), QStringLiteral("remove"));
+    QCOMPARE(lines.at(2)
+                 .value(QStringLiteral("device"))
+                 .toObject()
+                 .value(QStringLiteral("syspath"))
+                 .toString(),
+             QStringLiteral("/sys/devices/test/2"));
+    QVERIFY(QDateTime::fromString(lines.at(0).value(QStringLiteral("time")).toString(),
+                                  Qt::ISODateWithMs)
+                .isValid());
+    QCOMPARE(writer.droppedCount(), quint64{0});
+}
+
+void DeviceChangeWriterTest::reportsOverflow() {
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    FakeDeviceMonitor monitor;
+    // The writer blocks in the first serialisation, like a consumer that stopped reading
+    QSemaphore entered;
+    QSemaphore release;
+    auto first = true;
+    DeviceChangeWriter writer(
+        &buffer,
+        [&](const DeviceInfo &device) {
+            if (std::exchange(first, false)) {
+                entered.release();
+                release.acquire();
+            }
+            return serializeSyspath(device);
+        },
+        4);
+    connect(&monitor, &DeviceMonitor::deviceEvent, &writer, &DeviceChangeWriter::addEvent);
+    writer.start();
+
+    monitor.emitEvent(QStringLiteral("add"), 0);
+    QVERIFY(entered.tryAcquire(1, 5000));
+    // A burst while the writer is stuck: four fit in the queue, six are dropped, and the monitor
+    // is never held up
+    for (auto i = 1; i <= 10; ++i) {
+        monitor.emitEvent(QStringLiteral("change"), i);
+    }
+    QCOMPARE(writer.droppedCount(), quint64{6});
+    release.release();
+    writer.stop();
+
+    const auto lines = writtenLines(buffer);
+    QCOMPARE(lines.size(), 6);
+    QCOMPARE(lines.at(4)
+                 .value(QStringLiteral("device"))
+                 .toObject()
+                 .value(QStringLiteral("syspath"))
+                 .toString(),
+             QStringLiteral("/sys/devices/test/4"));
+    QCOMPARE(lines.at(5).value(QStringLiteral("event")).toString(), QStringLiteral("overflow"));
+    QCOMPARE(lines.at(5).value(QStringLiteral("dropped")).toInteger(), qint64{6});
+}
+
+void DeviceChangeWriterTest::stop_dropsLaterEvents() {
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    FakeDeviceMonitor monitor;
+    DeviceChangeWriter writer(&buffer, serializeSyspath);
+    connect(&monitor, &DeviceMonitor::deviceEvent, &writer, &DeviceChangeWriter::addEvent);
+    writer.start();
+    writer.stop();
+
+    monitor.emitEvent(QStringLiteral("add"), 0);
+    QCOMPARE(writer.droppedCount(), quint64{1});
+    QVERIFY(buffer.data().isEmpty());
+}
+
+void DeviceChangeWriterTest::liveDevice_notUsedByWriterThread() {
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    DeviceChangeWriter writer(&buffer, [](const DeviceInfo &device) {
+        return QJsonObject{{QStringLiteral("model"), device.propertyValue("ID_MODEL")}};
+    });
+    writer.start();
+
+    std::atomic_int foreignAccesses = 0;
+    writer.addEvent(QStringLiteral("add"),
+                    DeviceInfo(new ThreadBoundDeviceInfoPrivate(&foreignAccesses)));
+    writer.stop();
+
+    const auto lines = writtenLines(buffer);
+    QCOMPARE(lines.size(), 1);
+    QCOMPARE(lines.at(0)
+                 .value(QStringLiteral("device"))
+                 .toObject()
+                 .value(QStringLiteral("model"))
+                 .toString(),
+             QStringLiteral("Test model"));
+    QCOMPARE(foreignAccesses.load(), 0);
+}
+
+QTEST_MAIN(DeviceChangeWriterTest)
+#include "devicechangewritertest.moc"
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceenumerationfilter.h"
+#include "deviceinfo.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &syspath,
+                      const QString &parentSyspath,
+                      const QString &subsystem,
+                      const QString &driver = {},
+                      const QJsonObject &properties = {}) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = syspath;
+    json[QStringLiteral("parentSyspath")] = parentSyspath;
+    json[QStringLiteral("subsystem")] = subsystem;
+    json[QStringLiteral("driver")] = driver;
+    json[QStringLiteral("properties")] = properties;
+    return DeviceInfo(json);
+}
+
+QList<DeviceInfo> makeDevices() {
+    return {
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00"), QString(), QString()),
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2"),
+                   QStringLiteral("/sys/devices/pci0000:00"),
+                   QStringLiteral("pci"),
+                   QStringLiteral("ahci"),
+                   {{QStringLiteral("ID_PCI_CLASS_FROM_DATABASE"),
+                     QStringLiteral("Mass storage controller")}}),
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2/ata1/block/sda"),
+                   QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2"),
+                   QStringLiteral("block"),
+                   QString(),
+                   {{QStringLiteral("ID_BUS"), QStringLiteral("ata")}}),
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:01:00.0/nvme/nvme0"),
+                   QStringLiteral("/sys/devices/pci0000:00/0000:01:00.0"),
+                   QStringLiteral("nvme"),
+                   QString(),
+                   {{QStringLiteral("ID_BUS"), QStringLiteral("nvme")}}),
+        makeDevice(QStringLiteral("/sys/devices/virtual/net/lo"),
+                   QStringLiteral("/sys/devices/virtual/net"),
+                   QStringLiteral("net")),
+    };
+}
+
+QStringList syspaths(const QList<DeviceInfo> &devices) {
+    QStringList result;
+    for (const auto &device : devices) {
+        result << device.syspath();
+    }
+    return result;
+}
+
+} // namespace
+
+class DeviceEnumerationFilterTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void parse();
+    void parse_invalid();
+    void filter_empty();
+    void filter_subsystems();
+    void filter_properties();
+    void filter_parent();
+    void filter_withDriver();
+    void filter_combined();
+};
+
+void DeviceEnumerationFilterTest::parse() {
+    const auto filter =
+        DeviceEnumerationFilter::parse({QStringLiteral("block")},
+                                       {QStringLiteral("ID_BUS=ata"), QStringLiteral("ID_X=a=b")},
+                                       QStringLiteral("/sys/devices/pci0000:00"),
+                                       true);
+    QVERIFY(filter);
+    QCOMPARE(filter->subsystems, QStringList({QStringLiteral("block")}));
+    QCOMPARE(filter->properties.size(), 2);
+    QCOMPARE(filter->properties.at(0).first, QStringLiteral("ID_BUS"));
+    QCOMPARE(filter->properties.at(0).second, QStringLiteral("ata"));
+    QCOMPARE(filter->properties.at(1).second, QStringLiteral("a=b"));
+    QCOMPARE(filter->parentSyspath, QStringLiteral("/sys/devices/pci0000:00"));
+    QVERIFY(filter->withDriver);
+    QVERIFY(!filter->isEmpty());
+    QVERIFY(DeviceEnumerationFilter{}.isEmpty());
+}
+
+void DeviceEnumerationFilterTest::parse_invalid() {
+    QVERIFY(!DeviceEnumerationFilter::parse({}, {QStringLiteral("ID_BUS")}, QString(), false));
+    const auto filter = DeviceEnumerationFilter::parse({}, {QStringLiteral("=ata")}, {}, false);
+    QVERIFY(!filter);
+    QVERIFY(filter.error().contains(QStringLiteral("=ata")));
+}
+
+void DeviceEnumerationFilterTest::filter_empty() {
+    QCOMPARE(filterDevices(makeDevices(), {}).size(), 5);
+}
+
+void DeviceEnumerationFilterTest::filter_subsystems() {
+    DeviceEnumerationFilter filter;
+    filter.subsystems = {QStringLiteral("block"), QStringLiteral("nv*")};
+    QCOMPARE(syspaths(filterDevices(makeDevices(), filter)),
+             QStringList({QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2/ata1/block/sda"),
+                          QStringLiteral("/sys/devices/pci0000:00/0000:01:00.0/nvme/nvme0")}));
+}
+
+void DeviceEnumerationFilterTest::filter_properties() {
+    DeviceEnumerationFilter filter;
+    filter.properties = {{QStringLiteral("ID_BUS"), QStringLiteral("nvme")},
+                         {QStringLiteral("ID_PCI_CLASS_FROM_DATABASE"), QStringLiteral("Mass*")}};
+    QCOMPARE(syspaths(filterDevices(makeDevices(), filter)),
+             QStringList({QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2"),
+                          QStringLiteral("/sys/devices/pci0000:00/0000:01:00.0/nvme/nvme0")}));
+
+    // A wildcard only matches devices that have the property
+    filter.properties = {{QStringLiteral("ID_BUS"), QStringLiteral("*")}};
+    QCOMPARE(filterDevices(makeDevices(), filter).size(), 2);
+}
+
+void DeviceEnumerationFilterTest::filter_parent() {
+    DeviceEnumerationFilter filter;
+    filter.parentSyspath = QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2");
+    QCOMPARE(syspaths(filterDevices(makeDevices(), filter)),
+             QStringList({QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2"),
+                          QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2/ata1/block/sda")}));
+
+    // nvme0's parent was not enumerated, so the chain to the root is broken
+    filter.parentSyspath = QStringLiteral("/sys/devices/pci0000:00");
+    QCOMPARE(filterDevices(makeDevices(), filter).size(), 3);
+}
+
+void DeviceEnumerationFilterTest::filter_withDriver() {
+    DeviceEnumerationFilter filter;
+    filter.withDriver = true;
+    QCOMPARE(syspaths(filterDevices(makeDevices(), filter)),
+             QStringList({QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2")}));
+}
+
+void DeviceEnumerationFilterTest::filter_combined() {
+    DeviceEnumerationFilter filter;
+    filter.subsystems = {QStringLiteral("block"), QStringLiteral("nvme")};
+    filter.parentSyspath = QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2");
+    QCOMPARE(syspaths(filterDevices(makeDevices(), filter)),
+             QStringList({QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.2/ata1/block/sda")}));
+}
+
+QTEST_MAIN(DeviceEnumerationFilterTest)
+#include "deviceenumerationfiltertest.moc"
@@ -0,0 +1,249 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSemaphore>
+#include <QtCore/QTemporaryDir>
+#include <QtNetwork/QLocalSocket>
+#include <QtTest/QTest>
+
+#include "devicequery.h"
+#include "devicequeryserver.h"
+
+namespace {
+
+DeviceInfo makeDevice(int index, const QString &driver, const QJsonObject &properties = {}) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = QStringLiteral("/sys/devices/test/%1").arg(index);
+    json[QStringLiteral("name")] = QStringLiteral("Device %1").arg(index);
+    json[QStringLiteral("driver")] = driver;
+    json[QStringLiteral("properties")] = properties;
+    return DeviceInfo(json);
+}
+
+QList<DeviceInfo> makeDevices() {
+    return {makeDevice(0, QStringLiteral("ahci")),
+            makeDevice(1, QStringLiteral("xhci_hcd")),
+            makeDevice(2, QStringLiteral("ahci"))};
+}
+
+QJsonObject respond(const DeviceQueryServer &server, const QByteArray &request) {
+    return QJsonDocument::fromJson(server.handleRequest(request)).object();
+}
+
+QStringList syspaths(const QJsonObject &response) {
+    QStringList result;
+    for (const auto &device : response.value(QStringLiteral("devices")).toArray()) {
+        result << device.toObject().value(QStringLiteral("syspath")).toString();
+    }
+    return result;
+}
+
+QStringList syspaths(const DeviceSnapshot &snapshot) {
+    QStringList result;
+    for (const auto &device : snapshot.devices) {
+        result << device.syspath();
+    }
+    return result;
+}
+
+} // namespace
+
+class DeviceQueryServerTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void handleRequest_filters();
+    void handleRequest_invalid();
+    void handleRequest_providerSetup();
+    void applyEvent_publishesOnce();
+    void applyEvent_move();
+    void replaceDevices_publishes();
+    void listen_answersClients();
+    void listen_slowRequestDoesNotBlockOthers();
+    void listen_replacesStaleSocket();
+};
+
+void DeviceQueryServerTest::handleRequest_filters() {
+    const DeviceQueryServer server(makeDevices());
+    const auto response =
+        respond(server, R"({"filters":["driver=ahci"],"fields":["syspath","name"]})");
+    QCOMPARE(response.value(QStringLiteral("generation")).toInteger(), qint64{0});
+    QCOMPARE(syspaths(response),
+             QStringList({QStringLiteral("/sys/devices/test/0"),
+                          QStringLiteral("/sys/devices/test/2")}));
+    const auto first = response.value(QStringLiteral("devices")).toArray().at(0).toObject();
+    QCOMPARE(first.keys(), QStringList({QStringLiteral("name"), QStringLiteral("syspath")}));
+
+    // Both members are optional
+    QCOMPARE(syspaths(respond(server, "{}")).size(), 3);
+}
+
+void DeviceQueryServerTest::handleRequest_invalid() {
+    const DeviceQueryServer server(makeDevices());
+    QVERIFY(respond(server, "not json").value(QStringLiteral("error")).isString());
+    QVERIFY(respond(server, "[]").value(QStringLiteral("error")).isString());
+    QVERIFY(respond(server, R"({"filters":"driver=ahci"})")
+                .value(QStringLiteral("error"))
+                .isString());
+    QVERIFY(respond(server, R"({"fields":[1]})").value(QStringLiteral("error")).isString());
+    QVERIFY(respond(server, R"({"fields":["colour"]})")
+                .value(QStringLiteral("error"))
+                .toString()
+                .contains(QStringLiteral("colour")));
+}
+
+void DeviceQueryServerTest::handleRequest_providerSetup() {
+    DeviceQueryServer server(makeDevices());
+    quint64 generation = 1;
+    server.setProviderSetup(
+        [&](DeviceQuery &query, const std::shared_ptr<const DeviceSnapshot> &snapshot) {
+            generation = snapshot->generation;
+            query.setFieldProvider(QStringLiteral("resources"), [](const DeviceInfo &info) {
+                return QJsonValue(QJsonArray{info.driver()});
+            });
+        });
+    const auto response = respond(server, R"({"filters":["resources~xhci"]})");
+    QCOMPARE(generation, quint64{0});
+    QCOMPARE(syspaths(response), QStringList({QStringLiteral("/sys/devices/test/1")}));
+}
+
+void DeviceQueryServerTest::applyEvent_publishesOnce() {
+    DeviceQueryServer server(makeDevices());
+    const auto before = server.snapshot();
+
+    server.applyEvent(QStringLiteral("add"), makeDevice(3, QStringLiteral("usb")));
+    server.applyEvent(QStringLiteral("bind"), makeDevice(1, QStringLiteral("uhci_hcd")));
+    server.applyEvent(QStringLiteral("remove"), makeDevice(0, QString()));
+    // Nothing is published until the event loop runs, and then the burst is one snapshot
+    QVERIFY(server.snapshot() == before);
+    QTRY_COMPARE(server.snapshot()->generation, quint64{1});
+
+    QCOMPARE(syspaths(*server.snapshot()),
+             QStringList({QStringLiteral("/sys/devices/test/1"),
+                          QStringLiteral("/sys/devices/test/2"),
+                          QStringLiteral("/sys/devices/test/3")}));
+    QCOMPARE(server.snapshot()->devices.at(0).driver(), QStringLiteral("uhci_hcd"));
+    // A request holding the old snapshot still sees it unchanged
+    QCOMPARE(syspaths(*before).size(), 3);
+    QCOMPARE(before->devices.at(1).driver(), QStringLiteral("xhci_hcd"));
+
+    // The index follows the removal, so later events still find their devices
+    server.applyEvent(QStringLiteral("remove"), makeDevice(3, QString()));
+    server.applyEvent(QStringLiteral("change"), makeDevice(2, QStringLiteral("nvme")));
+    QTRY_COMPARE(server.snapshot()->generation, quint64{2});
+    QCOMPARE(syspaths(*server.snapshot()),
+             QStringList({QStringLiteral("/sys/devices/test/1"),
+                          QStringLiteral("/sys/devices/test/2")}));
+    QCOMPARE(server.snapshot()->devices.at(1).driver(), QStringLiteral("nvme"));
+}
+
+void DeviceQueryServerTest::applyEvent_move() {
+    DeviceQueryServer server(makeDevices());
+    server.applyEvent(QStringLiteral("move"),
+                      makeDevice(4,
+                                 QStringLiteral("ahci"),
+                                 {{QStringLiteral("DEVPATH_OLD"),
+                                   QStringLiteral("/devices/test/0")}}));
+    QTRY_COMPARE(server.snapshot()->generation, quint64{1});
+    QCOMPARE(syspaths(*server.snapshot()),
+             QStringList({QStringLiteral("/sys/devices/test/1"),
+                          QStringLiteral("/sys/devices/test/2"),
+                          QStringLiteral("/sys/devices/test/4")}));
+}
+
+void DeviceQueryServerTest::replaceDevices_publishes() {
+    DeviceQueryServer server(makeDevices());
+    server.applyEvent(QStringLiteral("remove"), makeDevice(0, QString()));
+    server.replaceDevices({makeDevice(2, QStringLiteral("nvme")), makeDevice(5, QString())});
+    QTRY_COMPARE(server.snapshot()->generation, quint64{1});
+    QCOMPARE(syspaths(*server.snapshot()),
+             QStringList({QStringLiteral("/sys/devices/test/2"),
+                          QStringLiteral("/sys/devices/test/5")}));
+
+    // Later events find the replaced devices
+    server.applyEvent(QStringLiteral("remove"), makeDevice(2, QString()));
+    QTRY_COMPARE(server.snapshot()->generation, quint64{2});
+    QCOMPARE(syspaths(*server.snapshot()), QStringList({QStringLiteral("/sys/devices/test/5")}));
+}
+
+void DeviceQueryServerTest::listen_answersClients() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto path = dir.filePath(QStringLiteral("hwview.sock"));
+    DeviceQueryServer server(makeDevices());
+    QVERIFY2(server.listen(path), qPrintable(server.errorString()));
+
+    // Two requests in one write are answered in order
+    QLocalSocket client;
+    client.connectToServer(path);
+    QVERIFY(client.waitForConnected(5000));
+    client.write("{\"filters\":[\"driver=xhci_hcd\"]}\n{\"filters\":[\"name~device\"]}\n");
+    QTRY_VERIFY(client.canReadLine());
+    QCOMPARE(syspaths(QJsonDocument::fromJson(client.readLine()).object()).size(), 1);
+    QTRY_VERIFY(client.canReadLine());
+    QCOMPARE(syspaths(QJsonDocument::fromJson(client.readLine()).object()).size(), 3);
+
+    // A second server cannot take over the socket while the first is answering on it
+    DeviceQueryServer other(makeDevices());
+    QVERIFY(!other.listen(path));
+}
+
+void DeviceQueryServerTest::listen_replacesStaleSocket() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto path = dir.filePath(QStringLiteral("hwview.sock"));
+    QFile stale(path);
+    QVERIFY(stale.open(QIODevice::WriteOnly));
+    stale.close();
+
+    DeviceQueryServer server(makeDevices());
+    QVERIFY2(server.listen(path), qPrintable(server.errorString()));
+    QLocalSocket client;
+    client.connectToServer(path);
+    QVERIFY(client.waitForConnected(5000));
+}
+
+void DeviceQueryServerTest::listen_slowRequestDoesNotBlockOthers() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto path = dir.filePath(QStringLiteral("hwview.sock"));
+    // Requests for resources wait until released, like a slow driver or resource lookup
+    QSemaphore gate;
+    DeviceQueryServer server(makeDevices());
+    server.setProviderSetup(
+        [&gate](DeviceQuery &query, const std::shared_ptr<const DeviceSnapshot> &) {
+            query.setFieldProvider(QStringLiteral("resources"), [&gate](const DeviceInfo &) {
+                // Bounded, so a failing test cannot leave the server waiting on its pool
+                if (gate.tryAcquire(1, 10000)) {
+                    gate.release();
+                }
+                return QJsonValue(QJsonArray());
+            });
+        });
+    QVERIFY2(server.listen(path), qPrintable(server.errorString()));
+
+    QLocalSocket slow;
+    slow.connectToServer(path);
+    QVERIFY(slow.waitForConnected(5000));
+    slow.write("{\"fields\":[\"resources\"]}\n{\"filters\":[\"driver=ahci\"]}\n");
+    QLocalSocket fast;
+    fast.connectToServer(path);
+    QVERIFY(fast.waitForConnected(5000));
+    fast.write("{\"filters\":[\"driver=xhci_hcd\"]}\n");
+
+    QTRY_VERIFY(fast.canReadLine());
+    QCOMPARE(syspaths(QJsonDocument::fromJson(fast.readLine()).object()).size(), 1);
+    QVERIFY(!slow.canReadLine());
+
+    // The slow client's answers follow in the order it asked
+    gate.release();
+    QTRY_VERIFY(slow.canReadLine());
+    QCOMPARE(syspaths(QJsonDocument::fromJson(slow.readLine()).object()).size(), 3);
+    QTRY_VERIFY(slow.canReadLine());
+    QCOMPARE(syspaths(QJsonDocument::fromJson(slow.readLine()).object()).size(), 2);
+}
+
+QTEST_MAIN(DeviceQueryServerTest)
+#include "devicequeryservertest.moc"
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "devicequery.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &name,
+                      const QString &driver,
+                      const QString &subsystem,
+                      DeviceCategory category,
+                      const QString &pciClass = {}) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = QStringLiteral("/sys/devices/test/") + name;
+    json[QStringLiteral("name")] = name;
+    json[QStringLiteral("driver")] = driver;
+    json[QStringLiteral("subsystem")] = subsystem;
+    json[QStringLiteral("category")] = static_cast<int>(category);
+    json[QStringLiteral("pciClass")] = pciClass;
+    json[QStringLiteral("isHidden")] = driver.isEmpty();
+    json[QStringLiteral("properties")] =
+        QJsonObject{{QStringLiteral("ID_VENDOR_ID"), QStringLiteral("8086")}};
+    return DeviceInfo(json);
+}
+
+QList<DeviceInfo> sampleDevices() {
+    return {makeDevice(QStringLiteral("GPU"),
+                       QStringLiteral("i915"),
+                       QStringLiteral("pci"),
+                       DeviceCategory::DisplayAdapters,
+                       QStringLiteral("Display controller")),
+            makeDevice(QStringLiteral("Ethernet"),
+                       QStringLiteral("e1000e"),
+                       QStringLiteral("pci"),
+                       DeviceCategory::NetworkAdapters,
+                       QStringLiteral("Network controller")),
+            makeDevice(QStringLiteral("Webcam"),
+                       QString(),
+                       QStringLiteral("usb"),
+                       DeviceCategory::SoundVideoAndGameControllers)};
+}
+
+QStringList matchingNames(const DeviceQuery &query, const QList<DeviceInfo> &devices) {
+    QStringList names;
+    for (const auto &info : devices) {
+        if (const auto device = query.evaluate(info)) {
+            names << info.name();
+        }
+    }
+    return names;
+}
+
+} // namespace
+
+class DeviceQueryTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void filters_data();
+    void filters();
+    void parse_invalid_data();
+    void parse_invalid();
+    void projection_default();
+    void projection_nested();
+    void providers_onlyWhenNamed();
+    void providers_notForRejected();
+    void usesField();
+};
+
+void DeviceQueryTest::filters_data() {
+    QTest::addColumn<QStringList>("filters");
+    QTest::addColumn<QStringList>("names");
+
+    QTest::newRow("none") << QStringList() << QStringList({QStringLiteral("GPU"),
+                                                           QStringLiteral("Ethernet"),
+                                                           QStringLiteral("Webcam")});
+    QTest::newRow("driver") << QStringList({QStringLiteral("driver=i915")})
+                            << QStringList({QStringLiteral("GPU")});
+    QTest::newRow("no driver") << QStringList({QStringLiteral("driver=")})
+                               << QStringList({QStringLiteral("Webcam")});
+    QTest::newRow("not equal") << QStringList({QStringLiteral("subsystem!=pci")})
+                               << QStringList({QStringLiteral("Webcam")});
+    QTest::newRow("contains ignoring case")
+        << QStringList({QStringLiteral("categoryName~ADAPTERS")})
+        << QStringList({QStringLiteral("GPU"), QStringLiteral("Ethernet")});
+    QTest::newRow("nested") << QStringList({QStringLiteral("pci.class=Network controller")})
+                            << QStringList({QStringLiteral("Ethernet")});
+    QTest::newRow("boolean") << QStringList({QStringLiteral("isHidden=true")})
+                             << QStringList({QStringLiteral("Webcam")});
+    QTest::newRow("number") << QStringList({QStringLiteral("category=5")})
+                            << QStringList({QStringLiteral("GPU")});
+    QTest::newRow("all must match")
+        << QStringList({QStringLiteral("subsystem=pci"), QStringLiteral("driver~e1000")})
+        << QStringList({QStringLiteral("Ethernet")});
+    QTest::newRow("value containing operators")
+        << QStringList({QStringLiteral("name=a=b~c")}) << QStringList();
+}
+
+void DeviceQueryTest::filters() {
+    QFETCH(QStringList, filters);
+    QFETCH(QStringList, names);
+
+    const auto query = DeviceQuery::parse(filters, {});
+    QVERIFY(query.has_value());
+    QCOMPARE(matchingNames(*query, sampleDevices()), names);
+}
+
+void DeviceQueryTest::parse_invalid_data() {
+    QTest::addColumn<QStringList>("filters");
+    QTest::addColumn<QStringList>("fields");
+    QTest::addColumn<QString>("error");
+
+    QTest::newRow("no operator") << QStringList({QStringLiteral("driver")}) << QStringList()
+                                 << QStringLiteral("Invalid filter 'driver'");
+    QTest::newRow("no field") << QStringList({QStringLiteral("!=x")}) << QStringList()
+                              << QStringLiteral("Invalid filter '!=x'");
+    QTest::newRow("unknown filter field") << QStringList({QStringLiteral("vendor=x")})
+                                          << QStringList()
+                                          << QStringLiteral("Unknown field 'vendor'");
+    QTest::newRow("unknown projected field")
+        << QStringList() << QStringList({QStringLiteral("name"), QStringLiteral("size")})
+        << QStringLiteral("Unknown field 'size'");
+    QTest::newRow("empty key") << QStringList() << QStringList({QStringLiteral("pci..class")})
+                               << QStringLiteral("Unknown field 'pci..class'");
+}
+
+void DeviceQueryTest::parse_invalid() {
+    QFETCH(QStringList, filters);
+    QFETCH(QStringList, fields);
+    QFETCH(QString, error);
+
+    const auto query = DeviceQuery::parse(filters, fields);
+    QVERIFY(!query.has_value());
+    QVERIFY2(query.error().startsWith(error), qPrintable(query.error()));
+}
+
+void DeviceQueryTest::projection_default() {
+    const auto query = DeviceQuery::parse({}, {});
+    QVERIFY(query.has_value());
+    const auto device = query->evaluate(sampleDevices().at(0));
+    QVERIFY(device.has_value());
+    QCOMPARE(device->keys().size(), DeviceQuery::defaultFields().size());
+    QCOMPARE(device->value(QStringLiteral("driver")).toString(), QStringLiteral("i915"));
+    QCOMPARE(device->value(QStringLiteral("categoryName")).toString(),
+             QStringLiteral("Display adapters"));
+}
+
+void DeviceQueryTest::projection_nested() {
+    const auto query = DeviceQuery::parse(
+        {}, {QStringLiteral("pci.class"), QStringLiteral("properties.ID_VENDOR_ID")});
+    QVERIFY(query.has_value());
+
+    const auto gpu = query->evaluate(sampleDevices().at(0));
+    QVERIFY(gpu.has_value());
+    QCOMPARE(*gpu,
+             QJsonObject({{QStringLiteral("pci.class"), QStringLiteral("Display controller")},
+                          {QStringLiteral("properties.ID_VENDOR_ID"), QStringLiteral("8086")}}));
+
+    // Devices without PCI information have a null pci field
+    const auto webcam = query->evaluate(sampleDevices().at(2));
+    QVERIFY(webcam.has_value());
+    QVERIFY(webcam->contains(QStringLiteral("pci.class")));
+    QVERIFY(webcam->value(QStringLiteral("pci.class")).isNull());
+}
+
+void DeviceQueryTest::providers_onlyWhenNamed() {
+    auto calls = 0;
+    const auto provider = [&calls](const DeviceInfo &info) {
+        ++calls;
+        return QJsonValue(QJsonObject{{QStringLiteral("name"), info.driver()}});
+    };
+
+    auto query = DeviceQuery::parse({QStringLiteral("subsystem=pci")}, {});
+    QVERIFY(query.has_value());
+    QVERIFY(query->setFieldProvider(QStringLiteral("driverInfo"), provider));
+    QVERIFY(!query->setFieldProvider(QStringLiteral("size"), provider));
+    QCOMPARE(matchingNames(*query, sampleDevices()).size(), 2);
+    QCOMPARE(calls, 0);
+
+    // Named by a filter and twice by the projection: computed once per device
+    query = DeviceQuery::parse({QStringLiteral("driverInfo.name~e")},
+                               {QStringLiteral("driverInfo"), QStringLiteral("driverInfo.name")});
+    QVERIFY(query.has_value());
+    QVERIFY(query->setFieldProvider(QStringLiteral("driverInfo"), provider));
+    const auto devices = sampleDevices();
+    const auto device = query->evaluate(devices.at(1));
+    QVERIFY(device.has_value());
+    QCOMPARE(calls, 1);
+    QCOMPARE(device->value(QStringLiteral("driverInfo.name")).toString(), QStringLiteral("e1000e"));
+}
+
+void DeviceQueryTest::providers_notForRejected() {
+    auto calls = 0;
+    auto query = DeviceQuery::parse({QStringLiteral("driver=i915")}, {QStringLiteral("resources")});
+    QVERIFY(query.has_value());
+    query->setFieldProvider(QStringLiteral("resources"), [&calls](const DeviceInfo &) {
+        ++calls;
+        return QJsonValue(QJsonArray());
+    });
+    QCOMPARE(matchingNames(*query, sampleDevices()), QStringList({QStringLiteral("GPU")}));
+    QCOMPARE(calls, 1);
+}
+
+void DeviceQueryTest::usesField() {
+    const auto query = DeviceQuery::parse({QStringLiteral("properties.ID_VENDOR_ID=8086")},
+                                          {QStringLiteral("name")});
+    QVERIFY(query.has_value());
+    QVERIFY(query->usesField(QStringLiteral("properties")));
+    QVERIFY(query->usesField(QStringLiteral("name")));
+    QVERIFY(!query->usesField(QStringLiteral("resources")));
+    QVERIFY(!query->usesField(QStringLiteral("size")));
+}
+
+QTEST_MAIN(DeviceQueryTest)
+#include "devicequerytest.moc"
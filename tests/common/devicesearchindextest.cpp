@@ -0,0 +1,165 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "devicesearchindex.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &syspath,
+                      const QString &name,
+                      const QString &driver = QString(),
+                      const QJsonObject &properties = QJsonObject()) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = syspath;
+    json[QStringLiteral("name")] = name;
+    json[QStringLiteral("driver")] = driver;
+    json[QStringLiteral("properties")] = properties;
+    return DeviceInfo(json);
+}
+
+QList<DeviceInfo> sampleDevices() {
+    return {
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:02.0"),
+                   QStringLiteral("UHD Graphics 620"),
+                   QStringLiteral("i915"),
+                   {{QStringLiteral("PCI_ID"), QStringLiteral("8086:5917")},
+                    {QStringLiteral("ID_VENDOR_FROM_DATABASE"),
+                     QStringLiteral("Intel Corporation")}}),
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:14.0"),
+                   QStringLiteral("USB controller"),
+                   QStringLiteral("xhci_hcd"),
+                   {{QStringLiteral("MODALIAS"),
+                     QStringLiteral("pci:v00008086d00009D2Fsv000017AAsd0000225Dbc0Csc03i30")}}),
+        makeDevice(QStringLiteral("/sys/devices/virtual/net/lo"), QStringLiteral("lo")),
+    };
+}
+
+} // namespace
+
+class DeviceSearchIndexTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void match_name();
+    void match_caseInsensitive();
+    void match_driver();
+    void match_syspath();
+    void match_pciId();
+    void match_modalias();
+    void match_vendor();
+    void match_displayName();
+    void match_shortTerm();
+    void match_allTermsRequired();
+    void match_termsMayMatchDifferentFields();
+    void match_doesNotSpanFields();
+    void match_emptyQuery();
+    void match_noResult();
+    void clear();
+};
+
+void DeviceSearchIndexTest::match_name() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.size(), 3);
+    QCOMPARE(index.match(QStringLiteral("Graphics")), QList<int>{0});
+}
+
+void DeviceSearchIndexTest::match_caseInsensitive() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("usb CONTROLLER")), QList<int>{1});
+}
+
+void DeviceSearchIndexTest::match_driver() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("xhci")), QList<int>{1});
+}
+
+void DeviceSearchIndexTest::match_syspath() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("0000:00")), (QList<int>{0, 1}));
+    QCOMPARE(index.match(QStringLiteral("virtual/net")), QList<int>{2});
+}
+
+void DeviceSearchIndexTest::match_pciId() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("8086:5917")), QList<int>{0});
+}
+
+void DeviceSearchIndexTest::match_modalias() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("d00009d2f")), QList<int>{1});
+}
+
+void DeviceSearchIndexTest::match_vendor() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("intel")), QList<int>{0});
+}
+
+void DeviceSearchIndexTest::match_displayName() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices(),
+                {{QStringLiteral("Intel UHD Graphics 620")},
+                 {},
+                 {QStringLiteral("Loopback"), QStringLiteral("Network: Loopback")}});
+    QCOMPARE(index.match(QStringLiteral("loopback")), QList<int>{2});
+    QCOMPARE(index.match(QStringLiteral("network:")), QList<int>{2});
+    QVERIFY(index.match(QStringLiteral("loopback usb")).isEmpty());
+}
+
+void DeviceSearchIndexTest::match_shortTerm() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("lo")), QList<int>{2});
+    QCOMPARE(index.match(QStringLiteral("91")), QList<int>{0});
+}
+
+void DeviceSearchIndexTest::match_allTermsRequired() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("pci0000 i915")), QList<int>{0});
+}
+
+void DeviceSearchIndexTest::match_termsMayMatchDifferentFields() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QCOMPARE(index.match(QStringLiteral("graphics 8086")), QList<int>{0});
+}
+
+void DeviceSearchIndexTest::match_doesNotSpanFields() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    // Name "lo" followed by the syspath must not produce a "lo/sys" match
+    QVERIFY(index.match(QStringLiteral("lo/sys")).isEmpty());
+}
+
+void DeviceSearchIndexTest::match_emptyQuery() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QVERIFY(index.match(QString()).isEmpty());
+    QVERIFY(index.match(QStringLiteral("   ")).isEmpty());
+}
+
+void DeviceSearchIndexTest::match_noResult() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    QVERIFY(index.match(QStringLiteral("nonexistent")).isEmpty());
+}
+
+void DeviceSearchIndexTest::clear() {
+    DeviceSearchIndex index;
+    index.build(sampleDevices());
+    index.clear();
+    QCOMPARE(index.size(), 0);
+    QVERIFY(index.match(QStringLiteral("graphics")).isEmpty());
+}
+
+QTEST_MAIN(DeviceSearchIndexTest)
+#include "devicesearchindextest.moc"
@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "devicetree.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &syspath, const QString &parentSyspath = QString()) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = syspath;
+    json[QStringLiteral("parentSyspath")] = parentSyspath;
+    return DeviceInfo(json);
+}
+
+} // namespace
+
+class DeviceTreeTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void build_resolvesParents();
+    void build_childOrderFollowsSnapshot();
+    void build_childBeforeParent();
+    void build_manyChildrenBeforeParents();
+    void build_missingParentIsRoot();
+    void build_selfParentIsRoot();
+    void indexOf_unknownSyspath();
+    void ancestorsOf_nearestFirst();
+    void outOfRange();
+    void clear();
+};
+
+void DeviceTreeTest::build_resolvesParents() {
+    QList<DeviceInfo> devices{
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00")),
+        makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:14.0"),
+                   QStringLiteral("/sys/devices/pci0000:00")),
+    };
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.size(), 2);
+    QCOMPARE(tree.parentOf(0), -1);
+    QCOMPARE(tree.parentOf(1), 0);
+    QCOMPARE(tree.childrenOf(0), QList<int>{1});
+    QCOMPARE(tree.roots(), QList<int>{0});
+}
+
+void DeviceTreeTest::build_childOrderFollowsSnapshot() {
+    QList<DeviceInfo> devices{
+        makeDevice(QStringLiteral("/sys/devices/a")),
+        makeDevice(QStringLiteral("/sys/devices/a/c"), QStringLiteral("/sys/devices/a")),
+        makeDevice(QStringLiteral("/sys/devices/a/b"), QStringLiteral("/sys/devices/a")),
+    };
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.childrenOf(0), (QList<int>{1, 2}));
+}
+
+void DeviceTreeTest::build_childBeforeParent() {
+    QList<DeviceInfo> devices{
+        makeDevice(QStringLiteral("/sys/devices/a/b"), QStringLiteral("/sys/devices/a")),
+        makeDevice(QStringLiteral("/sys/devices/a")),
+    };
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.parentOf(0), 1);
+    QCOMPARE(tree.roots(), QList<int>{1});
+}
+
+void DeviceTreeTest::build_manyChildrenBeforeParents() {
+    // A chain listed deepest first: every device adopts the one before it
+    constexpr auto kDepth = 1000;
+    const auto syspath = [](int depth) { return QStringLiteral("/sys/devices/d%1").arg(depth); };
+    QList<DeviceInfo> devices;
+    devices.reserve(kDepth);
+    for (auto depth = kDepth - 1; depth >= 0; --depth) {
+        devices.append(makeDevice(syspath(depth), depth > 0 ? syspath(depth - 1) : QString()));
+    }
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.roots(), QList<int>{kDepth - 1});
+    QCOMPARE(tree.parentOf(0), 1);
+    QCOMPARE(tree.childrenOf(kDepth - 1), QList<int>{kDepth - 2});
+}
+
+void DeviceTreeTest::build_missingParentIsRoot() {
+    QList<DeviceInfo> devices{
+        makeDevice(QStringLiteral("/sys/devices/a/b"), QStringLiteral("/sys/devices/a")),
+    };
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.parentOf(0), -1);
+    QCOMPARE(tree.roots(), QList<int>{0});
+}
+
+void DeviceTreeTest::build_selfParentIsRoot() {
+    QList<DeviceInfo> devices{
+        makeDevice(QStringLiteral("/sys/devices/a"), QStringLiteral("/sys/devices/a")),
+    };
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.parentOf(0), -1);
+    QVERIFY(tree.childrenOf(0).isEmpty());
+    QVERIFY(tree.ancestorsOf(0).isEmpty());
+}
+
+void DeviceTreeTest::indexOf_unknownSyspath() {
+    QList<DeviceInfo> devices{makeDevice(QStringLiteral("/sys/devices/a"))};
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.indexOf(QStringLiteral("/sys/devices/a")), 0);
+    QCOMPARE(tree.indexOf(QStringLiteral("/sys/devices/b")), -1);
+    QCOMPARE(tree.indexOf(QString()), -1);
+}
+
+void DeviceTreeTest::ancestorsOf_nearestFirst() {
+    QList<DeviceInfo> devices{
+        makeDevice(QStringLiteral("/sys/devices/a")),
+        makeDevice(QStringLiteral("/sys/devices/a/b"), QStringLiteral("/sys/devices/a")),
+        makeDevice(QStringLiteral("/sys/devices/a/b/c"), QStringLiteral("/sys/devices/a/b")),
+    };
+    DeviceTree tree;
+    tree.build(devices);
+
+    QCOMPARE(tree.ancestorsOf(2), (QList<int>{1, 0}));
+    QVERIFY(tree.ancestorsOf(0).isEmpty());
+}
+
+void DeviceTreeTest::outOfRange() {
+    DeviceTree tree;
+    QCOMPARE(tree.parentOf(0), -1);
+    QCOMPARE(tree.parentOf(-1), -1);
+    QVERIFY(tree.childrenOf(5).isEmpty());
+    QVERIFY(tree.ancestorsOf(5).isEmpty());
+}
+
+void DeviceTreeTest::clear() {
+    QList<DeviceInfo> devices{makeDevice(QStringLiteral("/sys/devices/a"))};
+    DeviceTree tree;
+    tree.build(devices);
+    tree.clear();
+
+    QCOMPARE(tree.size(), 0);
+    QVERIFY(tree.roots().isEmpty());
+    QCOMPARE(tree.indexOf(QStringLiteral("/sys/devices/a")), -1);
+}
+
+QTEST_MAIN(DeviceTreeTest)
+#include "devicetreetest.moc"
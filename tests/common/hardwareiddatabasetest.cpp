@@ -0,0 +1,203 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+#include "hardwareiddatabase.h"
+
+namespace {
+
+QString fixturePath(const QString &name) {
+    return QStringLiteral(HWVIEW_TEST_DATA_DIR) + QLatin1Char('/') + name;
+}
+
+// Copies a fixture so that its modification time can be changed
+QString copyFixture(const QTemporaryDir &dir, const QString &name) {
+    const auto path = dir.filePath(name);
+    QFile::copy(fixturePath(name), path);
+    QFile::setPermissions(path, QFile::ReadOwner | QFile::WriteOwner);
+    return path;
+}
+
+void setModified(const QString &path, const QDateTime &time) {
+    QFile file(path);
+    if (file.open(QIODevice::ReadWrite)) {
+        file.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+}
+
+} // namespace
+
+class HardwareIdDatabaseTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+
+    void usbVendors();
+    void skipsNonVendorSections();
+    void parseId();
+    void missingOrEmptyFile();
+    void cache_roundTrip();
+    void cache_invalidatedByModification();
+    void cache_corruptIsRebuilt();
+    void cache_sameNameDifferentDirectory();
+};
+
+void HardwareIdDatabaseTest::initTestCase() {
+    // openFirst() caches under the generic cache location; keep that out of the user's
+    QStandardPaths::setTestModeEnabled(true);
+}
+
+void HardwareIdDatabaseTest::usbVendors() {
+    HardwareIdDatabase db;
+    QVERIFY(db.open(fixturePath(QStringLiteral("usb-test.ids"))));
+    QVERIFY(db.isOpen());
+    QVERIFY(!db.isFromCache());
+    QCOMPARE(db.vendorCount(), 4);
+
+    QCOMPARE(db.vendor(0x046d), QStringLiteral("Logitech, Inc."));
+    QCOMPARE(db.vendor(0x0001), QStringLiteral("Fry's Electronics"));
+    QCOMPARE(db.vendor(0x8087), QStringLiteral("Intel Corp."));
+    QVERIFY(db.vendor(0x1234).isEmpty());
+    // Product lines are not vendors
+    QVERIFY(db.vendor(0xc52b).isEmpty());
+}
+
+void HardwareIdDatabaseTest::skipsNonVendorSections() {
+    HardwareIdDatabase db;
+    QVERIFY(db.open(fixturePath(QStringLiteral("usb-test.ids"))));
+    // Neither the class section's "C 03" nor its nested lines are vendors
+    QCOMPARE(db.vendorCount(), 4);
+    QVERIFY(db.vendor(0x0c03).isEmpty());
+}
+
+void HardwareIdDatabaseTest::parseId() {
+    quint16 id = 0;
+    QVERIFY(HardwareIdDatabase::parseId(QStringLiteral("046d"), id));
+    QCOMPARE(id, 0x046d);
+    QVERIFY(HardwareIdDatabase::parseId(QStringLiteral("0x8086\n"), id));
+    QCOMPARE(id, 0x8086);
+    QVERIFY(HardwareIdDatabase::parseId(QStringLiteral("C52B"), id));
+    QCOMPARE(id, 0xc52b);
+    QVERIFY(!HardwareIdDatabase::parseId(QString(), id));
+    QVERIFY(!HardwareIdDatabase::parseId(QStringLiteral("12345"), id));
+    QVERIFY(!HardwareIdDatabase::parseId(QStringLiteral("xyz"), id));
+}
+
+void HardwareIdDatabaseTest::missingOrEmptyFile() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    HardwareIdDatabase db;
+    QVERIFY(!db.open(dir.filePath(QStringLiteral("missing.ids"))));
+    QVERIFY(!db.isOpen());
+
+    QFile empty(dir.filePath(QStringLiteral("empty.ids")));
+    QVERIFY(empty.open(QIODevice::WriteOnly));
+    empty.write("# only comments\n");
+    empty.close();
+    QVERIFY(!db.open(empty.fileName()));
+    QVERIFY(db.vendor(0x046d).isEmpty());
+
+    QVERIFY(db.openFirst({dir.filePath(QStringLiteral("missing.ids")), empty.fileName(),
+                          fixturePath(QStringLiteral("usb-test.ids"))}));
+    QCOMPARE(db.vendor(0x03f0), QStringLiteral("HP, Inc."));
+}
+
+void HardwareIdDatabaseTest::cache_roundTrip() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto source = copyFixture(dir, QStringLiteral("usb-test.ids"));
+    const auto cache = dir.filePath(QStringLiteral("cache/usb.ids.idx"));
+
+    HardwareIdDatabase db;
+    QVERIFY(db.open(source, cache));
+    QVERIFY(!db.isFromCache());
+    QVERIFY(QFile::exists(cache));
+
+    HardwareIdDatabase cached;
+    QVERIFY(cached.open(source, cache));
+    QVERIFY(cached.isFromCache());
+    QCOMPARE(cached.vendorCount(), db.vendorCount());
+    QCOMPARE(cached.vendor(0x046d), QStringLiteral("Logitech, Inc."));
+    QCOMPARE(cached.vendor(0x8087), QStringLiteral("Intel Corp."));
+}
+
+void HardwareIdDatabaseTest::cache_invalidatedByModification() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto source = copyFixture(dir, QStringLiteral("usb-test.ids"));
+    const auto cache = dir.filePath(QStringLiteral("usb.ids.idx"));
+    setModified(source, QDateTime::fromSecsSinceEpoch(1700000000));
+
+    HardwareIdDatabase db;
+    QVERIFY(db.open(source, cache));
+    db.close();
+
+    // Same size, different contents: only the modification time tells them apart
+    QFile file(source);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    auto contents = file.readAll();
+    contents.replace("Logitech, Inc.", "Logitech, Ltd.");
+    file.seek(0);
+    file.write(contents);
+    file.close();
+    setModified(source, QDateTime::fromSecsSinceEpoch(1700000100));
+
+    QVERIFY(db.open(source, cache));
+    QVERIFY(!db.isFromCache());
+    QCOMPARE(db.vendor(0x046d), QStringLiteral("Logitech, Ltd."));
+
+    // The rebuilt index replaced the stale one
+    HardwareIdDatabase again;
+    QVERIFY(again.open(source, cache));
+    QVERIFY(again.isFromCache());
+}
+
+void HardwareIdDatabaseTest::cache_corruptIsRebuilt() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const auto source = copyFixture(dir, QStringLiteral("usb-test.ids"));
+    const auto cache = dir.filePath(QStringLiteral("usb.ids.idx"));
+
+    HardwareIdDatabase db;
+    QVERIFY(db.open(source, cache));
+    db.close();
+
+    QFile file(cache);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.resize(file.size() - 3));
+    file.close();
+
+    QVERIFY(db.open(source, cache));
+    QVERIFY(!db.isFromCache());
+    QCOMPARE(db.vendor(0x03f0), QStringLiteral("HP, Inc."));
+}
+
+void HardwareIdDatabaseTest::cache_sameNameDifferentDirectory() {
+    QTemporaryDir first;
+    QTemporaryDir second;
+    QVERIFY(first.isValid());
+    QVERIFY(second.isValid());
+    const auto usb = copyFixture(first, QStringLiteral("usb-test.ids"));
+    const auto other = second.filePath(QStringLiteral("usb-test.ids"));
+    QFile file(other);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("10de  NVIDIA Corp.\n\t2484  GA104 [GeForce RTX 3070]\n");
+    file.close();
+
+    HardwareIdDatabase db;
+    QVERIFY(db.openFirst({usb}));
+    QVERIFY(db.openFirst({other}));
+    QCOMPARE(db.vendor(0x10de), QStringLiteral("NVIDIA Corp."));
+
+    // Opening the other file did not replace the first file's cache
+    QVERIFY(db.openFirst({usb}));
+    QVERIFY(db.isFromCache());
+    QCOMPARE(db.vendor(0x046d), QStringLiteral("Logitech, Inc."));
+}
+
+QTEST_MAIN(HardwareIdDatabaseTest)
+#include "hardwareiddatabasetest.moc"
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QTest>
+
+#include "irqratesampler.h"
+
+namespace {
+
+IrqInfo makeIrq(const QString &number, const QList<quint64> &counts) {
+    IrqInfo irq;
+    irq.irqNumber = number;
+    irq.deviceName = QStringLiteral("dev") + number;
+    irq.cpuCounts = counts;
+    return irq;
+}
+
+} // namespace
+
+class IrqRateSamplerTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void firstSample_hasNoRates();
+    void rate_perCpuAndTotal();
+    void rate_busiestCpu();
+    void rate_idleIrq();
+    void rate_counterWentBackwards();
+    void rate_cpuCountChanged();
+    void rate_newIrq();
+    void addSample_ignoresStaleTimestamp();
+    void clear();
+};
+
+void IrqRateSamplerTest::firstSample_hasNoRates() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {10, 20})}, 0);
+    QVERIFY(!sampler.hasRates());
+    QCOMPARE(sampler.latest().size(), 1);
+    QVERIFY(sampler.rate(QStringLiteral("24")).perCpu.isEmpty());
+}
+
+void IrqRateSamplerTest::rate_perCpuAndTotal() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {10, 20})}, 1000);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {30, 120})}, 3000);
+    QVERIFY(sampler.hasRates());
+
+    auto rate = sampler.rate(QStringLiteral("24"));
+    QCOMPARE(rate.perCpu, (QList<double>{10, 50}));
+    QCOMPARE(rate.total, 60.0);
+}
+
+void IrqRateSamplerTest::rate_busiestCpu() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {0, 0, 0, 0})}, 0);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {1, 0, 97, 2})}, 1000);
+    QCOMPARE(sampler.rate(QStringLiteral("24")).busiestCpu, 2);
+}
+
+void IrqRateSamplerTest::rate_idleIrq() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {5, 5})}, 0);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {5, 5})}, 1000);
+
+    auto rate = sampler.rate(QStringLiteral("24"));
+    QCOMPARE(rate.perCpu, (QList<double>{0, 0}));
+    QCOMPARE(rate.busiestCpu, -1);
+}
+
+void IrqRateSamplerTest::rate_counterWentBackwards() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {100, 10})}, 0);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {3, 20})}, 1000);
+    QCOMPARE(sampler.rate(QStringLiteral("24")).perCpu, (QList<double>{0, 10}));
+}
+
+void IrqRateSamplerTest::rate_cpuCountChanged() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {1, 2})}, 0);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {1, 2, 3})}, 1000);
+    QVERIFY(sampler.rate(QStringLiteral("24")).perCpu.isEmpty());
+
+    // The next interval has matching columns again
+    sampler.addSample({makeIrq(QStringLiteral("24"), {2, 4, 6})}, 2000);
+    QCOMPARE(sampler.rate(QStringLiteral("24")).total, 6.0);
+}
+
+void IrqRateSamplerTest::rate_newIrq() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {1})}, 0);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {2}), makeIrq(QStringLiteral("25"), {9})},
+                      1000);
+    QCOMPARE(sampler.rate(QStringLiteral("24")).total, 1.0);
+    QVERIFY(sampler.rate(QStringLiteral("25")).perCpu.isEmpty());
+}
+
+void IrqRateSamplerTest::addSample_ignoresStaleTimestamp() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {0})}, 1000);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {50})}, 1000);
+    QVERIFY(!sampler.hasRates());
+    QCOMPARE(sampler.latest().constFirst().cpuCounts, QList<quint64>{0});
+}
+
+void IrqRateSamplerTest::clear() {
+    IrqRateSampler sampler;
+    sampler.addSample({makeIrq(QStringLiteral("24"), {0})}, 0);
+    sampler.addSample({makeIrq(QStringLiteral("24"), {5})}, 1000);
+    sampler.clear();
+
+    QVERIFY(!sampler.hasRates());
+    QVERIFY(sampler.latest().isEmpty());
+    // Timestamps start over after clearing
+    sampler.addSample({makeIrq(QStringLiteral("24"), {5})}, 0);
+    QCOMPARE(sampler.latest().size(), 1);
+}
+
+QTEST_MAIN(IrqRateSamplerTest)
+#include "irqratesamplertest.moc"
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QTest>
+
+#include "journalline.h"
+
+class JournalLineTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void split_data();
+    void split();
+    void rejects_data();
+    void rejects();
+};
+
+void JournalLineTest::split_data() {
+    QTest::addColumn<QString>("line");
+    QTest::addColumn<QString>("timestamp");
+    QTest::addColumn<QString>("message");
+
+    QTest::newRow("kernel") << QStringLiteral(
+        "2026-03-14T09:12:01+01:00 host kernel: usb 1-2: new full-speed USB device")
+                            << QStringLiteral("2026-03-14T09:12:01+01:00")
+                            << QStringLiteral("usb 1-2: new full-speed USB device");
+    QTest::newRow("offset without colon")
+        << QStringLiteral("2026-03-14T09:12:01-0500 host kernel:   trailing space  ")
+        << QStringLiteral("2026-03-14T09:12:01-0500") << QStringLiteral("trailing space");
+    QTest::newRow("other identifier")
+        << QStringLiteral("2026-03-14T09:12:01+00:00 host systemd[1]: Started session 2.")
+        << QStringLiteral("2026-03-14T09:12:01+00:00") << QStringLiteral("Started session 2.");
+    QTest::newRow("no identifier")
+        << QStringLiteral("2026-03-14T09:12:01+00:00\t  just text ")
+        << QStringLiteral("2026-03-14T09:12:01+00:00") << QStringLiteral("just text");
+}
+
+void JournalLineTest::split() {
+    QFETCH(QString, line);
+    QFETCH(QString, timestamp);
+    QFETCH(QString, message);
+
+    QStringView actualTimestamp;
+    QStringView actualMessage;
+    QVERIFY(splitJournalLine(line, actualTimestamp, actualMessage));
+    QCOMPARE(actualTimestamp.toString(), timestamp);
+    QCOMPARE(actualMessage.toString(), message);
+}
+
+void JournalLineTest::rejects_data() {
+    QTest::addColumn<QString>("line");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("boot marker") << QStringLiteral("-- Boot 0f3c9b2a --");
+    QTest::newRow("no offset") << QStringLiteral("2026-03-14T09:12:01 host kernel: x");
+    QTest::newRow("short offset") << QStringLiteral("2026-03-14T09:12:01+01 host kernel: x");
+    QTest::newRow("space separator") << QStringLiteral("2026-03-14 09:12:01+01:00 host kernel: x");
+    QTest::newRow("letter in date") << QStringLiteral("2026-O3-14T09:12:01+01:00 host kernel: x");
+    QTest::newRow("no whitespace") << QStringLiteral("2026-03-14T09:12:01+01:00host kernel: x");
+    QTest::newRow("timestamp only") << QStringLiteral("2026-03-14T09:12:01+01:00");
+}
+
+void JournalLineTest::rejects() {
+    QFETCH(QString, line);
+
+    QStringView timestamp(u"unchanged");
+    QStringView message(u"unchanged");
+    QVERIFY(!splitJournalLine(line, timestamp, message));
+    QCOMPARE(timestamp, QStringView(u"unchanged"));
+    QCOMPARE(message, QStringView(u"unchanged"));
+}
+
+QTEST_MAIN(JournalLineTest)
+#include "journallinetest.moc"
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QTest>
+
+#include "kerneleventstore.h"
+
+namespace {
+
+QStringList messages(const QList<KernelEventStore::Event> &events) {
+    QStringList result;
+    for (const auto &event : events) {
+        result << event.message;
+    }
+    return result;
+}
+
+QString deviceSyspath(int index) {
+    return QStringLiteral("/sys/devices/pci0000:00/0000:00:%1.0").arg(index % 32, 2, 16,
+                                                                      QLatin1Char('0'));
+}
+
+// Fills a store with messages attributed round-robin to 32 devices, every fourth one unattributed
+void fillStore(KernelEventStore &store, int count) {
+    for (auto i = 0; i < count; ++i) {
+        const auto syspaths = i % 4 == 0 ? QStringList() : QStringList{deviceSyspath(i)};
+        store.append(i, QStringLiteral("message %1 for device %2").arg(i).arg(i % 32), syspaths);
+    }
+}
+
+} // namespace
+
+class KernelEventStoreTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void eventsForDevice();
+    void eventsForDevice_limitKeepsNewest();
+    void eventsForDevice_multipleDevices();
+    void eviction_updatesIndex();
+    void search();
+    void clear();
+};
+
+void KernelEventStoreTest::eventsForDevice() {
+    KernelEventStore store(16);
+    store.append(100, QStringLiteral("usb 1-2: new high-speed USB device"), {QStringLiteral("/a")});
+    store.append(200, QStringLiteral("unrelated"));
+    store.append(
+        300, QStringLiteral("usb 1-2: Product: Receiver"), {QStringLiteral("/a")}, quint64{57});
+
+    const auto events = store.eventsForDevice(QStringLiteral("/a"), 10);
+    QCOMPARE(events.size(), 2);
+    QCOMPARE(events.at(0).timestamp, qint64{100});
+    QCOMPARE(events.at(0).id, quint64{0});
+    QCOMPARE(events.at(1).message, QStringLiteral("usb 1-2: Product: Receiver"));
+    QCOMPARE(events.at(1).id, quint64{2});
+    QCOMPARE(events.at(1).sequence, quint64{57});
+    QVERIFY(store.eventsForDevice(QStringLiteral("/b"), 10).isEmpty());
+    QVERIFY(store.eventsForDevice(QStringLiteral("/a"), 0).isEmpty());
+}
+
+void KernelEventStoreTest::eventsForDevice_limitKeepsNewest() {
+    KernelEventStore store(16);
+    for (auto i = 0; i < 6; ++i) {
+        store.append(i, QString::number(i), {QStringLiteral("/a")});
+    }
+    QCOMPARE(messages(store.eventsForDevice(QStringLiteral("/a"), 3)),
+             QStringList({QStringLiteral("3"), QStringLiteral("4"), QStringLiteral("5")}));
+}
+
+void KernelEventStoreTest::eventsForDevice_multipleDevices() {
+    KernelEventStore store(16);
+    store.append(0,
+                 QStringLiteral("sd 0:0:0:0: [sda] Attached SCSI disk"),
+                 {QStringLiteral("/scsi"), QStringLiteral("/sda"), QStringLiteral("/sda")});
+    QCOMPARE(store.eventsForDevice(QStringLiteral("/scsi"), 10).size(), 1);
+    // A device listed twice for one message still gets the message once
+    QCOMPARE(store.eventsForDevice(QStringLiteral("/sda"), 10).size(), 1);
+}
+
+void KernelEventStoreTest::eviction_updatesIndex() {
+    KernelEventStore store(4);
+    store.append(0, QStringLiteral("a0"), {QStringLiteral("/a")});
+    store.append(1, QStringLiteral("b1"), {QStringLiteral("/b")});
+    store.append(2, QStringLiteral("a2"), {QStringLiteral("/a")});
+    store.append(3, QStringLiteral("b3"), {QStringLiteral("/b")});
+    QCOMPARE(store.size(), 4);
+
+    store.append(4, QStringLiteral("c4"), {QStringLiteral("/c")});
+    store.append(5, QStringLiteral("c5"), {QStringLiteral("/c")});
+    QCOMPARE(store.size(), 4);
+    QCOMPARE(store.capacity(), 4);
+    QCOMPARE(messages(store.eventsForDevice(QStringLiteral("/a"), 10)),
+             QStringList({QStringLiteral("a2")}));
+    QCOMPARE(messages(store.eventsForDevice(QStringLiteral("/b"), 10)),
+             QStringList({QStringLiteral("b3")}));
+
+    store.append(6, QStringLiteral("c6"), {QStringLiteral("/c")});
+    QVERIFY(store.eventsForDevice(QStringLiteral("/a"), 10).isEmpty());
+    QCOMPARE(messages(store.eventsForDevice(QStringLiteral("/c"), 10)),
+             QStringList({QStringLiteral("c4"), QStringLiteral("c5"), QStringLiteral("c6")}));
+}
+
+void KernelEventStoreTest::search() {
+    KernelEventStore store(3);
+    store.append(0, QStringLiteral("nvme nvme0: 8/0/0 default/read/poll queues"));
+    store.append(1, QStringLiteral("usb 1-2: new high-speed USB device"));
+    store.append(2, QStringLiteral("NVME0N1: p1 p2"));
+    store.append(3, QStringLiteral("EXT4-fs (nvme0n1p2): mounted filesystem"));
+
+    // The first message was evicted
+    QCOMPARE(messages(store.search({QStringLiteral("nvme0")}, 10)),
+             QStringList({QStringLiteral("NVME0N1: p1 p2"),
+                          QStringLiteral("EXT4-fs (nvme0n1p2): mounted filesystem")}));
+    QCOMPARE(messages(store.search({QStringLiteral("nvme0"), QStringLiteral("usb")}, 2)),
+             QStringList({QStringLiteral("NVME0N1: p1 p2"),
+                          QStringLiteral("EXT4-fs (nvme0n1p2): mounted filesystem")}));
+    QVERIFY(store.search({}, 10).isEmpty());
+}
+
+void KernelEventStoreTest::clear() {
+    KernelEventStore store(4);
+    fillStore(store, 10);
+    store.clear();
+    QCOMPARE(store.size(), 0);
+    QVERIFY(store.eventsForDevice(deviceSyspath(1), 10).isEmpty());
+    store.append(0, QStringLiteral("again"), {QStringLiteral("/a")});
+    QCOMPARE(store.eventsForDevice(QStringLiteral("/a"), 10).at(0).id, quint64{0});
+}
+
+QTEST_MAIN(KernelEventStoreTest)
+#include "kerneleventstoretest.moc"
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QTest>
+
+#include "namemappings.h"
+
+namespace {
+
+QJsonObject readJson(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QJsonDocument::fromJson(file.readAll()).object();
+}
+
+QString dataPath(const char *name) {
+    return QStringLiteral(HWVIEW_DATA_DIR) + QLatin1Char('/') + QLatin1String(name);
+}
+
+} // namespace
+
+class NameMappingsBuiltinTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void cleanupTestCase();
+
+    void builtin_matchesJson();
+    void builtin_caseInsensitiveKeys();
+    void builtin_overriddenByJson();
+    void clear_disablesBuiltin();
+};
+
+void NameMappingsBuiltinTest::cleanupTestCase() {
+    NameMappings::instance().reload();
+}
+
+void NameMappingsBuiltinTest::builtin_matchesJson() {
+    auto &mappings = NameMappings::instance();
+    mappings.clear();
+    QVERIFY(mappings.loadBuiltin());
+
+    const auto root = readJson(dataPath("name-mappings.json"));
+    QVERIFY(!root.isEmpty());
+    const auto check = [&root](const char *section, const auto &lookup) {
+        const auto object = root.value(QLatin1String(section)).toObject();
+        QVERIFY(!object.isEmpty());
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            QCOMPARE(lookup(it.key()), it.value().toString());
+        }
+    };
+    check("guid-to-category",
+          [&](const QString &key) { return mappings.categoryNameFromGuid(key); });
+    check("hid-vendor", [&](const QString &key) { return mappings.hidVendorName(key); });
+    check("hid-bus-type", [&](const QString &key) { return mappings.hidBusTypeName(key.toInt()); });
+    check("software-device",
+          [&](const QString &key) { return mappings.softwareDeviceDisplayName(key); });
+    check("acpi-device", [&](const QString &key) { return mappings.acpiDeviceDisplayName(key); });
+
+    const auto vendors = readJson(dataPath("vendors.json"));
+    QVERIFY(!vendors.isEmpty());
+    for (auto it = vendors.begin(); it != vendors.end(); ++it) {
+        QCOMPARE(mappings.vendorSupportUrl(it.key()), it.value().toString());
+    }
+}
+
+void NameMappingsBuiltinTest::builtin_caseInsensitiveKeys() {
+    auto &mappings = NameMappings::instance();
+    mappings.clear();
+    QVERIFY(mappings.loadBuiltin());
+
+    QCOMPARE(mappings.hidVendorName(QStringLiteral("046D")), QStringLiteral("Logitech"));
+    QCOMPARE(mappings.acpiDeviceDisplayName(QStringLiteral("pnp0c09")),
+             QStringLiteral("ACPI Embedded Controller"));
+    QCOMPARE(mappings.categoryNameFromGuid(
+                 QStringLiteral("{4D36E96B-E325-11CE-BFC1-08002BE10318}")),
+             QStringLiteral("Keyboards"));
+    QCOMPARE(mappings.categoryNameFromGuid(
+                 QStringLiteral("{00000000-0000-0000-0000-000000000000}")),
+             QStringLiteral("Other devices"));
+    QVERIFY(mappings.hidBusTypeName(999).isEmpty());
+    QVERIFY(mappings.softwareDeviceDisplayName(QStringLiteral("no-such-device")).isEmpty());
+}
+
+void NameMappingsBuiltinTest::builtin_overriddenByJson() {
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QFile file(dir.filePath(QStringLiteral("overrides.json")));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(R"({"hid-vendor": {"046D": "Logitech International"}})");
+    file.close();
+
+    auto &mappings = NameMappings::instance();
+    mappings.clear();
+    QVERIFY(mappings.loadBuiltin());
+    mappings.loadFromFile(file.fileName());
+
+    QCOMPARE(mappings.hidVendorName(QStringLiteral("046d")),
+             QStringLiteral("Logitech International"));
+    // Keys the override does not mention still come from the compiled-in table
+    QCOMPARE(mappings.hidVendorName(QStringLiteral("056a")), QStringLiteral("Wacom"));
+}
+
+void NameMappingsBuiltinTest::clear_disablesBuiltin() {
+    auto &mappings = NameMappings::instance();
+    QVERIFY(mappings.loadBuiltin());
+    QVERIFY(!mappings.hidVendorName(QStringLiteral("046d")).isEmpty());
+
+    mappings.clear();
+    QVERIFY(mappings.hidVendorName(QStringLiteral("046d")).isEmpty());
+}
+
+QTEST_MAIN(NameMappingsBuiltinTest)
+#include "namemappingsbuiltintest.moc"
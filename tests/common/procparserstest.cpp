@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtTest/QTest>
+
+#include <string_view>
+
+#include "procparsers.h"
+
+using namespace procparsers;
+
+namespace {
+
+QByteArray readFixture(const QString &name) {
+    QFile file(QStringLiteral(HWVIEW_TEST_DATA_DIR) + QLatin1Char('/') + name);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return file.readAll();
+}
+
+std::string_view view(const QByteArray &bytes) {
+    return {bytes.constData(), static_cast<size_t>(bytes.size())};
+}
+
+} // namespace
+
+class ProcParsersTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void nextToken_splitsOnWhitespace();
+    void isInterruptTypeToken();
+    void resourceRange_nested();
+    void resourceRange_skipsMalformed();
+    void dma_channels();
+    void dma_skipsMalformed();
+    void interrupts_cpuCountFromHeader();
+    void interrupts_countsBoundedByCpuCount();
+    void interrupts_summaryLines();
+    void interrupts_capturedFixture();
+    void mountInfo_fields();
+    void mountInfo_skipsMalformed();
+    void unescapeMountField();
+    void kmsg_record();
+    void kmsg_rejectsMalformed();
+    void unescapeKmsgText();
+};
+
+void ProcParsersTest::nextToken_splitsOnWhitespace() {
+    std::string_view text = "  IR-PCI-MSI\t327680-edge   xhci_hcd ";
+    std::string_view token;
+    QVERIFY(nextToken(text, token));
+    QCOMPARE(token, std::string_view("IR-PCI-MSI"));
+    QVERIFY(nextToken(text, token));
+    QCOMPARE(token, std::string_view("327680-edge"));
+    QVERIFY(nextToken(text, token));
+    QCOMPARE(token, std::string_view("xhci_hcd"));
+    QVERIFY(!nextToken(text, token));
+}
+
+void ProcParsersTest::isInterruptTypeToken() {
+    QVERIFY(procparsers::isInterruptTypeToken("IR-IO-APIC"));
+    QVERIFY(procparsers::isInterruptTypeToken("PCI-MSIX-0000:00:01.0"));
+    QVERIFY(procparsers::isInterruptTypeToken("DMAR-MSI"));
+    QVERIFY(procparsers::isInterruptTypeToken("2-edge"));
+    QVERIFY(procparsers::isInterruptTypeToken("9-fasteoi"));
+    QVERIFY(!procparsers::isInterruptTypeToken("xhci_hcd"));
+    QVERIFY(!procparsers::isInterruptTypeToken("27"));
+}
+
+void ProcParsersTest::resourceRange_nested() {
+    ResourceRangeParser parser("0000-0cf7 : PCI Bus 0000:00\n"
+                               "  0000-001f : dma1\n"
+                               "    fed00000-fed003ff : HPET 0\n");
+    ResourceRange range;
+    QVERIFY(parser.next(range));
+    QCOMPARE(range.start, std::string_view("0000"));
+    QCOMPARE(range.end, std::string_view("0cf7"));
+    QCOMPARE(range.name, std::string_view("PCI Bus 0000:00"));
+    QCOMPARE(range.indentLevel, 0);
+    QVERIFY(parser.next(range));
+    QCOMPARE(range.name, std::string_view("dma1"));
+    QCOMPARE(range.indentLevel, 2);
+    QVERIFY(parser.next(range));
+    QCOMPARE(range.start, std::string_view("fed00000"));
+    QCOMPARE(range.end, std::string_view("fed003ff"));
+    QCOMPARE(range.name, std::string_view("HPET 0"));
+    QCOMPARE(range.indentLevel, 4);
+    QVERIFY(!parser.next(range));
+}
+
+void ProcParsersTest::resourceRange_skipsMalformed() {
+    ResourceRangeParser parser("\n"
+                               "0000-001f dma1\n"
+                               "0020-0021 : \n"
+                               "zzzz-0021 : pic1\n"
+                               "0040 : timer0\n"
+                               "0060-0060 : keyboard");
+    ResourceRange range;
+    QVERIFY(parser.next(range));
+    QCOMPARE(range.name, std::string_view("keyboard"));
+    QVERIFY(!parser.next(range));
+}
+
+void ProcParsersTest::dma_channels() {
+    DmaParser parser(" 2: floppy\n 4: cascade\n");
+    DmaChannel channel;
+    QVERIFY(parser.next(channel));
+    QCOMPARE(channel.channel, std::string_view("2"));
+    QCOMPARE(channel.name, std::string_view("floppy"));
+    QVERIFY(parser.next(channel));
+    QCOMPARE(channel.channel, std::string_view("4"));
+    QCOMPARE(channel.name, std::string_view("cascade"));
+    QVERIFY(!parser.next(channel));
+}
+
+void ProcParsersTest::dma_skipsMalformed() {
+    DmaParser parser("\nfloppy\n3 cascade\n5:\n");
+    DmaChannel channel;
+    QVERIFY(parser.next(channel));
+    QCOMPARE(channel.channel, std::string_view("5"));
+    QVERIFY(channel.name.empty());
+    QVERIFY(!parser.next(channel));
+}
+
+void ProcParsersTest::interrupts_cpuCountFromHeader() {
+    InterruptsParser parser("           CPU0       CPU1       CPU2       \n");
+    QCOMPARE(parser.cpuCount(), 3);
+    InterruptLine line;
+    QVERIFY(!parser.next(line));
+}
+
+void ProcParsersTest::interrupts_countsBoundedByCpuCount() {
+    // ARM lines put a numeric hwirq after the counts; it must stay in the description
+    InterruptsParser parser("   CPU0   CPU1\n"
+                            " 11:   5   7   GICv3  27 Level     arch_timer\n"
+                            "  5:   1   2   3 unnamed\n");
+    InterruptLine line;
+    QVERIFY(parser.next(line));
+    QCOMPARE(line.irq, std::string_view("11"));
+    QCOMPARE(line.counts, std::string_view("5   7"));
+    QCOMPARE(line.countColumns, 2);
+    QCOMPARE(line.description, std::string_view("GICv3  27 Level     arch_timer"));
+    QVERIFY(parser.next(line));
+    QCOMPARE(line.counts, std::string_view("1   2"));
+    QCOMPARE(line.description, std::string_view("3 unnamed"));
+    QVERIFY(!parser.next(line));
+}
+
+void ProcParsersTest::interrupts_summaryLines() {
+    InterruptsParser parser("   CPU0   CPU1\n"
+                            "NMI:   0   0   Non-maskable interrupts\n"
+                            "ERR:   0\n"
+                            "\n");
+    InterruptLine line;
+    QVERIFY(parser.next(line));
+    QCOMPARE(line.irq, std::string_view("NMI"));
+    QCOMPARE(line.description, std::string_view("Non-maskable interrupts"));
+    QVERIFY(parser.next(line));
+    QCOMPARE(line.irq, std::string_view("ERR"));
+    QCOMPARE(line.countColumns, 1);
+    QVERIFY(line.description.empty());
+    QVERIFY(!parser.next(line));
+}
+
+void ProcParsersTest::interrupts_capturedFixture() {
+    const auto captured = readFixture(QStringLiteral("proc-interrupts-8cpu.txt"));
+    QVERIFY(!captured.isEmpty());
+
+    InterruptsParser parser(view(captured));
+    QCOMPARE(parser.cpuCount(), 8);
+    InterruptLine line;
+    auto lines = 0;
+    auto nvmeQueues = 0;
+    while (parser.next(line)) {
+        ++lines;
+        if (line.irq != "ERR" && line.irq != "MIS") {
+            QCOMPARE(line.countColumns, 8);
+        }
+        if (line.description.ends_with("nvme0q0")) {
+            QCOMPARE(line.irq, std::string_view("126"));
+            QCOMPARE(line.description,
+                     std::string_view("IR-PCI-MSIX-0000:01:00.0    0-edge      nvme0q0"));
+        }
+        nvmeQueues += line.description.contains("nvme0q") ? 1 : 0;
+    }
+    QCOMPARE(lines, 50);
+    QCOMPARE(nvmeQueues, 9);
+}
+
+void ProcParsersTest::mountInfo_fields() {
+    MountInfoParser parser(
+        "22 1 259:2 / / rw,relatime shared:1 - ext4 /dev/nvme0n1p2 rw\n"
+        "36 22 8:17 /data /mnt/usb\\040disk rw,nosuid shared:5 master:1 - vfat /dev/sdb1 rw\n"
+        "40 22 0:35 / /tmp rw - tmpfs tmpfs rw,size=8g\n");
+    MountInfoEntry entry;
+    QVERIFY(parser.next(entry));
+    QCOMPARE(entry.major, 259u);
+    QCOMPARE(entry.minor, 2u);
+    QCOMPARE(entry.mountPoint, std::string_view("/"));
+    QCOMPARE(entry.source, std::string_view("/dev/nvme0n1p2"));
+    QVERIFY(parser.next(entry));
+    QCOMPARE(entry.major, 8u);
+    QCOMPARE(entry.minor, 17u);
+    QCOMPARE(entry.mountPoint, std::string_view("/mnt/usb\\040disk"));
+    QCOMPARE(entry.source, std::string_view("/dev/sdb1"));
+    QVERIFY(parser.next(entry));
+    QCOMPARE(entry.major, 0u);
+    QCOMPARE(entry.source, std::string_view("tmpfs"));
+    QVERIFY(!parser.next(entry));
+}
+
+void ProcParsersTest::mountInfo_skipsMalformed() {
+    MountInfoParser parser("\n"
+                           "22 1 259 / / rw - ext4 /dev/nvme0n1p2 rw\n"
+                           "22 1 8:x / / rw - ext4 /dev/sda1 rw\n"
+                           "22 1 8:1 / / rw shared:1 ext4 /dev/sda1 rw\n"
+                           "22 1 8:2 / /boot rw -\n"
+                           "23 1 8:3 / /home rw - xfs /dev/sda3 rw\n");
+    MountInfoEntry entry;
+    QVERIFY(parser.next(entry));
+    QCOMPARE(entry.minor, 3u);
+    QCOMPARE(entry.mountPoint, std::string_view("/home"));
+    QVERIFY(!parser.next(entry));
+}
+
+void ProcParsersTest::unescapeMountField() {
+    QCOMPARE(procparsers::unescapeMountField("/mnt/usb\\040disk"), std::string("/mnt/usb disk"));
+    QCOMPARE(procparsers::unescapeMountField("/a\\011b\\012c\\134d"), std::string("/a\tb\nc\\d"));
+    // Incomplete or non-octal escapes are kept as they are
+    QCOMPARE(procparsers::unescapeMountField("/x\\09y\\04"), std::string("/x\\09y\\04"));
+}
+
+void ProcParsersTest::kmsg_record() {
+    KmsgRecord record;
+    QVERIFY(parseKmsgRecord("6,1234,5678901,-;usb 1-2: new high-speed USB device number 3\n",
+                            record));
+    QCOMPARE(record.priority, 6u);
+    QCOMPARE(record.facility, 0u);
+    QCOMPARE(record.sequence, 1234ull);
+    QCOMPARE(record.timestamp, 5678901ull);
+    QCOMPARE(record.message, std::string_view("usb 1-2: new high-speed USB device number 3"));
+    QVERIFY(record.subsystem.empty());
+    QVERIFY(record.device.empty());
+
+    // Continuation lines name the device; fields after the flags are ignored
+    QVERIFY(parseKmsgRecord("30,99,100,c,extra;systemd[1]: Started\n"
+                            " SUBSYSTEM=pci\n"
+                            " DEVICE=+pci:0000:00:1f.3\n",
+                            record));
+    QCOMPARE(record.priority, 6u);
+    QCOMPARE(record.facility, 3u);
+    QCOMPARE(record.message, std::string_view("systemd[1]: Started"));
+    QCOMPARE(record.subsystem, std::string_view("pci"));
+    QCOMPARE(record.device, std::string_view("+pci:0000:00:1f.3"));
+}
+
+void ProcParsersTest::kmsg_rejectsMalformed() {
+    KmsgRecord record;
+    QVERIFY(!parseKmsgRecord("", record));
+    QVERIFY(!parseKmsgRecord("6,1,2,-", record));
+    QVERIFY(!parseKmsgRecord("6,1;message", record));
+    QVERIFY(!parseKmsgRecord("x,1,2,-;message", record));
+    QVERIFY(!parseKmsgRecord(" SUBSYSTEM=pci\n6,1,2,-;message", record));
+}
+
+void ProcParsersTest::unescapeKmsgText() {
+    QCOMPARE(procparsers::unescapeKmsgText("tab\\x09here"), std::string("tab\there"));
+    QCOMPARE(procparsers::unescapeKmsgText("back\\x5cslash"), std::string("back\\slash"));
+    // Incomplete escapes are kept as they are
+    QCOMPARE(procparsers::unescapeKmsgText("end\\x4"), std::string("end\\x4"));
+    QCOMPARE(procparsers::unescapeKmsgText("\\xzz"), std::string("\\xzz"));
+}
+
+QTEST_MAIN(ProcParsersTest)
+#include "procparserstest.moc"
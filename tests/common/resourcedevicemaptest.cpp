@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "resourcedevicemap.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &syspath,
+                      const QString &subsystem,
+                      const QString &driver = QString()) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = syspath;
+    json[QStringLiteral("subsystem")] = subsystem;
+    json[QStringLiteral("driver")] = driver;
+    return DeviceInfo(json);
+}
+
+const auto nvmeController = QStringLiteral("/sys/devices/pci0000:00/0000:00:1d.0/0000:03:00.0");
+const auto nvmeNamespace =
+    QStringLiteral("/sys/devices/pci0000:00/0000:00:1d.0/0000:03:00.0/nvme/nvme0");
+const auto xhci0 = QStringLiteral("/sys/devices/pci0000:00/0000:00:14.0");
+const auto xhci1 = QStringLiteral("/sys/devices/pci0000:00/0000:00:0d.0");
+const auto ahci = QStringLiteral("/sys/devices/pci0000:00/0000:00:17.0");
+const auto i8042 = QStringLiteral("/sys/devices/platform/i8042");
+
+QList<DeviceInfo> sampleDevices() {
+    return {
+        makeDevice(nvmeController, QStringLiteral("pci"), QStringLiteral("nvme")),
+        makeDevice(nvmeNamespace, QStringLiteral("nvme")),
+        makeDevice(xhci0, QStringLiteral("pci"), QStringLiteral("xhci_hcd")),
+        makeDevice(xhci1, QStringLiteral("pci"), QStringLiteral("xhci_hcd")),
+        makeDevice(ahci, QStringLiteral("pci"), QStringLiteral("ahci")),
+        makeDevice(i8042, QStringLiteral("platform"), QStringLiteral("i8042")),
+    };
+}
+
+IrqInfo makeIrq(const QString &type, const QString &deviceName) {
+    IrqInfo irq;
+    irq.irqNumber = QStringLiteral("42");
+    irq.irqType = type;
+    irq.deviceName = deviceName;
+    return irq;
+}
+
+} // namespace
+
+class ResourceDeviceMapTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void deviceForRange_pciAddress();
+    void deviceForRange_driverUnderParent();
+    void deviceForRange_uniqueDriver();
+    void deviceForRange_ambiguousDriver();
+    void deviceForRange_unknown();
+    void deviceForIrq_pciAddressInType();
+    void deviceForIrq_queueSuffix();
+    void deviceForIrq_bracketedAddress();
+    void deviceForIrq_sharedIrq();
+    void deviceForIrq_kernelName();
+    void clear();
+};
+
+void ResourceDeviceMapTest::deviceForRange_pciAddress() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForRange(QStringLiteral("0000:03:00.0")), nvmeController);
+    QCOMPARE(map.deviceForRange(QStringLiteral("0000:00:14.0")), xhci0);
+}
+
+void ResourceDeviceMapTest::deviceForRange_driverUnderParent() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForRange(QStringLiteral("xhci-hcd"), xhci1), QString());
+    QCOMPARE(map.deviceForRange(QStringLiteral("xhci_hcd"), xhci1), xhci1);
+}
+
+void ResourceDeviceMapTest::deviceForRange_uniqueDriver() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForRange(QStringLiteral("ahci")), ahci);
+}
+
+void ResourceDeviceMapTest::deviceForRange_ambiguousDriver() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForRange(QStringLiteral("xhci_hcd")), QString());
+}
+
+void ResourceDeviceMapTest::deviceForRange_unknown() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForRange(QStringLiteral("System RAM")), QString());
+    QCOMPARE(map.deviceForRange(QStringLiteral("0000:09:00.0")), QString());
+    QCOMPARE(map.deviceForRange(QString()), QString());
+}
+
+void ResourceDeviceMapTest::deviceForIrq_pciAddressInType() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    // The PCI address identifies the controller even though the queue name matches nvme0
+    QCOMPARE(map.deviceForIrq(makeIrq(QStringLiteral("IR-PCI-MSIX-0000:03:00.0"),
+                                      QStringLiteral("nvme0q1"))),
+             nvmeController);
+}
+
+void ResourceDeviceMapTest::deviceForIrq_queueSuffix() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForIrq(makeIrq(QStringLiteral("IR-PCI-MSI"), QStringLiteral("nvme0q12"))),
+             nvmeNamespace);
+}
+
+void ResourceDeviceMapTest::deviceForIrq_bracketedAddress() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForIrq(
+                 makeIrq(QStringLiteral("IR-PCI-MSI"), QStringLiteral("xhci_hcd[0000:00:0d.0]"))),
+             xhci1);
+}
+
+void ResourceDeviceMapTest::deviceForIrq_sharedIrq() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    // The first listed device is ambiguous, so the next one is used
+    QCOMPARE(map.deviceForIrq(
+                 makeIrq(QStringLiteral("IO-APIC"), QStringLiteral("xhci_hcd:usb1, ahci"))),
+             ahci);
+}
+
+void ResourceDeviceMapTest::deviceForIrq_kernelName() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    QCOMPARE(map.deviceForIrq(makeIrq(QStringLiteral("IO-APIC"), QStringLiteral("i8042"))), i8042);
+    QCOMPARE(map.deviceForIrq(makeIrq(QStringLiteral("IO-APIC"), QStringLiteral("acpi"))),
+             QString());
+}
+
+void ResourceDeviceMapTest::clear() {
+    ResourceDeviceMap map;
+    map.build(sampleDevices());
+    map.clear();
+    QCOMPARE(map.deviceForRange(QStringLiteral("0000:03:00.0")), QString());
+    QCOMPARE(map.deviceForRange(QStringLiteral("nvme"), nvmeController), QString());
+}
+
+QTEST_MAIN(ResourceDeviceMapTest)
+#include "resourcedevicemaptest.moc"
@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QTest>
+
+#include "resourceindex.h"
+
+namespace {
+
+ResourceIndex::Range makeRange(quint64 start, quint64 end, const QString &name, int depth = 0) {
+    ResourceIndex::Range range;
+    range.start = start;
+    range.end = end;
+    range.name = name;
+    range.depth = depth;
+    return range;
+}
+
+// Shaped like /proc/iomem: a bus window with nested device BARs
+QList<ResourceIndex::Range> sampleRanges() {
+    return {
+        makeRange(0x00000000, 0x00000fff, QStringLiteral("Reserved")),
+        makeRange(0x00001000, 0x0009ffff, QStringLiteral("System RAM")),
+        makeRange(0xc0000000, 0xfebfffff, QStringLiteral("PCI Bus 0000:00")),
+        makeRange(0xc0000000, 0xcfffffff, QStringLiteral("0000:00:02.0"), 2),
+        makeRange(0xde000000, 0xde0fffff, QStringLiteral("PCI Bus 0000:03"), 2),
+        makeRange(0xde000000, 0xde003fff, QStringLiteral("0000:03:00.0"), 4),
+        makeRange(0xde000000, 0xde003fff, QStringLiteral("nvme"), 6),
+    };
+}
+
+// /proc/iomem as an unprivileged user reads it: the layout is kept, the addresses are zeroed
+QList<MemoryRangeInfo> unprivilegedIomem() {
+    const auto zero = QStringLiteral("00000000");
+    return {
+        {zero, zero, QStringLiteral("Reserved"), 0},
+        {zero, zero, QStringLiteral("System RAM"), 0},
+        {zero, zero, QStringLiteral("PCI Bus 0000:00"), 0},
+        {zero, zero, QStringLiteral("0000:00:02.0"), 2},
+        {zero, zero, QStringLiteral("PCI Bus 0000:03"), 2},
+        {zero, zero, QStringLiteral("0000:03:00.0"), 4},
+        {zero, zero, QStringLiteral("nvme"), 6},
+    };
+}
+
+QList<int> bruteForceOverlapping(const QList<ResourceIndex::Range> &ranges,
+                                 quint64 start,
+                                 quint64 end) {
+    QList<int> result;
+    for (auto i = 0; i < ranges.size(); ++i) {
+        if (ranges.at(i).start <= end && ranges.at(i).end >= start) {
+            result.append(i);
+        }
+    }
+    return result;
+}
+
+QList<ResourceIndex::Range> randomRanges(int count, quint32 seed) {
+    QRandomGenerator random(seed);
+    QList<ResourceIndex::Range> ranges;
+    ranges.reserve(count);
+    for (auto i = 0; i < count; ++i) {
+        const auto start = random.bounded(static_cast<quint64>(1) << 32);
+        const auto length = random.bounded(static_cast<quint64>(1) << 20);
+        ranges.append(makeRange(start, start + length, QStringLiteral("r%1").arg(i)));
+    }
+    return ranges;
+}
+
+} // namespace
+
+class ResourceIndexTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void overlapping_address();
+    void overlapping_span();
+    void overlapping_none();
+    void overlapping_matchesBruteForce();
+    void containing();
+    void rangesOf();
+    void conflicts_nestedIsNotConflict();
+    void conflicts_partialOverlap();
+    void conflicts_sameLevelDuplicate();
+    void conflicts_hiddenAddresses();
+    void build_fromIoPorts();
+    void build_invalidRangeIgnored();
+    void clear();
+};
+
+void ResourceIndexTest::overlapping_address() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    QCOMPARE(index.overlapping(0xde001000, 0xde001000), (QList<int>{2, 4, 5, 6}));
+}
+
+void ResourceIndexTest::overlapping_span() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    QCOMPARE(index.overlapping(0x0, 0x1000), (QList<int>{0, 1}));
+}
+
+void ResourceIndexTest::overlapping_none() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    QVERIFY(index.overlapping(0xfec00000, 0xffffffff).isEmpty());
+    QVERIFY(index.overlapping(0x2000, 0x1000).isEmpty());
+}
+
+void ResourceIndexTest::overlapping_matchesBruteForce() {
+    const auto ranges = randomRanges(2000, 42);
+    ResourceIndex index;
+    index.build(ranges);
+
+    QRandomGenerator random(7);
+    for (auto i = 0; i < 200; ++i) {
+        const auto start = random.bounded(static_cast<quint64>(1) << 32);
+        const auto end = start + random.bounded(static_cast<quint64>(1) << 24);
+        QCOMPARE(index.overlapping(start, end), bruteForceOverlapping(ranges, start, end));
+    }
+}
+
+void ResourceIndexTest::containing() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    QCOMPARE(index.containing(0xde000000, 0xde003fff), (QList<int>{2, 4, 5, 6}));
+    // Crosses the end of the NVMe BAR, so only the bus windows contain it
+    QCOMPARE(index.containing(0xde003000, 0xde004fff), (QList<int>{2, 4}));
+}
+
+void ResourceIndexTest::rangesOf() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    QCOMPARE(index.rangesOf(QStringLiteral("nvme")), QList<int>{6});
+    QCOMPARE(index.at(index.rangesOf(QStringLiteral("0000:00:02.0")).constFirst()).end,
+             static_cast<quint64>(0xcfffffff));
+    QVERIFY(index.rangesOf(QStringLiteral("missing")).isEmpty());
+}
+
+void ResourceIndexTest::conflicts_nestedIsNotConflict() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    for (auto i = 0; i < index.size(); ++i) {
+        QVERIFY2(index.conflictsWith(i).isEmpty(), qPrintable(index.at(i).name));
+    }
+}
+
+void ResourceIndexTest::conflicts_partialOverlap() {
+    ResourceIndex index;
+    index.build({
+        makeRange(0x3f8, 0x3ff, QStringLiteral("serial")),
+        makeRange(0x3fc, 0x403, QStringLiteral("rogue")),
+        makeRange(0x500, 0x50f, QStringLiteral("other")),
+    });
+    QCOMPARE(index.conflictsWith(0), QList<int>{1});
+    QCOMPARE(index.conflictsWith(1), QList<int>{0});
+    QVERIFY(index.conflictsWith(2).isEmpty());
+}
+
+void ResourceIndexTest::conflicts_sameLevelDuplicate() {
+    ResourceIndex index;
+    index.build({
+        makeRange(0x0, 0xffff, QStringLiteral("PCI Bus 0000:00")),
+        makeRange(0x60, 0x60, QStringLiteral("keyboard"), 2),
+        makeRange(0x60, 0x60, QStringLiteral("other"), 2),
+    });
+    QVERIFY(index.conflictsWith(0).isEmpty());
+    QCOMPARE(index.conflictsWith(1), QList<int>{2});
+    QCOMPARE(index.conflictsWith(2), QList<int>{1});
+}
+
+void ResourceIndexTest::build_fromIoPorts() {
+    QList<IoPortInfo> ports{
+        {QStringLiteral("0000"), QStringLiteral("0CF7"), QStringLiteral("PCI Bus 0000:00"), 0},
+        {QStringLiteral("0020"), QStringLiteral("0021"), QStringLiteral("pic1"), 2},
+    };
+    ResourceIndex index;
+    index.build(ports);
+    QCOMPARE(index.size(), 2);
+    QCOMPARE(index.at(0).end, static_cast<quint64>(0xcf7));
+    QCOMPARE(index.at(1).depth, 2);
+    QCOMPARE(index.overlapping(0x21, 0x21), (QList<int>{0, 1}));
+}
+
+void ResourceIndexTest::build_invalidRangeIgnored() {
+    QList<MemoryRangeInfo> ranges{
+        {QStringLiteral("zzzz"), QStringLiteral("0FFF"), QStringLiteral("bad"), 0},
+        {QStringLiteral("2000"), QStringLiteral("1000"), QStringLiteral("reversed"), 0},
+        {QStringLiteral("0000"), QStringLiteral("0FFF"), QStringLiteral("good"), 0},
+    };
+    ResourceIndex index;
+    index.build(ranges);
+    QCOMPARE(index.size(), 3);
+    QVERIFY(!index.at(0).valid);
+    QVERIFY(!index.at(1).valid);
+    QCOMPARE(index.overlapping(0x0, 0xffff), QList<int>{2});
+    QVERIFY(index.rangesOf(QStringLiteral("bad")).isEmpty());
+}
+
+void ResourceIndexTest::clear() {
+    ResourceIndex index;
+    index.build(sampleRanges());
+    index.clear();
+    QCOMPARE(index.size(), 0);
+    QVERIFY(index.overlapping(0x0, ~static_cast<quint64>(0)).isEmpty());
+}
+
+void ResourceIndexTest::conflicts_hiddenAddresses() {
+    ResourceIndex index;
+    index.build(unprivilegedIomem());
+    QVERIFY(index.addressesHidden());
+    for (auto i = 0; i < index.size(); ++i) {
+        QVERIFY2(index.conflictsWith(i).isEmpty(), qPrintable(index.at(i).name));
+    }
+    QCOMPARE(index.rangesOf(QStringLiteral("nvme")), QList<int>{6});
+
+    index.build(sampleRanges());
+    QVERIFY(!index.addressesHidden());
+}
+
+QTEST_MAIN(ResourceIndexTest)
+#include "resourceindextest.moc"
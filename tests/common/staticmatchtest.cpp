@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QStringList>
+#include <QtTest/QTest>
+
+#include <algorithm>
+#include <iterator>
+
+#include "diskmanufacturers.h"
+#include "staticmatch.h"
+
+using namespace std::string_view_literals;
+
+namespace {
+
+constexpr auto kColours = staticmatch::makePerfectHashMap<int>({
+    {"red", 1},
+    {"green", 2},
+    {"blue", 3},
+    {"mapper/control", 4},
+    {"loop-control", 5},
+});
+
+constexpr std::string_view kNodeKeys[] = {
+    "autofs", "cpu_dma_latency", "fuse", "hpet", "hwrng", "kvm", "loop-control", "mcelog",
+    "net/tun", "ntsync", "rfkill", "uhid", "uinput", "vga_arbiter", "vhost-net", "mapper/control",
+};
+constexpr auto kNodes = staticmatch::makePerfectHashSet(kNodeKeys);
+
+// The production table: its order and overlapping patterns are what the matcher must honour
+constexpr auto &kVendors = diskmanufacturers::kPatterns;
+constexpr auto &kVendorMatcher = diskmanufacturers::kMatcher;
+
+// Everything is resolved by the compiler
+static_assert(*kColours.find("blue"sv) == 3);
+static_assert(kColours.find("Blue"sv) == nullptr);
+static_assert(kColours.find(""sv) == nullptr);
+static_assert(kNodes.size() == std::size(kNodeKeys));
+static_assert(kVendorMatcher.firstMatch("WDC WD10EZEX-00BN5A0"sv) == 1);
+static_assert(kVendorMatcher.firstMatch("no match here"sv) == -1);
+
+QString fromKey(std::string_view key) {
+    return QString::fromLatin1(key.data(), static_cast<qsizetype>(key.size()));
+}
+
+// Reference behaviour: the first pattern that occurs anywhere in the text
+int linearFirstMatch(const QString &text) {
+    for (std::size_t i = 0; i < std::size(kVendors); ++i) {
+        if (text.contains(fromKey(kVendors[i]), Qt::CaseInsensitive)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+// Mix of software device names and disk model strings, about a third of which match a key
+QStringList syntheticDeviceNames(int count, quint32 seed) {
+    static const QStringList models = {
+        QStringLiteral("Samsung SSD 980 PRO 1TB"), QStringLiteral("WDC WD40EFRX-68N32N0"),
+        QStringLiteral("CT1000MX500SSD1"),         QStringLiteral("KINGSTON SA400S37240G"),
+        QStringLiteral("Generic Flash Disk"),      QStringLiteral("QEMU HARDDISK"),
+        QStringLiteral("VBOX HARDDISK"),           QStringLiteral("Virtual Disk"),
+    };
+    constexpr auto kNodeCount = static_cast<int>(std::size(kNodeKeys));
+    QStringList names;
+    names.reserve(count);
+    QRandomGenerator random(seed);
+    for (auto i = 0; i < count; ++i) {
+        switch (i % 3) {
+        case 0:
+            names.append(fromKey(kNodeKeys[random.bounded(kNodeCount)]));
+            break;
+        case 1:
+            names.append(models.at(random.bounded(static_cast<int>(models.size()))) +
+                         QLatin1Char(' ') + QString::number(i));
+            break;
+        default:
+            names.append(QStringLiteral("device%1").arg(i));
+            break;
+        }
+    }
+    return names;
+}
+
+QString randomText(QRandomGenerator &random, const QString &alphabet, int maxLength) {
+    QString text;
+    const auto length = random.bounded(1, maxLength + 1);
+    for (auto i = 0; i < length; ++i) {
+        text.append(alphabet.at(random.bounded(static_cast<int>(alphabet.size()))));
+    }
+    return text;
+}
+
+} // namespace
+
+class StaticMatchTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void perfectHash_findsEveryKey();
+    void perfectHash_rejectsOtherText();
+    void perfectHash_utf16AndLatin1Agree();
+    void matcher_earliestPatternWins();
+    void matcher_ignoresCase();
+    void matcher_nonAsciiText();
+    void matcher_matchesLinearScan();
+    void diskManufacturers_names();
+};
+
+void StaticMatchTest::perfectHash_findsEveryKey() {
+    for (const auto key : kNodeKeys) {
+        QVERIFY(kNodes.contains(fromKey(key)));
+        QVERIFY(kNodes.find(key));
+    }
+    QCOMPARE(*kColours.find(QStringLiteral("mapper/control")), 4);
+    QCOMPARE(*kColours.find(QStringLiteral("loop-control")), 5);
+}
+
+void StaticMatchTest::perfectHash_rejectsOtherText() {
+    QVERIFY(!kNodes.contains(QString()));
+    QVERIFY(!kNodes.contains(QStringLiteral("KVM")));
+    QVERIFY(!kNodes.contains(QStringLiteral("kvm ")));
+    QVERIFY(!kNodes.contains(QStringLiteral("mapper")));
+    QVERIFY(!kNodes.contains(QStringLiteral("input/event3")));
+
+    // Random strings over the keys' alphabet land in occupied slots often enough to exercise the
+    // key comparison
+    QRandomGenerator random(40);
+    const auto alphabet = QStringLiteral("abcdefghijklmnopqrstuvwxyz_-/");
+    for (auto i = 0; i < 10000; ++i) {
+        const auto text = randomText(random, alphabet, 15);
+        const auto isKey = std::find(std::begin(kNodeKeys), std::end(kNodeKeys),
+                                     text.toStdString()) != std::end(kNodeKeys);
+        QCOMPARE(kNodes.contains(text), isKey);
+    }
+}
+
+void StaticMatchTest::perfectHash_utf16AndLatin1Agree() {
+    for (const auto key : kNodeKeys) {
+        QCOMPARE(kNodes.find(fromKey(key)), kNodes.find(key));
+    }
+    // Same low byte as an ASCII key, but not the same character
+    QVERIFY(!kColours.find(QStringView(u"rťd")));
+}
+
+void StaticMatchTest::matcher_earliestPatternWins() {
+    // "CT" occurs inside "Crucial_CT500" but "Crucial" is listed first
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("Crucial_CT500MX500SSD1")), 9);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("CT500MX500SSD1")), 10);
+    // Position in the text does not matter, only position in the list
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("HP OEM Samsung drive")), 0);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("Western Digital WDC")), 1);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("Silicon Power SPCC")), 27);
+}
+
+void StaticMatchTest::matcher_ignoresCase() {
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("samsung ssd")), 0);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("SAMSUNG SSD")), 0);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("sk HYNIX")), 13);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("lite-on it")), 22);
+    QCOMPARE(kVendorMatcher.firstMatch(QString()), -1);
+}
+
+void StaticMatchTest::matcher_nonAsciiText() {
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("Ünbekannt Festplatte")), -1);
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("Fäst Samsung")), 0);
+    // A non-ASCII character breaks a pattern rather than matching any of its characters
+    QCOMPARE(kVendorMatcher.firstMatch(QStringLiteral("Samsüng")), -1);
+    QCOMPARE(kVendorMatcher.firstMatch("Sams\xc3\xbcng"sv), -1);
+}
+
+void StaticMatchTest::matcher_matchesLinearScan() {
+    for (const auto &name : syntheticDeviceNames(3000, 1)) {
+        QCOMPARE(kVendorMatcher.firstMatch(name), linearFirstMatch(name));
+    }
+    // Random text over the patterns' letters produces partial and overlapping matches
+    QRandomGenerator random(41);
+    const auto alphabet = QStringLiteral("SAMSUNGWDCTEINLHPsamungwdcteinlhp -");
+    for (auto i = 0; i < 10000; ++i) {
+        const auto text = randomText(random, alphabet, 23);
+        QCOMPARE(kVendorMatcher.firstMatch(text), linearFirstMatch(text));
+    }
+}
+
+void StaticMatchTest::diskManufacturers_names() {
+    const auto name = [](const QString &model) {
+        const auto index = kVendorMatcher.firstMatch(model);
+        return index < 0 ? QString() : QString::fromLatin1(diskmanufacturers::kNames[index]);
+    };
+    QCOMPARE(name(QStringLiteral("WDC WD40EFRX-68N32N0")), QStringLiteral("Western Digital"));
+    QCOMPARE(name(QStringLiteral("CT1000MX500SSD1")), QStringLiteral("Crucial"));
+    QCOMPARE(name(QStringLiteral("LITE-ON IT DVD")), QStringLiteral("Lite-On"));
+    QCOMPARE(name(QStringLiteral("SPCC Solid State Disk")), QStringLiteral("Silicon Power"));
+    QCOMPARE(name(QStringLiteral("QEMU HARDDISK")), QString());
+}
+
+QTEST_MAIN(StaticMatchTest)
+#include "staticmatchtest.moc"
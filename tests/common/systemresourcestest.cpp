@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "systemresources.h"
+
+namespace {
+
+QHash<QString, QString> sampleRaw() {
+    return {
+        {QStringLiteral("dma"), QStringLiteral(" 2: floppy\n 4: cascade\n")},
+        {QStringLiteral("ioports"),
+         QStringLiteral("0000-0cf7 : PCI Bus 0000:00\n  0060-0060 : keyboard\n")},
+        {QStringLiteral("interrupts"),
+         QStringLiteral("           CPU0       CPU1\n"
+                        "   1:         10          0  IR-IO-APIC    1-edge      i8042\n"
+                        " 131:          3          4  IR-PCI-MSIX-0000:01:00.0    5-edge      "
+                        "nvme0q5\n"
+                        "NMI:          0          0   Non-maskable interrupts\n")},
+        {QStringLiteral("iomem"),
+         QStringLiteral("00000000-00000fff : Reserved\n00001000-0009ffff : System RAM\n")},
+    };
+}
+
+} // namespace
+
+class SystemResourcesTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void fromRaw_parsesAllTables();
+    void fromRaw_irqClassification();
+    void fromRaw_missingTables();
+    void fromExport_deviceResources();
+};
+
+void SystemResourcesTest::fromRaw_parsesAllTables() {
+    const auto resources = SystemResources::fromRaw(sampleRaw());
+    QCOMPARE(resources.raw, sampleRaw());
+
+    QCOMPARE(resources.dmaChannels.size(), 2);
+    QCOMPARE(resources.dmaChannels.at(0).channel, QStringLiteral("2"));
+    QCOMPARE(resources.dmaChannels.at(0).name, QStringLiteral("floppy"));
+
+    QCOMPARE(resources.ioPorts.size(), 2);
+    QCOMPARE(resources.ioPorts.at(0).rangeEnd, QStringLiteral("0CF7"));
+    QCOMPARE(resources.ioPorts.at(1).name, QStringLiteral("keyboard"));
+    QCOMPARE(resources.ioPorts.at(1).indentLevel, 2);
+
+    QCOMPARE(resources.memoryRanges.size(), 2);
+    QCOMPARE(resources.memoryRanges.at(1).name, QStringLiteral("System RAM"));
+
+    QVERIFY(resources.deviceResources.isEmpty());
+}
+
+void SystemResourcesTest::fromRaw_irqClassification() {
+    const auto resources = SystemResources::fromRaw(sampleRaw());
+    QCOMPARE(resources.irqs.size(), 3);
+
+    const auto &msi = resources.irqs.at(1);
+    QCOMPARE(msi.irqNumber, QStringLiteral("131"));
+    QCOMPARE(msi.irqType, QStringLiteral("IR-PCI-MSIX-0000:01:00.0 5-edge"));
+    QCOMPARE(msi.deviceName, QStringLiteral("nvme0q5"));
+    QCOMPARE(msi.cpuCounts, (QList<quint64>{3, 4}));
+    QVERIFY(msi.affinity.isEmpty());
+
+    QCOMPARE(resources.irqs.at(2).deviceName, QStringLiteral("Non-maskable interrupts"));
+}
+
+void SystemResourcesTest::fromRaw_missingTables() {
+    const auto resources = SystemResources::fromRaw({{QStringLiteral("dma"), QString()}});
+    QVERIFY(resources.dmaChannels.isEmpty());
+    QVERIFY(resources.ioPorts.isEmpty());
+    QVERIFY(resources.irqs.isEmpty());
+    QVERIFY(resources.memoryRanges.isEmpty());
+}
+
+void SystemResourcesTest::fromExport_deviceResources() {
+    QJsonObject systemResources;
+    const auto raw = sampleRaw();
+    for (auto it = raw.cbegin(); it != raw.cend(); ++it) {
+        systemResources[it.key()] = it.value();
+    }
+
+    QJsonObject irq{{QStringLiteral("type"), QStringLiteral("IRQ")},
+                    {QStringLiteral("displayValue"), QStringLiteral("0X00000010 (16)")},
+                    {QStringLiteral("value"), 16}};
+    QJsonObject bar{{QStringLiteral("type"), QStringLiteral("Memory Range")},
+                    {QStringLiteral("displayValue"),
+                     QStringLiteral("00000000DE000000 - 00000000DE003FFF")},
+                    {QStringLiteral("start"), QStringLiteral("DE000000")},
+                    {QStringLiteral("end"), QStringLiteral("DE003FFF")},
+                    {QStringLiteral("flags"), QStringLiteral("140204")}};
+    QJsonObject withResources{
+        {QStringLiteral("syspath"), QStringLiteral("/sys/devices/pci0000:00/0000:01:00.0")},
+        {QStringLiteral("resources"), QJsonArray{irq, bar}}};
+    QJsonObject withoutResources{
+        {QStringLiteral("syspath"), QStringLiteral("/sys/devices/platform/i8042")}};
+
+    const auto resources = SystemResources::fromExport(
+        systemResources, {DeviceInfo(withResources), DeviceInfo(withoutResources)});
+    QCOMPARE(resources.irqs.size(), 3);
+    QCOMPARE(resources.deviceResources.size(), 1);
+
+    const auto list =
+        resources.deviceResources.value(QStringLiteral("/sys/devices/pci0000:00/0000:01:00.0"));
+    QCOMPARE(list.size(), 2);
+    QCOMPARE(list.at(0).type, QStringLiteral("IRQ"));
+    QCOMPARE(list.at(0).value, 16);
+    QCOMPARE(list.at(1).start, QStringLiteral("DE000000"));
+    QCOMPARE(list.at(1).flags, QStringLiteral("140204"));
+}
+
+QTEST_MAIN(SystemResourcesTest)
+#include "systemresourcestest.moc"
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QStringList>
+#include <QtTest/QTest>
+
+#include "termmatcher.h"
+
+namespace {
+
+// Reference behaviour: the first term contained in the text
+int linearFirstMatch(const QStringList &terms, const QString &text) {
+    for (qsizetype i = 0; i < terms.size(); ++i) {
+        if (text.contains(terms.at(i), Qt::CaseInsensitive)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace
+
+class TermMatcherTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void firstMatch_priority();
+    void firstMatch_overlappingTerms();
+    void caseInsensitive();
+    void emptyTerms();
+    void nonAscii();
+    void loneSurrogate();
+    void matchesLinearSearch();
+};
+
+void TermMatcherTest::firstMatch_priority() {
+    const TermMatcher matcher({QStringLiteral("abc"), QStringLiteral("b")});
+    QCOMPARE(matcher.termCount(), 2);
+    QCOMPARE(matcher.firstMatch(QStringView(u"xabcx")), 0);
+    QCOMPARE(matcher.firstMatch(QStringView(u"xbx")), 1);
+    // The earlier-listed term wins even when the later one occurs first
+    QCOMPARE(matcher.firstMatch(QStringView(u"b then abc")), 0);
+    QCOMPARE(matcher.firstMatch(QStringView(u"xyz")), -1);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("b then abc")), 0);
+    QVERIFY(matcher.matches(QByteArrayView("xbx")));
+    QVERIFY(!matcher.matches(QByteArrayView("xyz")));
+}
+
+void TermMatcherTest::firstMatch_overlappingTerms() {
+    const TermMatcher matcher({QStringLiteral("hers"),
+                               QStringLiteral("his"),
+                               QStringLiteral("she"),
+                               QStringLiteral("he")});
+    QCOMPARE(matcher.firstMatch(QByteArrayView("ushers")), 0);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("ushe")), 2);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("ahe")), 3);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("hhis")), 1);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("hs")), -1);
+}
+
+void TermMatcherTest::caseInsensitive() {
+    const TermMatcher matcher({QStringLiteral("idVendor=046d"), QStringLiteral("USB")});
+    QCOMPARE(matcher.firstMatch(QByteArrayView("New USB device found, IDVENDOR=046D")), 0);
+    QCOMPARE(matcher.firstMatch(QStringView(u"usb 1-2: new full-speed device")), 1);
+    QCOMPARE(matcher.firstMatch(QStringView(u"idvendor=046")), -1);
+}
+
+void TermMatcherTest::emptyTerms() {
+    QVERIFY(!TermMatcher().matches(QByteArrayView("anything")));
+    QVERIFY(!TermMatcher().matches(QStringView()));
+    QVERIFY(!TermMatcher(QStringList()).matches(QByteArrayView("anything")));
+    QCOMPARE(TermMatcher().termCount(), 0);
+
+    // As with QString::contains(), an empty term is in every text, including an empty one
+    const TermMatcher matcher({QStringLiteral("x"), QString()});
+    QCOMPARE(matcher.firstMatch(QByteArrayView("abc")), 1);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("abx")), 0);
+    QCOMPARE(matcher.firstMatch(QStringView()), 1);
+}
+
+void TermMatcherTest::nonAscii() {
+    const TermMatcher matcher({QStringLiteral("Café"), QStringLiteral("🙂")});
+    QCOMPARE(matcher.firstMatch(QStringView(u"associated with CAFÉ, not CAFé")), 0);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("associated with CAFé")), 0);
+    // Only ASCII letters are folded
+    QCOMPARE(matcher.firstMatch(QStringView(u"associated with CAFÉ")), -1);
+    QCOMPARE(matcher.firstMatch(QStringView(u"smile 🙂")), 1);
+    QCOMPARE(matcher.firstMatch(QByteArrayView("smile 🙂")), 1);
+    // A multi-byte character does not match another sharing its lead byte
+    QCOMPARE(matcher.firstMatch(QStringView(u"Cafè 🙃")), -1);
+}
+
+void TermMatcherTest::loneSurrogate() {
+    const TermMatcher matcher({QString(QChar::ReplacementCharacter)});
+    auto text = QStringLiteral("broken ");
+    text.append(QChar(0xd800));
+    QVERIFY(matcher.matches(text));
+    QVERIFY(!matcher.matches(QStringView(u"🙂")));
+}
+
+void TermMatcherTest::matchesLinearSearch() {
+    // Small alphabet so that terms overlap often
+    static const QString alphabet = QStringLiteral("abAB-é");
+    QRandomGenerator random(7);
+    const auto randomText = [&random](int maxLength) {
+        QString text;
+        const auto length = random.bounded(maxLength + 1);
+        for (auto i = 0; i < length; ++i) {
+            text.append(alphabet.at(random.bounded(static_cast<int>(alphabet.size()))));
+        }
+        return text;
+    };
+    for (auto round = 0; round < 2000; ++round) {
+        QStringList terms;
+        const auto termCount = random.bounded(1, 5);
+        for (auto i = 0; i < termCount; ++i) {
+            terms.append(randomText(4));
+        }
+        const TermMatcher matcher(terms);
+        for (auto i = 0; i < 10; ++i) {
+            const auto text = randomText(24);
+            const auto expected = linearFirstMatch(terms, text);
+            QCOMPARE(matcher.firstMatch(text), expected);
+            QCOMPARE(matcher.firstMatch(text.toUtf8()), expected);
+            QCOMPARE(matcher.matches(text), expected >= 0);
+        }
+    }
+}
+
+QTEST_MAIN(TermMatcherTest)
+#include "termmatchertest.moc"
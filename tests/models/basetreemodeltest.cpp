@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QTest>
+
+#include "models/basetreemodel.h"
+
+namespace {
+
+class TestTreeModel : public BaseTreeModel {
+public:
+    explicit TestTreeModel(Node *root) {
+        setRootItem(root);
+    }
+};
+
+Node *addNode(Node *parent, const QString &text) {
+    auto *node = new Node({text}, parent);
+    parent->appendChild(node);
+    return node;
+}
+
+// Shaped like Devices by type: categories of devices under the host
+Node *sampleTree() {
+    auto *root = new Node({QString()});
+    auto *host = addNode(root, QStringLiteral("host"));
+    auto *keyboards = addNode(host, QStringLiteral("Keyboards"));
+    addNode(keyboards, QStringLiteral("AT Translated Set 2 keyboard"));
+    addNode(keyboards, QStringLiteral("USB Keyboard"));
+    auto *mice = addNode(host, QStringLiteral("Mice and other pointing devices"));
+    addNode(mice, QStringLiteral("USB Optical Mouse"));
+    addNode(host, QStringLiteral("Batteries"));
+    return root;
+}
+
+std::function<bool(const Node *)> containing(const QString &term) {
+    return [term](const Node *node) {
+        return node->data(0).toString().contains(term, Qt::CaseInsensitive);
+    };
+}
+
+QStringList childTexts(const QAbstractItemModel &model, const QModelIndex &parent) {
+    QStringList result;
+    for (auto row = 0; row < model.rowCount(parent); ++row) {
+        result << model.index(row, 0, parent).data().toString();
+    }
+    return result;
+}
+
+QStringList texts(const QModelIndexList &indexes) {
+    QStringList result;
+    for (const auto &index : indexes) {
+        result << index.data().toString();
+    }
+    result.sort();
+    return result;
+}
+
+} // namespace
+
+class BaseTreeModelTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void setFilter_keepsAncestorsOfMatches();
+    void setFilter_matchedLabelShowsChildren();
+    void setFilter_loadsDeferredChildren();
+    void clearFilter_showsEverything();
+};
+
+void BaseTreeModelTest::setFilter_keepsAncestorsOfMatches() {
+    TestTreeModel model(sampleTree());
+    model.setFilter(containing(QStringLiteral("usb")));
+
+    const auto host = model.index(0, 0);
+    QCOMPARE(childTexts(model, host),
+             QStringList({QStringLiteral("Keyboards"),
+                          QStringLiteral("Mice and other pointing devices")}));
+    QCOMPARE(childTexts(model, model.index(0, 0, host)),
+             QStringList({QStringLiteral("USB Keyboard")}));
+    // Only the ancestors of the matches need expanding
+    QCOMPARE(texts(model.matchAncestors()),
+             QStringList({QStringLiteral("Keyboards"),
+                          QStringLiteral("Mice and other pointing devices"),
+                          QStringLiteral("host")}));
+}
+
+void BaseTreeModelTest::setFilter_matchedLabelShowsChildren() {
+    TestTreeModel model(sampleTree());
+    model.setFilter(containing(QStringLiteral("keyboards")));
+
+    const auto host = model.index(0, 0);
+    QCOMPARE(childTexts(model, host), QStringList({QStringLiteral("Keyboards")}));
+    // The category matched, so its devices are shown even though they do not match
+    QCOMPARE(childTexts(model, model.index(0, 0, host)).size(), 2);
+    QCOMPARE(texts(model.matchAncestors()), QStringList({QStringLiteral("host")}));
+}
+
+void BaseTreeModelTest::setFilter_loadsDeferredChildren() {
+    auto *root = sampleTree();
+    auto *batteries = root->child(0)->child(2);
+    batteries->setChildLoader(1, [](Node *item) { addNode(item, QStringLiteral("BAT0")); });
+    TestTreeModel model(root);
+    model.setFilter(containing(QStringLiteral("bat0")));
+
+    const auto host = model.index(0, 0);
+    QCOMPARE(childTexts(model, host), QStringList({QStringLiteral("Batteries")}));
+    QCOMPARE(childTexts(model, model.index(0, 0, host)), QStringList({QStringLiteral("BAT0")}));
+}
+
+void BaseTreeModelTest::clearFilter_showsEverything() {
+    TestTreeModel model(sampleTree());
+    model.setFilter(containing(QStringLiteral("nothing matches this")));
+    QCOMPARE(model.rowCount(), 0);
+    QVERIFY(model.matchAncestors().isEmpty());
+
+    model.clearFilter();
+    QVERIFY(!model.isFiltered());
+    QCOMPARE(childTexts(model, model.index(0, 0)).size(), 3);
+    QVERIFY(model.matchAncestors().isEmpty());
+}
+
+QTEST_MAIN(BaseTreeModelTest)
+#include "basetreemodeltest.moc"
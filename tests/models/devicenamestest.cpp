@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+#include <QtCore/QJsonObject>
+#include <QtTest/QTest>
+
+#include "deviceinfo.h"
+#include "devicenames.h"
+#include "namemappings.h"
+
+namespace {
+
+DeviceInfo makeDevice(const QString &syspath,
+                      const QString &name,
+                      const QString &subsystem,
+                      DeviceCategory category = DeviceCategory::Unknown,
+                      const QJsonObject &properties = {}) {
+    QJsonObject json;
+    json[QStringLiteral("syspath")] = syspath;
+    json[QStringLiteral("devPath")] = syspath.mid(4);
+    json[QStringLiteral("name")] = name;
+    json[QStringLiteral("subsystem")] = subsystem;
+    json[QStringLiteral("category")] = static_cast<int>(category);
+    json[QStringLiteral("properties")] = properties;
+    return DeviceInfo(json);
+}
+
+} // namespace
+
+class DeviceNamesTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void names_unnamedDevice();
+    void names_acpiDevice();
+    void names_noPrefixForMappedSubsystems();
+    void typeNames_storageVolume();
+    void typeNames_softwareDevice();
+    void sortByName_usesDisplayNames();
+    void sortByTypeName_usesVolumeLabels();
+    void clear_removesNames();
+};
+
+void DeviceNamesTest::initTestCase() {
+    NameMappings::instance().clear();
+    NameMappings::instance().loadFromFile(QStringLiteral(HWVIEW_TEST_DATA_DIR) +
+                                          QStringLiteral("/name-mappings-test.json"));
+}
+
+void DeviceNamesTest::cleanupTestCase() {
+    NameMappings::instance().reload();
+}
+
+void DeviceNamesTest::names_unnamedDevice() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/virtual/misc/fuse"),
+                            QString(),
+                            QStringLiteral("misc"))});
+    QCOMPARE(names.size(), 1);
+    const auto &entry = names.at(0);
+    QCOMPARE(entry.rawName, QStringLiteral("fuse"));
+    QCOMPARE(entry.name, QStringLiteral("FUSE"));
+    QCOMPARE(entry.connectionRawName, QStringLiteral("[misc] fuse"));
+    QCOMPARE(entry.connectionName, QStringLiteral("[misc] FUSE"));
+}
+
+void DeviceNamesTest::names_acpiDevice() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/LNXSYSTM:00/PNP0C0A:00"),
+                            QString(),
+                            QStringLiteral("acpi"))});
+    const auto &entry = names.at(0);
+    QCOMPARE(entry.rawName, QStringLiteral("PNP0C0A:00"));
+    QCOMPARE(entry.name, QStringLiteral("ACPI-Compliant Control Method Battery"));
+    QCOMPARE(entry.connectionName, entry.name);
+}
+
+void DeviceNamesTest::names_noPrefixForMappedSubsystems() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:1f.4/i2c-1"),
+                            QString(),
+                            QStringLiteral("i2c")),
+                 makeDevice(QStringLiteral("/sys/devices/virtual/misc/kvm"),
+                            QStringLiteral("kvm"),
+                            QStringLiteral("misc"))});
+    QCOMPARE(names.at(0).connectionName, QStringLiteral("I²C Adapter 1"));
+    QCOMPARE(names.at(0).connectionRawName, QStringLiteral("i2c-1"));
+    // Only unnamed devices get the subsystem prefix
+    QCOMPARE(names.at(1).connectionName, QStringLiteral("KVM"));
+    QCOMPARE(names.at(1).connectionRawName, QStringLiteral("kvm"));
+}
+
+void DeviceNamesTest::typeNames_storageVolume() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/virtual/block/sda1"),
+                            QStringLiteral("sda1"),
+                            QStringLiteral("block"),
+                            DeviceCategory::StorageVolumes,
+                            {{QStringLiteral("ID_FS_LABEL"), QStringLiteral("Data")}}),
+                 makeDevice(QStringLiteral("/sys/devices/virtual/block/sda2"),
+                            QStringLiteral("sda2"),
+                            QStringLiteral("block"),
+                            DeviceCategory::StorageVolumes,
+                            {{QStringLiteral("ID_PART_ENTRY_NAME"), QStringLiteral("EFI")},
+                             {QStringLiteral("ID_FS_LABEL"), QStringLiteral("ESP")}})});
+    QCOMPARE(names.at(0).typeName, QStringLiteral("Data"));
+    QCOMPARE(names.at(0).typeRawName, QStringLiteral("sda1"));
+    QCOMPARE(names.at(1).typeName, QStringLiteral("EFI"));
+}
+
+void DeviceNamesTest::typeNames_softwareDevice() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/virtual/block/loop0"),
+                            QStringLiteral("/dev/loop0"),
+                            QStringLiteral("block"),
+                            DeviceCategory::SoftwareDevices)});
+    QCOMPARE(names.at(0).typeRawName, QStringLiteral("loop0"));
+    QCOMPARE(names.at(0).typeName, QStringLiteral("Loop device 0"));
+}
+
+void DeviceNamesTest::sortByName_usesDisplayNames() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:17.0/ata1/sda"),
+                            QStringLiteral("sda"),
+                            QStringLiteral("block")),
+                 makeDevice(QStringLiteral("/sys/devices/pci0000:00/0000:00:17.0/target0:0:0"),
+                            QStringLiteral("target0:0:0"),
+                            QStringLiteral("scsi"))});
+    // By raw name "sda" would come first; "SCSI Target 0:0:0" is what the views show
+    QList<int> indexes{0, 1};
+    names.sortByName(indexes);
+    QCOMPARE(indexes, QList<int>({1, 0}));
+}
+
+void DeviceNamesTest::sortByTypeName_usesVolumeLabels() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/virtual/block/sda1"),
+                            QStringLiteral("sda1"),
+                            QStringLiteral("block"),
+                            DeviceCategory::StorageVolumes),
+                 makeDevice(QStringLiteral("/sys/devices/virtual/block/sdz1"),
+                            QStringLiteral("sdz1"),
+                            QStringLiteral("block"),
+                            DeviceCategory::StorageVolumes,
+                            {{QStringLiteral("ID_FS_LABEL"), QStringLiteral("Backup")}})});
+    QList<int> indexes{0, 1};
+    names.sortByTypeName(indexes);
+    QCOMPARE(indexes, QList<int>({1, 0}));
+}
+
+void DeviceNamesTest::clear_removesNames() {
+    DeviceNames names;
+    names.build({makeDevice(QStringLiteral("/sys/devices/virtual/misc/fuse"),
+                            QStringLiteral("fuse"),
+                            QStringLiteral("misc"))});
+    names.clear();
+    QCOMPARE(names.size(), 0);
+}
+
+QTEST_MAIN(DeviceNamesTest)
+#include "devicenamestest.moc"
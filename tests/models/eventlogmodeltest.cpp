@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include "models/eventlogmodel.h"
+
+namespace {
+
+QList<ParsedEvent> makeEvents(int first, int count) {
+    QList<ParsedEvent> events;
+    for (auto i = first; i < first + count; ++i) {
+        events.append({QString::number(i), QStringLiteral("message %1").arg(i)});
+    }
+    return events;
+}
+
+QStringList timestamps(const EventLogModel &model) {
+    QStringList result;
+    for (auto row = 0; row < model.rowCount(); ++row) {
+        result << model.event(row).timestamp;
+    }
+    return result;
+}
+
+} // namespace
+
+class EventLogModelTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void data();
+    void appendEvents_withinCapacity();
+    void appendEvents_dropsOldest();
+    void appendEvents_largerThanCapacity();
+    void appendEvents_empty();
+    void setEvents_keepsNewest();
+};
+
+void EventLogModelTest::data() {
+    EventLogModel model(10);
+    model.appendEvents({{QStringLiteral("today"), QStringLiteral("usb 1-2: reset")}});
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.columnCount(), 2);
+    QCOMPARE(model.data(model.index(0, EventLogModel::TimestampColumn)).toString(),
+             QStringLiteral("today"));
+    QCOMPARE(model.data(model.index(0, EventLogModel::MessageColumn)).toString(),
+             QStringLiteral("usb 1-2: reset"));
+    QVERIFY(!model.data(model.index(0, 0), Qt::DecorationRole).isValid());
+    QCOMPARE(model.headerData(EventLogModel::MessageColumn, Qt::Horizontal).toString(),
+             QStringLiteral("Event"));
+    QCOMPARE(model.rowCount(model.index(0, 0)), 0);
+}
+
+void EventLogModelTest::appendEvents_withinCapacity() {
+    EventLogModel model(10);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+
+    model.appendEvents(makeEvents(0, 3));
+    model.appendEvents(makeEvents(3, 4));
+
+    QCOMPARE(model.rowCount(), 7);
+    QCOMPARE(inserted.count(), 2);
+    QCOMPARE(inserted.at(1).at(1).toInt(), 3);
+    QCOMPARE(inserted.at(1).at(2).toInt(), 6);
+    QCOMPARE(removed.count(), 0);
+}
+
+void EventLogModelTest::appendEvents_dropsOldest() {
+    EventLogModel model(5);
+    model.appendEvents(makeEvents(0, 4));
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+
+    model.appendEvents(makeEvents(4, 3));
+
+    QCOMPARE(model.rowCount(), 5);
+    QCOMPARE(timestamps(model),
+             QStringList({QStringLiteral("2"),
+                          QStringLiteral("3"),
+                          QStringLiteral("4"),
+                          QStringLiteral("5"),
+                          QStringLiteral("6")}));
+    // One removal and one insertion for the whole batch
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(removed.at(0).at(1).toInt(), 0);
+    QCOMPARE(removed.at(0).at(2).toInt(), 1);
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(inserted.at(0).at(1).toInt(), 2);
+    QCOMPARE(inserted.at(0).at(2).toInt(), 4);
+}
+
+void EventLogModelTest::appendEvents_largerThanCapacity() {
+    EventLogModel model(3);
+    model.appendEvents(makeEvents(0, 2));
+    model.appendEvents(makeEvents(2, 5));
+    QCOMPARE(timestamps(model),
+             QStringList({QStringLiteral("4"), QStringLiteral("5"), QStringLiteral("6")}));
+}
+
+void EventLogModelTest::appendEvents_empty() {
+    EventLogModel model(3);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    model.appendEvents({});
+    QCOMPARE(inserted.count(), 0);
+    QCOMPARE(model.rowCount(), 0);
+}
+
+void EventLogModelTest::setEvents_keepsNewest() {
+    EventLogModel model(0);
+    QCOMPARE(model.capacity(), 1);
+
+    EventLogModel bounded(2);
+    bounded.appendEvents(makeEvents(0, 2));
+    bounded.setEvents(makeEvents(10, 3));
+    QCOMPARE(timestamps(bounded), QStringList({QStringLiteral("11"), QStringLiteral("12")}));
+    bounded.setEvents({});
+    QCOMPARE(bounded.rowCount(), 0);
+}
+
+QTEST_MAIN(EventLogModelTest)
+#include "eventlogmodeltest.moc"
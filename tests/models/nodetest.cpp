@@ -15,18 +15,25 @@ private Q_SLOTS:
     void childCount();
     void columnCount();
     void data_validColumn();
+    void setData();
     void parentItem();
     void row();
     void setIcon_icon();
     void type_setType();
     void syspath_setSyspath();
     void isHidden_setIsHidden();
+    void key_fallbacks();
+    void key_setKey();
+    void key_sameNamedSiblings();
     void rawName_setRawName();
     void sortChildren();
     void sortChildren_updatesRowIndices();
     void disabledPixmap_noIcon();
     void disabledPixmap_withIcon();
     void disabledPixmap_caching();
+    void childLoader_defersChildren();
+    void childLoader_runsOnce();
+    void childLoader_none();
 };
 
 void NodeTest::defaultConstructor() {
@@ -105,6 +112,13 @@ void NodeTest::data_validColumn() {
     QCOMPARE(node.data(2).toBool(), true);
 }
 
+void NodeTest::setData() {
+    Node node({QStringLiteral("Name"), QStringLiteral("Details")});
+    node.setData(0, QStringLiteral("Renamed"));
+    QCOMPARE(node.data(0).toString(), QStringLiteral("Renamed"));
+    QCOMPARE(node.data(1).toString(), QStringLiteral("Details"));
+}
+
 void NodeTest::parentItem() {
     Node parent;
     Node child({}, &parent);
@@ -245,5 +259,92 @@ void NodeTest::disabledPixmap_caching() {
     QCOMPARE(first.cacheKey(), second.cacheKey());
 }
 
+void NodeTest::key_fallbacks() {
+    Node empty;
+    QVERIFY(empty.key().isEmpty());
+
+    Node node({QStringLiteral("Display Name")});
+    QCOMPARE(node.key(), QStringLiteral("Display Name"));
+
+    node.setSyspath(QStringLiteral("/sys/devices/test"));
+    QCOMPARE(node.key(), QStringLiteral("/sys/devices/test"));
+}
+
+void NodeTest::key_setKey() {
+    Node node({QStringLiteral("Keyboards")});
+    node.setSyspath(QStringLiteral("/sys/devices/test"));
+    node.setKey(NodeKeys::category(8));
+    QCOMPARE(node.key(), QStringLiteral("category:8"));
+    QCOMPARE(NodeKeys::driver(QStringLiteral("i915")), QStringLiteral("driver:i915"));
+    QCOMPARE(NodeKeys::resourceType(QStringLiteral("irq")), QStringLiteral("resource:irq"));
+    QCOMPARE(NodeKeys::dmaChannel(QStringLiteral("4")), QStringLiteral("dma:4"));
+    QCOMPARE(
+        NodeKeys::range(QStringLiteral("0000"), QStringLiteral("0cf7"), QStringLiteral("PCI Bus")),
+        QStringLiteral("range:0000-0cf7 PCI Bus"));
+}
+
+void NodeTest::key_sameNamedSiblings() {
+    Node root({QStringLiteral("Root")});
+    root.setKey(NodeKeys::resourceType(QStringLiteral("dma")));
+    auto *first = new Node({QStringLiteral("cascade")}, &root);
+    auto *other = new Node({QStringLiteral("floppy")}, &root);
+    auto *second = new Node({QStringLiteral("cascade")}, &root);
+    root.appendChild(first);
+    root.appendChild(other);
+    root.appendChild(second);
+
+    QCOMPARE(first->key(), QStringLiteral("resource:dma/cascade"));
+    QCOMPARE(second->key(), QStringLiteral("resource:dma/cascade#1"));
+    QCOMPARE(other->key(), QStringLiteral("resource:dma/floppy"));
+
+    // Same-named nodes under different parents differ by their parents' keys
+    auto *child = new Node({QStringLiteral("reserved")}, first);
+    first->appendChild(child);
+    auto *cousin = new Node({QStringLiteral("reserved")}, second);
+    second->appendChild(cousin);
+    QVERIFY(child->key() != cousin->key());
+}
+
+void NodeTest::childLoader_defersChildren() {
+    Node parent;
+    parent.setChildLoader(2, [](Node *item) {
+        item->appendChild(new Node({QStringLiteral("Child 1")}, item));
+        item->appendChild(new Node({QStringLiteral("Child 2")}, item));
+    });
+
+    QCOMPARE(parent.childCount(), 0);
+    QCOMPARE(parent.pendingChildCount(), 2);
+
+    parent.loadChildren();
+
+    QCOMPARE(parent.childCount(), 2);
+    QCOMPARE(parent.pendingChildCount(), 0);
+    QCOMPARE(parent.child(1)->row(), 1);
+}
+
+void NodeTest::childLoader_runsOnce() {
+    Node parent;
+    auto calls = 0;
+    parent.setChildLoader(1, [&calls](Node *item) {
+        ++calls;
+        item->appendChild(new Node({QStringLiteral("Child")}, item));
+    });
+
+    parent.loadChildren();
+    parent.loadChildren();
+
+    QCOMPARE(calls, 1);
+    QCOMPARE(parent.childCount(), 1);
+}
+
+void NodeTest::childLoader_none() {
+    Node parent;
+    QCOMPARE(parent.pendingChildCount(), 0);
+    parent.loadChildren();
+    QCOMPARE(parent.childCount(), 0);
+    parent.setChildLoader(3, nullptr);
+    QCOMPARE(parent.pendingChildCount(), 0);
+}
+
 QTEST_MAIN(NodeTest)
 #include "nodetest.moc"
@@ -0,0 +1,198 @@
+// SPDX-License-Identifier: MIT
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QSignalSpy>
+#include <QtTest/QTest>
+
+#include "kmsgeventstream.h"
+
+namespace {
+
+const QString kSyspath = QStringLiteral("/sys/devices/pci0000:00/0000:00:14.0/usb1/1-2");
+
+// A FIFO standing in for /dev/kmsg, and the writing end the test plays the kernel with
+class FakeKmsg {
+public:
+    explicit FakeKmsg(const QTemporaryDir &dir) : path_(dir.filePath(QStringLiteral("kmsg"))) {
+        created_ = mkfifo(path_.toLocal8Bit().constData(), 0600) == 0;
+    }
+
+    ~FakeKmsg() {
+        closeWriter();
+    }
+
+    bool isCreated() const {
+        return created_;
+    }
+
+    const QString &path() const {
+        return path_;
+    }
+
+    // Only succeeds once the stream has opened the reading end
+    bool openWriter() {
+        fd_ = ::open(path_.toLocal8Bit().constData(), O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+        return fd_ >= 0;
+    }
+
+    void closeWriter() {
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool write(const QByteArray &records) {
+        return ::write(fd_, records.constData(), static_cast<std::size_t>(records.size())) ==
+               records.size();
+    }
+
+private:
+    QString path_;
+    bool created_ = false;
+    int fd_ = -1;
+};
+
+QList<DeviceEvent> receivedEvents(const QSignalSpy &spy) {
+    QList<DeviceEvent> events;
+    for (const auto &arguments : spy) {
+        events << arguments.at(0).value<QList<DeviceEvent>>();
+    }
+    return events;
+}
+
+QStringList receivedLines(const QSignalSpy &spy) {
+    QStringList lines;
+    for (const auto &event : receivedEvents(spy)) {
+        lines << event.line;
+    }
+    return lines;
+}
+
+} // namespace
+
+class KmsgEventStreamTest : public QObject {
+    Q_OBJECT
+
+private Q_SLOTS:
+    void start_missingLog();
+    void followsDevice();
+    void splitsRecords();
+    void batchesReads();
+    void stop();
+};
+
+void KmsgEventStreamTest::start_missingLog() {
+    KmsgEventStream stream(kSyspath, {}, QStringLiteral("/nonexistent/kmsg"));
+    QVERIFY(!stream.start());
+    QVERIFY(!stream.isRunning());
+}
+
+void KmsgEventStreamTest::followsDevice() {
+    QTemporaryDir dir;
+    FakeKmsg kmsg(dir);
+    QVERIFY(kmsg.isCreated());
+    KmsgEventStream stream(kSyspath, {QStringLiteral("hidraw3")}, kmsg.path());
+    stream.setBatchInterval(0);
+    QSignalSpy spy(&stream, &DeviceEventStream::eventsReceived);
+    QVERIFY(stream.start());
+    QVERIFY(stream.isRunning());
+    QVERIFY(kmsg.openWriter());
+
+    QVERIFY(kmsg.write(
+        // Not about the device
+        "6,100,1000000,-;audit: type=1400 apparmor=\"STATUS\"\n"
+        // From a program rather than the kernel (facility 1)
+        "14,101,2000000,-;hidraw3 from user space\n"
+        // Malformed
+        "garbage\n"
+        // Names the device's hidraw node
+        "6,102,3000000,-;hid-generic 0003:046D:C52B.0004: hidraw3: USB HID v1.11 Device\n"
+        // Escaped text, named without case
+        "4,103,4000000,-;HIDRAW3:\\x20caf\\xc3\\xa9\n"));
+    QVERIFY(spy.wait());
+
+    const auto lines = receivedLines(spy);
+    QCOMPARE(lines.size(), 2);
+    QVERIFY(lines.at(0).endsWith(
+        QStringLiteral(" kernel: hid-generic 0003:046D:C52B.0004: hidraw3: USB HID v1.11 Device")));
+    QVERIFY(lines.at(1).endsWith(QStringLiteral(" kernel: HIDRAW3: café")));
+    // Entries are identified by their records' sequence numbers
+    const auto events = receivedEvents(spy);
+    QCOMPARE(events.at(0).cursor, QStringLiteral("102"));
+    QCOMPARE(events.at(1).cursor, QStringLiteral("103"));
+}
+
+void KmsgEventStreamTest::splitsRecords() {
+    QTemporaryDir dir;
+    FakeKmsg kmsg(dir);
+    QVERIFY(kmsg.isCreated());
+    KmsgEventStream stream(kSyspath, {QStringLiteral("usb 1-2")}, kmsg.path());
+    stream.setBatchInterval(0);
+    QSignalSpy spy(&stream, &DeviceEventStream::eventsReceived);
+    QVERIFY(stream.start());
+    QVERIFY(kmsg.openWriter());
+
+    // Continuation lines belong to the record before them, even when written separately from the
+    // next record; a record is only read once its newline has arrived
+    QVERIFY(kmsg.write("6,200,1000000,-;usb 1-2: reset full-speed USB device\n"
+                       " SUBSYSTEM=nonexistent\n"
+                       " DEVICE=+nonexistent:1-2\n"
+                       "6,201,2000000,-;usb 1-2: USB disconnect"));
+    QVERIFY(spy.wait());
+    QCOMPARE(receivedLines(spy).size(), 1);
+
+    QVERIFY(kmsg.write(", device number 3\n"));
+    QVERIFY(spy.wait());
+    const auto lines = receivedLines(spy);
+    QCOMPARE(lines.size(), 2);
+    QVERIFY(
+        lines.at(1).endsWith(QStringLiteral(" kernel: usb 1-2: USB disconnect, device number 3")));
+}
+
+void KmsgEventStreamTest::batchesReads() {
+    QTemporaryDir dir;
+    FakeKmsg kmsg(dir);
+    QVERIFY(kmsg.isCreated());
+    KmsgEventStream stream(kSyspath, {QStringLiteral("usb 1-2")}, kmsg.path());
+    stream.setBatchInterval(100);
+    QSignalSpy spy(&stream, &DeviceEventStream::eventsReceived);
+    QVERIFY(stream.start());
+    QVERIFY(kmsg.openWriter());
+
+    // A reset loop: the records arrive over several reads but are delivered together
+    for (auto i = 0; i < 3; ++i) {
+        QVERIFY(kmsg.write(QStringLiteral("6,%1,%2,-;usb 1-2: reset full-speed USB device\n")
+                               .arg(300 + i)
+                               .arg((i + 1) * 1000000)
+                               .toUtf8()));
+        QTest::qWait(10);
+    }
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(receivedLines(spy).size(), 3);
+}
+
+void KmsgEventStreamTest::stop() {
+    QTemporaryDir dir;
+    FakeKmsg kmsg(dir);
+    QVERIFY(kmsg.isCreated());
+    KmsgEventStream stream(kSyspath, {QStringLiteral("usb 1-2")}, kmsg.path());
+    stream.setBatchInterval(50);
+    QSignalSpy spy(&stream, &DeviceEventStream::eventsReceived);
+    QVERIFY(stream.start());
+    QVERIFY(kmsg.openWriter());
+
+    QVERIFY(kmsg.write("6,400,1000000,-;usb 1-2: reset full-speed USB device\n"));
+    QTest::qWait(10);
+    stream.stop();
+    QVERIFY(!stream.isRunning());
+    // Lines still waiting for the batch timer are dropped
+    QVERIFY(!spy.wait(200));
+}
+
+QTEST_MAIN(KmsgEventStreamTest)
+#include "kmsgeventstreamtest.moc"